@@ -24,6 +24,7 @@ namespace Venus {
 		SerializeRegistry();
 		
 		s_AssetRegistry.Clear();
+		s_AssetHandleIndex.clear();
 		s_LoadedAssets.clear();
 		s_MemoryAssets.clear();
 	}
@@ -35,13 +36,7 @@ namespace Venus {
 
 	const AssetMetadata& AssetManager::GetMetadata(AssetHandle handle)
 	{
-		for (auto& [filepath, metadata] : s_AssetRegistry)
-		{
-			if (metadata.Handle == handle)
-				return metadata;
-		}
-
-		return AssetMetadata();
+		return GetMetadata_Internal(handle);
 	}
 
 	const AssetMetadata& AssetManager::GetMetadata(const std::filesystem::path& path)
@@ -49,19 +44,41 @@ namespace Venus {
 		if (s_AssetRegistry.Contains(path))
 			return s_AssetRegistry[path];
 
-		return AssetMetadata();
+		return s_NullMetadata;
 	}
 
 
 	AssetMetadata& AssetManager::GetMetadata_Internal(AssetHandle handle)
 	{
-		for (auto& [filepath, metadata] : s_AssetRegistry)
-		{
-			if (metadata.Handle == handle)
-				return metadata;
-		}
+		if (const auto iter = s_AssetHandleIndex.find(handle); iter != s_AssetHandleIndex.end())
+			return *iter->second;
+
+		s_NullMetadata = AssetMetadata();
+		return s_NullMetadata;
+	}
+
+	AssetMetadata& AssetManager::RegisterMetadata(const AssetMetadata& metadata)
+	{
+		auto& entry = s_AssetRegistry[metadata.FilePath];
 
-		return AssetMetadata();
+		// Path was owned by another handle, drop the stale index entry
+		if (entry.IsValid() && entry.Handle != metadata.Handle)
+			s_AssetHandleIndex.erase(entry.Handle);
+
+		entry = metadata;
+		s_AssetHandleIndex[entry.Handle] = &entry;
+
+		return entry;
+	}
+
+	void AssetManager::UnregisterMetadata(AssetHandle handle)
+	{
+		const auto iter = s_AssetHandleIndex.find(handle);
+		if (iter == s_AssetHandleIndex.end())
+			return;
+
+		s_AssetRegistry.Remove(iter->second->FilePath);
+		s_AssetHandleIndex.erase(iter);
 	}
 
 	AssetHandle AssetManager::ImportAsset(const std::filesystem::path& path)
@@ -81,14 +98,14 @@ namespace Venus {
 		metadata.FilePath = relativePath;
 		metadata.Type = type;
 
-		s_AssetRegistry[relativePath] = metadata;
+		RegisterMetadata(metadata);
 
 		return metadata.Handle;
 	}
 
 	std::filesystem::path AssetManager::GetPath(AssetHandle handle)
 	{
-		AssetMetadata metadata = GetMetadata(handle);
+		const AssetMetadata& metadata = GetMetadata(handle);
 		return g_AssetsPath / metadata.FilePath;
 	}
 
@@ -240,7 +257,7 @@ namespace Venus {
 				CORE_LOG_TRACE("Found most likely candidate '{0}'", metadata.FilePath.string());
 			}
 
-			s_AssetRegistry[metadata.FilePath] = metadata;
+			RegisterMetadata(metadata);
 		}
 
 		CORE_LOG_INFO("Loaded {0} Asset entries from Registry", s_AssetRegistry.Count());
@@ -252,9 +269,9 @@ namespace Venus {
 		if (!metadata.IsValid())
 			return;
 
-		s_AssetRegistry.Remove(metadata.FilePath);
+		UnregisterMetadata(asset);
 		metadata.FilePath = newFilePath;
-		s_AssetRegistry[metadata.FilePath] = metadata;
+		RegisterMetadata(metadata);
 
 		SerializeRegistry();
 	}
@@ -265,20 +282,19 @@ namespace Venus {
 		if (!metadata.IsValid())
 			return;
 
-		s_AssetRegistry.Remove(metadata.FilePath);
+		UnregisterMetadata(asset);
 		metadata.FilePath = s_AssetRegistry.GetPathKey(newFilePath);
-		s_AssetRegistry[metadata.FilePath] = metadata;
+		RegisterMetadata(metadata);
 
 		SerializeRegistry();
 	}
 
 	void AssetManager::OnAssetDeleted(AssetHandle asset)
 	{
-		AssetMetadata metadata = GetMetadata(asset);
-		if (!metadata.IsValid())
+		if (!IsAssetHandleRegistered(asset))
 			return;
 
-		s_AssetRegistry.Remove(metadata.FilePath);
+		UnregisterMetadata(asset);
 		// TODO: Delete asset from memory
 
 		SerializeRegistry();
@@ -25,7 +25,8 @@ namespace Venus {
 			static std::filesystem::path GetPath(AssetHandle handle);
 			static std::filesystem::path GetRelativePath(const std::filesystem::path& path);
 			static AssetType GetAssetType(const std::string& extension);
-			static bool IsAssetHandleValid(AssetHandle handle) { return IsMemoryAsset(handle) || GetMetadata(handle).IsValid(); }
+			static bool IsAssetHandleValid(AssetHandle handle) { return IsMemoryAsset(handle) || IsAssetHandleRegistered(handle); }
+			static bool IsAssetHandleRegistered(AssetHandle handle) { return s_AssetHandleIndex.find(handle) != s_AssetHandleIndex.end(); }
 			static bool IsMemoryAsset(AssetHandle handle) { return s_MemoryAssets.find(handle) != s_MemoryAssets.end(); }
 
 			//- Asset Management--------------------------------------------------------------------
@@ -69,7 +70,7 @@ namespace Venus {
 					}
 				}
 
-				s_AssetRegistry[metadata.FilePath] = metadata;
+				RegisterMetadata(metadata);
 				SerializeRegistry();
 
 				Ref<T> asset = std::make_shared<T>(std::forward<Args>(args)...);
@@ -133,6 +134,8 @@ namespace Venus {
 
 		private:
 			static AssetMetadata& GetMetadata_Internal(AssetHandle handle);
+			static AssetMetadata& RegisterMetadata(const AssetMetadata& metadata);
+			static void UnregisterMetadata(AssetHandle handle);
 
 			static void ReloadAssets();
 			static void ProcessDirectory(const std::filesystem::path& path);
@@ -149,6 +152,10 @@ namespace Venus {
 			static std::unordered_map<AssetHandle, Ref<Asset>> s_MemoryAssets;
 			inline static AssetRegistry s_AssetRegistry;
 
+			// Points into s_AssetRegistry entries (node addresses are stable), kept in sync by Register/UnregisterMetadata
+			inline static std::unordered_map<AssetHandle, AssetMetadata*> s_AssetHandleIndex;
+			inline static AssetMetadata s_NullMetadata;
+
 			friend class AssetBrowserPanel;
 	};
 
@@ -28,7 +28,7 @@ namespace Venus {
 
 	bool TextureSerializer::TryLoadAsset(const AssetMetadata& metadata, Ref<Asset>& asset) const
 	{
-		asset = Texture2D::Create(AssetManager::GetPath(metadata.Handle).string());
+		asset = Texture2D::Create(AssetManager::GetPath(metadata.Handle).string(), TextureProperties(), true);
 		asset->Handle = metadata.Handle;
 
 		bool result = std::dynamic_pointer_cast<Texture2D>(asset)->IsLoaded();
@@ -0,0 +1,217 @@
+#include "pch.h"
+#include "FrameProfiler.h"
+
+namespace Venus {
+
+	void FrameProfiler::Reset()
+	{
+		m_Markers.clear();
+		m_PendingScopes.clear();
+		m_DrainIndex = 0;
+		m_ResetTicks = Instrumentor::GetTicks();
+		m_ResetTime = std::chrono::steady_clock::now();
+
+		std::lock_guard lock(m_Mutex);
+		m_Frames.clear();
+		m_Stats.clear();
+	}
+
+	void FrameProfiler::AddEvents(uint32_t threadIndex, const ProfileEvent* events, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const ProfileEvent& event = events[i];
+			if (event.Type == ProfileEventType::Frame)
+				m_Markers.push_back({ event.ID, event.Start, m_DrainIndex, threadIndex });
+			else if (event.Type == ProfileEventType::Scope)
+				m_PendingScopes.push_back({ threadIndex, { event.Name, event.Start, event.End, 0 } });
+		}
+	}
+
+	void FrameProfiler::EndDrain()
+	{
+		// Nothing marks frames, scopes would pile up
+		if (m_Markers.empty())
+			m_PendingScopes.clear();
+
+		// Tick rate measured since the capture started, converges within a few frames
+		double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_ResetTime).count();
+		double ticksPerMillisecond = milliseconds > 0.0 ? (Instrumentor::GetTicks() - m_ResetTicks) / milliseconds : 1.0;
+
+		// The marker ending a frame was drained a pass ago, so every scope pushed before it has been drained by now
+		bool framesAdded = false;
+		while (m_Markers.size() >= 2 && m_Markers[1].DrainIndex < m_DrainIndex)
+		{
+			Ref<ProfileFrame> frame = BuildFrame(m_Markers[0], m_Markers[1].Ticks, ticksPerMillisecond);
+			m_Markers.erase(m_Markers.begin());
+
+			if (m_Frozen)
+				continue;
+
+			{
+				std::lock_guard lock(m_Mutex);
+				m_Frames.push_back(frame);
+				if (m_Frames.size() > m_HistorySize)
+					m_Frames.erase(m_Frames.begin(), m_Frames.end() - m_HistorySize);
+			}
+			framesAdded = true;
+
+			if (m_AutoFreeze && frame->Duration > m_Budget)
+			{
+				m_Frozen = true;
+				m_SpikeFrame = (int64_t)frame->Index;
+			}
+		}
+
+		if (framesAdded)
+			UpdateStats();
+
+		m_DrainIndex++;
+	}
+
+	std::vector<Ref<ProfileFrame>> FrameProfiler::GetFrames() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Frames;
+	}
+
+	std::vector<ProfileScopeStats> FrameProfiler::GetScopeStats() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Stats;
+	}
+
+	void FrameProfiler::SetHistorySize(uint32_t size)
+	{
+		std::lock_guard lock(m_Mutex);
+		m_HistorySize = std::max(size, 1u);
+		if (m_Frames.size() > m_HistorySize)
+			m_Frames.erase(m_Frames.begin(), m_Frames.end() - m_HistorySize);
+	}
+
+	void FrameProfiler::SetFrozen(bool frozen)
+	{
+		m_Frozen = frozen;
+		m_SpikeFrame = -1;
+	}
+
+	Ref<ProfileFrame> FrameProfiler::BuildFrame(const FrameMarker& marker, uint64_t end, double ticksPerMillisecond)
+	{
+		Ref<ProfileFrame> frame = CreateRef<ProfileFrame>();
+		frame->Index = marker.Index;
+		frame->Start = marker.Ticks;
+		frame->End = end;
+		frame->TicksPerMillisecond = ticksPerMillisecond;
+		frame->Duration = frame->ToMilliseconds(end - marker.Ticks);
+
+		// Scopes starting before the frame are older than the history, e.g. the run loop's own function
+		auto frameEnd = std::partition(m_PendingScopes.begin(), m_PendingScopes.end(), [end](const PendingScope& pending) { return pending.Scope.Start < end; });
+		for (auto it = m_PendingScopes.begin(); it != frameEnd; it++)
+		{
+			if (it->Scope.Start < marker.Ticks)
+				continue;
+
+			auto timeline = std::find_if(frame->Threads.begin(), frame->Threads.end(), [it](const ProfileThreadTimeline& thread) { return thread.ThreadIndex == it->ThreadIndex; });
+			if (timeline == frame->Threads.end())
+			{
+				timeline = frame->Threads.emplace(frame->Threads.end());
+				timeline->ThreadIndex = it->ThreadIndex;
+			}
+
+			timeline->Scopes.push_back(it->Scope);
+		}
+		m_PendingScopes.erase(m_PendingScopes.begin(), frameEnd);
+
+		std::sort(frame->Threads.begin(), frame->Threads.end(), [&marker](const ProfileThreadTimeline& a, const ProfileThreadTimeline& b)
+		{
+			if ((a.ThreadIndex == marker.ThreadIndex) != (b.ThreadIndex == marker.ThreadIndex))
+				return a.ThreadIndex == marker.ThreadIndex;
+
+			return a.ThreadIndex < b.ThreadIndex;
+		});
+
+		std::unordered_map<const char*, uint32_t> totalIndices;
+		std::vector<uint64_t> parentEnds;
+		for (auto& thread : frame->Threads)
+		{
+			// Scopes on a thread nest, the depth is how many still open ones enclose it
+			std::sort(thread.Scopes.begin(), thread.Scopes.end(), [](const ProfileScope& a, const ProfileScope& b)
+			{
+				return a.Start != b.Start ? a.Start < b.Start : a.End > b.End;
+			});
+
+			parentEnds.clear();
+			for (auto& scope : thread.Scopes)
+			{
+				while (!parentEnds.empty() && parentEnds.back() <= scope.Start)
+					parentEnds.pop_back();
+
+				scope.Depth = (uint32_t)parentEnds.size();
+				thread.MaxDepth = std::max(thread.MaxDepth, scope.Depth);
+				parentEnds.push_back(scope.End);
+
+				auto [it, inserted] = totalIndices.try_emplace(scope.Name, (uint32_t)frame->Totals.size());
+				if (inserted)
+					frame->Totals.push_back({ scope.Name, 0.0f, 0 });
+
+				frame->Totals[it->second].Time += frame->ToMilliseconds(scope.End - scope.Start);
+				frame->Totals[it->second].Calls++;
+			}
+		}
+
+		return frame;
+	}
+
+	void FrameProfiler::UpdateStats()
+	{
+		std::vector<Ref<ProfileFrame>> frames = GetFrames();
+
+		std::unordered_map<const char*, uint32_t> statIndices;
+		std::vector<ProfileScopeStats> stats;
+		std::vector<std::vector<float>> times;
+		for (const auto& frame : frames)
+		{
+			for (const auto& total : frame->Totals)
+			{
+				auto [it, inserted] = statIndices.try_emplace(total.Name, (uint32_t)stats.size());
+				if (inserted)
+				{
+					stats.push_back({ total.Name });
+					times.emplace_back();
+				}
+
+				times[it->second].push_back(total.Time);
+			}
+		}
+
+		if (!frames.empty())
+		{
+			for (const auto& total : frames.back()->Totals)
+			{
+				ProfileScopeStats& stat = stats[statIndices[total.Name]];
+				stat.Last = total.Time;
+				stat.Calls = total.Calls;
+			}
+		}
+
+		for (uint32_t i = 0; i < (uint32_t)stats.size(); i++)
+		{
+			std::vector<float>& scopeTimes = times[i];
+			std::sort(scopeTimes.begin(), scopeTimes.end());
+
+			float sum = 0.0f;
+			for (float time : scopeTimes)
+				sum += time;
+
+			stats[i].Min = scopeTimes.front();
+			stats[i].Average = sum / scopeTimes.size();
+			stats[i].P99 = scopeTimes[std::min((size_t)(scopeTimes.size() * 0.99f), scopeTimes.size() - 1)];
+		}
+
+		std::sort(stats.begin(), stats.end(), [](const ProfileScopeStats& a, const ProfileScopeStats& b) { return a.Average > b.Average; });
+
+		std::lock_guard lock(m_Mutex);
+		m_Stats = std::move(stats);
+	}
+
+}
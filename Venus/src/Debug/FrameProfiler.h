@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Debug/Instrumentor.h"
+
+namespace Venus {
+
+	struct ProfileScope
+	{
+		const char* Name;
+		uint64_t Start;
+		uint64_t End;
+		uint32_t Depth;
+	};
+
+	struct ProfileThreadTimeline
+	{
+		uint32_t ThreadIndex = 0;
+		uint32_t MaxDepth = 0;
+		std::vector<ProfileScope> Scopes; // By start, parents before their children
+	};
+
+	struct ProfileScopeTotal
+	{
+		const char* Name;
+		float Time; // ms
+		uint32_t Calls;
+	};
+
+	struct ProfileFrame
+	{
+		uint64_t Index = 0;
+		uint64_t Start = 0;
+		uint64_t End = 0;
+		double TicksPerMillisecond = 1.0;
+		float Duration = 0.0f; // ms
+
+		// The thread marking frames comes first
+		std::vector<ProfileThreadTimeline> Threads;
+		// Every scope of the frame summed up by name, in order of first call
+		std::vector<ProfileScopeTotal> Totals;
+
+		float ToMilliseconds(uint64_t ticks) const { return (float)(ticks / TicksPerMillisecond); }
+	};
+
+	// Per frame totals over the frames in the history that call the scope
+	struct ProfileScopeStats
+	{
+		const char* Name;
+		float Min = 0.0f;
+		float Average = 0.0f;
+		float P99 = 0.0f;
+		// Newest frame
+		float Last = 0.0f;
+		uint32_t Calls = 0;
+	};
+
+	// Builds frames out of the scopes the instrumentor's writer drains while live capture is on
+	class FrameProfiler
+	{
+		public:
+			// Writer thread
+			void Reset();
+			void AddEvents(uint32_t threadIndex, const ProfileEvent* events, uint32_t count);
+			void EndDrain();
+
+			// Oldest first
+			std::vector<Ref<ProfileFrame>> GetFrames() const;
+			std::vector<ProfileScopeStats> GetScopeStats() const;
+
+			uint32_t GetHistorySize() const { return m_HistorySize; }
+			void SetHistorySize(uint32_t size);
+
+			// Frames going over the budget freeze the history so the spike stays selected
+			float GetBudget() const { return m_Budget; }
+			void SetBudget(float milliseconds) { m_Budget = milliseconds; }
+			bool IsAutoFreezeEnabled() const { return m_AutoFreeze; }
+			void SetAutoFreeze(bool enabled) { m_AutoFreeze = enabled; }
+
+			bool IsFrozen() const { return m_Frozen; }
+			void SetFrozen(bool frozen);
+			// Index of the frame that froze the history, -1 when frozen by hand or not at all
+			int64_t GetSpikeFrame() const { return m_SpikeFrame; }
+
+		private:
+			struct FrameMarker
+			{
+				uint64_t Index;
+				uint64_t Ticks;
+				uint64_t DrainIndex;
+				uint32_t ThreadIndex;
+			};
+
+			Ref<ProfileFrame> BuildFrame(const FrameMarker& marker, uint64_t end, double ticksPerMillisecond);
+			void UpdateStats();
+
+		private:
+			struct PendingScope
+			{
+				uint32_t ThreadIndex;
+				ProfileScope Scope;
+			};
+
+			// Writer thread only
+			std::vector<FrameMarker> m_Markers;
+			std::vector<PendingScope> m_PendingScopes;
+			uint64_t m_DrainIndex = 0;
+			uint64_t m_ResetTicks = 0;
+			std::chrono::steady_clock::time_point m_ResetTime;
+
+			mutable std::mutex m_Mutex;
+			std::vector<Ref<ProfileFrame>> m_Frames;
+			std::vector<ProfileScopeStats> m_Stats;
+			uint32_t m_HistorySize = 300;
+
+			std::atomic<float> m_Budget = 1000.0f / 60.0f;
+			std::atomic<bool> m_AutoFreeze = true;
+			std::atomic<bool> m_Frozen = false;
+			std::atomic<int64_t> m_SpikeFrame = -1;
+	};
+
+}
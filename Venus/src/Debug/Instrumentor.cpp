@@ -0,0 +1,548 @@
+#include "pch.h"
+#include "Instrumentor.h"
+
+#include "Debug/FrameProfiler.h"
+
+#include <iomanip>
+
+namespace Venus {
+
+	struct ProfileTraceHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t StartTicks;
+		double TicksPerSecond;
+		uint64_t EventCount;
+		uint64_t DroppedEvents;
+		char Session[64];
+	};
+
+	enum class ProfileRecord : uint8_t
+	{
+		Name = 0,	// uint32 id, uint32 length, characters
+		Thread,		// uint32 index, uint32 length, characters
+		Event		// uint8 type, uint32 thread, uint32 name, uint64 start, uint64 end/value/id
+	};
+
+	static constexpr char s_TraceMagic[4] = { 'V', 'S', 'P', 'F' };
+	static constexpr uint32_t s_TraceVersion = 1;
+
+	namespace Utils {
+
+		template<typename T>
+		static void WriteValue(std::vector<uint8_t>& buffer, const T& value)
+		{
+			size_t offset = buffer.size();
+			buffer.resize(offset + sizeof(T));
+			memcpy(buffer.data() + offset, &value, sizeof(T));
+		}
+
+		static void WriteString(std::vector<uint8_t>& buffer, const char* string, uint32_t length)
+		{
+			WriteValue(buffer, length);
+			buffer.insert(buffer.end(), string, string + length);
+		}
+
+		template<typename T>
+		static bool ReadValue(const std::vector<uint8_t>& data, size_t& offset, T& value)
+		{
+			if (offset + sizeof(T) > data.size())
+				return false;
+
+			memcpy(&value, data.data() + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+
+		static bool ReadString(const std::vector<uint8_t>& data, size_t& offset, std::string& string)
+		{
+			uint32_t length;
+			if (!ReadValue(data, offset, length) || offset + length > data.size())
+				return false;
+
+			string.assign((const char*)data.data() + offset, length);
+			offset += length;
+			return true;
+		}
+
+		static std::string EscapeJson(const std::string& string)
+		{
+			std::string result;
+			result.reserve(string.size());
+			for (char c : string)
+			{
+				if (c == '"' || c == '\\')
+					result += '\\';
+				result += c;
+			}
+			return result;
+		}
+
+	}
+
+	uint32_t ProfileEventBuffer::Pop(ProfileEvent* events, uint32_t maxCount)
+	{
+		uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+		uint64_t head = m_Head.load(std::memory_order_acquire);
+
+		uint32_t count = (uint32_t)std::min<uint64_t>(head - tail, maxCount);
+		for (uint32_t i = 0; i < count; i++)
+			events[i] = m_Events[(tail + i) & (Capacity - 1)];
+
+		m_Tail.store(tail + count, std::memory_order_release);
+		return count;
+	}
+
+	void ProfileEventBuffer::Discard()
+	{
+		m_Tail.store(m_Head.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	Instrumentor::Instrumentor()
+		: m_FrameProfiler(CreateScope<FrameProfiler>())
+	{
+	}
+
+	Instrumentor::~Instrumentor()
+	{
+		EndSession();
+		SetLiveCapture(false);
+	}
+
+	void Instrumentor::BeginSession(const std::string& name, const std::string& filepath)
+	{
+		std::lock_guard lock(m_Mutex);
+		if (m_SessionOpen)
+		{
+			// If there is already a current session, then close it before beginning new one.
+			// Subsequent profiling output meant for the original session will end up in the
+			// newly opened session instead.  That's better than having badly formatted
+			// profiling output.
+			if (Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
+			{
+				CORE_LOG_ERROR("Instrumentor::BeginSession('{0}') when session '{1}' already open.", name, m_SessionName);
+			}
+			InternalEndSession();
+		}
+
+		{
+			std::lock_guard writerLock(m_WriterMutex);
+
+			// Recorded before the session, they only belong to live capture
+			if (m_Writer.joinable())
+				Drain();
+
+			m_OutputStream.open(filepath, std::ios::out | std::ios::binary);
+			if (!m_OutputStream.is_open())
+			{
+				if (Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
+				{
+					CORE_LOG_ERROR("Instrumentor could not open results file '{0}'.", filepath);
+				}
+				return;
+			}
+
+			m_SessionName = name;
+			m_Filepath = filepath;
+			m_NameIDs.clear();
+			m_WrittenThreadCount = 0;
+			m_EventCount = 0;
+			m_DroppedEvents = 0;
+
+			// Patched with the measured tick rate once the session ends
+			ProfileTraceHeader header = {};
+			m_OutputStream.write((const char*)&header, sizeof(ProfileTraceHeader));
+
+			m_StartTime = std::chrono::steady_clock::now();
+			m_StartTicks = GetTicks();
+			m_SessionOpen = true;
+		}
+
+		StartWriter();
+	}
+
+	void Instrumentor::EndSession()
+	{
+		std::lock_guard lock(m_Mutex);
+		InternalEndSession();
+	}
+
+	void Instrumentor::InternalEndSession()
+	{
+		if (!m_SessionOpen)
+			return;
+
+		uint64_t endTicks = GetTicks();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_StartTime).count();
+
+		ProfileTraceHeader header = {};
+		{
+			std::lock_guard writerLock(m_WriterMutex);
+			Drain();
+
+			memcpy(header.Magic, s_TraceMagic, sizeof(header.Magic));
+			header.Version = s_TraceVersion;
+			header.StartTicks = m_StartTicks;
+			header.TicksPerSecond = seconds > 0.0 ? (endTicks - m_StartTicks) / seconds : 1e9;
+			header.EventCount = m_EventCount;
+			header.DroppedEvents = m_DroppedEvents.load();
+			strncpy(header.Session, m_SessionName.c_str(), sizeof(header.Session) - 1);
+
+			m_OutputStream.seekp(0);
+			m_OutputStream.write((const char*)&header, sizeof(ProfileTraceHeader));
+			m_OutputStream.close();
+			m_SessionOpen = false;
+		}
+
+		StopWriterIfIdle();
+
+		if (header.DroppedEvents && Log::GetCoreLogger())
+			CORE_LOG_WARN("Instrumentor: session '{0}' dropped {1} events, buffers were full", m_SessionName, header.DroppedEvents);
+
+		// Done here so converting never competes with the frames being captured
+		std::filesystem::path jsonPath = m_Filepath;
+		jsonPath.replace_extension(".json");
+		ConvertToJson(m_Filepath, jsonPath.string());
+	}
+
+	void Instrumentor::CaptureFrames(uint32_t count, const std::string& filepath)
+	{
+		if (IsSessionOpen())
+		{
+			CORE_LOG_WARN("Instrumentor: can't capture frames while session '{0}' is open", m_SessionName);
+			return;
+		}
+
+		m_PendingCaptureFrames = std::max(count, 1u);
+		m_PendingCapturePath = filepath;
+	}
+
+	void Instrumentor::NextFrame()
+	{
+		if (m_CaptureFramesLeft > 0 && --m_CaptureFramesLeft == 0)
+			EndSession();
+
+		if (m_PendingCaptureFrames > 0)
+		{
+			BeginSession("Frame Capture", m_PendingCapturePath);
+			m_CaptureFramesLeft = m_PendingCaptureFrames;
+			m_PendingCaptureFrames = 0;
+		}
+
+		ProfileEvent event;
+		event.Name = "Frame";
+		event.Start = GetTicks();
+		event.ID = m_FrameIndex++;
+		event.Type = ProfileEventType::Frame;
+		WriteEvent(event);
+	}
+
+	void Instrumentor::SetLiveCapture(bool enabled)
+	{
+		std::lock_guard lock(m_Mutex);
+		if (m_LiveCapture == enabled)
+			return;
+
+		{
+			std::lock_guard writerLock(m_WriterMutex);
+			if (m_Writer.joinable())
+				Drain();
+
+			m_LiveCapture = enabled;
+			if (enabled)
+				m_FrameProfiler->Reset();
+		}
+
+		if (enabled)
+			StartWriter();
+		else
+			StopWriterIfIdle();
+	}
+
+	void Instrumentor::StartWriter()
+	{
+		if (!m_Writer.joinable())
+		{
+			// Left over from the last time by threads racing its end
+			{
+				std::lock_guard buffersLock(m_BuffersMutex);
+				for (auto& buffer : m_Buffers)
+					buffer.Buffer->Discard();
+			}
+
+			m_WriterRunning = true;
+			m_Writer = std::thread(&Instrumentor::WriterLoop, this);
+		}
+
+		m_Active.store(true, std::memory_order_release);
+	}
+
+	void Instrumentor::StopWriterIfIdle()
+	{
+		if (m_SessionOpen || m_LiveCapture || !m_Writer.joinable())
+			return;
+
+		m_Active.store(false, std::memory_order_release);
+
+		// The writer drains once more before leaving
+		{
+			std::lock_guard writerLock(m_WriterMutex);
+			m_WriterRunning = false;
+		}
+		m_WriterCondition.notify_one();
+		m_Writer.join();
+	}
+
+	void Instrumentor::SetThreadName(const std::string& name)
+	{
+		std::lock_guard lock(m_BuffersMutex);
+		GetThreadBuffer().Name = name;
+	}
+
+	std::string Instrumentor::GetThreadName(uint32_t threadIndex)
+	{
+		std::lock_guard lock(m_BuffersMutex);
+		if (threadIndex >= (uint32_t)m_Buffers.size() || m_Buffers[threadIndex].Name.empty())
+			return "Thread " + std::to_string(threadIndex);
+
+		return m_Buffers[threadIndex].Name;
+	}
+
+	ProfileEventBuffer* Instrumentor::CreateTrack(const std::string& name)
+	{
+		std::lock_guard lock(m_BuffersMutex);
+
+		// The default id never matches a running thread
+		ThreadBuffer& buffer = m_Buffers.emplace_back();
+		buffer.Buffer = CreateScope<ProfileEventBuffer>();
+		buffer.Name = name;
+		return buffer.Buffer.get();
+	}
+
+	ProfileEventBuffer* Instrumentor::RegisterThread()
+	{
+		std::lock_guard lock(m_BuffersMutex);
+		return GetThreadBuffer().Buffer.get();
+	}
+
+	Instrumentor::ThreadBuffer& Instrumentor::GetThreadBuffer()
+	{
+		std::thread::id threadID = std::this_thread::get_id();
+		for (auto& buffer : m_Buffers)
+		{
+			if (buffer.ThreadID == threadID)
+				return buffer;
+		}
+
+		ThreadBuffer& buffer = m_Buffers.emplace_back();
+		buffer.Buffer = CreateScope<ProfileEventBuffer>();
+		buffer.ThreadID = threadID;
+		return buffer;
+	}
+
+	void Instrumentor::WriterLoop()
+	{
+		std::unique_lock lock(m_WriterMutex);
+		while (true)
+		{
+			m_WriterCondition.wait_for(lock, std::chrono::milliseconds(10), [this]() { return !m_WriterRunning; });
+			Drain();
+
+			if (!m_WriterRunning)
+				break;
+		}
+	}
+
+	void Instrumentor::Drain()
+	{
+		bool session = m_SessionOpen;
+
+		std::vector<ProfileEventBuffer*> buffers;
+		{
+			std::lock_guard lock(m_BuffersMutex);
+			for (; session && m_WrittenThreadCount < (uint32_t)m_Buffers.size(); m_WrittenThreadCount++)
+			{
+				const std::string& name = m_Buffers[m_WrittenThreadCount].Name;
+				Utils::WriteValue(m_WriteBuffer, ProfileRecord::Thread);
+				Utils::WriteValue(m_WriteBuffer, m_WrittenThreadCount);
+				Utils::WriteString(m_WriteBuffer, name.c_str(), (uint32_t)name.size());
+			}
+
+			for (auto& buffer : m_Buffers)
+				buffers.push_back(buffer.Buffer.get());
+		}
+
+		static constexpr uint32_t batchSize = 256;
+		ProfileEvent events[batchSize];
+
+		for (uint32_t thread = 0; thread < (uint32_t)buffers.size(); thread++)
+		{
+			uint32_t count;
+			while ((count = buffers[thread]->Pop(events, batchSize)) > 0)
+			{
+				if (m_LiveCapture)
+					m_FrameProfiler->AddEvents(thread, events, count);
+
+				if (!session)
+					continue;
+
+				for (uint32_t i = 0; i < count; i++)
+				{
+					const ProfileEvent& event = events[i];
+
+					// Names are interned by pointer, the string is written the first time it shows up
+					auto [it, inserted] = m_NameIDs.try_emplace(event.Name, (uint32_t)m_NameIDs.size());
+					if (inserted)
+					{
+						Utils::WriteValue(m_WriteBuffer, ProfileRecord::Name);
+						Utils::WriteValue(m_WriteBuffer, it->second);
+						Utils::WriteString(m_WriteBuffer, event.Name, (uint32_t)strlen(event.Name));
+					}
+
+					Utils::WriteValue(m_WriteBuffer, ProfileRecord::Event);
+					Utils::WriteValue(m_WriteBuffer, event.Type);
+					Utils::WriteValue(m_WriteBuffer, thread);
+					Utils::WriteValue(m_WriteBuffer, it->second);
+					Utils::WriteValue(m_WriteBuffer, event.Start);
+					Utils::WriteValue(m_WriteBuffer, event.End);
+				}
+
+				m_EventCount += count;
+			}
+		}
+
+		if (m_LiveCapture)
+			m_FrameProfiler->EndDrain();
+
+		if (!m_WriteBuffer.empty())
+		{
+			m_OutputStream.write((const char*)m_WriteBuffer.data(), m_WriteBuffer.size());
+			m_WriteBuffer.clear();
+		}
+	}
+
+	bool Instrumentor::ConvertToJson(const std::string& tracePath, const std::string& jsonPath)
+	{
+		std::ifstream in(tracePath, std::ios::in | std::ios::binary);
+		if (!in.is_open())
+			return false;
+
+		std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		in.close();
+
+		ProfileTraceHeader header;
+		size_t offset = 0;
+		if (!Utils::ReadValue(data, offset, header) || memcmp(header.Magic, s_TraceMagic, sizeof(header.Magic)) != 0 || header.Version != s_TraceVersion)
+		{
+			CORE_LOG_ERROR("Instrumentor: '{0}' is not a valid trace", tracePath);
+			return false;
+		}
+
+		std::ofstream out(jsonPath);
+		if (!out.is_open())
+		{
+			CORE_LOG_ERROR("Instrumentor could not open results file '{0}'.", jsonPath);
+			return false;
+		}
+
+		header.Session[sizeof(header.Session) - 1] = '\0';
+		double microsecondsPerTick = 1e6 / header.TicksPerSecond;
+		auto toMicroseconds = [&](uint64_t ticks)
+		{
+			// Scopes opened before the session started are clamped to its start
+			return ticks > header.StartTicks ? (ticks - header.StartTicks) * microsecondsPerTick : 0.0;
+		};
+
+		out << std::setprecision(3) << std::fixed;
+		out << "{\"otherData\":{\"session\":\"" << Utils::EscapeJson(header.Session) << "\",\"droppedEvents\":" << header.DroppedEvents << "},\"traceEvents\":[{}";
+
+		std::vector<std::string> names;
+		while (offset < data.size())
+		{
+			ProfileRecord record = {};
+			Utils::ReadValue(data, offset, record);
+
+			switch (record)
+			{
+				case ProfileRecord::Name:
+				{
+					uint32_t id;
+					std::string name;
+					if (!Utils::ReadValue(data, offset, id) || !Utils::ReadString(data, offset, name))
+						break;
+
+					names.resize(std::max<size_t>(names.size(), id + 1));
+					names[id] = Utils::EscapeJson(name);
+					continue;
+				}
+				case ProfileRecord::Thread:
+				{
+					uint32_t index;
+					std::string name;
+					if (!Utils::ReadValue(data, offset, index) || !Utils::ReadString(data, offset, name))
+						break;
+
+					if (name.empty())
+						name = "Thread " + std::to_string(index);
+
+					out << ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << index << ",\"args\":{\"name\":\"" << Utils::EscapeJson(name) << "\"}}";
+					continue;
+				}
+				case ProfileRecord::Event:
+				{
+					ProfileEventType type;
+					uint32_t thread, nameID;
+					uint64_t start, value;
+					if (!Utils::ReadValue(data, offset, type) || !Utils::ReadValue(data, offset, thread) || !Utils::ReadValue(data, offset, nameID)
+						|| !Utils::ReadValue(data, offset, start) || !Utils::ReadValue(data, offset, value) || nameID >= names.size())
+						break;
+
+					const std::string& name = names[nameID];
+					double timestamp = toMicroseconds(start);
+
+					out << ",{\"name\":\"" << name << "\",\"pid\":0,\"tid\":" << thread << ",\"ts\":" << timestamp;
+					switch (type)
+					{
+						case ProfileEventType::Scope:
+						{
+							out << ",\"cat\":\"function\",\"ph\":\"X\",\"dur\":" << std::max(toMicroseconds(value) - timestamp, 0.0);
+							break;
+						}
+						case ProfileEventType::Counter:
+						{
+							double counter;
+							memcpy(&counter, &value, sizeof(double));
+							out << ",\"ph\":\"C\",\"args\":{\"value\":" << counter << "}";
+							break;
+						}
+						case ProfileEventType::FlowBegin:
+						{
+							out << ",\"cat\":\"flow\",\"ph\":\"s\",\"id\":" << value;
+							break;
+						}
+						case ProfileEventType::FlowEnd:
+						{
+							out << ",\"cat\":\"flow\",\"ph\":\"f\",\"bp\":\"e\",\"id\":" << value;
+							break;
+						}
+						case ProfileEventType::Frame:
+						{
+							out << ",\"ph\":\"i\",\"s\":\"g\",\"args\":{\"frame\":" << value << "}";
+							break;
+						}
+					}
+					out << "}";
+					continue;
+				}
+			}
+
+			CORE_LOG_WARN("Instrumentor: '{0}' is truncated", tracePath);
+			break;
+		}
+
+		out << "]}";
+		return true;
+	}
+
+}
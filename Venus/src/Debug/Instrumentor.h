@@ -1,175 +1,265 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
-#include <iomanip>
 #include <string>
 #include <thread>
 #include <mutex>
-#include <sstream>
+#include <unordered_map>
+#include <vector>
 
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#endif
+
+#include "Engine/Base.h"
 #include "Engine/Log.h"
 
 namespace Venus {
 
-	using FloatingPointMicroseconds = std::chrono::duration<double, std::micro>;
-
-	struct ProfileResult
+	enum class ProfileEventType : uint8_t
 	{
-		std::string Name;
+		Scope = 0,
+		Counter,
+		FlowBegin,
+		FlowEnd,
+		Frame
+	};
 
-		FloatingPointMicroseconds Start;
-		std::chrono::microseconds ElapsedTime;
-		std::thread::id ThreadID;
+	// Fixed size so recording never allocates, names are only stored as pointers and must outlive the session
+	struct ProfileEvent
+	{
+		const char* Name;
+		uint64_t Start;
+		union
+		{
+			uint64_t End;	// Scope
+			double Value;	// Counter
+			uint64_t ID;	// Flow, frame index
+		};
+		ProfileEventType Type;
 	};
 
-	struct InstrumentationSession
+	// Written by its thread and drained by the instrumentor's writer thread, full buffers drop events instead of blocking
+	class ProfileEventBuffer
 	{
-		std::string Name;
+		public:
+			static constexpr uint64_t Capacity = 1 << 16;
+
+			bool Push(const ProfileEvent& event)
+			{
+				uint64_t head = m_Head.load(std::memory_order_relaxed);
+				if (head - m_Tail.load(std::memory_order_acquire) == Capacity)
+					return false;
+
+				m_Events[head & (Capacity - 1)] = event;
+				m_Head.store(head + 1, std::memory_order_release);
+				return true;
+			}
+
+			// Consumer side only
+			uint32_t Pop(ProfileEvent* events, uint32_t maxCount);
+			void Discard();
+
+		private:
+			std::atomic<uint64_t> m_Head = 0;
+			std::atomic<uint64_t> m_Tail = 0;
+			ProfileEvent m_Events[Capacity];
 	};
 
+	class FrameProfiler;
+
+	// Sessions are written as a compact binary trace by a background thread and converted to Chrome/Perfetto JSON once they end,
+	// live capture hands the same events to the frame profiler
 	class Instrumentor
 	{
 		public:
 			Instrumentor(const Instrumentor&) = delete;
 			Instrumentor(Instrumentor&&) = delete;
 
-			void BeginSession(const std::string& name, const std::string& filepath = "results.json")
+			void BeginSession(const std::string& name, const std::string& filepath = "results.vsprof");
+			void EndSession();
+
+			// Starts a session on the next frame and ends it after count frames
+			void CaptureFrames(uint32_t count, const std::string& filepath);
+			// Called once a frame by the application, marks frame boundaries in the trace
+			void NextFrame();
+
+			void SetLiveCapture(bool enabled);
+			bool IsLiveCaptureEnabled() const { return m_LiveCapture; }
+			FrameProfiler& GetFrameProfiler() { return *m_FrameProfiler; }
+
+			// Recording, for a session or live capture
+			bool IsActive() const { return m_Active.load(std::memory_order_relaxed); }
+			bool IsSessionOpen() const { return m_SessionOpen; }
+
+			// Invariant TSC where available, converted with a frequency measured over the session
+			static uint64_t GetTicks()
 			{
-				std::lock_guard lock(m_Mutex);
-				if (m_CurrentSession)
-				{
-					// If there is already a current session, then close it before beginning new one.
-					// Subsequent profiling output meant for the original session will end up in the
-					// newly opened session instead.  That's better than having badly formatted
-					// profiling output.
-					if (Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
-					{
-						CORE_LOG_ERROR("Instrumentor::BeginSession('{0}') when session '{1}' already open.", name, m_CurrentSession->Name);
-					}
-					InternalEndSession();
-				}
-				m_OutputStream.open(filepath);
-
-				if (m_OutputStream.is_open())
-				{
-					m_CurrentSession = new InstrumentationSession({ name });
-					WriteHeader();
-				}
-				else
-				{
-					if (Log::GetCoreLogger()) // Edge case: BeginSession() might be before Log::Init()
-					{
-						CORE_LOG_ERROR("Instrumentor could not open results file '{0}'.", filepath);
-					}
-				}
+			#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+				return __rdtsc();
+			#else
+				return (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+			#endif
 			}
 
-			void EndSession()
+			void WriteEvent(const ProfileEvent& event)
 			{
-				std::lock_guard lock(m_Mutex);
-				InternalEndSession();
+				if (!IsActive())
+					return;
+
+				thread_local ProfileEventBuffer* buffer = nullptr;
+				if (!buffer)
+					buffer = RegisterThread();
+
+				if (!buffer->Push(event))
+					m_DroppedEvents.fetch_add(1, std::memory_order_relaxed);
 			}
 
-			void WriteProfile(const ProfileResult& result)
+			// Events timed somewhere else than the recording thread, e.g. GPU scopes read back a few frames later.
+			// A track is shown like a thread and must only be written by one thread at a time
+			ProfileEventBuffer* CreateTrack(const std::string& name);
+
+			void WriteEvent(ProfileEventBuffer* track, const ProfileEvent& event)
 			{
-				std::stringstream json;
-
-				json << std::setprecision(3) << std::fixed;
-				json << ",{";
-				json << "\"cat\":\"function\",";
-				json << "\"dur\":" << (result.ElapsedTime.count()) << ',';
-				json << "\"name\":\"" << result.Name << "\",";
-				json << "\"ph\":\"X\",";
-				json << "\"pid\":0,";
-				json << "\"tid\":" << result.ThreadID << ",";
-				json << "\"ts\":" << result.Start.count();
-				json << "}";
-
-				std::lock_guard lock(m_Mutex);
-				if (m_CurrentSession)
-				{
-					m_OutputStream << json.str();
-					m_OutputStream.flush();
-				}
+				if (!IsActive())
+					return;
+
+				if (!track->Push(event))
+					m_DroppedEvents.fetch_add(1, std::memory_order_relaxed);
 			}
 
-			static Instrumentor& Get()
+			void WriteScope(const char* name, uint64_t start, uint64_t end)
 			{
-				static Instrumentor instance;
-				return instance;
+				ProfileEvent event;
+				event.Name = name;
+				event.Start = start;
+				event.End = end;
+				event.Type = ProfileEventType::Scope;
+				WriteEvent(event);
 			}
-		private:
-			Instrumentor()
-				: m_CurrentSession(nullptr)
+
+			void WriteScope(ProfileEventBuffer* track, const char* name, uint64_t start, uint64_t end)
 			{
+				ProfileEvent event;
+				event.Name = name;
+				event.Start = start;
+				event.End = end;
+				event.Type = ProfileEventType::Scope;
+				WriteEvent(track, event);
 			}
 
-			~Instrumentor()
+			void WriteCounter(const char* name, double value)
 			{
-				EndSession();
+				ProfileEvent event;
+				event.Name = name;
+				event.Start = GetTicks();
+				event.Value = value;
+				event.Type = ProfileEventType::Counter;
+				WriteEvent(event);
 			}
 
-			void WriteHeader()
+			void WriteFlow(const char* name, uint64_t id, bool begin)
 			{
-				m_OutputStream << "{\"otherData\": {},\"traceEvents\":[{}";
-				m_OutputStream.flush();
+				ProfileEvent event;
+				event.Name = name;
+				event.Start = GetTicks();
+				event.ID = id;
+				event.Type = begin ? ProfileEventType::FlowBegin : ProfileEventType::FlowEnd;
+				WriteEvent(event);
 			}
 
-			void WriteFooter()
+			// Shown instead of the thread index, set before the thread records anything
+			void SetThreadName(const std::string& name);
+			std::string GetThreadName(uint32_t threadIndex);
+
+			static bool ConvertToJson(const std::string& tracePath, const std::string& jsonPath);
+
+			static Instrumentor& Get()
 			{
-				m_OutputStream << "]}";
-				m_OutputStream.flush();
+				static Instrumentor instance;
+				return instance;
 			}
+		private:
+			Instrumentor();
+			~Instrumentor();
+
+			struct ThreadBuffer
+			{
+				Scope<ProfileEventBuffer> Buffer;
+				std::thread::id ThreadID;
+				std::string Name;
+			};
+
+			ProfileEventBuffer* RegisterThread();
+			ThreadBuffer& GetThreadBuffer(); // m_BuffersMutex must be held
+
+			// m_Mutex must be held
+			void StartWriter();
+			void StopWriterIfIdle();
+
+			void WriterLoop();
+			void Drain(); // m_WriterMutex must be held
 
 			// Note: you must already own lock on m_Mutex before
 			// calling InternalEndSession()
-			void InternalEndSession()
-			{
-				if (m_CurrentSession)
-				{
-					WriteFooter();
-					m_OutputStream.close();
-					delete m_CurrentSession;
-					m_CurrentSession = nullptr;
-				}
-			}
+			void InternalEndSession();
+
 		private:
 			std::mutex m_Mutex;
-			InstrumentationSession* m_CurrentSession;
+			std::atomic<bool> m_Active = false;
+			std::atomic<bool> m_SessionOpen = false;
+			std::atomic<uint64_t> m_DroppedEvents = 0;
+			std::atomic<bool> m_LiveCapture = false;
+			Scope<FrameProfiler> m_FrameProfiler;
+
+			std::mutex m_BuffersMutex;
+			std::vector<ThreadBuffer> m_Buffers;
+
+			// Session, m_WriterMutex must be held while the writer runs
+			std::string m_SessionName;
+			std::string m_Filepath;
 			std::ofstream m_OutputStream;
+			std::vector<uint8_t> m_WriteBuffer;
+			std::unordered_map<const char*, uint32_t> m_NameIDs;
+			uint32_t m_WrittenThreadCount = 0;
+			uint64_t m_EventCount = 0;
+			uint64_t m_StartTicks = 0;
+			std::chrono::steady_clock::time_point m_StartTime;
+
+			std::thread m_Writer;
+			std::mutex m_WriterMutex;
+			std::condition_variable m_WriterCondition;
+			bool m_WriterRunning = false;
+
+			// Frame captures, main thread only
+			uint64_t m_FrameIndex = 0;
+			uint32_t m_CaptureFramesLeft = 0;
+			uint32_t m_PendingCaptureFrames = 0;
+			std::string m_PendingCapturePath;
 	};
 
 	class InstrumentationTimer
 	{
 		public:
 			InstrumentationTimer(const char* name)
-				: m_Name(name), m_Stopped(false)
+				: m_Name(name)
 			{
-				m_StartTimepoint = std::chrono::steady_clock::now();
+				m_Start = Instrumentor::GetTicks();
 			}
 
 			~InstrumentationTimer()
 			{
-				if (!m_Stopped)
-					Stop();
-			}
-
-			void Stop()
-			{
-				auto endTimepoint = std::chrono::steady_clock::now();
-				auto highResStart = FloatingPointMicroseconds{ m_StartTimepoint.time_since_epoch() };
-				auto elapsedTime = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch() - std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch();
-
-				Instrumentor::Get().WriteProfile({ m_Name, highResStart, elapsedTime, std::this_thread::get_id() });
-
-				m_Stopped = true;
+				Instrumentor::Get().WriteScope(m_Name, m_Start, Instrumentor::GetTicks());
 			}
 		private:
 			const char* m_Name;
-			std::chrono::time_point<std::chrono::steady_clock> m_StartTimepoint;
-			bool m_Stopped;
+			uint64_t m_Start;
 	};
 
 	namespace InstrumentorUtils {
@@ -227,14 +317,27 @@ namespace Venus {
 
 #define VS_PROFILE_BEGIN_SESSION(name, filepath) ::Venus::Instrumentor::Get().BeginSession(name, filepath)
 #define VS_PROFILE_END_SESSION() ::Venus::Instrumentor::Get().EndSession()
-#define VS_PROFILE_SCOPE_LINE2(name, line) constexpr auto fixedName##line = ::Venus::InstrumentorUtils::CleanupOutputString(name, "__cdecl ");\
+#define VS_PROFILE_CAPTURE_FRAMES(count, filepath) ::Venus::Instrumentor::Get().CaptureFrames(count, filepath)
+#define VS_PROFILE_FRAME() ::Venus::Instrumentor::Get().NextFrame()
+#define VS_PROFILE_THREAD(name) ::Venus::Instrumentor::Get().SetThreadName(name)
+// Static so the trace can keep a pointer to the name
+#define VS_PROFILE_SCOPE_LINE2(name, line) static constexpr auto fixedName##line = ::Venus::InstrumentorUtils::CleanupOutputString(name, "__cdecl ");\
 											   ::Venus::InstrumentationTimer timer##line(fixedName##line.Data)
 #define VS_PROFILE_SCOPE_LINE(name, line) VS_PROFILE_SCOPE_LINE2(name, line)
 #define VS_PROFILE_SCOPE(name) VS_PROFILE_SCOPE_LINE(name, __LINE__)
 #define VS_PROFILE_FUNCTION() VS_PROFILE_SCOPE(VS_FUNC_SIG)
+#define VS_PROFILE_COUNTER(name, value) ::Venus::Instrumentor::Get().WriteCounter(name, (double)(value))
+#define VS_PROFILE_FLOW_BEGIN(name, id) ::Venus::Instrumentor::Get().WriteFlow(name, id, true)
+#define VS_PROFILE_FLOW_END(name, id) ::Venus::Instrumentor::Get().WriteFlow(name, id, false)
 #else
 #define VS_PROFILE_BEGIN_SESSION(name, filepath)
 #define VS_PROFILE_END_SESSION()
+#define VS_PROFILE_CAPTURE_FRAMES(count, filepath)
+#define VS_PROFILE_FRAME()
+#define VS_PROFILE_THREAD(name)
 #define VS_PROFILE_SCOPE(name)
 #define VS_PROFILE_FUNCTION()
-#endif
\ No newline at end of file
+#define VS_PROFILE_COUNTER(name, value)
+#define VS_PROFILE_FLOW_BEGIN(name, id)
+#define VS_PROFILE_FLOW_END(name, id)
+#endif
@@ -3,11 +3,12 @@
 
 #include "Engine/Log.h"
 #include "Engine/Input.h"
+#include "Engine/JobSystem.h"
 #include "Renderer/Renderer.h"
+#include "Renderer/GPUProfiler.h"
+#include "Renderer/TextureStreamer.h"
 #include "Scripting/ScriptingEngine.h"
 
-#include <GLFW/glfw3.h>
-
 namespace Venus {
 
 	Application* Application::s_Instance = nullptr;
@@ -20,6 +21,9 @@ namespace Venus {
 
 		s_Instance = this;
 
+		RendererAPI::SetAPI(spec.API);
+		bool headless = spec.Headless || spec.API == RendererAPI::API::None;
+
 		// Window
 		WindowProps props;
 		props.Title = spec.Name;
@@ -28,16 +32,21 @@ namespace Venus {
 		props.Fullscreen = spec.Fullscreen;
 		props.Vsync = spec.Vsync;
 		props.Decorated = spec.WindowDecorated;
+		props.Headless = headless;
 		m_Window = Window::Create(props);
 		m_Window->SetEventCallback(VS_BIND_EVENT_FN(Application::OnEvent));
 	
 		// Init Engine Components
+		JobSystem::Init();
 		Renderer::Init();
 		ScriptingEngine::Init();
 
 		// ImGui
-		m_ImGuiLayer = new ImGuiLayer();
-		PushOverlay(m_ImGuiLayer);
+		if (!headless)
+		{
+			m_ImGuiLayer = new ImGuiLayer();
+			PushOverlay(m_ImGuiLayer);
+		}
 	}
 
 	Application::~Application()
@@ -46,6 +55,7 @@ namespace Venus {
 
 		m_Window->SetEventCallback([](Event& e) {});
 		
+		JobSystem::Shutdown();
 		Renderer::Shutdown();
 		ScriptingEngine::Shutdown();
 		Log::Shutdown();
@@ -94,12 +104,17 @@ namespace Venus {
 
 		while (m_Running)
 		{
+			VS_PROFILE_FRAME();
 			VS_PROFILE_SCOPE("RunLoop");
 
-			float time = (float)glfwGetTime();
+			float time = m_Window->GetTime();
 			m_Timestep = time - m_LastFrameTime;
 			m_LastFrameTime = time;
 
+			GPUProfiler::NextFrame();
+			JobSystem::ProcessMainThreadJobs();
+			TextureStreamer::Update();
+
 			if (!m_Minimized)
 			{
 				{
@@ -109,14 +124,20 @@ namespace Venus {
 						layer->OnUpdate(m_Timestep);
 				}
 
-				m_ImGuiLayer->Begin();
+				if (m_ImGuiLayer)
 				{
-					VS_PROFILE_SCOPE("LayerStack OnImGuiRender");
-
-					for (Layer* layer : m_LayerStack)
-						layer->OnImGuiRender();
+					m_ImGuiLayer->Begin();
+					{
+						VS_PROFILE_SCOPE("LayerStack OnImGuiRender");
+
+						for (Layer* layer : m_LayerStack)
+							layer->OnImGuiRender();
+					}
+					{
+						GPUProfileScope gpuScope("ImGui");
+						m_ImGuiLayer->End();
+					}
 				}
-				m_ImGuiLayer->End();
 			}
 
 			m_Window->OnUpdate();
@@ -10,6 +10,8 @@
 
 #include "ImGui/ImGuiLayer.h"
 
+#include "Renderer/RendererAPI.h"
+
 int main(int argc, char** argv);
 
 namespace Venus {
@@ -33,6 +35,11 @@ namespace Venus {
 		bool Fullscreen = true;
 		bool Vsync = true;
 		bool WindowDecorated = true;
+
+		// None runs headless with no GPU, e.g. for CPU benchmarks
+		RendererAPI::API API = RendererAPI::API::OpenGL;
+		// No window, input or ImGui, everything is rendered offscreen
+		bool Headless = false;
 	};
 
 	class Application
@@ -49,6 +56,7 @@ namespace Venus {
 
 			static Application& Get() { return *s_Instance; }
 			Window& GetWindow() { return *m_Window; }
+			// Null when headless
 			ImGuiLayer* GetImGuiLayer() { return m_ImGuiLayer; }
 			float GetFrametime() { return m_Timestep.GetMilliseconds(); }
 			ApplicationCommandLineArgs GetCommandLineArgs() const { return m_CommandLineArgs; }
@@ -60,7 +68,7 @@ namespace Venus {
 		private:
 			ApplicationCommandLineArgs m_CommandLineArgs;
 			Scope<Window> m_Window;
-			ImGuiLayer* m_ImGuiLayer;
+			ImGuiLayer* m_ImGuiLayer = nullptr;
 			bool m_Running = true;
 			bool m_Minimized = false;
 			LayerStack m_LayerStack;
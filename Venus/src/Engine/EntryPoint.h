@@ -9,16 +9,16 @@ extern Venus::Application* Venus::CreateApplication(ApplicationCommandLineArgs a
 int main(int argc, char** argv)
 {
 	Venus::Log::Init();
+	VS_PROFILE_THREAD("Main");
 
-	VS_PROFILE_BEGIN_SESSION("Startup", "VenusProfile-Startup.json");
+	VS_PROFILE_BEGIN_SESSION("Startup", "VenusProfile-Startup.vsprof");
 	auto app = Venus::CreateApplication({ argc, argv });
 	VS_PROFILE_END_SESSION();
 
-	VS_PROFILE_BEGIN_SESSION("Runtime", "VenusProfile-Runtime.json");
+	// Runtime is captured in frame ranges, see VS_PROFILE_CAPTURE_FRAMES
 	app->Run();
-	VS_PROFILE_END_SESSION();
 
-	VS_PROFILE_BEGIN_SESSION("Shutdown", "VenusProfile-Shutdown.json");
+	VS_PROFILE_BEGIN_SESSION("Shutdown", "VenusProfile-Shutdown.vsprof");
 	CORE_LOG_WARN("Shutting Down...");
 	delete app;
 	VS_PROFILE_END_SESSION();
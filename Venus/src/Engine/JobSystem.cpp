@@ -0,0 +1,322 @@
+#include "pch.h"
+#include "JobSystem.h"
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace Venus {
+
+	struct WorkQueue
+	{
+		std::mutex Mutex;
+		std::deque<Job> Jobs;
+	};
+
+	struct JobSystemData
+	{
+		// Queue 0 belongs to the main thread (and any thread that isn't a worker), workers own 1..N
+		std::vector<Scope<WorkQueue>> Queues;
+		WorkQueue MainThreadQueue;
+		std::vector<std::thread> Workers;
+
+		std::atomic<uint32_t> QueuedJobs = 0;
+		std::atomic<uint64_t> NextJobID = 1;
+		std::atomic<bool> Running = false;
+		std::mutex WakeMutex;
+		std::condition_variable WakeCondition;
+
+		std::thread::id MainThreadID;
+	};
+
+	static JobSystemData* s_JobData = nullptr;
+	static thread_local uint32_t s_QueueIndex = 0;
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		VS_PROFILE_FUNCTION();
+		VS_CORE_ASSERT(!s_JobData, "JobSystem already initialized!");
+
+		if (workerCount == 0)
+			workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		s_JobData = new JobSystemData();
+		s_JobData->MainThreadID = std::this_thread::get_id();
+		s_JobData->Running = true;
+
+		for (uint32_t i = 0; i <= workerCount; i++)
+			s_JobData->Queues.push_back(CreateScope<WorkQueue>());
+
+		for (uint32_t i = 1; i <= workerCount; i++)
+			s_JobData->Workers.emplace_back(&JobSystem::WorkerLoop, i);
+
+		CORE_LOG_INFO("JobSystem: {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		VS_PROFILE_FUNCTION();
+
+		if (!s_JobData)
+			return;
+
+		s_JobData->Running = false;
+		{
+			std::lock_guard lock(s_JobData->WakeMutex);
+		}
+		s_JobData->WakeCondition.notify_all();
+
+		for (auto& worker : s_JobData->Workers)
+			worker.join();
+
+		// Whatever is left runs here so counters being waited on still complete
+		while (TryRunJob())
+			;
+
+		delete s_JobData;
+		s_JobData = nullptr;
+	}
+
+	void JobSystem::Execute(std::function<void()> function, JobCounter* counter, JobAffinity affinity)
+	{
+		Job job;
+		job.Function = std::move(function);
+		job.Counter = counter;
+		job.Affinity = affinity;
+
+		if (counter)
+			counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+		// Without workers everything runs inline
+		if (!s_JobData)
+		{
+			RunJob(job);
+			return;
+		}
+
+		Schedule(std::move(job));
+	}
+
+	void JobSystem::ExecuteAfter(JobCounter& dependency, std::function<void()> function, JobCounter* counter, JobAffinity affinity)
+	{
+		Job job;
+		job.Function = std::move(function);
+		job.Counter = counter;
+		job.Affinity = affinity;
+
+		if (counter)
+			counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+		{
+			std::lock_guard lock(dependency.m_Mutex);
+			if (!dependency.IsDone())
+			{
+				dependency.m_Continuations.push_back(std::move(job));
+				return;
+			}
+		}
+
+		if (!s_JobData)
+		{
+			RunJob(job);
+			return;
+		}
+
+		Schedule(std::move(job));
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t begin, uint32_t end)>& function)
+	{
+		if (count == 0)
+			return;
+
+		batchSize = std::max(batchSize, 1u);
+		if (!s_JobData || count <= batchSize)
+		{
+			function(0, count);
+			return;
+		}
+
+		JobCounter counter;
+		for (uint32_t begin = batchSize; begin < count; begin += batchSize)
+		{
+			uint32_t end = std::min(begin + batchSize, count);
+			Execute([&function, begin, end]() { function(begin, end); }, &counter);
+		}
+
+		// Caller takes the first range instead of idling
+		function(0, batchSize);
+		Wait(counter);
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!TryRunJob())
+				std::this_thread::yield();
+		}
+
+		// The last job may still be releasing continuations, the counter must outlive that
+		std::lock_guard lock(counter.m_Mutex);
+	}
+
+	void JobSystem::ProcessMainThreadJobs()
+	{
+		VS_PROFILE_FUNCTION();
+		VS_CORE_ASSERT(IsMainThread(), "Main thread jobs processed from another thread!");
+
+		if (!s_JobData)
+			return;
+
+		// Jobs queued while draining wait for the next frame
+		std::deque<Job> jobs;
+		{
+			std::lock_guard lock(s_JobData->MainThreadQueue.Mutex);
+			jobs.swap(s_JobData->MainThreadQueue.Jobs);
+		}
+
+		for (Job& job : jobs)
+			RunJob(job);
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return s_JobData ? (uint32_t)s_JobData->Workers.size() : 0;
+	}
+
+	bool JobSystem::IsMainThread()
+	{
+		return !s_JobData || std::this_thread::get_id() == s_JobData->MainThreadID;
+	}
+
+	void JobSystem::Schedule(Job&& job)
+	{
+		job.ID = s_JobData->NextJobID.fetch_add(1, std::memory_order_relaxed);
+		VS_PROFILE_FLOW_BEGIN("Job", job.ID);
+
+		if (job.Affinity == JobAffinity::MainThread)
+		{
+			std::lock_guard lock(s_JobData->MainThreadQueue.Mutex);
+			s_JobData->MainThreadQueue.Jobs.push_back(std::move(job));
+			return;
+		}
+
+		WorkQueue& queue = *s_JobData->Queues[s_QueueIndex];
+		{
+			std::lock_guard lock(queue.Mutex);
+			queue.Jobs.push_back(std::move(job));
+		}
+		uint32_t queuedJobs = s_JobData->QueuedJobs.fetch_add(1, std::memory_order_release) + 1;
+		VS_PROFILE_COUNTER("Queued Jobs", queuedJobs);
+
+		// Taking the lock orders this with a worker about to sleep, so the wake up can't be lost
+		{
+			std::lock_guard lock(s_JobData->WakeMutex);
+		}
+		s_JobData->WakeCondition.notify_one();
+	}
+
+	bool JobSystem::TryRunJob()
+	{
+		Job job;
+		bool found = false;
+
+		if (IsMainThread())
+		{
+			WorkQueue& queue = s_JobData->MainThreadQueue;
+			std::lock_guard lock(queue.Mutex);
+			if (!queue.Jobs.empty())
+			{
+				job = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+				found = true;
+			}
+		}
+
+		// Newest job of our own queue first, it is likely still in cache
+		if (!found)
+		{
+			WorkQueue& queue = *s_JobData->Queues[s_QueueIndex];
+			std::lock_guard lock(queue.Mutex);
+			if (!queue.Jobs.empty())
+			{
+				job = std::move(queue.Jobs.back());
+				queue.Jobs.pop_back();
+				found = true;
+			}
+		}
+
+		// Otherwise steal the oldest job of another queue
+		uint32_t queueCount = (uint32_t)s_JobData->Queues.size();
+		for (uint32_t i = 1; i < queueCount && !found; i++)
+		{
+			WorkQueue& queue = *s_JobData->Queues[(s_QueueIndex + i) % queueCount];
+			std::lock_guard lock(queue.Mutex);
+			if (!queue.Jobs.empty())
+			{
+				job = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+				found = true;
+			}
+		}
+
+		if (!found)
+			return false;
+
+		if (job.Affinity == JobAffinity::Any)
+			s_JobData->QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+		RunJob(job);
+		return true;
+	}
+
+	void JobSystem::RunJob(Job& job)
+	{
+		{
+			VS_PROFILE_SCOPE("Job");
+			VS_PROFILE_FLOW_END("Job", job.ID);
+
+			job.Function();
+		}
+
+		JobCounter* counter = job.Counter;
+		if (!counter)
+			return;
+
+		std::vector<Job> continuations;
+		{
+			std::lock_guard lock(counter->m_Mutex);
+			if (counter->m_Count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				continuations.swap(counter->m_Continuations);
+		}
+
+		// Counter may be gone from here on
+		for (Job& continuation : continuations)
+		{
+			if (s_JobData)
+				Schedule(std::move(continuation));
+			else
+				RunJob(continuation);
+		}
+	}
+
+	void JobSystem::WorkerLoop(uint32_t index)
+	{
+		s_QueueIndex = index;
+		VS_PROFILE_THREAD("Worker " + std::to_string(index));
+
+		while (s_JobData->Running)
+		{
+			if (TryRunJob())
+				continue;
+
+			std::unique_lock lock(s_JobData->WakeMutex);
+			s_JobData->WakeCondition.wait(lock, []()
+			{
+				return !s_JobData->Running || s_JobData->QueuedJobs.load(std::memory_order_acquire) > 0;
+			});
+		}
+	}
+
+}
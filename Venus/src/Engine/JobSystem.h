@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Venus {
+
+	enum class JobAffinity
+	{
+		Any = 0,
+		MainThread // GL and other main thread only work
+	};
+
+	struct Job
+	{
+		std::function<void()> Function;
+		class JobCounter* Counter = nullptr;
+		JobAffinity Affinity = JobAffinity::Any;
+		uint64_t ID = 0; // Links the job to where it was scheduled in profiles
+	};
+
+	// Tracks outstanding jobs, jobs scheduled after it run once it reaches zero
+	class JobCounter
+	{
+		public:
+			JobCounter() = default;
+			JobCounter(const JobCounter&) = delete;
+			JobCounter& operator=(const JobCounter&) = delete;
+
+			bool IsDone() const { return m_Count.load(std::memory_order_acquire) == 0; }
+
+		private:
+			std::atomic<uint32_t> m_Count = 0;
+
+			std::mutex m_Mutex;
+			std::vector<Job> m_Continuations;
+
+			friend class JobSystem;
+	};
+
+	// Per worker deques, owners pop the newest job and idle workers steal the oldest one from the others
+	class JobSystem
+	{
+		public:
+			// Zero workers means one per hardware thread besides the main thread
+			static void Init(uint32_t workerCount = 0);
+			static void Shutdown();
+
+			// Counter is incremented now and decremented once the job ran
+			static void Execute(std::function<void()> function, JobCounter* counter = nullptr, JobAffinity affinity = JobAffinity::Any);
+
+			// Job is only scheduled once every job tracked by dependency finished
+			static void ExecuteAfter(JobCounter& dependency, std::function<void()> function, JobCounter* counter = nullptr, JobAffinity affinity = JobAffinity::Any);
+
+			// Splits [0, count) in ranges of at most batchSize and blocks until all ran, the caller works on them too
+			static void ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t begin, uint32_t end)>& function);
+
+			// Runs other jobs while waiting instead of blocking the thread
+			static void Wait(JobCounter& counter);
+
+			// Drains jobs with main thread affinity, called once a frame by the application
+			static void ProcessMainThreadJobs();
+
+			static uint32_t GetWorkerCount();
+			static bool IsMainThread();
+
+		private:
+			static void Schedule(Job&& job);
+			static bool TryRunJob();
+			static void RunJob(Job& job);
+			static void WorkerLoop(uint32_t index);
+	};
+
+}
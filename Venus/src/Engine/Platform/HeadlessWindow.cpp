@@ -0,0 +1,29 @@
+#include "pch.h"
+#include "HeadlessWindow.h"
+
+namespace Venus {
+
+	HeadlessWindow::HeadlessWindow(const WindowProps& props)
+		: m_Width(props.Width), m_Height(props.Height), m_StartTime(std::chrono::steady_clock::now())
+	{
+		VS_PROFILE_FUNCTION();
+
+		CORE_LOG_INFO("Creating headless window {0} ({1}, {2})", props.Title, props.Width, props.Height);
+
+		m_Context = GraphicsContext::CreateHeadless(props.Width, props.Height);
+		m_Context->Init();
+	}
+
+	void HeadlessWindow::OnUpdate()
+	{
+		VS_PROFILE_FUNCTION();
+
+		m_Context->SwapBuffers();
+	}
+
+	float HeadlessWindow::GetTime() const
+	{
+		return std::chrono::duration<float>(std::chrono::steady_clock::now() - m_StartTime).count();
+	}
+
+}
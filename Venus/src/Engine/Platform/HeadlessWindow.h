@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Engine/Window.h"
+#include "Renderer/GraphicsContext.h"
+
+namespace Venus {
+
+	// No native window, events or input, only a size and an offscreen graphics context
+	class HeadlessWindow : public Window
+	{
+		public:
+			HeadlessWindow(const WindowProps& props);
+			virtual ~HeadlessWindow() = default;
+
+			void OnUpdate() override;
+
+			uint32_t GetWidth() const override { return m_Width; }
+			uint32_t GetHeight() const override { return m_Height; }
+			float GetTime() const override;
+
+			void SetEventCallback(const EventCallbackFn& callback) override {}
+
+			void SetVSync(bool enabled) override {}
+			bool IsVSync() const override { return false; }
+
+			void SetWindowTitle(const std::string& title) override {}
+
+			void Maximize() override {}
+			bool IsMaximized() override { return false; }
+			void Minimize() override {}
+			void Restore() override {}
+
+			virtual void* GetNativeWindow() const { return nullptr; }
+
+		private:
+			uint32_t m_Width, m_Height;
+			std::chrono::steady_clock::time_point m_StartTime;
+
+			Scope<GraphicsContext> m_Context;
+	};
+
+}
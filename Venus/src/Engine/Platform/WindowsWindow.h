@@ -17,6 +17,7 @@ namespace Venus {
 
 			unsigned int GetWidth() const override { return m_Data.Width; }
 			unsigned int GetHeight() const override { return m_Data.Height; }
+			float GetTime() const override { return (float)glfwGetTime(); }
 
 			void SetEventCallback(const EventCallbackFn& callback) override { m_Data.EventCallback = callback; }
 
@@ -1,6 +1,8 @@
 #include "pch.h"
 #include "Window.h"
 
+#include "Engine/Platform/HeadlessWindow.h"
+
 #ifdef VS_PLATFORM_WINDOWS
 #include "Engine/Platform/WindowsWindow.h"
 #endif
@@ -9,6 +11,9 @@ namespace Venus {
 
 	Scope<Window> Window::Create(const WindowProps& props)
 	{
+		if (props.Headless)
+			return CreateScope<HeadlessWindow>(props);
+
 #ifdef VS_PLATFORM_WINDOWS
 		return CreateScope<WindowsWindow>(props);
 #else
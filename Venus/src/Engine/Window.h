@@ -15,6 +15,8 @@ namespace Venus {
 		bool Vsync;
 		bool Fullscreen;
 		bool Decorated;
+		// No platform window or input, see HeadlessWindow
+		bool Headless = false;
 
 		WindowProps(const std::string& title = "Venus Engine",
 			uint32_t width = 1600,
@@ -38,6 +40,8 @@ namespace Venus {
 
 			virtual uint32_t GetWidth() const = 0;
 			virtual uint32_t GetHeight() const = 0;
+			// Seconds since the window was created
+			virtual float GetTime() const = 0;
 
 			virtual void SetEventCallback(const EventCallbackFn& callback) = 0;
 
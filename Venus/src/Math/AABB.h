@@ -0,0 +1,66 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <limits>
+
+namespace Venus {
+
+	struct AABB
+	{
+		glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 Max = glm::vec3(std::numeric_limits<float>::lowest());
+
+		AABB() = default;
+		AABB(const glm::vec3& min, const glm::vec3& max)
+			: Min(min), Max(max) {}
+
+		bool IsValid() const { return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z; }
+
+		glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+		glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+		float GetSurfaceArea() const
+		{
+			glm::vec3 size = Max - Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		void Extend(const glm::vec3& point)
+		{
+			Min = glm::min(Min, point);
+			Max = glm::max(Max, point);
+		}
+
+		void Extend(const AABB& other)
+		{
+			Min = glm::min(Min, other.Min);
+			Max = glm::max(Max, other.Max);
+		}
+
+		bool Contains(const AABB& other) const
+		{
+			return glm::all(glm::lessThanEqual(Min, other.Min)) && glm::all(glm::greaterThanEqual(Max, other.Max));
+		}
+
+		// Bounds of the transformed box, projects the extents on each axis instead of transforming 8 corners
+		AABB Transform(const glm::mat4& transform) const
+		{
+			glm::vec3 center = glm::vec3(transform * glm::vec4(GetCenter(), 1.0f));
+			glm::vec3 extents = GetExtents();
+
+			glm::vec3 newExtents =
+				glm::abs(glm::vec3(transform[0])) * extents.x +
+				glm::abs(glm::vec3(transform[1])) * extents.y +
+				glm::abs(glm::vec3(transform[2])) * extents.z;
+
+			return AABB(center - newExtents, center + newExtents);
+		}
+
+		static AABB Union(const AABB& a, const AABB& b)
+		{
+			return AABB(glm::min(a.Min, b.Min), glm::max(a.Max, b.Max));
+		}
+	};
+
+}
@@ -0,0 +1,321 @@
+#include "pch.h"
+#include "DynamicAABBTree.h"
+
+namespace Venus {
+
+	int32_t DynamicAABBTree::CreateProxy(const AABB& aabb, uint32_t userData)
+	{
+		int32_t proxyID = AllocateNode();
+
+		Node& node = m_Nodes[proxyID];
+		node.Box = AABB(aabb.Min - glm::vec3(Margin), aabb.Max + glm::vec3(Margin));
+		node.UserData = userData;
+		node.Height = 0;
+
+		InsertLeaf(proxyID);
+		m_ProxyCount++;
+
+		return proxyID;
+	}
+
+	void DynamicAABBTree::DestroyProxy(int32_t proxyID)
+	{
+		VS_CORE_ASSERT(proxyID >= 0 && proxyID < (int32_t)m_Nodes.size(), "Invalid proxy!");
+		VS_CORE_ASSERT(m_Nodes[proxyID].IsLeaf(), "Proxy is not a leaf!");
+
+		RemoveLeaf(proxyID);
+		FreeNode(proxyID);
+		m_ProxyCount--;
+	}
+
+	bool DynamicAABBTree::MoveProxy(int32_t proxyID, const AABB& aabb)
+	{
+		VS_CORE_ASSERT(proxyID >= 0 && proxyID < (int32_t)m_Nodes.size(), "Invalid proxy!");
+		VS_CORE_ASSERT(m_Nodes[proxyID].IsLeaf(), "Proxy is not a leaf!");
+
+		AABB fatAABB(aabb.Min - glm::vec3(Margin), aabb.Max + glm::vec3(Margin));
+
+		// Keep the old box while it still contains the new one and isn't much larger
+		const AABB& treeAABB = m_Nodes[proxyID].Box;
+		if (treeAABB.Contains(aabb))
+		{
+			AABB hugeAABB(aabb.Min - glm::vec3(4.0f * Margin), aabb.Max + glm::vec3(4.0f * Margin));
+			if (hugeAABB.Contains(treeAABB))
+				return false;
+		}
+
+		RemoveLeaf(proxyID);
+		m_Nodes[proxyID].Box = fatAABB;
+		InsertLeaf(proxyID);
+
+		return true;
+	}
+
+	void DynamicAABBTree::Clear()
+	{
+		m_Nodes.clear();
+		m_Root = NullNode;
+		m_FreeList = NullNode;
+		m_ProxyCount = 0;
+	}
+
+	int32_t DynamicAABBTree::AllocateNode()
+	{
+		if (m_FreeList == NullNode)
+		{
+			m_Nodes.emplace_back();
+			return (int32_t)m_Nodes.size() - 1;
+		}
+
+		int32_t node = m_FreeList;
+		m_FreeList = m_Nodes[node].Parent;
+		m_Nodes[node] = Node();
+		return node;
+	}
+
+	void DynamicAABBTree::FreeNode(int32_t node)
+	{
+		m_Nodes[node].Parent = m_FreeList;
+		m_Nodes[node].Height = -1;
+		m_FreeList = node;
+	}
+
+	void DynamicAABBTree::InsertLeaf(int32_t leaf)
+	{
+		if (m_Root == NullNode)
+		{
+			m_Root = leaf;
+			m_Nodes[leaf].Parent = NullNode;
+			return;
+		}
+
+		// Walk down picking the child with the lowest surface area cost
+		AABB leafAABB = m_Nodes[leaf].Box;
+		int32_t index = m_Root;
+		while (!m_Nodes[index].IsLeaf())
+		{
+			int32_t left = m_Nodes[index].Left;
+			int32_t right = m_Nodes[index].Right;
+
+			float area = m_Nodes[index].Box.GetSurfaceArea();
+			float combinedArea = AABB::Union(m_Nodes[index].Box, leafAABB).GetSurfaceArea();
+
+			// Cost of creating a new parent for this node and the leaf
+			float cost = 2.0f * combinedArea;
+
+			// Minimum cost of pushing the leaf further down
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto descendCost = [&](int32_t child)
+			{
+				float newArea = AABB::Union(leafAABB, m_Nodes[child].Box).GetSurfaceArea();
+				if (m_Nodes[child].IsLeaf())
+					return newArea + inheritanceCost;
+
+				return newArea - m_Nodes[child].Box.GetSurfaceArea() + inheritanceCost;
+			};
+
+			float costLeft = descendCost(left);
+			float costRight = descendCost(right);
+
+			if (cost < costLeft && cost < costRight)
+				break;
+
+			index = costLeft < costRight ? left : right;
+		}
+
+		int32_t sibling = index;
+
+		// AllocateNode may grow the node array, no references are held across it
+		int32_t oldParent = m_Nodes[sibling].Parent;
+		int32_t newParent = AllocateNode();
+		m_Nodes[newParent].Parent = oldParent;
+		m_Nodes[newParent].Box = AABB::Union(leafAABB, m_Nodes[sibling].Box);
+		m_Nodes[newParent].Height = m_Nodes[sibling].Height + 1;
+		m_Nodes[newParent].Left = sibling;
+		m_Nodes[newParent].Right = leaf;
+		m_Nodes[sibling].Parent = newParent;
+		m_Nodes[leaf].Parent = newParent;
+
+		if (oldParent != NullNode)
+		{
+			if (m_Nodes[oldParent].Left == sibling)
+				m_Nodes[oldParent].Left = newParent;
+			else
+				m_Nodes[oldParent].Right = newParent;
+		}
+		else
+		{
+			m_Root = newParent;
+		}
+
+		// Refit and rebalance the ancestors
+		index = m_Nodes[leaf].Parent;
+		while (index != NullNode)
+		{
+			index = Balance(index);
+
+			Node& node = m_Nodes[index];
+			node.Height = 1 + glm::max(m_Nodes[node.Left].Height, m_Nodes[node.Right].Height);
+			node.Box = AABB::Union(m_Nodes[node.Left].Box, m_Nodes[node.Right].Box);
+
+			index = node.Parent;
+		}
+	}
+
+	void DynamicAABBTree::RemoveLeaf(int32_t leaf)
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = NullNode;
+			return;
+		}
+
+		int32_t parent = m_Nodes[leaf].Parent;
+		int32_t grandParent = m_Nodes[parent].Parent;
+		int32_t sibling = m_Nodes[parent].Left == leaf ? m_Nodes[parent].Right : m_Nodes[parent].Left;
+
+		if (grandParent != NullNode)
+		{
+			// Sibling takes the parent's place
+			if (m_Nodes[grandParent].Left == parent)
+				m_Nodes[grandParent].Left = sibling;
+			else
+				m_Nodes[grandParent].Right = sibling;
+
+			m_Nodes[sibling].Parent = grandParent;
+			FreeNode(parent);
+
+			int32_t index = grandParent;
+			while (index != NullNode)
+			{
+				index = Balance(index);
+
+				Node& node = m_Nodes[index];
+				node.Height = 1 + glm::max(m_Nodes[node.Left].Height, m_Nodes[node.Right].Height);
+				node.Box = AABB::Union(m_Nodes[node.Left].Box, m_Nodes[node.Right].Box);
+
+				index = node.Parent;
+			}
+		}
+		else
+		{
+			m_Root = sibling;
+			m_Nodes[sibling].Parent = NullNode;
+			FreeNode(parent);
+		}
+	}
+
+	int32_t DynamicAABBTree::Balance(int32_t iA)
+	{
+		Node& A = m_Nodes[iA];
+		if (A.IsLeaf() || A.Height < 2)
+			return iA;
+
+		int32_t iB = A.Left;
+		int32_t iC = A.Right;
+		Node& B = m_Nodes[iB];
+		Node& C = m_Nodes[iC];
+
+		int32_t balance = C.Height - B.Height;
+
+		// Rotate C up
+		if (balance > 1)
+		{
+			int32_t iF = C.Left;
+			int32_t iG = C.Right;
+			Node& F = m_Nodes[iF];
+			Node& G = m_Nodes[iG];
+
+			C.Left = iA;
+			C.Parent = A.Parent;
+			A.Parent = iC;
+
+			if (C.Parent != NullNode)
+			{
+				if (m_Nodes[C.Parent].Left == iA)
+					m_Nodes[C.Parent].Left = iC;
+				else
+					m_Nodes[C.Parent].Right = iC;
+			}
+			else
+			{
+				m_Root = iC;
+			}
+
+			if (F.Height > G.Height)
+			{
+				C.Right = iF;
+				A.Right = iG;
+				G.Parent = iA;
+				A.Box = AABB::Union(B.Box, G.Box);
+				C.Box = AABB::Union(A.Box, F.Box);
+				A.Height = 1 + glm::max(B.Height, G.Height);
+				C.Height = 1 + glm::max(A.Height, F.Height);
+			}
+			else
+			{
+				C.Right = iG;
+				A.Right = iF;
+				F.Parent = iA;
+				A.Box = AABB::Union(B.Box, F.Box);
+				C.Box = AABB::Union(A.Box, G.Box);
+				A.Height = 1 + glm::max(B.Height, F.Height);
+				C.Height = 1 + glm::max(A.Height, G.Height);
+			}
+
+			return iC;
+		}
+
+		// Rotate B up
+		if (balance < -1)
+		{
+			int32_t iD = B.Left;
+			int32_t iE = B.Right;
+			Node& D = m_Nodes[iD];
+			Node& E = m_Nodes[iE];
+
+			B.Left = iA;
+			B.Parent = A.Parent;
+			A.Parent = iB;
+
+			if (B.Parent != NullNode)
+			{
+				if (m_Nodes[B.Parent].Left == iA)
+					m_Nodes[B.Parent].Left = iB;
+				else
+					m_Nodes[B.Parent].Right = iB;
+			}
+			else
+			{
+				m_Root = iB;
+			}
+
+			if (D.Height > E.Height)
+			{
+				B.Right = iD;
+				A.Left = iE;
+				E.Parent = iA;
+				A.Box = AABB::Union(C.Box, E.Box);
+				B.Box = AABB::Union(A.Box, D.Box);
+				A.Height = 1 + glm::max(C.Height, E.Height);
+				B.Height = 1 + glm::max(A.Height, D.Height);
+			}
+			else
+			{
+				B.Right = iE;
+				A.Left = iD;
+				D.Parent = iA;
+				A.Box = AABB::Union(C.Box, D.Box);
+				B.Box = AABB::Union(A.Box, E.Box);
+				A.Height = 1 + glm::max(C.Height, D.Height);
+				B.Height = 1 + glm::max(A.Height, E.Height);
+			}
+
+			return iB;
+		}
+
+		return iA;
+	}
+
+}
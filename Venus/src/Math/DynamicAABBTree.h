@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Math/AABB.h"
+#include "Math/Frustum.h"
+
+#include <vector>
+
+namespace Venus {
+
+	// Incrementally balanced BVH, leaves store a fattened box so small moves don't touch the tree
+	class DynamicAABBTree
+	{
+		public:
+			static constexpr int32_t NullNode = -1;
+
+			DynamicAABBTree() = default;
+
+			int32_t CreateProxy(const AABB& aabb, uint32_t userData);
+			void DestroyProxy(int32_t proxyID);
+
+			// Returns true if the proxy left its fat box and had to be reinserted
+			bool MoveProxy(int32_t proxyID, const AABB& aabb);
+
+			void Clear();
+
+			uint32_t GetUserData(int32_t proxyID) const { return m_Nodes[proxyID].UserData; }
+			const AABB& GetFatAABB(int32_t proxyID) const { return m_Nodes[proxyID].Box; }
+			uint32_t GetProxyCount() const { return m_ProxyCount; }
+			int32_t GetHeight() const { return m_Root == NullNode ? 0 : m_Nodes[m_Root].Height; }
+
+			// Calls fn(userData) for every proxy touching the frustum
+			template<typename Fn>
+			void Query(const Frustum& frustum, Fn&& fn) const
+			{
+				if (m_Root == NullNode)
+					return;
+
+				// Subtrees fully inside the frustum skip the plane tests
+				struct StackEntry
+				{
+					int32_t Node;
+					bool Inside;
+				};
+
+				std::vector<StackEntry> stack;
+				stack.reserve(64);
+				stack.push_back({ m_Root, false });
+
+				while (!stack.empty())
+				{
+					StackEntry entry = stack.back();
+					stack.pop_back();
+
+					const Node& node = m_Nodes[entry.Node];
+
+					bool inside = entry.Inside;
+					if (!inside)
+					{
+						FrustumTest result = frustum.Test(node.Box);
+						if (result == FrustumTest::Outside)
+							continue;
+
+						inside = result == FrustumTest::Inside;
+					}
+
+					if (node.IsLeaf())
+					{
+						fn(node.UserData);
+					}
+					else
+					{
+						stack.push_back({ node.Left, inside });
+						stack.push_back({ node.Right, inside });
+					}
+				}
+			}
+
+		private:
+			struct Node
+			{
+				AABB Box;
+				int32_t Parent = NullNode; // Next free node while in the free list
+				int32_t Left = NullNode;
+				int32_t Right = NullNode;
+				int32_t Height = -1;
+				uint32_t UserData = 0;
+
+				bool IsLeaf() const { return Left == NullNode; }
+			};
+
+			int32_t AllocateNode();
+			void FreeNode(int32_t node);
+
+			void InsertLeaf(int32_t leaf);
+			void RemoveLeaf(int32_t leaf);
+			int32_t Balance(int32_t node);
+
+		private:
+			std::vector<Node> m_Nodes;
+			int32_t m_Root = NullNode;
+			int32_t m_FreeList = NullNode;
+			uint32_t m_ProxyCount = 0;
+
+			static constexpr float Margin = 0.1f;
+	};
+
+}
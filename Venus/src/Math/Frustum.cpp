@@ -0,0 +1,47 @@
+#include "pch.h"
+#include "Frustum.h"
+
+namespace Venus {
+
+	Frustum::Frustum(const glm::mat4& viewProjection)
+	{
+		// Gribb/Hartmann plane extraction, clip space z in [-w, w]
+		glm::vec4 rowX = { viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0] };
+		glm::vec4 rowY = { viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1] };
+		glm::vec4 rowZ = { viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2] };
+		glm::vec4 rowW = { viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3] };
+
+		m_Planes[0] = rowW + rowX;
+		m_Planes[1] = rowW - rowX;
+		m_Planes[2] = rowW + rowY;
+		m_Planes[3] = rowW - rowY;
+		m_Planes[4] = rowW + rowZ;
+		m_Planes[5] = rowW - rowZ;
+
+		for (glm::vec4& plane : m_Planes)
+			plane /= glm::length(glm::vec3(plane));
+	}
+
+	FrustumTest Frustum::Test(const AABB& aabb) const
+	{
+		glm::vec3 center = aabb.GetCenter();
+		glm::vec3 extents = aabb.GetExtents();
+
+		FrustumTest result = FrustumTest::Inside;
+		for (const glm::vec4& plane : m_Planes)
+		{
+			glm::vec3 normal = glm::vec3(plane);
+			float distance = glm::dot(normal, center) + plane.w;
+			float radius = glm::dot(extents, glm::abs(normal));
+
+			if (distance < -radius)
+				return FrustumTest::Outside;
+
+			if (distance < radius)
+				result = FrustumTest::Intersect;
+		}
+
+		return result;
+	}
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Math/AABB.h"
+
+namespace Venus {
+
+	enum class FrustumTest
+	{
+		Outside = 0, Intersect, Inside
+	};
+
+	class Frustum
+	{
+		public:
+			Frustum() = default;
+			Frustum(const glm::mat4& viewProjection);
+
+			FrustumTest Test(const AABB& aabb) const;
+			bool Intersects(const AABB& aabb) const { return Test(aabb) != FrustumTest::Outside; }
+
+		private:
+			// Left, Right, Bottom, Top, Near, Far, normals point inwards
+			glm::vec4 m_Planes[6];
+	};
+
+}
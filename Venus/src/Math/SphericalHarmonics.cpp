@@ -0,0 +1,122 @@
+#include "pch.h"
+#include "SphericalHarmonics.h"
+
+#include <glm/gtc/constants.hpp>
+
+namespace Venus {
+
+	namespace Utils {
+
+		// Matches GetCubeMapTexCoord of the environment compute shaders, at texel centers
+		static glm::vec3 GetCubeMapDirection(uint32_t face, float u, float v)
+		{
+			glm::vec3 direction;
+			switch (face)
+			{
+				case 0: direction = glm::vec3( 1.0f, v, -u); break;
+				case 1: direction = glm::vec3(-1.0f, v, u); break;
+				case 2: direction = glm::vec3(u, 1.0f, -v); break;
+				case 3: direction = glm::vec3(u, -1.0f, v); break;
+				case 4: direction = glm::vec3(u, v, 1.0f); break;
+				default: direction = glm::vec3(-u, v, -1.0f); break;
+			}
+
+			return glm::normalize(direction);
+		}
+
+		static void EvaluateSHBasis(const glm::vec3& d, float basis[9])
+		{
+			basis[0] = 0.282095f;
+			basis[1] = 0.488603f * d.y;
+			basis[2] = 0.488603f * d.z;
+			basis[3] = 0.488603f * d.x;
+			basis[4] = 1.092548f * d.x * d.y;
+			basis[5] = 1.092548f * d.y * d.z;
+			basis[6] = 0.315392f * (3.0f * d.z * d.z - 1.0f);
+			basis[7] = 1.092548f * d.x * d.z;
+			basis[8] = 0.546274f * (d.x * d.x - d.y * d.y);
+		}
+
+	}
+
+	SphericalHarmonics SphericalHarmonics::ProjectCubeMap(const float* faces, uint32_t size)
+	{
+		SphericalHarmonics result;
+		float totalWeight = 0.0f;
+
+		for (uint32_t face = 0; face < 6; face++)
+		{
+			for (uint32_t y = 0; y < size; y++)
+			{
+				for (uint32_t x = 0; x < size; x++)
+				{
+					float u = 2.0f * (x + 0.5f) / size - 1.0f;
+					float v = 2.0f * (1.0f - (y + 0.5f) / size) - 1.0f;
+
+					// Texels near the face corners cover a smaller solid angle
+					float weight = 1.0f / std::pow(1.0f + u * u + v * v, 1.5f);
+
+					float basis[9];
+					Utils::EvaluateSHBasis(Utils::GetCubeMapDirection(face, u, v), basis);
+
+					const float* texel = faces + (((uint64_t)face * size + y) * size + x) * 4;
+					glm::vec3 radiance(texel[0], texel[1], texel[2]);
+					for (uint32_t i = 0; i < 9; i++)
+						result.Coefficients[i] += radiance * basis[i] * weight;
+
+					totalWeight += weight;
+				}
+			}
+		}
+
+		float normalization = 4.0f * glm::pi<float>() / totalWeight;
+		for (uint32_t i = 0; i < 9; i++)
+			result.Coefficients[i] *= normalization;
+
+		return result;
+	}
+
+	void SphericalHarmonics::ConvolveLambert()
+	{
+		// Clamped cosine lobe per band (pi, 2pi/3, pi/4), divided by pi
+		static const float bands[9] = { 1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+		for (uint32_t i = 0; i < 9; i++)
+			Coefficients[i] *= bands[i];
+	}
+
+	glm::vec3 SphericalHarmonics::Evaluate(const glm::vec3& direction) const
+	{
+		float basis[9];
+		Utils::EvaluateSHBasis(direction, basis);
+
+		glm::vec3 result(0.0f);
+		for (uint32_t i = 0; i < 9; i++)
+			result += Coefficients[i] * basis[i];
+
+		return glm::max(result, glm::vec3(0.0f));
+	}
+
+	void SphericalHarmonics::EvaluateCubeMap(float* faces, uint32_t size) const
+	{
+		for (uint32_t face = 0; face < 6; face++)
+		{
+			for (uint32_t y = 0; y < size; y++)
+			{
+				for (uint32_t x = 0; x < size; x++)
+				{
+					float u = 2.0f * (x + 0.5f) / size - 1.0f;
+					float v = 2.0f * (1.0f - (y + 0.5f) / size) - 1.0f;
+
+					glm::vec3 irradiance = Evaluate(Utils::GetCubeMapDirection(face, u, v));
+
+					float* texel = faces + (((uint64_t)face * size + y) * size + x) * 4;
+					texel[0] = irradiance.r;
+					texel[1] = irradiance.g;
+					texel[2] = irradiance.b;
+					texel[3] = 1.0f;
+				}
+			}
+		}
+	}
+
+}
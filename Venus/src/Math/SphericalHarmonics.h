@@ -0,0 +1,24 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Venus {
+
+	// Third order RGB spherical harmonics, nine coefficients
+	struct SphericalHarmonics
+	{
+		glm::vec3 Coefficients[9] = {};
+
+		// Projects RGBA float faces laid out like the cube map compute shaders write them
+		static SphericalHarmonics ProjectCubeMap(const float* faces, uint32_t size);
+
+		// Radiance to cosine convolved irradiance over pi, which is what irradiance maps store
+		void ConvolveLambert();
+
+		glm::vec3 Evaluate(const glm::vec3& direction) const;
+
+		// Writes RGBA float faces, same layout as ProjectCubeMap reads
+		void EvaluateCubeMap(float* faces, uint32_t size) const;
+	};
+
+}
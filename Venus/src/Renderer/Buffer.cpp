@@ -3,6 +3,7 @@
 
 #include "Renderer/Renderer.h"
 #include "Renderer/OpenGL/OpenGLBuffer.h"
+#include "Renderer/Null/NullBuffer.h"
 
 namespace Venus {
 
@@ -10,7 +11,7 @@ namespace Venus {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateRef<NullVertexBuffer>(size);
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLVertexBuffer>(size);
 		}
 
@@ -18,11 +19,23 @@ namespace Venus {
 		return nullptr;
 	}
 
+	Ref<VertexBuffer> VertexBuffer::Create(const Ref<RingBuffer>& ringBuffer)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    return CreateRef<NullVertexBuffer>(0);
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLVertexBuffer>(ringBuffer);
+		}
+
+		VS_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
 	Ref<VertexBuffer> VertexBuffer::Create(float* vertices, uint32_t size)
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateRef<NullVertexBuffer>(size);
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLVertexBuffer>(vertices, size);
 		}
 
@@ -30,11 +43,11 @@ namespace Venus {
 		return nullptr;
 	}
 
-	Ref<VertexBuffer> VertexBuffer::Create(void* vertices, uint32_t size)
+	Ref<VertexBuffer> VertexBuffer::Create(const void* vertices, uint32_t size)
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateRef<NullVertexBuffer>(size);
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLVertexBuffer>(vertices, size);
 		}
 
@@ -42,11 +55,11 @@ namespace Venus {
 		return nullptr;
 	}
 
-	Ref<IndexBuffer> IndexBuffer::Create(uint32_t* indices, uint32_t size)
+	Ref<IndexBuffer> IndexBuffer::Create(const uint32_t* indices, uint32_t size)
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateRef<NullIndexBuffer>(size);
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLIndexBuffer>(indices, size);
 		}
 
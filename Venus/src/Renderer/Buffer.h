@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Renderer/RingBuffer.h"
+
 namespace Venus {
 
 	enum class ShaderDataType
@@ -115,7 +117,9 @@ namespace Venus {
 
 			static Ref<VertexBuffer> Create(uint32_t size);
 			static Ref<VertexBuffer> Create(float* vertices, uint32_t size);
-			static Ref<VertexBuffer> Create(void* vertices, uint32_t size);
+			static Ref<VertexBuffer> Create(const void* vertices, uint32_t size);
+			// Vertex data is pushed to the ring buffer directly, draws offset into it with a base vertex
+			static Ref<VertexBuffer> Create(const Ref<RingBuffer>& ringBuffer);
 	};
 
 	// Currently Venus only supports 32-bit index buffers
@@ -129,7 +133,7 @@ namespace Venus {
 
 			virtual uint32_t GetCount() const = 0;
 
-			static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t count);
+			static Ref<IndexBuffer> Create(const uint32_t* indices, uint32_t count);
 	};
 
 }
@@ -3,6 +3,7 @@
 
 #include "Renderer/Renderer.h"
 #include "Renderer/OpenGL/OpenGLComputePipeline.h"
+#include "Renderer/Null/NullComputePipeline.h"
 
 namespace Venus {
 
@@ -10,7 +11,7 @@ namespace Venus {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateRef<NullComputePipeline>(computeShader);
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLComputePipeline>(computeShader);
 		}
 
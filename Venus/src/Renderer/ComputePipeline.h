@@ -2,6 +2,7 @@
 
 #include "Renderer/Shader.h"
 #include "Renderer/Texture.h"
+#include "Renderer/Framebuffer.h"
 
 namespace Venus {
 
@@ -14,6 +15,8 @@ namespace Venus {
 			virtual void BindImage(uint32_t binding, Ref<Texture> texture, uint32_t level = 0, uint32_t layer = 0) = 0;
 			virtual void BindReadOnlyImage(uint32_t binding, Ref<Texture> texture, uint32_t level = 0, uint32_t layer = 0) = 0;
 			virtual void BindWriteOnlyImage(uint32_t binding, Ref<Texture> texture, uint32_t level = 0, uint32_t layer = 0) = 0;
+			// Color attachment of a framebuffer, for passes writing render graph targets
+			virtual void BindWriteOnlyImage(uint32_t binding, const Ref<Framebuffer>& framebuffer, uint32_t attachmentIndex = 0) = 0;
 
 			virtual Ref<Shader> GetShader() = 0;
 
@@ -0,0 +1,174 @@
+#include "pch.h"
+#include "EnvironmentCache.h"
+
+#include "Utils/Hash.h"
+
+namespace Venus {
+
+	namespace Utils {
+
+		static const char* GetEnvironmentCacheDirectory()
+		{
+			return "Resources/Cache/Environment";
+		}
+
+		static void CreateEnvironmentCacheDirectoryIfNeeded()
+		{
+			std::string cacheDirectory = GetEnvironmentCacheDirectory();
+			if (!std::filesystem::exists(cacheDirectory))
+				std::filesystem::create_directories(cacheDirectory);
+		}
+
+		static uint32_t GetLevelCount(uint32_t size)
+		{
+			return (uint32_t)std::floor(std::log2(size)) + 1;
+		}
+
+	}
+
+	// Layout: header, then every radiance level and the irradiance cube unless it is stored as SH
+	struct EnvironmentCacheHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t SourceHash;
+		uint32_t RadianceSize;
+		uint32_t RadianceLevelCount;
+		uint32_t IrradianceSize;
+		uint32_t IrradianceSH;
+		glm::vec3 SHCoefficients[9];
+	};
+
+	static constexpr char s_EnvironmentCacheMagic[4] = { 'V', 'S', 'E', 'V' };
+	static constexpr uint64_t s_BytesPerTexel = 4 * sizeof(uint16_t);
+	static constexpr uint64_t s_DataOffset = (sizeof(EnvironmentCacheHeader) + 15) & ~15ull;
+
+	uint64_t EnvironmentCache::HashSource(const std::string& sourcePath)
+	{
+		VS_PROFILE_FUNCTION();
+
+		MappedFile source(sourcePath);
+		if (!source.IsValid())
+			return 0;
+
+		return Hash::GenerateFNVHash64(source.GetData(), source.GetSize());
+	}
+
+	std::filesystem::path EnvironmentCache::GetCachePath(const std::string& sourcePath)
+	{
+		std::filesystem::path path = sourcePath;
+		uint32_t pathHash = Hash::GenerateFNVHash(std::filesystem::absolute(path).generic_string());
+
+		std::stringstream name;
+		name << path.stem().string() << "_" << std::hex << pathHash << ".vsenv";
+
+		return std::filesystem::path(Utils::GetEnvironmentCacheDirectory()) / name.str();
+	}
+
+	uint64_t EnvironmentCache::GetLevelSize(uint32_t size, uint32_t level)
+	{
+		uint64_t levelSize = std::max(size >> level, 1u);
+		return levelSize * levelSize * 6 * s_BytesPerTexel;
+	}
+
+	bool EnvironmentCache::Write(const std::filesystem::path& path, uint64_t sourceHash, const EnvironmentBakeSettings& settings, const CookedEnvironment& environment)
+	{
+		VS_PROFILE_FUNCTION();
+		VS_CORE_ASSERT(environment.RadianceLevels.size() == Utils::GetLevelCount(environment.RadianceSize), "Radiance mip chain incomplete!");
+		VS_CORE_ASSERT(settings.IrradianceSH || environment.Irradiance, "Irradiance missing!");
+
+		EnvironmentCacheHeader header = {};
+		memcpy(header.Magic, s_EnvironmentCacheMagic, sizeof(header.Magic));
+		header.Version = Version;
+		header.SourceHash = sourceHash;
+		header.RadianceSize = environment.RadianceSize;
+		header.RadianceLevelCount = (uint32_t)environment.RadianceLevels.size();
+		header.IrradianceSize = environment.IrradianceSize;
+		header.IrradianceSH = settings.IrradianceSH;
+		memcpy(header.SHCoefficients, environment.IrradianceSH.Coefficients, sizeof(header.SHCoefficients));
+
+		Utils::CreateEnvironmentCacheDirectoryIfNeeded();
+
+		// Written next to the target first so a crash never leaves a torn cache behind
+		std::filesystem::path tempPath = path;
+		tempPath += ".tmp";
+
+		std::ofstream out(tempPath, std::ios::out | std::ios::binary);
+		if (!out.is_open())
+		{
+			CORE_LOG_WARN("EnvironmentCache: Could not write {0}", path.string());
+			return false;
+		}
+
+		// Levels are large, they go straight to the file instead of through one big buffer
+		char padding[16] = {};
+		out.write((const char*)&header, sizeof(EnvironmentCacheHeader));
+		out.write(padding, s_DataOffset - sizeof(EnvironmentCacheHeader));
+
+		for (uint32_t level = 0; level < header.RadianceLevelCount; level++)
+			out.write((const char*)environment.RadianceLevels[level], GetLevelSize(environment.RadianceSize, level));
+
+		if (!settings.IrradianceSH)
+			out.write((const char*)environment.Irradiance, GetLevelSize(environment.IrradianceSize, 0));
+
+		out.close();
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, path, error);
+		if (error)
+		{
+			CORE_LOG_WARN("EnvironmentCache: Could not write {0}: {1}", path.string(), error.message());
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+
+		return true;
+	}
+
+	EnvironmentCache::Reader::Reader(const std::filesystem::path& path, uint64_t sourceHash, const EnvironmentBakeSettings& settings)
+		: m_File(path)
+	{
+		VS_PROFILE_FUNCTION();
+
+		if (!m_File.IsValid() || m_File.GetSize() < s_DataOffset)
+			return;
+
+		const uint8_t* data = m_File.GetData();
+		const uint64_t size = m_File.GetSize();
+
+		EnvironmentCacheHeader header;
+		memcpy(&header, data, sizeof(EnvironmentCacheHeader));
+
+		// Anything that changes the bake makes the file stale
+		if (memcmp(header.Magic, s_EnvironmentCacheMagic, sizeof(header.Magic)) != 0 || header.Version != Version
+			|| header.SourceHash != sourceHash || header.RadianceSize != settings.RadianceSize
+			|| header.IrradianceSize != settings.IrradianceSize || (bool)header.IrradianceSH != settings.IrradianceSH
+			|| header.RadianceLevelCount != Utils::GetLevelCount(header.RadianceSize))
+			return;
+
+		uint64_t cursor = s_DataOffset;
+		m_Environment.RadianceSize = header.RadianceSize;
+		for (uint32_t level = 0; level < header.RadianceLevelCount; level++)
+		{
+			uint64_t levelSize = GetLevelSize(header.RadianceSize, level);
+			if (cursor + levelSize > size)
+				return;
+
+			m_Environment.RadianceLevels.push_back(data + cursor);
+			cursor += levelSize;
+		}
+
+		m_Environment.IrradianceSize = header.IrradianceSize;
+		memcpy(m_Environment.IrradianceSH.Coefficients, header.SHCoefficients, sizeof(header.SHCoefficients));
+		if (!header.IrradianceSH)
+		{
+			if (cursor + GetLevelSize(header.IrradianceSize, 0) > size)
+				return;
+
+			m_Environment.Irradiance = data + cursor;
+		}
+
+		m_Valid = true;
+	}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Math/SphericalHarmonics.h"
+#include "Utils/PlatformUtils.h"
+
+#include <filesystem>
+
+namespace Venus {
+
+	// Anything that changes the baked result, part of the cache key
+	struct EnvironmentBakeSettings
+	{
+		uint32_t RadianceSize = 1024;
+		uint32_t IrradianceSize = 32;
+
+		// Stores nine SH coefficients instead of the irradiance cube and skips its convolution
+		bool IrradianceSH = false;
+	};
+
+	// Baked environment, levels are RGBA16F with the six faces packed one after the other
+	struct CookedEnvironment
+	{
+		uint32_t RadianceSize = 0;
+		std::vector<const uint8_t*> RadianceLevels;
+
+		uint32_t IrradianceSize = 0;
+		const uint8_t* Irradiance = nullptr; // Null when the irradiance is stored as SH
+		SphericalHarmonics IrradianceSH;
+	};
+
+	// Baked environments as .vsenv files, keyed by source content hash and bake settings
+	class EnvironmentCache
+	{
+		public:
+			static constexpr uint32_t Version = 1;
+
+			// Zero if the source can't be read
+			static uint64_t HashSource(const std::string& sourcePath);
+			static std::filesystem::path GetCachePath(const std::string& sourcePath);
+
+			// Size of one level with all six faces
+			static uint64_t GetLevelSize(uint32_t size, uint32_t level);
+
+			static bool Write(const std::filesystem::path& path, uint64_t sourceHash, const EnvironmentBakeSettings& settings, const CookedEnvironment& environment);
+
+			// Keeps the file mapped, level data points straight into it
+			class Reader
+			{
+				public:
+					Reader(const std::filesystem::path& path, uint64_t sourceHash, const EnvironmentBakeSettings& settings);
+
+					bool IsValid() const { return m_Valid; }
+					const CookedEnvironment& GetEnvironment() const { return m_Environment; }
+
+				private:
+					MappedFile m_File;
+					CookedEnvironment m_Environment;
+					bool m_Valid = false;
+			};
+	};
+
+}
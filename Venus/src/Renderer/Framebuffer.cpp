@@ -3,6 +3,7 @@
 #include "Renderer/Framebuffer.h"
 #include "Renderer/Renderer.h"
 #include "Renderer/OpenGL/OpenGLFramebuffer.h"
+#include "Renderer/Null/NullFramebuffer.h"
 
 namespace Venus {
 	
@@ -10,7 +11,7 @@ namespace Venus {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateRef<NullFramebuffer>(spec);
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLFramebuffer>(spec);
 		}
 
@@ -13,6 +13,7 @@ namespace Venus {
 		RGBA8,
 		RGBA16F,
 		RGBA32F,
+		R11G11B10F,
 		RED_INTEGER,
 
 		// Depth/stencil
@@ -76,8 +77,11 @@ namespace Venus {
 
 			virtual void Resize(uint32_t width, uint32_t height) = 0;
 			virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) = 0;
+			// Whole normalized or float attachment converted to RGBA8, bottom row first. Stalls until the GPU is done with it
+			virtual void ReadColorAttachment(uint32_t attachmentIndex, void* data, uint32_t size) = 0;
 
 			virtual void ClearAttachment(uint32_t attachmentIndex, int value) = 0;
+			virtual void ClearDepthAttachment(uint32_t layer, float value = 1.0f) = 0;
 
 			virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const = 0;
 			virtual uint32_t GetDepthAttachmentRendererID() const = 0;
@@ -0,0 +1,228 @@
+#include "pch.h"
+#include "GPUProfiler.h"
+
+#include "Renderer/RenderCommand.h"
+#include "Renderer/TimerQuery.h"
+
+namespace Venus {
+
+	struct GPUFrameScope
+	{
+		const char* Name;
+		uint32_t Depth;
+	};
+
+	struct GPUFrameQueries
+	{
+		// Scope i writes queries 2i and 2i + 1 of the frame
+		std::vector<GPUFrameScope> Scopes;
+		uint64_t Index = 0;
+		bool Pending = false;
+
+		// GPU clock and instrumentor ticks sampled together when the frame started
+		uint64_t CalibrationTimestamp = 0;
+		uint64_t CalibrationTicks = 0;
+	};
+
+	struct GPUProfilerData
+	{
+		Ref<TimerQueryPool> Queries;
+		std::array<GPUFrameQueries, GPUProfiler::FramesInFlight> Frames;
+		uint64_t FrameIndex = 0;
+
+		// Scope indices of the current frame, -1 past the query budget
+		std::vector<int32_t> OpenScopes;
+		std::unordered_set<std::string> Names;
+
+		std::vector<GPUScopeTime> ScopeTimes;
+		uint64_t ResultFrame = 0;
+		float FrameTime = 0.0f;
+		uint32_t DroppedFrames = 0;
+
+		ProfileEventBuffer* Track = nullptr;
+		uint64_t StartTicks = 0;
+		std::chrono::steady_clock::time_point StartTime;
+
+		bool Initialized = false;
+	};
+
+	static GPUProfilerData s_GPUData;
+
+	static uint32_t GetFirstQuery(uint32_t frameSlot)
+	{
+		return frameSlot * GPUProfiler::MaxScopesPerFrame * 2;
+	}
+
+	static bool ReadBack(GPUFrameQueries& frame, uint32_t frameSlot)
+	{
+		uint32_t queryCount = (uint32_t)frame.Scopes.size() * 2;
+		uint64_t timestamps[GPUProfiler::MaxScopesPerFrame * 2];
+		if (!s_GPUData.Queries->GetTimestamps(GetFirstQuery(frameSlot), queryCount, timestamps))
+			return false;
+
+		s_GPUData.ScopeTimes.clear();
+		s_GPUData.ResultFrame = frame.Index;
+		s_GPUData.FrameTime = 0.0f;
+		for (uint32_t i = 0; i < (uint32_t)frame.Scopes.size(); i++)
+		{
+			const GPUFrameScope& scope = frame.Scopes[i];
+			float time = (timestamps[i * 2 + 1] - timestamps[i * 2]) / 1000000.0f;
+			s_GPUData.ScopeTimes.push_back({ scope.Name, scope.Depth, time });
+
+			if (scope.Depth == 0)
+				s_GPUData.FrameTime += time;
+		}
+
+	#if VS_PROFILE
+		Instrumentor& instrumentor = Instrumentor::Get();
+		if (instrumentor.IsActive() && frame.CalibrationTicks != 0)
+		{
+			// Tick rate measured since init, the offset comes from the frame's own calibration so drift stays small
+			double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - s_GPUData.StartTime).count();
+			double ticksPerNanosecond = nanoseconds > 0.0 ? (Instrumentor::GetTicks() - s_GPUData.StartTicks) / nanoseconds : 1.0;
+
+			auto toTicks = [&frame, ticksPerNanosecond](uint64_t timestamp)
+			{
+				int64_t nanoseconds = (int64_t)(timestamp - frame.CalibrationTimestamp);
+				return (uint64_t)((int64_t)frame.CalibrationTicks + (int64_t)(nanoseconds * ticksPerNanosecond));
+			};
+
+			for (uint32_t i = 0; i < (uint32_t)frame.Scopes.size(); i++)
+				instrumentor.WriteScope(s_GPUData.Track, frame.Scopes[i].Name, toTicks(timestamps[i * 2]), toTicks(timestamps[i * 2 + 1]));
+
+			VS_PROFILE_COUNTER("GPU Frame (ms)", s_GPUData.FrameTime);
+		}
+	#endif
+
+		return true;
+	}
+
+	void GPUProfiler::Init()
+	{
+		VS_PROFILE_FUNCTION();
+
+		s_GPUData.Queries = TimerQueryPool::Create(FramesInFlight * MaxScopesPerFrame * 2);
+		s_GPUData.Initialized = true;
+
+	#if VS_PROFILE
+		s_GPUData.Track = Instrumentor::Get().CreateTrack("GPU");
+		s_GPUData.StartTicks = Instrumentor::GetTicks();
+		s_GPUData.StartTime = std::chrono::steady_clock::now();
+	#endif
+	}
+
+	void GPUProfiler::Shutdown()
+	{
+		s_GPUData.Initialized = false;
+		s_GPUData.Queries = nullptr;
+		for (auto& frame : s_GPUData.Frames)
+			frame = GPUFrameQueries();
+	}
+
+	void GPUProfiler::NextFrame()
+	{
+		VS_PROFILE_FUNCTION();
+
+		if (!s_GPUData.Initialized)
+			return;
+
+		VS_CORE_ASSERT(s_GPUData.OpenScopes.empty(), "GPU scope still open at the end of the frame!");
+		s_GPUData.OpenScopes.clear();
+
+		uint32_t currentSlot = s_GPUData.FrameIndex % FramesInFlight;
+		s_GPUData.Frames[currentSlot].Pending = !s_GPUData.Frames[currentSlot].Scopes.empty();
+
+		// Oldest first, so the newest finished frame is the one kept. The frame just recorded is left for later
+		for (uint32_t i = 1; i < FramesInFlight; i++)
+		{
+			uint32_t slot = (currentSlot + i) % FramesInFlight;
+			GPUFrameQueries& frame = s_GPUData.Frames[slot];
+			if (frame.Pending && ReadBack(frame, slot))
+				frame.Pending = false;
+		}
+
+		s_GPUData.FrameIndex++;
+		GPUFrameQueries& frame = s_GPUData.Frames[s_GPUData.FrameIndex % FramesInFlight];
+		if (frame.Pending)
+			s_GPUData.DroppedFrames++;
+
+		frame.Scopes.clear();
+		frame.Index = s_GPUData.FrameIndex;
+		frame.Pending = false;
+		frame.CalibrationTicks = 0;
+
+	#if VS_PROFILE
+		if (Instrumentor::Get().IsActive())
+		{
+			frame.CalibrationTimestamp = s_GPUData.Queries->GetCurrentTimestamp();
+			frame.CalibrationTicks = Instrumentor::GetTicks();
+		}
+	#endif
+	}
+
+	void GPUProfiler::BeginScope(const std::string& name)
+	{
+		RenderCommand::PushDebugGroup(name);
+
+		if (!s_GPUData.Initialized)
+			return;
+
+		GPUFrameQueries& frame = s_GPUData.Frames[s_GPUData.FrameIndex % FramesInFlight];
+		if (frame.Scopes.size() == MaxScopesPerFrame)
+		{
+			s_GPUData.OpenScopes.push_back(-1);
+			return;
+		}
+
+		// Names have to outlive the trace, pass names are rebuilt every frame
+		auto it = s_GPUData.Names.find(name);
+		if (it == s_GPUData.Names.end())
+			it = s_GPUData.Names.insert(name).first;
+
+		uint32_t index = (uint32_t)frame.Scopes.size();
+		frame.Scopes.push_back({ it->c_str(), (uint32_t)s_GPUData.OpenScopes.size() });
+		s_GPUData.OpenScopes.push_back((int32_t)index);
+		s_GPUData.Queries->WriteTimestamp(GetFirstQuery(s_GPUData.FrameIndex % FramesInFlight) + index * 2);
+	}
+
+	void GPUProfiler::EndScope()
+	{
+		RenderCommand::PopDebugGroup();
+
+		if (!s_GPUData.Initialized)
+			return;
+
+		VS_CORE_ASSERT(!s_GPUData.OpenScopes.empty(), "No GPU scope to end!");
+		int32_t index = s_GPUData.OpenScopes.back();
+		s_GPUData.OpenScopes.pop_back();
+
+		if (index >= 0)
+			s_GPUData.Queries->WriteTimestamp(GetFirstQuery(s_GPUData.FrameIndex % FramesInFlight) + index * 2 + 1);
+	}
+
+	uint64_t GPUProfiler::GetCurrentFrame()
+	{
+		return s_GPUData.FrameIndex;
+	}
+
+	uint64_t GPUProfiler::GetResultFrame()
+	{
+		return s_GPUData.ResultFrame;
+	}
+
+	const std::vector<GPUScopeTime>& GPUProfiler::GetScopeTimes()
+	{
+		return s_GPUData.ScopeTimes;
+	}
+
+	float GPUProfiler::GetFrameTime()
+	{
+		return s_GPUData.FrameTime;
+	}
+
+	uint32_t GPUProfiler::GetDroppedFrameCount()
+	{
+		return s_GPUData.DroppedFrames;
+	}
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Engine/Base.h"
+
+namespace Venus {
+
+	struct GPUScopeTime
+	{
+		const char* Name; // Kept until shutdown
+		uint32_t Depth;
+		float Time; // ms
+	};
+
+	// Times scopes with GPU timestamps. Each frame writes its own set of queries, read back a few frames later
+	// once the GPU finished them, so the results lag behind but never stall the pipeline
+	class GPUProfiler
+	{
+		public:
+			static constexpr uint32_t FramesInFlight = 3;
+			static constexpr uint32_t MaxScopesPerFrame = 128;
+
+			static void Init();
+			static void Shutdown();
+
+			// Once a frame on the main thread, reads back finished frames and starts a new one
+			static void NextFrame();
+
+			// Scopes nest, each one is also pushed as a debug group
+			static void BeginScope(const std::string& name);
+			static void EndScope();
+
+			// Counted by NextFrame, the results belong to an older frame than the one being recorded
+			static uint64_t GetCurrentFrame();
+			static uint64_t GetResultFrame();
+
+			// Newest frame read back, in the order the scopes began
+			static const std::vector<GPUScopeTime>& GetScopeTimes();
+			// Sum of the outermost scopes, ms
+			static float GetFrameTime();
+			static uint32_t GetDroppedFrameCount();
+	};
+
+	class GPUProfileScope
+	{
+		public:
+			GPUProfileScope(const std::string& name) { GPUProfiler::BeginScope(name); }
+			~GPUProfileScope() { GPUProfiler::EndScope(); }
+	};
+
+}
@@ -3,6 +3,8 @@
 
 #include "Renderer/Renderer.h"
 #include "Renderer/OpenGL/OpenGLContext.h"
+#include "Renderer/OpenGL/OpenGLHeadlessContext.h"
+#include "Renderer/Null/NullContext.h"
 
 namespace Venus {
 
@@ -10,7 +12,7 @@ namespace Venus {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateScope<NullContext>();
 			case RendererAPI::API::OpenGL:  return CreateScope<OpenGLContext>(static_cast<GLFWwindow*>(window));
 		}
 
@@ -18,4 +20,16 @@ namespace Venus {
 		return nullptr;
 	}
 
+	Scope<GraphicsContext> GraphicsContext::CreateHeadless(uint32_t width, uint32_t height)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    return CreateScope<NullContext>();
+			case RendererAPI::API::OpenGL:  return CreateScope<OpenGLHeadlessContext>(width, height);
+		}
+
+		VS_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
 }
\ No newline at end of file
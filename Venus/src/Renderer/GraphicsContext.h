@@ -18,6 +18,8 @@ namespace Venus {
 			virtual void SwapBuffers() = 0;
 
 			static Scope<GraphicsContext> Create(void* window);
+			// Renders offscreen only, nothing is presented
+			static Scope<GraphicsContext> CreateHeadless(uint32_t width, uint32_t height);
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "pch.h"
+#include "Image.h"
+
+#include <stb_image.h>
+
+namespace Venus {
+
+	Image::~Image()
+	{
+		if (m_Data)
+			stbi_image_free(m_Data);
+	}
+
+	Scope<Image> Image::Load(const std::string& path, bool flipVertically)
+	{
+		VS_PROFILE_FUNCTION();
+
+		// stbi's flip flag is global state, rows are flipped here so workers never race on it
+		int width, height, channels;
+		bool isHDR = stbi_is_hdr(path.c_str());
+
+		uint8_t* data = nullptr;
+		if (isHDR)
+			data = (uint8_t*)stbi_loadf(path.c_str(), &width, &height, &channels, 4);
+		else
+			data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+
+		if (!data)
+			return nullptr;
+
+		Scope<Image> image(new Image());
+		image->m_Data = data;
+		image->m_Width = width;
+		image->m_Height = height;
+		image->m_IsHDR = isHDR;
+
+		if (flipVertically)
+		{
+			uint32_t rowSize = image->GetRowSize();
+			std::vector<uint8_t> row(rowSize);
+			for (uint32_t y = 0; y < image->m_Height / 2; y++)
+			{
+				uint8_t* top = data + (uint64_t)y * rowSize;
+				uint8_t* bottom = data + (uint64_t)(image->m_Height - 1 - y) * rowSize;
+				memcpy(row.data(), top, rowSize);
+				memcpy(top, bottom, rowSize);
+				memcpy(bottom, row.data(), rowSize);
+			}
+		}
+
+		return image;
+	}
+
+	bool Image::GetInfo(const std::string& path, uint32_t& width, uint32_t& height, bool& isHDR)
+	{
+		int w, h, channels;
+		if (!stbi_info(path.c_str(), &w, &h, &channels))
+			return false;
+
+		width = w;
+		height = h;
+		isHDR = stbi_is_hdr(path.c_str());
+		return true;
+	}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Engine/Base.h"
+
+#include <string>
+
+namespace Venus {
+
+	// Decoded RGBA pixels, 8 bit per channel or 32 bit float for HDR files. Safe to load from any thread
+	class Image
+	{
+		public:
+			~Image();
+
+			Image(const Image&) = delete;
+			Image& operator=(const Image&) = delete;
+
+			// Null if the file can't be decoded
+			static Scope<Image> Load(const std::string& path, bool flipVertically);
+
+			// Reads only the header
+			static bool GetInfo(const std::string& path, uint32_t& width, uint32_t& height, bool& isHDR);
+
+			uint32_t GetWidth() const { return m_Width; }
+			uint32_t GetHeight() const { return m_Height; }
+			bool IsHDR() const { return m_IsHDR; }
+
+			const uint8_t* GetData() const { return m_Data; }
+			uint32_t GetRowSize() const { return m_Width * (m_IsHDR ? 4 * sizeof(float) : 4); }
+			uint64_t GetSize() const { return (uint64_t)GetRowSize() * m_Height; }
+
+		private:
+			Image() = default;
+
+			uint8_t* m_Data = nullptr;
+			uint32_t m_Width = 0;
+			uint32_t m_Height = 0;
+			bool m_IsHDR = false;
+	};
+
+}
@@ -17,67 +17,77 @@ namespace Venus {
 
 	void Material::Bind()
 	{
-		for (auto& [name, uniform] : m_Uniforms)
+		if (m_UniformBuffer)
 		{
-			switch (uniform.type)
+			if (m_Dirty)
+			{
+				m_UniformBuffer->SetData(m_UniformStorage.data(), (uint32_t)m_UniformStorage.size());
+				m_Dirty = false;
+			}
+
+			m_UniformBuffer->Bind();
+		}
+
+		for (uint32_t binding = 0; binding < MaxTextureSlots; binding++)
+		{
+			const MaterialTexture& texture = m_Textures[binding];
+			switch (texture.Type)
 			{
-				case MaterialType::Int:
-				{
-					m_Shader->SetInt(uniform.name, uniform.intValue);
-					break;
-				}
-				case MaterialType::Float:
-				{
-					m_Shader->SetFloat(uniform.name, uniform.floatValue);
-					break;
-				}
-				case MaterialType::Float2:
-				{
-					m_Shader->SetFloat2(uniform.name, uniform.float2Value);
-					break;
-				}
-				case MaterialType::Float3:
-				{
-					m_Shader->SetFloat3(uniform.name, uniform.float3Value);
-					break;
-				}
-				case MaterialType::Float4:
-				{
-					m_Shader->SetFloat3(uniform.name, uniform.float4Value);
-					break;
-				}
-				case MaterialType::Mat4:
-				{
-					m_Shader->SetMat4(uniform.name, uniform.mat4Value);
-					break;
-				}
 				case MaterialType::Texture:
 				{
-					m_Shader->SetTexture(uniform.name, uniform.intValue, uniform.texture);
+					RenderCommand::BindTexture(binding, texture.RendererID);
+					RenderCommand::BindSampler(binding, texture.SamplerID);
 					break;
 				}
 				case MaterialType::TextureCube:
 				{
-					m_Shader->SetCubeMap(uniform.name, uniform.intValue, uniform.texture);
+					RenderCommand::BindTextureCube(binding, texture.RendererID);
+					RenderCommand::BindSampler(binding, 0);
 					break;
 				}
 				case MaterialType::TextureArray:
 				{
-					m_Shader->SetTextureArray(uniform.name, uniform.intValue, uniform.texture);
+					RenderCommand::BindTextureArray(binding, texture.RendererID);
+					RenderCommand::BindSampler(binding, 0);
 					break;
 				}
 			}
 		}
 	}
 
-	void Material::SetInt(const std::string& name, int value)
+	uint8_t* Material::GetUniformStorage(const std::string& name, uint32_t size)
 	{
-		MaterialUniform uniform;
-		uniform.type = MaterialType::Int;
-		uniform.name = name;
-		uniform.intValue = value;
+		const ShaderBuffer* buffer = m_Shader->GetMaterialBuffer();
+		if (!buffer)
+		{
+			CORE_LOG_WARN("Material: Shader {0} has no material block, uniform {1} ignored", m_Shader->GetName(), name);
+			return nullptr;
+		}
 
-		m_Uniforms[name] = uniform;
+		auto it = buffer->Uniforms.find(Shader::GetUniformID(name));
+		if (it == buffer->Uniforms.end())
+		{
+			CORE_LOG_WARN("Material: Uniform {0} not found in shader {1}", name, m_Shader->GetName());
+			return nullptr;
+		}
+
+		const ShaderUniform& uniform = it->second;
+		VS_CORE_ASSERT(uniform.Size == size, "Material uniform size mismatch!");
+
+		// Storage is created on first use, materials that only hold textures never get a buffer
+		if (m_UniformStorage.empty())
+		{
+			m_UniformStorage.resize(buffer->Size, 0);
+			m_UniformBuffer = UniformBuffer::Create(buffer->Size, Shader::MaterialBufferBinding);
+			m_Dirty = true;
+		}
+
+		return m_UniformStorage.data() + uniform.Offset;
+	}
+
+	void Material::SetInt(const std::string& name, int value)
+	{
+		SetValue(name, value);
 	}
 
 	void Material::SetIntArray(const std::string& name, int* values, uint32_t count)
@@ -87,115 +97,94 @@ namespace Venus {
 
 	void Material::SetFloat(const std::string& name, float value)
 	{
-		MaterialUniform uniform;
-		uniform.type = MaterialType::Float;
-		uniform.name = name;
-		uniform.floatValue = value;
-
-		m_Uniforms[name] = uniform;
+		SetValue(name, value);
 	}
 
 	void Material::SetFloat2(const std::string& name, const glm::vec2& value)
 	{
-		MaterialUniform uniform;
-		uniform.type = MaterialType::Float2;
-		uniform.name = name;
-		uniform.float2Value = value;
-
-		m_Uniforms[name] = uniform;
+		SetValue(name, value);
 	}
 
 	void Material::SetFloat3(const std::string& name, const glm::vec3& value)
 	{
-		MaterialUniform uniform;
-		uniform.type = MaterialType::Float3;
-		uniform.name = name;
-		uniform.float3Value = value;
-
-		m_Uniforms[name] = uniform;
+		SetValue(name, value);
 	}
 
 	void Material::SetFloat4(const std::string& name, const glm::vec4& value)
 	{
-		MaterialUniform uniform;
-		uniform.type = MaterialType::Float4;
-		uniform.name = name;
-		uniform.float4Value = value;
-
-		m_Uniforms[name] = uniform;
+		SetValue(name, value);
 	}
 
 	void Material::SetMat4(const std::string& name, const glm::mat4& value)
 	{
-		MaterialUniform uniform;
-		uniform.type = MaterialType::Mat4;
-		uniform.name = name;
-		uniform.mat4Value = value;
-
-		m_Uniforms[name] = uniform;
+		SetValue(name, value);
 	}
 
 	int& Material::GetInt(const std::string& name)
 	{
-		VS_CORE_ASSERT(Exists(name), "Uniform not found!");
-		return m_Uniforms[name].intValue;
+		return GetValue<int>(name);
 	}
 
 	float& Material::GetFloat(const std::string& name)
 	{
-		VS_CORE_ASSERT(Exists(name), "Uniform not found!");
-		return m_Uniforms[name].floatValue;
+		return GetValue<float>(name);
 	}
 
 	glm::vec3& Material::GetFloat3(const std::string& name)
 	{
-		VS_CORE_ASSERT(Exists(name), "Uniform not found!");
-		return m_Uniforms[name].float3Value;
+		return GetValue<glm::vec3>(name);
 	}
 
-	void Material::SetTexture(const std::string& name, int binding, uint32_t texture)
+	void Material::SetTextureSlot(const std::string& name, int binding, uint32_t texture, uint32_t sampler, MaterialType type)
 	{
-		MaterialUniform uniform;
-		uniform.type = MaterialType::Texture;
-		uniform.name = name;
-		uniform.intValue = binding;
-		uniform.texture = texture;
+		VS_CORE_ASSERT(binding >= 0 && binding < (int)MaxTextureSlots, "Material texture binding out of range!");
+
+		MaterialTexture& slot = m_Textures[binding];
+		slot.ID = Shader::GetUniformID(name);
+		slot.Type = type;
+		slot.RendererID = texture;
+		slot.SamplerID = sampler;
+	}
 
-		m_Uniforms[name] = uniform;
+	void Material::SetTexture(const std::string& name, int binding, uint32_t texture, uint32_t sampler)
+	{
+		SetTextureSlot(name, binding, texture, sampler, MaterialType::Texture);
 	}
 
 	uint32_t Material::GetTexture(const std::string& name)
 	{
-		VS_CORE_ASSERT(Exists(name), "Uniform not found!");
-		return m_Uniforms[name].texture;
+		ShaderUniformID id = Shader::GetUniformID(name);
+		for (const MaterialTexture& texture : m_Textures)
+		{
+			if (texture.Type != MaterialType::None && texture.ID == id)
+				return texture.RendererID;
+		}
+
+		VS_CORE_ASSERT(false, "Uniform not found!");
+		return 0;
 	}
 
 	void Material::SetCubeMap(const std::string& name, int binding, uint32_t texture)
 	{
-		MaterialUniform uniform;
-		uniform.type = MaterialType::TextureCube;
-		uniform.name = name;
-		uniform.intValue = binding;
-		uniform.texture = texture;
-
-		m_Uniforms[name] = uniform;
+		SetTextureSlot(name, binding, texture, 0, MaterialType::TextureCube);
 	}
 
 	void Material::SetTextureArray(const std::string& name, int binding, uint32_t texture)
 	{
-		MaterialUniform uniform;
-		uniform.type = MaterialType::TextureArray;
-		uniform.name = name;
-		uniform.intValue = binding;
-		uniform.texture = texture;
-
-		m_Uniforms[name] = uniform;
+		SetTextureSlot(name, binding, texture, 0, MaterialType::TextureArray);
 	}
 
 	bool Material::Exists(const std::string& name)
 	{
-		return m_Uniforms.find(name) != m_Uniforms.end();
-	}
+		ShaderUniformID id = Shader::GetUniformID(name);
+		for (const MaterialTexture& texture : m_Textures)
+		{
+			if (texture.Type != MaterialType::None && texture.ID == id)
+				return true;
+		}
 
+		const ShaderBuffer* buffer = m_Shader->GetMaterialBuffer();
+		return !m_UniformStorage.empty() && buffer && buffer->Uniforms.find(id) != buffer->Uniforms.end();
+	}
 
-}
\ No newline at end of file
+}
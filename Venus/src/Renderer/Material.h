@@ -2,6 +2,9 @@
 
 #include "Renderer/Shader.h"
 #include "Renderer/Texture.h"
+#include "Renderer/UniformBuffer.h"
+
+#include <array>
 
 namespace Venus {
 
@@ -10,18 +13,12 @@ namespace Venus {
 		None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool, Texture, TextureCube, TextureArray
 	};
 
-	// TODO: use buffer as value
-	struct MaterialUniform
+	struct MaterialTexture
 	{
-		MaterialType type = MaterialType::Int;
-		std::string name = "";
-		int intValue = 0;
-		float floatValue = 0.0f;
-		glm::vec2 float2Value = glm::vec2(0.0f);
-		glm::vec3 float3Value = glm::vec3(0.0f);
-		glm::vec4 float4Value = glm::vec4(0.0f);
-		glm::mat4 mat4Value = glm::mat4(1.0f);
-		uint32_t texture = 0;
+		ShaderUniformID ID = 0;
+		MaterialType Type = MaterialType::None;
+		uint32_t RendererID = 0;
+		uint32_t SamplerID = 0; // Zero samples with the texture's own parameters
 	};
 
 	class Material
@@ -42,25 +39,59 @@ namespace Venus {
 			void SetFloat4(const std::string& name, const glm::vec4& value);
 			void SetMat4(const std::string& name, const glm::mat4& value);
 
+			// References point into the packed buffer, the material is flagged dirty since callers may write through them
 			int& GetInt(const std::string& name);
 			float& GetFloat(const std::string& name);
 			glm::vec3& GetFloat3(const std::string& name);
 
-			void SetTexture(const std::string& name, int binding, uint32_t texture);
+			void SetTexture(const std::string& name, int binding, uint32_t texture, uint32_t sampler = 0);
 			uint32_t GetTexture(const std::string& name);
 
 			void SetCubeMap(const std::string& name, int binding, uint32_t texture);
 			void SetTextureArray(const std::string& name, int binding, uint32_t texture);
 
 			bool Exists(const std::string& name);
-			
+
 			std::string GetShaderName() { return m_Shader->GetName(); }
 
+			static constexpr uint32_t MaxTextureSlots = 8;
+
+		private:
+			uint8_t* GetUniformStorage(const std::string& name, uint32_t size);
+			void SetTextureSlot(const std::string& name, int binding, uint32_t texture, uint32_t sampler, MaterialType type);
+
+			template<typename T>
+			void SetValue(const std::string& name, const T& value)
+			{
+				uint8_t* storage = GetUniformStorage(name, sizeof(T));
+				if (!storage || memcmp(storage, &value, sizeof(T)) == 0)
+					return;
+
+				memcpy(storage, &value, sizeof(T));
+				m_Dirty = true;
+			}
+
+			template<typename T>
+			T& GetValue(const std::string& name)
+			{
+				uint8_t* storage = GetUniformStorage(name, sizeof(T));
+				VS_CORE_ASSERT(storage, "Uniform not found!");
+
+				m_Dirty = true;
+				return *reinterpret_cast<T*>(storage);
+			}
+
 		private:
 			Ref<Shader> m_Shader;
 			std::string m_Name;
 
-			std::unordered_map<std::string, MaterialUniform> m_Uniforms;
+			// std140 image of the shader material block, uploaded on Bind only when dirty
+			std::vector<uint8_t> m_UniformStorage;
+			Ref<UniformBuffer> m_UniformBuffer;
+			bool m_Dirty = false;
+
+			// Indexed by texture binding
+			std::array<MaterialTexture, MaxTextureSlots> m_Textures;
 	};
 
 }
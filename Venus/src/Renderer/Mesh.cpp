@@ -4,10 +4,12 @@
 #include "Engine/Timer.h"
 
 #include "Assets/AssetManager.h"
+#include "Renderer/MeshCache.h"
 
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/Importer.hpp>
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/LogStream.hpp>
 #include <assimp/material.h>
@@ -18,18 +20,27 @@ namespace Venus {
 	// Mesh /////////////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////
 
-	Mesh::Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices, uint32_t materialIndex)
-		: m_Vertices(vertices), m_Indices(indices), m_MaterialIndex(materialIndex)
+	Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, uint32_t materialIndex)
+		: m_VertexCount((uint32_t)vertices.size()), m_IndexCount((uint32_t)indices.size()), m_MaterialIndex(materialIndex)
 	{
-		InitMesh();
+		for (const Vertex& vertex : vertices)
+			m_BoundingBox.Extend(vertex.Position);
+
+		InitMesh(vertices.data(), indices.data());
+	}
+
+	Mesh::Mesh(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, uint32_t materialIndex, const AABB& boundingBox)
+		: m_VertexCount(vertexCount), m_IndexCount(indexCount), m_MaterialIndex(materialIndex), m_BoundingBox(boundingBox)
+	{
+		InitMesh(vertices, indices);
 	}
 
-	void Mesh::InitMesh()
+	void Mesh::InitMesh(const Vertex* vertices, const uint32_t* indices)
 	{
 		m_VertexArray = VertexArray::Create();
-		m_VertexBuffer = VertexBuffer::Create(&m_Vertices[0], m_Vertices.size() * sizeof(Vertex));
+		m_VertexBuffer = VertexBuffer::Create(vertices, m_VertexCount * sizeof(Vertex));
 
-		m_IndexBuffer = IndexBuffer::Create(&m_Indices[0], m_Indices.size());
+		m_IndexBuffer = IndexBuffer::Create(indices, m_IndexCount);
 
 		m_VertexBuffer->SetLayout({
 			{ ShaderDataType::Float3, "a_Position" },
@@ -62,61 +73,48 @@ namespace Venus {
 		LoadModel();
 	}
 
-	void Model::LoadModel()
-	{
-		Timer timer;
-
-		Assimp::Importer importer;
-
-		const uint32_t meshImportFlags =
-			aiProcess_CalcTangentSpace |        // Create binormals/tangents just in case
-			aiProcess_Triangulate |             // Make sure we're triangles
-			aiProcess_SortByPType |             // Split meshes by primitive type
-			aiProcess_GenNormals |              // Make sure we have legit normals
-			aiProcess_GenUVCoords |             // Convert UVs if required 
-	//		aiProcess_OptimizeGraph |
-			aiProcess_OptimizeMeshes |          // Batch draws where possible
-			aiProcess_JoinIdenticalVertices |
-			aiProcess_GlobalScale |             // e.g. convert cm to m for fbx import (and other formats where cm is native)
-			aiProcess_ValidateDataStructure;    // Validation
+	// Part of the cache key, changing it re-imports every model
+	static const uint32_t s_ImportFlags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace;
 
+	// Records the other files an import reads, glTF buffers or OBJ material libraries, so they become part of the cache key
+	class DependencyIOSystem : public Assimp::DefaultIOSystem
+	{
+		public:
+			DependencyIOSystem(const std::string& sourcePath, std::vector<std::string>& dependencies)
+				: m_SourcePath(std::filesystem::absolute(sourcePath).lexically_normal()), m_Dependencies(dependencies) {}
 
-		const uint32_t oldImportFlags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace;
+			using Assimp::DefaultIOSystem::Open;
+			virtual Assimp::IOStream* Open(const char* file, const char* mode = "rb") override
+			{
+				Assimp::IOStream* stream = Assimp::DefaultIOSystem::Open(file, mode);
+				if (!stream)
+					return nullptr;
 
-		const aiScene* scene = importer.ReadFile(m_Path, oldImportFlags);
+				std::string path = std::filesystem::path(file).generic_string();
+				if (std::filesystem::absolute(path).lexically_normal() != m_SourcePath
+					&& std::find(m_Dependencies.begin(), m_Dependencies.end(), path) == m_Dependencies.end())
+					m_Dependencies.push_back(path);
 
-		if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
-			CORE_LOG_ERROR("Failed to load model! : {0}", importer.GetErrorString());
-		else
-		{
-			uint32_t materialCount = scene->mNumMaterials;
-			m_Materials = CreateRef<MaterialTable>(materialCount);
+				return stream;
+			}
 
-			CORE_LOG_TRACE("Loading Model: {0}", m_Path);
-			ProcessNode(scene->mRootNode, scene);
-		}
+		private:
+			std::filesystem::path m_SourcePath;
+			std::vector<std::string>& m_Dependencies;
+	};
 
-		CORE_LOG_WARN("Model {0} loading took: {1} ms", m_Path, timer.ElapsedMillis());
-	}
-
-	void Model::ProcessNode(aiNode* node, const aiScene* scene)
+	struct ImportedMesh
 	{
-		for (uint32_t i = 0; i < node->mNumMeshes; i++)
-		{
-			aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-			m_Meshes.push_back(ProcessMesh(mesh, scene));
-		}
-
-		for (uint32_t i = 0; i < node->mNumChildren; i++)
-		{
-			ProcessNode(node->mChildren[i], scene);
-		}
-	}
+		std::vector<Vertex> Vertices;
+		std::vector<uint32_t> Indices;
+		uint32_t MaterialIndex = 0;
+		AABB BoundingBox;
+	};
 
-	Mesh Model::ProcessMesh(aiMesh* mesh, const aiScene* scene)
+	static ImportedMesh ProcessMesh(aiMesh* mesh)
 	{
-		std::vector<Vertex> vertices;
-		std::vector<uint32_t> indices;
+		ImportedMesh result;
+		result.Vertices.reserve(mesh->mNumVertices);
 
 		// Vertices
 		for (uint32_t i = 0; i < mesh->mNumVertices; i++)
@@ -162,7 +160,8 @@ namespace Venus {
 				vertex.TexCoords = glm::vec2(0.0f, 0.0f);
 			}
 
-			vertices.push_back(vertex);
+			result.Vertices.push_back(vertex);
+			result.BoundingBox.Extend(vertex.Position);
 		}
 
 		// Indices
@@ -171,110 +170,230 @@ namespace Venus {
 			aiFace face = mesh->mFaces[i];
 			for (uint32_t j = 0; j < face.mNumIndices; j++)
 			{
-				indices.push_back(face.mIndices[j]);
+				result.Indices.push_back(face.mIndices[j]);
 			}
 		}
 
-		// Material
-		uint32_t materialIndex = mesh->mMaterialIndex;
-		aiMaterial* material = scene->mMaterials[materialIndex];
+		result.MaterialIndex = mesh->mMaterialIndex;
+		return result;
+	}
 
-		if (!m_Materials->HasMaterial(materialIndex))
+	static void ProcessNode(aiNode* node, const aiScene* scene, std::vector<ImportedMesh>& meshes)
+	{
+		for (uint32_t i = 0; i < node->mNumMeshes; i++)
 		{
-			aiString materialName = material->GetName();
-			CORE_LOG_TRACE("Loading Default Material '{0}' at: {1}", materialName.C_Str(), materialIndex);
+			aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
+			meshes.push_back(ProcessMesh(mesh));
+		}
 
-			Ref<MeshMaterial> meshMaterial = MeshMaterial::Create(materialName.C_Str());
+		for (uint32_t i = 0; i < node->mNumChildren; i++)
+		{
+			ProcessNode(node->mChildren[i], scene, meshes);
+		}
+	}
 
-			aiColor3D aiColor, aiEmission;
-			// Albedo Color
-			if (material->Get(AI_MATKEY_COLOR_DIFFUSE, aiColor) == AI_SUCCESS)
-			{
-				CORE_LOG_TRACE("	Setting Albedo Color : {0},{1},{2} ", aiColor.r, aiColor.g, aiColor.b);
-				meshMaterial->SetAlbedoColor( { aiColor.r, aiColor.g, aiColor.b } );
-			}
-			// Emission
-			if (material->Get(AI_MATKEY_COLOR_EMISSIVE, aiEmission) == AI_SUCCESS)
-			{
-				CORE_LOG_TRACE("	Setting Emission : {0}", aiEmission.r);
-				meshMaterial->SetEmission(aiEmission.r);
-			}
-			float metalness, shininess;
-			// Metalness
-			if (material->Get(AI_MATKEY_REFLECTIVITY, metalness) == AI_SUCCESS)
-			{
-				CORE_LOG_TRACE("	Setting Metalness : {0}", metalness);
-				meshMaterial->SetMetalness(metalness);
-			}
-			// Roughness
-			if (material->Get(AI_MATKEY_SHININESS, shininess) == AI_SUCCESS)
+	static CookedMaterial ProcessMaterial(uint32_t materialIndex, aiMaterial* material)
+	{
+		CookedMaterial result;
+		result.Index = materialIndex;
+		result.Name = material->GetName().C_Str();
+
+		aiColor3D aiColor, aiEmission;
+		// Albedo Color
+		if (material->Get(AI_MATKEY_COLOR_DIFFUSE, aiColor) == AI_SUCCESS)
+		{
+			result.Flags |= CookedMaterial::HasAlbedoColor;
+			result.AlbedoColor = { aiColor.r, aiColor.g, aiColor.b };
+		}
+		// Emission
+		if (material->Get(AI_MATKEY_COLOR_EMISSIVE, aiEmission) == AI_SUCCESS)
+		{
+			result.Flags |= CookedMaterial::HasEmission;
+			result.Emission = aiEmission.r;
+		}
+		float metalness, shininess;
+		// Metalness
+		if (material->Get(AI_MATKEY_REFLECTIVITY, metalness) == AI_SUCCESS)
+		{
+			result.Flags |= CookedMaterial::HasMetalness;
+			result.Metalness = metalness;
+		}
+		// Roughness
+		if (material->Get(AI_MATKEY_SHININESS, shininess) == AI_SUCCESS)
+		{
+			float roughness = 1.0f - glm::sqrt(shininess / 100.0f);
+			if (roughness < 0)
+				roughness = 0;
+
+			result.Flags |= CookedMaterial::HasRoughness;
+			result.Roughness = roughness;
+		}
+
+		aiString aiTexPath;
+		// Albedo Map
+		if (material->GetTexture(aiTextureType_DIFFUSE, 0, &aiTexPath) == AI_SUCCESS)
+			result.AlbedoMap = aiTexPath.C_Str();
+		// Normal Map 
+		bool hasNormalMap = material->GetTexture(aiTextureType_NORMALS, 0, &aiTexPath) == AI_SUCCESS ||
+							material->GetTexture(aiTextureType_DISPLACEMENT, 0, &aiTexPath) == AI_SUCCESS ||
+							material->GetTexture(aiTextureType_HEIGHT, 0, &aiTexPath) == AI_SUCCESS;
+		if (hasNormalMap)
+			result.NormalMap = aiTexPath.C_Str();
+		// Roughness Map
+		if (material->GetTexture(aiTextureType_SHININESS, 0, &aiTexPath) == AI_SUCCESS)
+			result.RoughnessMap = aiTexPath.C_Str();
+
+		//TODO: Metalness
+
+		return result;
+	}
+
+	void Model::LoadModel()
+	{
+		Timer timer;
+
+		// Cooked data skips Assimp entirely and uploads straight from the mapped file
+		uint64_t sourceHash = MeshCache::HashSource(m_Path);
+		if (sourceHash)
+		{
+			MeshCache::Reader reader(MeshCache::GetCachePath(m_Path), sourceHash, s_ImportFlags);
+			if (reader.IsValid())
 			{
-				float roughness = 1.0f - glm::sqrt(shininess / 100.0f);
-				if (roughness < 0)
-					roughness = 0;
-				CORE_LOG_TRACE("	Setting Roughness : {0}", roughness);
-				meshMaterial->SetRoughtness(roughness);
+				CORE_LOG_TRACE("Loading Cooked Model: {0}", m_Path);
+				BuildModel(reader.GetModel());
+				CORE_LOG_WARN("Model {0} loading took: {1} ms", m_Path, timer.ElapsedMillis());
+				return;
 			}
+		}
 
-			aiString aiTexPath;
-			// Albedo Map
-			bool hasAlbedoMap = material->GetTexture(aiTextureType_DIFFUSE, 0, &aiTexPath) == AI_SUCCESS;
-			if (hasAlbedoMap)
-			{
-				CORE_LOG_TRACE("	Loading Albedo Map : {0}", aiTexPath.C_Str());
+		ImportModel(sourceHash);
 
-				std::filesystem::path modelPath = std::filesystem::path(m_Path).parent_path();
-				std::string finalTexPath = modelPath.string() + "/" + aiTexPath.C_Str();
+		CORE_LOG_WARN("Model {0} loading took: {1} ms", m_Path, timer.ElapsedMillis());
+	}
 
-				Ref<Texture2D> texture = AssetManager::GetAsset<Texture2D>(finalTexPath);
+	void Model::ImportModel(uint64_t sourceHash)
+	{
+		CookedModel cooked;
 
-				if (texture && texture->IsLoaded())
-				{
-					TextureProperties props;
-					props.Format = TextureFormat::SRGB;
-					texture->SetProperties(props, true);
-					meshMaterial->SetAlbedoMap(texture);
-				}
-			}
-			// Normal Map 
-			bool hasNormalMap = material->GetTexture(aiTextureType_NORMALS, 0, &aiTexPath) == AI_SUCCESS ||
-								material->GetTexture(aiTextureType_DISPLACEMENT, 0, &aiTexPath) == AI_SUCCESS ||
-								material->GetTexture(aiTextureType_HEIGHT, 0, &aiTexPath) == AI_SUCCESS;
-			if (hasNormalMap)
-			{
-				CORE_LOG_TRACE("	Loading Normal Map : {0}", aiTexPath.C_Str());
+		// Owned and deleted by the importer
+		Assimp::Importer importer;
+		importer.SetIOHandler(new DependencyIOSystem(m_Path, cooked.Dependencies));
 
-				std::filesystem::path modelPath = std::filesystem::path(m_Path).parent_path();
-				std::string finalTexPath = modelPath.string() + "/" + aiTexPath.C_Str();
+		const aiScene* scene = importer.ReadFile(m_Path, s_ImportFlags);
 
-				Ref<Texture2D> texture = AssetManager::GetAsset<Texture2D>(finalTexPath);
-				if (texture && texture->IsLoaded())
-					meshMaterial->SetNormalMap(texture);
-			}
-			// Roughness Map
-			bool hasRoughnessMap = material->GetTexture(aiTextureType_SHININESS, 0, &aiTexPath) == AI_SUCCESS;
-			if (hasRoughnessMap)
-			{
-				CORE_LOG_TRACE("	Loading Roughness Map : {0}", aiTexPath.C_Str());
+		if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+		{
+			CORE_LOG_ERROR("Failed to load model! : {0}", importer.GetErrorString());
+			return;
+		}
+
+		CORE_LOG_TRACE("Loading Model: {0}", m_Path);
+
+		std::vector<ImportedMesh> meshes;
+		ProcessNode(scene->mRootNode, scene, meshes);
+
+		cooked.MaterialSlotCount = scene->mNumMaterials;
 
-				std::filesystem::path modelPath = std::filesystem::path(m_Path).parent_path();
-				std::string finalTexPath = modelPath.string() + "/" + aiTexPath.C_Str();
+		// Only materials some mesh uses are created
+		std::unordered_set<uint32_t> usedMaterials;
+		for (const ImportedMesh& mesh : meshes)
+		{
+			cooked.Meshes.push_back({ mesh.Vertices.data(), (uint32_t)mesh.Vertices.size(), mesh.Indices.data(), (uint32_t)mesh.Indices.size(), mesh.MaterialIndex, mesh.BoundingBox });
+			cooked.BoundingBox.Extend(mesh.BoundingBox);
+
+			if (usedMaterials.insert(mesh.MaterialIndex).second)
+				cooked.Materials.push_back(ProcessMaterial(mesh.MaterialIndex, scene->mMaterials[mesh.MaterialIndex]));
+		}
+
+		if (sourceHash)
+			MeshCache::Write(MeshCache::GetCachePath(m_Path), sourceHash, s_ImportFlags, cooked);
 
-				Ref<Texture2D> texture = AssetManager::GetAsset<Texture2D>(finalTexPath);
-				if (texture && texture->IsLoaded())
-					meshMaterial->SetRoughnessMap(texture);
+		BuildModel(cooked);
+	}
+
+	void Model::BuildModel(const CookedModel& cooked)
+	{
+		m_Materials = CreateRef<MaterialTable>(cooked.MaterialSlotCount);
+		for (const CookedMaterial& material : cooked.Materials)
+			m_Materials->SetMaterial(material.Index, CreateMaterial(material));
+
+		m_Meshes.reserve(cooked.Meshes.size());
+		for (const CookedMesh& mesh : cooked.Meshes)
+			m_Meshes.emplace_back(mesh.Vertices, mesh.VertexCount, mesh.Indices, mesh.IndexCount, mesh.MaterialIndex, mesh.BoundingBox);
+
+		m_BoundingBox = cooked.BoundingBox;
+	}
+
+	Ref<MeshMaterial> Model::CreateMaterial(const CookedMaterial& cooked)
+	{
+		CORE_LOG_TRACE("Loading Default Material '{0}' at: {1}", cooked.Name, cooked.Index);
+
+		Ref<MeshMaterial> meshMaterial = MeshMaterial::Create(cooked.Name);
+
+		if (cooked.Flags & CookedMaterial::HasAlbedoColor)
+		{
+			CORE_LOG_TRACE("	Setting Albedo Color : {0},{1},{2} ", cooked.AlbedoColor.r, cooked.AlbedoColor.g, cooked.AlbedoColor.b);
+			meshMaterial->SetAlbedoColor(cooked.AlbedoColor);
+		}
+		if (cooked.Flags & CookedMaterial::HasEmission)
+		{
+			CORE_LOG_TRACE("	Setting Emission : {0}", cooked.Emission);
+			meshMaterial->SetEmission(cooked.Emission);
+		}
+		if (cooked.Flags & CookedMaterial::HasMetalness)
+		{
+			CORE_LOG_TRACE("	Setting Metalness : {0}", cooked.Metalness);
+			meshMaterial->SetMetalness(cooked.Metalness);
+		}
+		if (cooked.Flags & CookedMaterial::HasRoughness)
+		{
+			CORE_LOG_TRACE("	Setting Roughness : {0}", cooked.Roughness);
+			meshMaterial->SetRoughtness(cooked.Roughness);
+		}
+
+		std::filesystem::path modelPath = std::filesystem::path(m_Path).parent_path();
+
+		// Albedo Map
+		if (!cooked.AlbedoMap.empty())
+		{
+			CORE_LOG_TRACE("	Loading Albedo Map : {0}", cooked.AlbedoMap);
+
+			Ref<Texture2D> texture = AssetManager::GetAsset<Texture2D>(modelPath.string() + "/" + cooked.AlbedoMap);
+			if (texture && texture->IsLoaded())
+			{
+				TextureProperties props;
+				props.Format = TextureFormat::SRGB;
+				texture->SetProperties(props, true);
+				meshMaterial->SetAlbedoMap(texture);
 			}
-			
-			//TODO: Metalness
+		}
+		// Normal Map 
+		if (!cooked.NormalMap.empty())
+		{
+			CORE_LOG_TRACE("	Loading Normal Map : {0}", cooked.NormalMap);
 
-			m_Materials->SetMaterial(materialIndex, meshMaterial);
+			Ref<Texture2D> texture = AssetManager::GetAsset<Texture2D>(modelPath.string() + "/" + cooked.NormalMap);
+			if (texture && texture->IsLoaded())
+				meshMaterial->SetNormalMap(texture);
 		}
-		else
+		// Roughness Map
+		if (!cooked.RoughnessMap.empty())
 		{
-			//CORE_LOG_TRACE("Default Material already loaded {0}", materialIndex);
+			CORE_LOG_TRACE("	Loading Roughness Map : {0}", cooked.RoughnessMap);
+
+			Ref<Texture2D> texture = AssetManager::GetAsset<Texture2D>(modelPath.string() + "/" + cooked.RoughnessMap);
+			if (texture && texture->IsLoaded())
+				meshMaterial->SetRoughnessMap(texture);
 		}
-			
-		return Mesh(vertices, indices, materialIndex);
+
+		return meshMaterial;
+	}
+
+	void Model::CalculateBoundingBox()
+	{
+		m_BoundingBox = AABB();
+		for (const auto& mesh : m_Meshes)
+			m_BoundingBox.Extend(mesh.m_BoundingBox);
 	}
 
 	void Model::LogMeshStatistics(const aiScene* scene)
@@ -285,8 +404,8 @@ namespace Venus {
 		uint32_t totalIndices = 0;
 		for (const auto& mesh : m_Meshes)
 		{
-			totalVertices += mesh.m_Vertices.size();
-			totalIndices += mesh.m_Indices.size();
+			totalVertices += mesh.m_VertexCount;
+			totalIndices += mesh.m_IndexCount;
 		}
 
 		CORE_LOG_TRACE("Total Vertices: {0}", totalVertices);
@@ -7,6 +7,8 @@
 #include "Renderer/VertexArray.h"
 #include "Renderer/MeshMaterial.h"
 
+#include "Math/AABB.h"
+
 struct aiNode;
 struct aiMesh;
 struct aiMaterial;
@@ -16,6 +18,9 @@ struct aiScene;
 
 namespace Venus {
 
+	struct CookedMaterial;
+	struct CookedModel;
+
 	struct Vertex
 	{
 		glm::vec3 Position;
@@ -28,14 +33,22 @@ namespace Venus {
 	class Mesh
 	{
 		public:
-			Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices, uint32_t materialIndex);
+			Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, uint32_t materialIndex);
+			// Data is only read during construction, it may live in a mapped file
+			Mesh(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, uint32_t materialIndex, const AABB& boundingBox);
+
+			uint32_t GetMaterialIndex() const { return m_MaterialIndex; }
+			const AABB& GetBoundingBox() const { return m_BoundingBox; }
+			uint32_t GetVertexCount() const { return m_VertexCount; }
+			uint32_t GetIndexCount() const { return m_IndexCount; }
 
 		private:
-			void InitMesh();
+			void InitMesh(const Vertex* vertices, const uint32_t* indices);
 
-			std::vector<Vertex> m_Vertices;
-			std::vector<uint32_t> m_Indices;
+			uint32_t m_VertexCount;
+			uint32_t m_IndexCount;
 			uint32_t m_MaterialIndex;
+			AABB m_BoundingBox;
 			
 			Ref<VertexArray> m_VertexArray;
 			Ref<VertexBuffer> m_VertexBuffer;
@@ -55,18 +68,22 @@ namespace Venus {
 			void LogMeshStatistics(const aiScene* scene);
 			Ref<MaterialTable> GetMaterialTable() const { return m_Materials; }
 			const std::vector<Mesh>& GetMeshs() const { return m_Meshes; }
+			const AABB& GetBoundingBox() const { return m_BoundingBox; }
 
 			static AssetType GetStaticType() { return AssetType::Model; }
 			virtual AssetType GetAssetType() const override { return GetStaticType(); }
 
 		private:
 			void LoadModel();
+			void ImportModel(uint64_t sourceHash);
+			void BuildModel(const CookedModel& cooked);
+			Ref<MeshMaterial> CreateMaterial(const CookedMaterial& cooked);
 
-			void ProcessNode(aiNode* node, const aiScene* scene);
-			Mesh ProcessMesh(aiMesh* mesh, const aiScene* scene);
+			void CalculateBoundingBox();
 
 			std::vector<Mesh> m_Meshes;
 			Ref<MaterialTable> m_Materials;
+			AABB m_BoundingBox;
 			
 			std::string m_Path;
 
@@ -0,0 +1,277 @@
+#include "pch.h"
+#include "MeshCache.h"
+
+#include "Utils/Hash.h"
+
+namespace Venus {
+
+	namespace Utils {
+
+		static const char* GetMeshCacheDirectory()
+		{
+			return "Resources/Cache/Mesh";
+		}
+
+		static void CreateMeshCacheDirectoryIfNeeded()
+		{
+			std::string cacheDirectory = GetMeshCacheDirectory();
+			if (!std::filesystem::exists(cacheDirectory))
+				std::filesystem::create_directories(cacheDirectory);
+		}
+
+	}
+
+	// Layout: header, dependencies, mesh table, materials, then 16 byte aligned vertex and index blobs
+	struct MeshCacheHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t SourceHash;
+		uint32_t ImportFlags;
+		uint32_t VertexStride;
+		uint32_t MaterialSlotCount;
+		uint32_t MaterialCount;
+		uint32_t MeshCount;
+		uint32_t DependencyCount;
+		AABB BoundingBox;
+	};
+
+	struct MeshCacheEntry
+	{
+		uint64_t VertexOffset;
+		uint64_t IndexOffset;
+		uint32_t VertexCount;
+		uint32_t IndexCount;
+		uint32_t MaterialIndex;
+		uint32_t Padding;
+		AABB BoundingBox;
+	};
+
+	static constexpr char s_MeshCacheMagic[4] = { 'V', 'S', 'M', 'S' };
+	static constexpr uint64_t s_MeshCacheAlignment = 16;
+
+	uint64_t MeshCache::HashSource(const std::string& sourcePath)
+	{
+		VS_PROFILE_FUNCTION();
+
+		MappedFile source(sourcePath);
+		if (!source.IsValid())
+			return 0;
+
+		return Hash::GenerateFNVHash64(source.GetData(), source.GetSize());
+	}
+
+	std::filesystem::path MeshCache::GetCachePath(const std::string& sourcePath)
+	{
+		// Path hash keeps equally named models from different folders apart
+		std::filesystem::path path = sourcePath;
+		uint32_t pathHash = Hash::GenerateFNVHash(std::filesystem::absolute(path).generic_string());
+
+		std::stringstream name;
+		name << path.stem().string() << "_" << std::hex << pathHash << ".vsmesh";
+
+		return std::filesystem::path(Utils::GetMeshCacheDirectory()) / name.str();
+	}
+
+	bool MeshCache::Write(const std::filesystem::path& path, uint64_t sourceHash, uint32_t importFlags, const CookedModel& model)
+	{
+		VS_PROFILE_FUNCTION();
+
+		std::vector<uint8_t> buffer;
+		auto write = [&buffer](const void* data, uint64_t size)
+		{
+			const uint8_t* bytes = (const uint8_t*)data;
+			buffer.insert(buffer.end(), bytes, bytes + size);
+		};
+		auto writeString = [&write](const std::string& string)
+		{
+			uint32_t length = (uint32_t)string.size();
+			write(&length, sizeof(uint32_t));
+			write(string.data(), length);
+		};
+		auto align = [&buffer]()
+		{
+			buffer.resize((buffer.size() + s_MeshCacheAlignment - 1) & ~(s_MeshCacheAlignment - 1), 0);
+		};
+
+		MeshCacheHeader header = {};
+		memcpy(header.Magic, s_MeshCacheMagic, sizeof(header.Magic));
+		header.Version = Version;
+		header.SourceHash = sourceHash;
+		header.ImportFlags = importFlags;
+		header.VertexStride = sizeof(Vertex);
+		header.MaterialSlotCount = model.MaterialSlotCount;
+		header.MaterialCount = (uint32_t)model.Materials.size();
+		header.MeshCount = (uint32_t)model.Meshes.size();
+		header.DependencyCount = (uint32_t)model.Dependencies.size();
+		header.BoundingBox = model.BoundingBox;
+		write(&header, sizeof(MeshCacheHeader));
+
+		for (const std::string& dependency : model.Dependencies)
+		{
+			uint64_t dependencyHash = HashSource(dependency);
+			writeString(dependency);
+			write(&dependencyHash, sizeof(uint64_t));
+		}
+
+		// Offsets are patched once the blobs are placed
+		uint64_t entriesOffset = buffer.size();
+		buffer.resize(buffer.size() + model.Meshes.size() * sizeof(MeshCacheEntry), 0);
+
+		for (const CookedMaterial& material : model.Materials)
+		{
+			write(&material.Index, sizeof(uint32_t));
+			write(&material.Flags, sizeof(uint32_t));
+			write(&material.AlbedoColor, sizeof(glm::vec3));
+			write(&material.Emission, sizeof(float));
+			write(&material.Metalness, sizeof(float));
+			write(&material.Roughness, sizeof(float));
+			writeString(material.Name);
+			writeString(material.AlbedoMap);
+			writeString(material.NormalMap);
+			writeString(material.RoughnessMap);
+		}
+
+		for (size_t i = 0; i < model.Meshes.size(); i++)
+		{
+			const CookedMesh& mesh = model.Meshes[i];
+
+			MeshCacheEntry entry = {};
+			entry.VertexCount = mesh.VertexCount;
+			entry.IndexCount = mesh.IndexCount;
+			entry.MaterialIndex = mesh.MaterialIndex;
+			entry.BoundingBox = mesh.BoundingBox;
+
+			align();
+			entry.VertexOffset = buffer.size();
+			write(mesh.Vertices, (uint64_t)mesh.VertexCount * sizeof(Vertex));
+
+			align();
+			entry.IndexOffset = buffer.size();
+			write(mesh.Indices, (uint64_t)mesh.IndexCount * sizeof(uint32_t));
+
+			memcpy(buffer.data() + entriesOffset + i * sizeof(MeshCacheEntry), &entry, sizeof(MeshCacheEntry));
+		}
+
+		Utils::CreateMeshCacheDirectoryIfNeeded();
+
+		// Written next to the target first so a crash never leaves a torn cache behind
+		std::filesystem::path tempPath = path;
+		tempPath += ".tmp";
+
+		std::ofstream out(tempPath, std::ios::out | std::ios::binary);
+		if (!out.is_open())
+		{
+			CORE_LOG_WARN("MeshCache: Could not write {0}", path.string());
+			return false;
+		}
+
+		out.write((const char*)buffer.data(), buffer.size());
+		out.close();
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, path, error);
+		if (error)
+		{
+			CORE_LOG_WARN("MeshCache: Could not write {0}: {1}", path.string(), error.message());
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+
+		return true;
+	}
+
+	MeshCache::Reader::Reader(const std::filesystem::path& path, uint64_t sourceHash, uint32_t importFlags)
+		: m_File(path)
+	{
+		VS_PROFILE_FUNCTION();
+
+		if (!m_File.IsValid() || m_File.GetSize() < sizeof(MeshCacheHeader))
+			return;
+
+		const uint8_t* data = m_File.GetData();
+		const uint64_t size = m_File.GetSize();
+
+		MeshCacheHeader header;
+		memcpy(&header, data, sizeof(MeshCacheHeader));
+
+		// Anything that changes the cooked output makes the file stale
+		if (memcmp(header.Magic, s_MeshCacheMagic, sizeof(header.Magic)) != 0 || header.Version != Version
+			|| header.SourceHash != sourceHash || header.ImportFlags != importFlags || header.VertexStride != sizeof(Vertex))
+			return;
+
+		uint64_t cursor = sizeof(MeshCacheHeader);
+		auto read = [&](void* dst, uint64_t count)
+		{
+			if (cursor + count > size)
+				return false;
+
+			memcpy(dst, data + cursor, count);
+			cursor += count;
+			return true;
+		};
+		auto readString = [&](std::string& string)
+		{
+			uint32_t length = 0;
+			if (!read(&length, sizeof(uint32_t)) || cursor + length > size)
+				return false;
+
+			string.assign((const char*)data + cursor, length);
+			cursor += length;
+			return true;
+		};
+
+		// An edited glTF buffer or OBJ material library makes the file stale too
+		for (uint32_t i = 0; i < header.DependencyCount; i++)
+		{
+			std::string dependency;
+			uint64_t dependencyHash = 0;
+			if (!readString(dependency) || !read(&dependencyHash, sizeof(uint64_t)) || HashSource(dependency) != dependencyHash)
+				return;
+		}
+
+		// Counts are checked against the file before anything is sized from them
+		if ((uint64_t)header.MeshCount * sizeof(MeshCacheEntry) > size - cursor || header.MaterialCount > size - cursor)
+			return;
+
+		std::vector<MeshCacheEntry> entries(header.MeshCount);
+		if (!read(entries.data(), entries.size() * sizeof(MeshCacheEntry)))
+			return;
+
+		m_Model.MaterialSlotCount = header.MaterialSlotCount;
+		m_Model.BoundingBox = header.BoundingBox;
+
+		m_Model.Materials.resize(header.MaterialCount);
+		for (CookedMaterial& material : m_Model.Materials)
+		{
+			bool valid = read(&material.Index, sizeof(uint32_t)) && read(&material.Flags, sizeof(uint32_t))
+				&& read(&material.AlbedoColor, sizeof(glm::vec3)) && read(&material.Emission, sizeof(float))
+				&& read(&material.Metalness, sizeof(float)) && read(&material.Roughness, sizeof(float))
+				&& readString(material.Name) && readString(material.AlbedoMap)
+				&& readString(material.NormalMap) && readString(material.RoughnessMap);
+
+			if (!valid)
+				return;
+		}
+
+		m_Model.Meshes.reserve(entries.size());
+		for (const MeshCacheEntry& entry : entries)
+		{
+			uint64_t vertexSize = (uint64_t)entry.VertexCount * sizeof(Vertex);
+			uint64_t indexSize = (uint64_t)entry.IndexCount * sizeof(uint32_t);
+			if (entry.VertexOffset + vertexSize > size || entry.IndexOffset + indexSize > size)
+				return;
+
+			CookedMesh& mesh = m_Model.Meshes.emplace_back();
+			mesh.Vertices = (const Vertex*)(data + entry.VertexOffset);
+			mesh.VertexCount = entry.VertexCount;
+			mesh.Indices = (const uint32_t*)(data + entry.IndexOffset);
+			mesh.IndexCount = entry.IndexCount;
+			mesh.MaterialIndex = entry.MaterialIndex;
+			mesh.BoundingBox = entry.BoundingBox;
+		}
+
+		m_Valid = true;
+	}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Renderer/Mesh.h"
+#include "Utils/PlatformUtils.h"
+
+#include <filesystem>
+
+namespace Venus {
+
+	// Material parameters as found in the source file, texture paths are relative to it
+	struct CookedMaterial
+	{
+		enum : uint32_t
+		{
+			HasAlbedoColor = 1 << 0,
+			HasEmission = 1 << 1,
+			HasMetalness = 1 << 2,
+			HasRoughness = 1 << 3
+		};
+
+		uint32_t Index = 0;
+		uint32_t Flags = 0;
+		glm::vec3 AlbedoColor = glm::vec3(1.0f);
+		float Emission = 0.0f;
+		float Metalness = 0.0f;
+		float Roughness = 1.0f;
+
+		std::string Name;
+		std::string AlbedoMap;
+		std::string NormalMap;
+		std::string RoughnessMap;
+	};
+
+	struct CookedMesh
+	{
+		const Vertex* Vertices = nullptr;
+		uint32_t VertexCount = 0;
+		const uint32_t* Indices = nullptr;
+		uint32_t IndexCount = 0;
+		uint32_t MaterialIndex = 0;
+		AABB BoundingBox;
+	};
+
+	struct CookedModel
+	{
+		uint32_t MaterialSlotCount = 0;
+		std::vector<CookedMaterial> Materials;
+		std::vector<CookedMesh> Meshes;
+		AABB BoundingBox;
+
+		// Files read by the import besides the source, hashed into the cache when written. Empty when read back
+		std::vector<std::string> Dependencies;
+	};
+
+	// Imported models cooked to .vsmesh files, keyed by source content hash, import flags and the hashes of the files the import depends on
+	class MeshCache
+	{
+		public:
+			static constexpr uint32_t Version = 2;
+
+			// Zero if the source can't be read
+			static uint64_t HashSource(const std::string& sourcePath);
+			static std::filesystem::path GetCachePath(const std::string& sourcePath);
+
+			static bool Write(const std::filesystem::path& path, uint64_t sourceHash, uint32_t importFlags, const CookedModel& model);
+
+			// Keeps the file mapped, mesh data points straight into it
+			class Reader
+			{
+				public:
+					Reader(const std::filesystem::path& path, uint64_t sourceHash, uint32_t importFlags);
+
+					bool IsValid() const { return m_Valid; }
+					const CookedModel& GetModel() const { return m_Model; }
+
+				private:
+					MappedFile m_File;
+					CookedModel m_Model;
+					bool m_Valid = false;
+			};
+	};
+
+}
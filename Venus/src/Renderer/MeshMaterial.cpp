@@ -23,6 +23,21 @@ namespace Venus {
 	static const uint32_t s_MetalnessMapBinding = 2;
 	static const uint32_t s_RoughnessMapBinding = 3;
 
+	namespace Utils {
+
+		// The slot a texture is bound to decides what its cooked copy keeps, the PBR shader reads normals from RG and masks from R
+		static void SetTextureUsage(const Ref<Texture2D>& texture, TextureUsage usage)
+		{
+			if (texture == Renderer::GetDefaultTexture() || texture->GetProperties().Usage == usage)
+				return;
+
+			TextureProperties props = texture->GetProperties();
+			props.Usage = usage;
+			texture->SetProperties(props, true);
+		}
+
+	}
+
 	/////////////////////////////////////////////////////////////////////////////
 	// MESH MATERIAL ////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////
@@ -116,6 +131,8 @@ namespace Venus {
 
 	void MeshMaterial::SetAlbedoMap(Ref<Texture2D> texture)
 	{
+		Utils::SetTextureUsage(texture, TextureUsage::Color);
+
 		m_AlbedoMapTexture = texture;
 		m_Material->SetTexture(s_AlbedoMapUniform, s_AlbedoMapBinding, texture->GetRendererID());
 	}
@@ -133,6 +150,8 @@ namespace Venus {
 
 	void MeshMaterial::SetNormalMap(Ref<Texture2D> texture)
 	{
+		Utils::SetTextureUsage(texture, TextureUsage::Normal);
+
 		m_NormalMapTexture = texture;
 		m_Material->SetTexture(s_NormalMapUniform, s_NormalMapBinding, texture->GetRendererID());
 	}
@@ -151,6 +170,8 @@ namespace Venus {
 
 	void MeshMaterial::SetMetalnessMap(Ref<Texture2D> texture)
 	{
+		Utils::SetTextureUsage(texture, TextureUsage::Mask);
+
 		m_MetalnessMapTexture = texture;
 		m_Material->SetTexture(s_MetalnessMapUniform, s_MetalnessMapBinding, texture->GetRendererID());
 	}
@@ -168,6 +189,8 @@ namespace Venus {
 
 	void MeshMaterial::SetRoughnessMap(Ref<Texture2D> texture)
 	{
+		Utils::SetTextureUsage(texture, TextureUsage::Mask);
+
 		m_RoughnessMapTexture = texture;
 		m_Material->SetTexture(s_RoughnessMapUniform, s_RoughnessMapBinding, texture->GetRendererID());
 	}
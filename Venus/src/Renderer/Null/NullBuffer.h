@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Renderer/Buffer.h"
+
+namespace Venus {
+
+	class NullVertexBuffer : public VertexBuffer
+	{
+		public:
+			// Zero for ring backed buffers, which are never written through SetData
+			NullVertexBuffer(uint32_t size)
+				: m_Size(size) {}
+
+			virtual void Bind() const override {}
+			virtual void Unbind() const override {}
+
+			// Same overflow the OpenGL buffer would hit, caught in headless runs too
+			virtual void SetData(const void* data, uint32_t size) override { VS_CORE_ASSERT(size <= m_Size, "Vertex data doesn't fit the buffer!"); }
+
+			virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+			virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+		private:
+			uint32_t m_Size = 0;
+			BufferLayout m_Layout;
+	};
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+		public:
+			NullIndexBuffer(uint32_t count)
+				: m_Count(count) {}
+
+			virtual void Bind() const override {}
+			virtual void Unbind() const override {}
+
+			virtual uint32_t GetCount() const override { return m_Count; }
+
+		private:
+			uint32_t m_Count;
+	};
+
+}
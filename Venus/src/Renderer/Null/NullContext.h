@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Renderer/GraphicsContext.h"
+
+namespace Venus {
+
+	class NullContext : public GraphicsContext
+	{
+		public:
+			virtual void Init() override {}
+			virtual void SwapBuffers() override {}
+	};
+
+}
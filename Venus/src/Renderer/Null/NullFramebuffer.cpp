@@ -0,0 +1,74 @@
+#include "pch.h"
+#include "NullFramebuffer.h"
+
+#include "Renderer/Null/NullRendererAPI.h"
+
+namespace Venus {
+
+	namespace Utils {
+
+		static bool IsDepthFormat(FramebufferTextureFormat format)
+		{
+			switch (format)
+			{
+				case FramebufferTextureFormat::DEPTH24STENCIL8:		return true;
+				case FramebufferTextureFormat::DEPTH32FSTENCIL8:	return true;
+				case FramebufferTextureFormat::DEPTH24:				return true;
+				case FramebufferTextureFormat::DEPTH32F:			return true;
+				case FramebufferTextureFormat::STENCIL8:			return true;
+			}
+
+			return false;
+		}
+
+	}
+
+	NullFramebuffer::NullFramebuffer(const FramebufferSpecification& spec)
+		: m_Specification(spec)
+	{
+		Invalidate();
+	}
+
+	void NullFramebuffer::Resize(uint32_t width, uint32_t height)
+	{
+		if (width == 0 || height == 0)
+		{
+			CORE_LOG_WARN("Attempted to rezize framebuffer to {0}, {1}", width, height);
+			return;
+		}
+
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+
+		Invalidate();
+	}
+
+	uint32_t NullFramebuffer::GetColorAttachmentRendererID(uint32_t index) const
+	{
+		VS_CORE_ASSERT(index < m_ColorAttachments.size());
+		return m_ColorAttachments[index];
+	}
+
+	void NullFramebuffer::Invalidate()
+	{
+		// New ids like a recreated OpenGL framebuffer, so anything caching them notices the resize
+		m_RendererID = NullRendererAPI::GenerateRendererID();
+		m_ColorAttachments.clear();
+		m_DepthAttachment = 0;
+
+		uint32_t colorIndex = 0;
+		for (const auto& attachment : m_Specification.Attachments.Attachments)
+		{
+			if (Utils::IsDepthFormat(attachment.TextureFormat))
+			{
+				m_DepthAttachment = m_Specification.ExistingDepthTexture ? m_Specification.ExistingDepthTexture : NullRendererAPI::GenerateRendererID();
+				continue;
+			}
+
+			bool existing = colorIndex < m_Specification.ExistingColorTextures.size();
+			m_ColorAttachments.push_back(existing ? m_Specification.ExistingColorTextures[colorIndex] : NullRendererAPI::GenerateRendererID());
+			colorIndex++;
+		}
+	}
+
+}
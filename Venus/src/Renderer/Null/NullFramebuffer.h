@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Renderer/Framebuffer.h"
+
+namespace Venus {
+
+	class NullFramebuffer : public Framebuffer
+	{
+		public:
+			NullFramebuffer(const FramebufferSpecification& spec);
+
+			virtual void Bind() override {}
+			virtual void Unbind() override {}
+
+			virtual void Copy(const Ref<Framebuffer>& from, uint32_t width, uint32_t height) override {}
+
+			virtual void Resize(uint32_t width, uint32_t height) override;
+			// Nothing is ever drawn, picking finds no entity
+			virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override { return -1; }
+			virtual void ReadColorAttachment(uint32_t attachmentIndex, void* data, uint32_t size) override { memset(data, 0, size); }
+
+			virtual void ClearAttachment(uint32_t attachmentIndex, int value) override {}
+			virtual void ClearDepthAttachment(uint32_t layer, float value = 1.0f) override {}
+
+			virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override;
+			virtual uint32_t GetDepthAttachmentRendererID() const override { return m_DepthAttachment; }
+
+			virtual FramebufferSpecification& GetSpecification() override { return m_Specification; }
+			virtual const uint32_t GetRendererID() const override { return m_RendererID; }
+
+		private:
+			void Invalidate();
+
+		private:
+			uint32_t m_RendererID = 0;
+			FramebufferSpecification m_Specification;
+
+			std::vector<uint32_t> m_ColorAttachments;
+			uint32_t m_DepthAttachment = 0;
+	};
+
+}
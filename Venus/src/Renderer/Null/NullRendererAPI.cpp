@@ -0,0 +1,13 @@
+#include "pch.h"
+#include "NullRendererAPI.h"
+
+namespace Venus {
+
+	uint32_t NullRendererAPI::GenerateRendererID()
+	{
+		// Zero means no resource, as it does for OpenGL
+		static std::atomic<uint32_t> s_NextID = 1;
+		return s_NextID++;
+	}
+
+}
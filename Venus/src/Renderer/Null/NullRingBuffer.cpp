@@ -0,0 +1,56 @@
+#include "pch.h"
+#include "NullRingBuffer.h"
+
+#include "Renderer/Null/NullRendererAPI.h"
+
+namespace Venus {
+
+	namespace Utils {
+
+		static uint32_t AlignOffset(uint32_t offset, uint32_t alignment)
+		{
+			return ((offset + alignment - 1) / alignment) * alignment;
+		}
+
+	}
+
+	NullRingBuffer::NullRingBuffer(uint32_t frameSize, RingBufferUsage usage)
+		: m_RendererID(NullRendererAPI::GenerateRendererID())
+	{
+		// Most common offset alignment of uniform and storage ranges
+		if (usage == RingBufferUsage::Uniform || usage == RingBufferUsage::Storage)
+			m_Alignment = 256;
+
+		m_FrameSize = Utils::AlignOffset(frameSize, m_Alignment);
+		m_Data.resize((size_t)m_FrameSize * FramesInFlight);
+	}
+
+	uint32_t NullRingBuffer::Push(const void* data, uint32_t size, uint32_t alignment)
+	{
+		alignment = alignment ? alignment : m_Alignment;
+
+		uint32_t regionStart = m_Region * m_FrameSize;
+		uint32_t offset = Utils::AlignOffset(regionStart + m_Offset, alignment);
+
+		if (offset + size > regionStart + m_FrameSize)
+		{
+			NextFrame();
+
+			regionStart = m_Region * m_FrameSize;
+			offset = Utils::AlignOffset(regionStart, alignment);
+			VS_CORE_ASSERT(offset + size <= regionStart + m_FrameSize, "Ring buffer allocation larger than a frame region!");
+		}
+
+		memcpy(m_Data.data() + offset, data, size);
+		m_Offset = offset + size - regionStart;
+
+		return offset;
+	}
+
+	void NullRingBuffer::NextFrame()
+	{
+		m_Region = (m_Region + 1) % FramesInFlight;
+		m_Offset = 0;
+	}
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Renderer/RingBuffer.h"
+
+namespace Venus {
+
+	// Same offsets as the OpenGL ring in system memory, the copy is kept so CPU timings match a mapped buffer
+	class NullRingBuffer : public RingBuffer
+	{
+		public:
+			NullRingBuffer(uint32_t frameSize, RingBufferUsage usage);
+
+			virtual uint32_t Push(const void* data, uint32_t size, uint32_t alignment = 0) override;
+			virtual void BindRange(uint32_t binding, uint32_t offset, uint32_t size) const override {}
+
+			virtual void NextFrame() override;
+
+			virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+		private:
+			uint32_t m_RendererID = 0;
+
+			std::vector<uint8_t> m_Data;
+			uint32_t m_FrameSize = 0;
+			uint32_t m_Alignment = 4;
+
+			uint32_t m_Region = 0;
+			uint32_t m_Offset = 0; // Inside the current region
+	};
+
+}
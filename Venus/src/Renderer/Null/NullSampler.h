@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Renderer/Sampler.h"
+#include "Renderer/Null/NullRendererAPI.h"
+
+namespace Venus {
+
+	class NullSampler : public Sampler
+	{
+		public:
+			NullSampler(const SamplerSpecification& spec)
+				: m_RendererID(NullRendererAPI::GenerateRendererID()), m_Specification(spec) {}
+
+			virtual void Bind(uint32_t slot) const override {}
+
+			virtual uint32_t GetRendererID() const override { return m_RendererID; }
+			virtual const SamplerSpecification& GetSpecification() const override { return m_Specification; }
+
+		private:
+			uint32_t m_RendererID;
+			SamplerSpecification m_Specification;
+	};
+
+}
@@ -0,0 +1,38 @@
+#include "pch.h"
+#include "NullShader.h"
+
+namespace Venus {
+
+	NullShader::NullShader(const std::string& filepath, const std::vector<ShaderSpecializationConstant>& specialization)
+		: m_FilePath(filepath)
+	{
+		VS_PROFILE_FUNCTION();
+
+		// Specialization only changes code, the material block is the same for every variant
+		CompileAndReflect(ShaderCompiler::PreProcess(ShaderCompiler::ReadFile(filepath)));
+
+		std::filesystem::path path = filepath;
+		m_Name = path.stem().string();
+	}
+
+	NullShader::NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+		: m_Name(name)
+	{
+		VS_PROFILE_FUNCTION();
+
+		std::unordered_map<ShaderStage, std::string> sources;
+		sources[ShaderStage::Vertex] = vertexSrc;
+		sources[ShaderStage::Fragment] = fragmentSrc;
+		CompileAndReflect(sources);
+	}
+
+	void NullShader::CompileAndReflect(const std::unordered_map<ShaderStage, std::string>& shaderSources)
+	{
+		ShaderCompiler::Reflection reflection;
+		for (const auto& [stage, data] : ShaderCompiler::CompileOrGetVulkanBinaries(shaderSources, m_FilePath))
+			ShaderCompiler::Reflect(stage, data, m_FilePath, reflection);
+
+		m_MaterialBuffer = std::move(reflection.MaterialBuffer);
+	}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Renderer/Shader.h"
+#include "Renderer/ShaderCompiler.h"
+
+namespace Venus {
+
+	// Compiled to Vulkan SPIR-V and reflected like the OpenGL shader so materials keep their layout, never linked into a program
+	class NullShader : public Shader
+	{
+		public:
+			NullShader(const std::string& filepath, const std::vector<ShaderSpecializationConstant>& specialization = {});
+			NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+
+			virtual void Bind() const override {}
+			virtual void Unbind() const override {}
+
+			virtual const std::string& GetName() const override { return m_Name; }
+			virtual const ShaderBuffer* GetMaterialBuffer() const override { return m_MaterialBuffer.Size ? &m_MaterialBuffer : nullptr; }
+
+			virtual void SetInt(const std::string& name, int value) override {}
+			virtual void SetIntArray(const std::string& name, int* values, uint32_t count) override {}
+			virtual void SetFloat(const std::string& name, float value) override {}
+			virtual void SetFloat2(const std::string& name, const glm::vec2& value) override {}
+			virtual void SetFloat3(const std::string& name, const glm::vec3& value) override {}
+			virtual void SetFloat4(const std::string& name, const glm::vec4& value) override {}
+			virtual void SetMat4(const std::string& name, const glm::mat4& value) override {}
+
+			virtual void SetInt(const ShaderUniformName& uniform, int value) override {}
+			virtual void SetIntArray(const ShaderUniformName& uniform, int* values, uint32_t count) override {}
+			virtual void SetFloat(const ShaderUniformName& uniform, float value) override {}
+			virtual void SetFloat2(const ShaderUniformName& uniform, const glm::vec2& value) override {}
+			virtual void SetFloat3(const ShaderUniformName& uniform, const glm::vec3& value) override {}
+			virtual void SetFloat4(const ShaderUniformName& uniform, const glm::vec4& value) override {}
+			virtual void SetMat4(const ShaderUniformName& uniform, const glm::mat4& value) override {}
+
+			virtual void SetTexture(const std::string& name, int binding, uint32_t texture) override {}
+			virtual void SetCubeMap(const std::string& name, int binding, uint32_t texture) override {}
+			virtual void SetTextureArray(const std::string& name, int binding, uint32_t texture) override {}
+
+			virtual int GetUniformLocation(const std::string& name) override { return -1; }
+			virtual int GetUniformLocation(const ShaderUniformName& uniform) override { return -1; }
+
+		private:
+			void CompileAndReflect(const std::unordered_map<ShaderStage, std::string>& shaderSources);
+
+		private:
+			std::string m_FilePath;
+			std::string m_Name;
+
+			ShaderBuffer m_MaterialBuffer;
+	};
+
+}
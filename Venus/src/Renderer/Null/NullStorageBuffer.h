@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Renderer/StorageBuffer.h"
+
+namespace Venus {
+
+	class NullStorageBuffer : public StorageBuffer
+	{
+		public:
+			NullStorageBuffer(uint32_t size)
+				: m_Size(size) {}
+
+			virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override {}
+			virtual void Resize(uint32_t size) override { m_Size = size; }
+			virtual uint32_t GetSize() const override { return m_Size; }
+
+		private:
+			uint32_t m_Size;
+	};
+
+}
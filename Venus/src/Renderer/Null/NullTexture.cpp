@@ -0,0 +1,171 @@
+#include "pch.h"
+#include "NullTexture.h"
+
+#include "Renderer/Image.h"
+#include "Renderer/Null/NullRendererAPI.h"
+
+#include <glm/glm.hpp>
+
+namespace Venus {
+
+	namespace Utils {
+
+		static uint32_t TextureBytesPerTexel(TextureFormat format)
+		{
+			switch (format)
+			{
+				case TextureFormat::SRGB:		return 4;
+				case TextureFormat::RGBA8:		return 4;
+				case TextureFormat::RGBA16F:	return 8;
+				case TextureFormat::RGBA32F:	return 16;
+				case TextureFormat::R11G11B10F:	return 4;
+			}
+
+			return 4;
+		}
+
+		// A failed load leaves the size at zero, where log2 isn't defined
+		static uint32_t MipLevelCount(uint32_t width, uint32_t height)
+		{
+			if (width == 0 || height == 0)
+				return 1;
+
+			return (uint32_t)std::floor(std::log2(glm::min(width, height))) + 1;
+		}
+
+		static std::pair<uint32_t, uint32_t> MipSize(uint32_t width, uint32_t height, uint32_t mip)
+		{
+			return { width >> mip, height >> mip };
+		}
+
+	}
+
+	//-- Texture 2D-----------------------------------------------------------------------------------------
+	NullTexture2D::NullTexture2D(uint32_t width, uint32_t height, TextureProperties props)
+		: m_RendererID(NullRendererAPI::GenerateRendererID()), m_Properties(props), m_Width(width), m_Height(height)
+	{
+	}
+
+	NullTexture2D::NullTexture2D(const std::string& path, TextureProperties props, bool streamed)
+		: m_RendererID(NullRendererAPI::GenerateRendererID()), m_Path(path), m_Properties(props), m_Streamed(streamed)
+	{
+		Load();
+	}
+
+	NullTexture2D::~NullTexture2D()
+	{
+		TextureStreamer::Cancel(m_StreamRequest);
+	}
+
+	void NullTexture2D::Reload()
+	{
+		if (!m_Path.empty())
+			Load();
+	}
+
+	void NullTexture2D::SetProperties(TextureProperties props, bool reload)
+	{
+		m_Properties = props;
+		if (reload)
+			Reload();
+	}
+
+	uint32_t NullTexture2D::GetMipLevelCount() const
+	{
+		return Utils::MipLevelCount(m_Width, m_Height);
+	}
+
+	std::pair<uint32_t, uint32_t> NullTexture2D::GetMipSize(uint32_t mip) const
+	{
+		return Utils::MipSize(m_Width, m_Height, mip);
+	}
+
+	void NullTexture2D::Load()
+	{
+		TextureStreamer::Cancel(m_StreamRequest);
+		m_StreamRequest = nullptr;
+
+		bool streamed = m_Streamed && TextureStreamer::IsInitialized();
+		bool isHDR = false;
+		if (streamed)
+		{
+			if (!Image::GetInfo(m_Path, m_Width, m_Height, isHDR))
+			{
+				CORE_LOG_ERROR("Could not load texture: {0}", m_Path);
+				return;
+			}
+
+			m_StreamRequest = TextureStreamer::Request(this, m_Path, m_Properties.FlipVertically, !isHDR, m_Properties.Usage);
+		}
+		else
+		{
+			Scope<Image> image = Image::Load(m_Path, m_Properties.FlipVertically);
+			if (!image)
+			{
+				CORE_LOG_ERROR("Could not load texture: {0}", m_Path);
+				return;
+			}
+
+			m_Width = image->GetWidth();
+			m_Height = image->GetHeight();
+			isHDR = image->IsHDR();
+		}
+
+		m_IsLoaded = true;
+		if (isHDR)
+			m_Properties.Format = TextureFormat::RGBA32F;
+	}
+
+	//-- Texture Cube---------------------------------------------------------------------------------------
+	NullTextureCube::NullTextureCube(uint32_t width, uint32_t height, TextureProperties props)
+		: m_RendererID(NullRendererAPI::GenerateRendererID()), m_Properties(props), m_Width(width), m_Height(height)
+	{
+	}
+
+	NullTextureCube::NullTextureCube(std::vector<std::string> paths, TextureProperties props)
+		: m_RendererID(NullRendererAPI::GenerateRendererID()), m_Properties(props)
+	{
+		m_IsLoaded = true;
+		for (const auto& path : paths)
+		{
+			Scope<Image> image = Image::Load(path, false);
+			if (!image)
+			{
+				CORE_LOG_ERROR("Could not find texture: {0}", path);
+				m_IsLoaded = false;
+				continue;
+			}
+
+			m_Width = image->GetWidth();
+			m_Height = image->GetHeight();
+		}
+	}
+
+	uint32_t NullTextureCube::GetLevelSize(uint32_t mipLevel) const
+	{
+		auto [width, height] = GetMipSize(mipLevel);
+		return width * height * 6 * Utils::TextureBytesPerTexel(m_Properties.Format);
+	}
+
+	void NullTextureCube::GetLevelData(void* data, uint32_t size, uint32_t mipLevel) const
+	{
+		VS_CORE_ASSERT(size == GetLevelSize(mipLevel), "Data must be entire level!");
+		memset(data, 0, size);
+	}
+
+	void NullTextureCube::SetLevelData(const void* data, uint32_t size, uint32_t mipLevel)
+	{
+		VS_CORE_ASSERT(size == GetLevelSize(mipLevel), "Data must be entire level!");
+	}
+
+	uint32_t NullTextureCube::GetMipLevelCount() const
+	{
+		return Utils::MipLevelCount(m_Width, m_Height);
+	}
+
+	std::pair<uint32_t, uint32_t> NullTextureCube::GetMipSize(uint32_t mip) const
+	{
+		return Utils::MipSize(m_Width, m_Height, mip);
+	}
+
+}
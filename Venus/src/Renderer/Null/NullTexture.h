@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Renderer/Texture.h"
+#include "Renderer/TextureStreamer.h"
+
+namespace Venus {
+
+	// Files are still decoded, streamed and cooked like the OpenGL texture does, only the upload is skipped
+	class NullTexture2D : public Texture2D
+	{
+		public:
+			NullTexture2D(uint32_t width, uint32_t height, TextureProperties props = TextureProperties());
+			NullTexture2D(const std::string& path, TextureProperties props = TextureProperties(), bool streamed = false);
+			virtual ~NullTexture2D();
+
+			virtual uint32_t GetWidth() const override { return m_Width; }
+			virtual uint32_t GetHeight() const override { return m_Height; }
+			virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+			virtual std::string GetPath() const override { return m_Path; }
+
+			virtual void Reload() override;
+			virtual void SetData(void* data, uint32_t size, uint32_t mipLevel = 0) override {}
+			virtual void SetData(const Ref<RingBuffer>& buffer, uint32_t offset, uint32_t y, uint32_t rows) override {}
+			virtual void BeginCompressedData(TextureCompression compression, uint32_t width, uint32_t height, uint32_t levelCount) override { m_Width = width; m_Height = height; }
+			virtual void SetCompressedData(const Ref<RingBuffer>& buffer, uint32_t offset, uint32_t level, uint32_t y, uint32_t rows) override {}
+			virtual void EndCompressedData() override {}
+			virtual void GenerateMips() override {}
+
+			virtual void Bind(uint32_t slot = 0) const override {}
+
+			virtual bool IsLoaded() const override { return m_IsLoaded; }
+			virtual TextureProperties GetProperties() override { return m_Properties; }
+			virtual void SetProperties(TextureProperties props, bool reload = true) override;
+			virtual TextureType GetType() const override { return TextureType::Texture2D; }
+			virtual uint32_t GetMipLevelCount() const override;
+			virtual std::pair<uint32_t, uint32_t> GetMipSize(uint32_t mip) const override;
+
+			static AssetType GetStaticType() { return AssetType::Texture; }
+			virtual AssetType GetAssetType() const override { return GetStaticType(); }
+
+			virtual bool operator==(const Texture& other) const override
+			{
+				return m_RendererID == other.GetRendererID();
+			}
+
+		private:
+			void Load();
+
+		private:
+			uint32_t m_RendererID = 0;
+			std::string m_Path;
+			bool m_IsLoaded = false;
+
+			TextureProperties m_Properties;
+			uint32_t m_Width = 1, m_Height = 1;
+
+			bool m_Streamed = false;
+			Ref<TextureStreamRequest> m_StreamRequest;
+	};
+
+	class NullTextureCube : public TextureCube
+	{
+		public:
+			NullTextureCube(uint32_t width, uint32_t height, TextureProperties props = TextureProperties());
+			NullTextureCube(std::vector<std::string> paths, TextureProperties props = TextureProperties());
+
+			virtual uint32_t GetWidth() const override { return m_Width; }
+			virtual uint32_t GetHeight() const override { return m_Height; }
+			virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+			virtual std::string GetPath() const override { return m_Path; }
+
+			virtual void Reload() override {}
+			virtual void SetData(void* data, uint32_t size, uint32_t mipLevel = 0) override {}
+			virtual void GenerateMips() override {}
+
+			virtual uint32_t GetLevelSize(uint32_t mipLevel) const override;
+			// Reads back as black
+			virtual void GetLevelData(void* data, uint32_t size, uint32_t mipLevel) const override;
+			virtual void SetLevelData(const void* data, uint32_t size, uint32_t mipLevel) override;
+
+			virtual void Bind(uint32_t slot = 0) const override {}
+
+			virtual bool IsLoaded() const override { return m_IsLoaded; }
+			virtual TextureProperties GetProperties() override { return m_Properties; }
+			virtual void SetProperties(TextureProperties props, bool reload = true) override { m_Properties = props; }
+			virtual TextureType GetType() const override { return TextureType::TextureCube; }
+			virtual uint32_t GetMipLevelCount() const override;
+			virtual std::pair<uint32_t, uint32_t> GetMipSize(uint32_t mip) const override;
+
+			static AssetType GetStaticType() { return AssetType::Texture; }
+			virtual AssetType GetAssetType() const override { return GetStaticType(); }
+
+			virtual bool operator==(const Texture& other) const override
+			{
+				return m_RendererID == other.GetRendererID();
+			}
+
+		private:
+			uint32_t m_RendererID = 0;
+			std::string m_Path;
+			bool m_IsLoaded = false;
+
+			TextureProperties m_Properties;
+			uint32_t m_Width = 1, m_Height = 1;
+	};
+
+}
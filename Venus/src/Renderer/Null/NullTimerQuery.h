@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Renderer/TimerQuery.h"
+
+namespace Venus {
+
+	// Every scope reads back as taking no time
+	class NullTimerQueryPool : public TimerQueryPool
+	{
+		public:
+			NullTimerQueryPool(uint32_t capacity)
+				: m_Capacity(capacity) {}
+
+			virtual void WriteTimestamp(uint32_t index) override {}
+
+			virtual bool GetTimestamps(uint32_t first, uint32_t count, uint64_t* timestamps) override
+			{
+				std::fill(timestamps, timestamps + count, 0);
+				return true;
+			}
+
+			virtual uint64_t GetCurrentTimestamp() override { return 0; }
+
+			virtual uint32_t GetCapacity() const override { return m_Capacity; }
+
+		private:
+			uint32_t m_Capacity;
+	};
+
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Renderer/UniformBuffer.h"
+
+namespace Venus {
+
+	class NullUniformBuffer : public UniformBuffer
+	{
+		public:
+			virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override {}
+			virtual void Bind() override {}
+			virtual void BindRange(uint32_t offset, uint32_t size) override {}
+	};
+
+}
@@ -27,7 +27,7 @@ namespace Venus {
 		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
 	}
 
-	OpenGLVertexBuffer::OpenGLVertexBuffer(void* vertices, uint32_t size)
+	OpenGLVertexBuffer::OpenGLVertexBuffer(const void* vertices, uint32_t size)
 	{
 		VS_PROFILE_FUNCTION();
 
@@ -36,11 +36,17 @@ namespace Venus {
 		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
 	}
 
+	OpenGLVertexBuffer::OpenGLVertexBuffer(const Ref<RingBuffer>& ringBuffer)
+		: m_RendererID(ringBuffer->GetRendererID()), m_RingBuffer(ringBuffer)
+	{
+	}
+
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
 		VS_PROFILE_FUNCTION();
 
-		glDeleteBuffers(1, &m_RendererID);
+		if (!m_RingBuffer)
+			glDeleteBuffers(1, &m_RendererID);
 	}
 
 	void OpenGLVertexBuffer::Bind() const
@@ -59,6 +65,8 @@ namespace Venus {
 
 	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
 	{
+		VS_CORE_ASSERT(!m_RingBuffer, "Ring backed vertex buffers are written through RingBuffer::Push!");
+
 		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
 	}
@@ -67,7 +75,7 @@ namespace Venus {
 	// IndexBuffer //////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////
 
-	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count)
+	OpenGLIndexBuffer::OpenGLIndexBuffer(const uint32_t* indices, uint32_t count)
 		: m_Count(count)
 	{
 		VS_PROFILE_FUNCTION();
@@ -9,7 +9,8 @@ namespace Venus {
 		public:
 			OpenGLVertexBuffer(uint32_t size);
 			OpenGLVertexBuffer(float* vertices, uint32_t size);
-			OpenGLVertexBuffer(void* vertices, uint32_t size);
+			OpenGLVertexBuffer(const void* vertices, uint32_t size);
+			OpenGLVertexBuffer(const Ref<RingBuffer>& ringBuffer);
 			virtual ~OpenGLVertexBuffer();
 
 			virtual void Bind() const override;
@@ -22,12 +23,14 @@ namespace Venus {
 		private:
 			uint32_t m_RendererID;
 			BufferLayout m_Layout;
+
+			Ref<RingBuffer> m_RingBuffer; // Owns the GL buffer when set
 		};
 
 		class OpenGLIndexBuffer : public IndexBuffer
 		{
 		public:
-			OpenGLIndexBuffer(uint32_t* indices, uint32_t count);
+			OpenGLIndexBuffer(const uint32_t* indices, uint32_t count);
 			virtual ~OpenGLIndexBuffer();
 
 			virtual void Bind() const;
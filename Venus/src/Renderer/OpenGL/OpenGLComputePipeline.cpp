@@ -8,6 +8,25 @@
 
 namespace Venus {
 
+	namespace Utils {
+
+		// Zero for depth formats, they can't be bound as images
+		static GLenum FramebufferColorFormatToGL(FramebufferTextureFormat format)
+		{
+			switch (format)
+			{
+				case FramebufferTextureFormat::RGBA8:		return GL_RGBA8;
+				case FramebufferTextureFormat::RGBA16F:		return GL_RGBA16F;
+				case FramebufferTextureFormat::RGBA32F:		return GL_RGBA32F;
+				case FramebufferTextureFormat::R11G11B10F:	return GL_R11F_G11F_B10F;
+				case FramebufferTextureFormat::RED_INTEGER:	return GL_R32I;
+			}
+
+			return 0;
+		}
+
+	}
+
 	OpenGLComputePipeline::OpenGLComputePipeline(Ref<Shader> computeShader)
 		: m_Shader(computeShader)
 	{
@@ -66,4 +85,25 @@ namespace Venus {
 		glBindImageTexture(binding, texture->GetRendererID(), level, layered, layer, GL_WRITE_ONLY, format);
 	}
 
-}
\ No newline at end of file
+	void OpenGLComputePipeline::BindWriteOnlyImage(uint32_t binding, const Ref<Framebuffer>& framebuffer, uint32_t attachmentIndex)
+	{
+		GLenum format = 0;
+		uint32_t colorIndex = 0;
+		for (const auto& attachment : framebuffer->GetSpecification().Attachments.Attachments)
+		{
+			GLenum colorFormat = Utils::FramebufferColorFormatToGL(attachment.TextureFormat);
+			if (!colorFormat)
+				continue;
+
+			if (colorIndex++ == attachmentIndex)
+			{
+				format = colorFormat;
+				break;
+			}
+		}
+		VS_CORE_ASSERT(format, "Framebuffer has no such color attachment!");
+
+		glBindImageTexture(binding, framebuffer->GetColorAttachmentRendererID(attachmentIndex), 0, GL_FALSE, 0, GL_WRITE_ONLY, format);
+	}
+
+}
@@ -17,6 +17,7 @@ namespace Venus {
 			virtual void BindImage(uint32_t binding, Ref<Texture> texture, uint32_t level = 0, uint32_t layer = 0) override;
 			virtual void BindReadOnlyImage(uint32_t binding, Ref<Texture> texture, uint32_t level = 0, uint32_t layer = 0) override;
 			virtual void BindWriteOnlyImage(uint32_t binding, Ref<Texture> texture, uint32_t level = 0, uint32_t layer = 0) override;
+			virtual void BindWriteOnlyImage(uint32_t binding, const Ref<Framebuffer>& framebuffer, uint32_t attachmentIndex = 0) override;
 
 			virtual Ref<Shader> GetShader() override { return m_Shader; }
 
@@ -129,6 +129,7 @@ namespace Venus {
 				case FramebufferTextureFormat::RGBA8:       return GL_RGBA8;
 				case FramebufferTextureFormat::RGBA16F:		return GL_RGBA16F;
 				case FramebufferTextureFormat::RGBA32F:		return GL_RGBA32F;
+				case FramebufferTextureFormat::R11G11B10F:	return GL_R11F_G11F_B10F;
 				case FramebufferTextureFormat::RED_INTEGER: return GL_RED_INTEGER;
 			}
 
@@ -219,6 +220,9 @@ namespace Venus {
 					case FramebufferTextureFormat::RGBA32F:
 						Utils::AttachColorTexture(m_Specification, m_ColorAttachments[i], i, GL_RGBA32F, GL_RGBA, GL_FLOAT, attachOnly);
 						break;
+					case FramebufferTextureFormat::R11G11B10F:
+						Utils::AttachColorTexture(m_Specification, m_ColorAttachments[i], i, GL_R11F_G11F_B10F, GL_RGB, GL_FLOAT, attachOnly);
+						break;
 					case FramebufferTextureFormat::RED_INTEGER:
 						Utils::AttachColorTexture(m_Specification, m_ColorAttachments[i], i, GL_R32I, GL_RED_INTEGER, GL_UNSIGNED_BYTE, attachOnly);
 						break;
@@ -327,6 +331,17 @@ namespace Venus {
 		return pixelData;
 	}
 
+	void OpenGLFramebuffer::ReadColorAttachment(uint32_t attachmentIndex, void* data, uint32_t size)
+	{
+		VS_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
+		VS_CORE_ASSERT(m_Specification.Samples == 1 && m_Specification.Layers == 1, "Only single sampled 2D attachments can be read back!");
+		VS_CORE_ASSERT(size >= m_Specification.Width * m_Specification.Height * 4);
+		// Normalized and float formats convert to RGBA8 on read, integer ones can't
+		VS_CORE_ASSERT(m_ColorAttachmentSpecifications[attachmentIndex].TextureFormat != FramebufferTextureFormat::RED_INTEGER, "Integer attachments can't be read back as RGBA8!");
+
+		glGetTextureImage(m_ColorAttachments[attachmentIndex], 0, GL_RGBA, GL_UNSIGNED_BYTE, size, data);
+	}
+
 	void OpenGLFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
 	{
 		VS_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
@@ -336,4 +351,15 @@ namespace Venus {
 			Utils::VenusFBTextureFormatToGL(spec.TextureFormat), GL_INT, &value);
 	}
 
+	void OpenGLFramebuffer::ClearDepthAttachment(uint32_t layer, float value)
+	{
+		VS_CORE_ASSERT(m_DepthAttachment, "Framebuffer has no depth attachment!");
+		VS_CORE_ASSERT(m_DepthAttachmentSpecification.TextureFormat == FramebufferTextureFormat::DEPTH32F, "Only float depth attachments can be cleared by layer!");
+		VS_CORE_ASSERT(layer < m_Specification.Layers, "Layer out of range!");
+
+		// Touches a single layer, the rest of the array keeps its contents
+		glClearTexSubImage(m_DepthAttachment, 0, 0, 0, layer, m_Specification.Width, m_Specification.Height, 1,
+			GL_DEPTH_COMPONENT, GL_FLOAT, &value);
+	}
+
 }
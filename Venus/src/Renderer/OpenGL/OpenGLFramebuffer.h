@@ -19,8 +19,10 @@ namespace Venus {
 
 			virtual void Resize(uint32_t width, uint32_t height) override;
 			virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+			virtual void ReadColorAttachment(uint32_t attachmentIndex, void* data, uint32_t size) override;
 
 			virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
+			virtual void ClearDepthAttachment(uint32_t layer, float value = 1.0f) override;
 
 			virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { VS_CORE_ASSERT(index < m_ColorAttachments.size()); return m_ColorAttachments[index]; }
 			virtual uint32_t GetDepthAttachmentRendererID() const override { return m_DepthAttachment; }
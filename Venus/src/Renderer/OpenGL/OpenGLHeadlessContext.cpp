@@ -0,0 +1,162 @@
+#include "pch.h"
+#include "Renderer/OpenGL/OpenGLHeadlessContext.h"
+
+#ifdef VS_EGL
+	// Xlib's macros clash with engine names, e.g. None
+	#define EGL_NO_X11
+	#define MESA_EGL_NO_X11_HEADERS
+	#include <EGL/egl.h>
+	#include <EGL/eglext.h>
+#else
+	#include <GLFW/glfw3.h>
+#endif
+
+#include <glad/glad.h>
+
+namespace Venus {
+
+#ifdef VS_EGL
+	namespace Utils {
+
+		static bool HasExtension(const char* extensions, const char* name)
+		{
+			if (!extensions)
+				return false;
+
+			// Space separated, match whole names only
+			size_t length = strlen(name);
+			for (const char* it = strstr(extensions, name); it; it = strstr(it + length, name))
+			{
+				bool start = it == extensions || it[-1] == ' ';
+				bool end = it[length] == ' ' || it[length] == '\0';
+				if (start && end)
+					return true;
+			}
+
+			return false;
+		}
+
+	}
+#endif
+
+	OpenGLHeadlessContext::OpenGLHeadlessContext(uint32_t width, uint32_t height)
+		: m_Width(width), m_Height(height)
+	{
+	}
+
+	OpenGLHeadlessContext::~OpenGLHeadlessContext()
+	{
+	#ifdef VS_EGL
+		if (m_Display)
+		{
+			eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			if (m_Context)
+				eglDestroyContext(m_Display, m_Context);
+			if (m_Surface)
+				eglDestroySurface(m_Display, m_Surface);
+			eglTerminate(m_Display);
+		}
+	#else
+		if (m_WindowHandle)
+		{
+			glfwDestroyWindow(m_WindowHandle);
+			glfwTerminate();
+		}
+	#endif
+	}
+
+	void OpenGLHeadlessContext::Init()
+	{
+		VS_PROFILE_FUNCTION();
+
+	#ifdef VS_EGL
+		// The surfaceless platform needs no display server or device node
+		auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+		if (getPlatformDisplay && Utils::HasExtension(eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS), "EGL_MESA_platform_surfaceless"))
+			m_Display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		if (!m_Display)
+			m_Display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		VS_CORE_ASSERT(m_Display, "Could not get an EGL display!");
+
+		EGLint major, minor;
+		EGLBoolean success = eglInitialize(m_Display, &major, &minor);
+		VS_CORE_ASSERT(success, "Could not initialize EGL!");
+		success = eglBindAPI(EGL_OPENGL_API);
+		VS_CORE_ASSERT(success, "EGL does not support desktop OpenGL!");
+
+		// Everything is drawn into framebuffers, the surface only has to exist when the context can't go without
+		bool surfaceless = Utils::HasExtension(eglQueryString(m_Display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+		const EGLint configAttributes[] =
+		{
+			EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_RED_SIZE, 8,
+			EGL_GREEN_SIZE, 8,
+			EGL_BLUE_SIZE, 8,
+			EGL_ALPHA_SIZE, 8,
+			EGL_NONE
+		};
+
+		EGLConfig config;
+		EGLint configCount = 0;
+		success = eglChooseConfig(m_Display, configAttributes, &config, 1, &configCount);
+		VS_CORE_ASSERT(success && configCount > 0, "No EGL config for OpenGL!");
+
+		const EGLint contextAttributes[] =
+		{
+			EGL_CONTEXT_MAJOR_VERSION, 4,
+			EGL_CONTEXT_MINOR_VERSION, 5,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		#if defined(VS_DEBUG)
+			EGL_CONTEXT_OPENGL_DEBUG, EGL_TRUE,
+		#endif
+			EGL_NONE
+		};
+
+		m_Context = eglCreateContext(m_Display, config, EGL_NO_CONTEXT, contextAttributes);
+		VS_CORE_ASSERT(m_Context, "Could not create an OpenGL 4.5 EGL context!");
+
+		if (!surfaceless)
+		{
+			const EGLint surfaceAttributes[] = { EGL_WIDTH, (EGLint)m_Width, EGL_HEIGHT, (EGLint)m_Height, EGL_NONE };
+			m_Surface = eglCreatePbufferSurface(m_Display, config, surfaceAttributes);
+			VS_CORE_ASSERT(m_Surface, "Could not create an EGL pbuffer!");
+		}
+
+		success = eglMakeCurrent(m_Display, m_Surface, m_Surface, m_Context);
+		VS_CORE_ASSERT(success, "Could not make the EGL context current!");
+
+		int status = gladLoadGLLoader((GLADloadproc)eglGetProcAddress);
+	#else
+		int success = glfwInit();
+		VS_CORE_ASSERT(success, "Could not initialize GLFW!");
+
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	#if defined(VS_DEBUG)
+		glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+	#endif
+		m_WindowHandle = glfwCreateWindow((int)m_Width, (int)m_Height, "Venus Headless", nullptr, nullptr);
+		VS_CORE_ASSERT(m_WindowHandle, "Could not create the hidden window!");
+
+		glfwMakeContextCurrent(m_WindowHandle);
+		int status = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+	#endif
+		VS_CORE_ASSERT(status, "Failed to initialize Glad!");
+
+		CORE_LOG_INFO("OpenGL Info (headless):");
+		CORE_LOG_INFO("  Vendor: {0}", (const char*)glGetString(GL_VENDOR));
+		CORE_LOG_INFO("  Renderer: {0}", (const char*)glGetString(GL_RENDERER));
+		CORE_LOG_INFO("  Version: {0}", (const char*)glGetString(GL_VERSION));
+
+		VS_CORE_ASSERT(GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 5), "Venus requires at least OpenGL version 4.5!");
+	}
+
+	void OpenGLHeadlessContext::SwapBuffers()
+	{
+		VS_PROFILE_FUNCTION();
+
+		// Nothing is presented to pace the frames, waiting here keeps the CPU from running ahead so every frame's timer queries resolve
+		glFinish();
+	}
+
+}
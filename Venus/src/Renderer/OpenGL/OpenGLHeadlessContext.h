@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Renderer/GraphicsContext.h"
+
+struct GLFWwindow;
+
+namespace Venus {
+
+	// Built with VS_EGL it needs no display server, a surfaceless or pbuffer EGL context (e.g. Mesa llvmpipe).
+	// Otherwise the context of a hidden GLFW window
+	class OpenGLHeadlessContext : public GraphicsContext
+	{
+		public:
+			OpenGLHeadlessContext(uint32_t width, uint32_t height);
+			virtual ~OpenGLHeadlessContext();
+
+			virtual void Init() override;
+			virtual void SwapBuffers() override;
+
+		private:
+			uint32_t m_Width, m_Height;
+
+		#ifdef VS_EGL
+			// EGLDisplay, EGLSurface and EGLContext
+			void* m_Display = nullptr;
+			void* m_Surface = nullptr;
+			void* m_Context = nullptr;
+		#else
+			GLFWwindow* m_WindowHandle = nullptr;
+		#endif
+	};
+
+}
@@ -91,6 +91,16 @@ namespace Venus {
 		glEnable(GL_DEPTH_TEST);
 	}
 
+	void OpenGLRendererAPI::DisableDepthWrite()
+	{
+		glDepthMask(GL_FALSE);
+	}
+
+	void OpenGLRendererAPI::EnableDepthWrite()
+	{
+		glDepthMask(GL_TRUE);
+	}
+
 	void OpenGLRendererAPI::SetStencilTest(int function, int value, int mask)
 	{
 		glStencilFunc((GLenum)function, value, mask);
@@ -114,16 +124,29 @@ namespace Venus {
 		glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
 	}
 
+	void OpenGLRendererAPI::BindSampler(int location, int samplerID)
+	{
+		// Zero falls back to the texture's own parameters
+		glBindSampler(location, samplerID);
+	}
+
 	void OpenGLRendererAPI::BindFramebuffer(int framebufferID)
 	{
 		glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
 	}
 
-	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
+	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex)
+	{
+		vertexArray->Bind();
+		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, baseVertex);
+	}
+
+	void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount)
 	{
 		vertexArray->Bind();
 		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
-		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+		glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, instanceCount);
 	}
 
 	void OpenGLRendererAPI::DrawArrays(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
@@ -132,10 +155,10 @@ namespace Venus {
 		glDrawArrays(GL_TRIANGLES, 0, indexCount);
 	}
 
-	void OpenGLRendererAPI::DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
+	void OpenGLRendererAPI::DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t firstVertex)
 	{
 		vertexArray->Bind();
-		glDrawArrays(GL_LINES, 0, vertexCount);
+		glDrawArrays(GL_LINES, firstVertex, vertexCount);
 	}
 
 	void OpenGLRendererAPI::SetLineWidth(float width)
@@ -144,4 +167,14 @@ namespace Venus {
 		glLineWidth(width);
 	}
 
+	void OpenGLRendererAPI::PushDebugGroup(const std::string& name)
+	{
+		glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name.c_str());
+	}
+
+	void OpenGLRendererAPI::PopDebugGroup()
+	{
+		glPopDebugGroup();
+	}
+
 }
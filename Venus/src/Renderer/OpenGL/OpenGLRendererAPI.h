@@ -19,18 +19,25 @@ namespace Venus {
 			virtual void EnableStencilWrite() override;
 			virtual void DisableDepthTest() override;
 			virtual void EnableDepthTest() override;
+			virtual void DisableDepthWrite() override;
+			virtual void EnableDepthWrite() override;
 			virtual void SetStencilTest(int function, int value, int mask) override;
 
 			virtual void BindTexture(int location, int textureID) override;
 			virtual void BindTextureCube(int location, int textureID) override;
 			virtual void BindTextureArray(int location, int textureID) override;
+			virtual void BindSampler(int location, int samplerID) override;
 			virtual void BindFramebuffer(int framebufferID) override;
 
-			virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+			virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0) override;
+			virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount = 0) override;
 			virtual void DrawArrays(const Ref<VertexArray>& vertexArray, uint32_t indexCount) override;
-			virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) override;
+			virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t firstVertex = 0) override;
 
 			virtual void SetLineWidth(float width) override;
+
+			virtual void PushDebugGroup(const std::string& name) override;
+			virtual void PopDebugGroup() override;
 	};
 
 
@@ -0,0 +1,139 @@
+#include "pch.h"
+#include "OpenGLRingBuffer.h"
+
+#include <glad/glad.h>
+
+namespace Venus {
+
+	namespace Utils {
+
+		static GLenum RingBufferUsageToGLTarget(RingBufferUsage usage)
+		{
+			switch (usage)
+			{
+				case RingBufferUsage::Uniform:	return GL_UNIFORM_BUFFER;
+				case RingBufferUsage::Storage:	return GL_SHADER_STORAGE_BUFFER;
+				case RingBufferUsage::Vertex:	return GL_ARRAY_BUFFER;
+				case RingBufferUsage::PixelUnpack:	return GL_PIXEL_UNPACK_BUFFER;
+			}
+
+			VS_CORE_ASSERT(false, "Unknown ring buffer usage!");
+			return 0;
+		}
+
+		static uint32_t RingBufferUsageAlignment(RingBufferUsage usage)
+		{
+			GLint alignment = 4;
+			switch (usage)
+			{
+				case RingBufferUsage::Uniform:	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment); break;
+				case RingBufferUsage::Storage:	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment); break;
+				case RingBufferUsage::Vertex:	break;
+				case RingBufferUsage::PixelUnpack:	break;
+			}
+
+			return (uint32_t)alignment;
+		}
+
+		static uint32_t AlignOffset(uint32_t offset, uint32_t alignment)
+		{
+			// Vertex strides are not always a power of two
+			return ((offset + alignment - 1) / alignment) * alignment;
+		}
+
+	}
+
+	OpenGLRingBuffer::OpenGLRingBuffer(uint32_t frameSize, RingBufferUsage usage)
+		: m_Usage(usage)
+	{
+		m_Alignment = Utils::RingBufferUsageAlignment(usage);
+		m_FrameSize = Utils::AlignOffset(frameSize, m_Alignment);
+
+		uint32_t size = m_FrameSize * FramesInFlight;
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferStorage(m_RendererID, size, nullptr, flags);
+		m_MappedData = (uint8_t*)glMapNamedBufferRange(m_RendererID, 0, size, flags);
+
+		VS_CORE_ASSERT(m_MappedData, "Failed to map ring buffer!");
+	}
+
+	OpenGLRingBuffer::~OpenGLRingBuffer()
+	{
+		for (GLsync& fence : m_Fences)
+		{
+			if (fence)
+				glDeleteSync(fence);
+		}
+
+		glUnmapNamedBuffer(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	uint32_t OpenGLRingBuffer::Push(const void* data, uint32_t size, uint32_t alignment)
+	{
+		alignment = alignment ? alignment : m_Alignment;
+
+		uint32_t regionStart = m_Region * m_FrameSize;
+		uint32_t offset = Utils::AlignOffset(regionStart + m_Offset, alignment);
+
+		// Region exhausted mid frame, move on early instead of overwriting data the GPU may still read
+		if (offset + size > regionStart + m_FrameSize)
+		{
+			NextFrame();
+
+			regionStart = m_Region * m_FrameSize;
+			offset = Utils::AlignOffset(regionStart, alignment);
+			VS_CORE_ASSERT(offset + size <= regionStart + m_FrameSize, "Ring buffer allocation larger than a frame region!");
+		}
+
+		memcpy(m_MappedData + offset, data, size);
+		m_Offset = offset + size - regionStart;
+
+		return offset;
+	}
+
+	void OpenGLRingBuffer::BindRange(uint32_t binding, uint32_t offset, uint32_t size) const
+	{
+		VS_CORE_ASSERT(m_Usage == RingBufferUsage::Uniform || m_Usage == RingBufferUsage::Storage, "Only uniform and storage ring buffers have indexed bindings!");
+		glBindBufferRange(Utils::RingBufferUsageToGLTarget(m_Usage), binding, m_RendererID, offset, size);
+	}
+
+	void OpenGLRingBuffer::NextFrame()
+	{
+		m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_Region = (m_Region + 1) % FramesInFlight;
+		m_Offset = 0;
+		WaitForRegion(m_Region);
+	}
+
+	void OpenGLRingBuffer::WaitForRegion(uint32_t region)
+	{
+		GLsync& fence = m_Fences[region];
+		if (!fence)
+			return;
+
+		// Flush on the first wait so the fence is guaranteed to signal
+		GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		while (true)
+		{
+			GLenum result = glClientWaitSync(fence, waitFlags, 1000000);
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+				break;
+
+			if (result == GL_WAIT_FAILED)
+			{
+				CORE_LOG_ERROR("OpenGLRingBuffer: Fence wait failed!");
+				break;
+			}
+
+			waitFlags = 0;
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+}
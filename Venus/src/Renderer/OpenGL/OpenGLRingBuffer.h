@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Renderer/RingBuffer.h"
+
+#include <array>
+
+typedef struct __GLsync* GLsync;
+
+namespace Venus {
+
+	class OpenGLRingBuffer : public RingBuffer
+	{
+		public:
+			OpenGLRingBuffer(uint32_t frameSize, RingBufferUsage usage);
+			virtual ~OpenGLRingBuffer();
+
+			virtual uint32_t Push(const void* data, uint32_t size, uint32_t alignment = 0) override;
+			virtual void BindRange(uint32_t binding, uint32_t offset, uint32_t size) const override;
+
+			virtual void NextFrame() override;
+
+			virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+		private:
+			void WaitForRegion(uint32_t region);
+
+		private:
+			uint32_t m_RendererID = 0;
+			RingBufferUsage m_Usage;
+
+			uint8_t* m_MappedData = nullptr;
+			uint32_t m_FrameSize = 0;
+			uint32_t m_Alignment = 4;
+
+			uint32_t m_Region = 0;
+			uint32_t m_Offset = 0; // Inside the current region
+			std::array<GLsync, FramesInFlight> m_Fences{};
+	};
+
+}
@@ -0,0 +1,34 @@
+#include "pch.h"
+#include "OpenGLSampler.h"
+
+#include "Renderer/OpenGL/OpenGLTexture.h"
+
+namespace Venus {
+
+	OpenGLSampler::OpenGLSampler(const SamplerSpecification& spec)
+		: m_Specification(spec)
+	{
+		GLenum minFilter = OpenGLFilterMode(spec.Filter);
+		if (spec.UseMipmaps && minFilter == GL_LINEAR)
+			minFilter = GL_LINEAR_MIPMAP_LINEAR;
+		else if (spec.UseMipmaps && minFilter == GL_NEAREST)
+			minFilter = GL_NEAREST_MIPMAP_NEAREST;
+
+		glCreateSamplers(1, &m_RendererID);
+		glSamplerParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, minFilter);
+		glSamplerParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, OpenGLFilterMode(spec.Filter));
+		glSamplerParameteri(m_RendererID, GL_TEXTURE_WRAP_S, OpenGLWrapMode(spec.WrapMode));
+		glSamplerParameteri(m_RendererID, GL_TEXTURE_WRAP_T, OpenGLWrapMode(spec.WrapMode));
+	}
+
+	OpenGLSampler::~OpenGLSampler()
+	{
+		glDeleteSamplers(1, &m_RendererID);
+	}
+
+	void OpenGLSampler::Bind(uint32_t slot) const
+	{
+		glBindSampler(slot, m_RendererID);
+	}
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Renderer/Sampler.h"
+
+namespace Venus {
+
+	class OpenGLSampler : public Sampler
+	{
+		public:
+			OpenGLSampler(const SamplerSpecification& spec);
+			virtual ~OpenGLSampler();
+
+			virtual void Bind(uint32_t slot) const override;
+
+			virtual uint32_t GetRendererID() const override { return m_RendererID; }
+			virtual const SamplerSpecification& GetSpecification() const override { return m_Specification; }
+
+		private:
+			uint32_t m_RendererID = 0;
+			SamplerSpecification m_Specification;
+	};
+
+}
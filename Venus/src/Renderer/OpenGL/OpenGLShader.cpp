@@ -8,7 +8,6 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <shaderc/shaderc.hpp>
-#include <spirv_cross/spirv_cross.hpp>
 #include <spirv_cross/spirv_glsl.hpp>
 
 #include "Engine/Timer.h"
@@ -17,18 +16,16 @@ namespace Venus {
 
 	namespace Utils {
 
-		static GLenum ShaderTypeFromString(const std::string& type)
+		static GLenum ShaderStageToGL(ShaderStage stage)
 		{
-			if (type == "vertex")
-				return GL_VERTEX_SHADER;
-			if (type == "fragment" || type == "pixel")
-				return GL_FRAGMENT_SHADER;
-			if (type == "geometry")
-				return GL_GEOMETRY_SHADER;
-			if (type == "compute")
-				return GL_COMPUTE_SHADER;
-
-			VS_CORE_ASSERT(false, "Unknown shader type!");
+			switch (stage)
+			{
+				case ShaderStage::Vertex:	return GL_VERTEX_SHADER;
+				case ShaderStage::Fragment:	return GL_FRAGMENT_SHADER;
+				case ShaderStage::Geometry:	return GL_GEOMETRY_SHADER;
+				case ShaderStage::Compute:	return GL_COMPUTE_SHADER;
+			}
+			VS_CORE_ASSERT(false);
 			return 0;
 		}
 
@@ -45,27 +42,9 @@ namespace Venus {
 			return (shaderc_shader_kind)0;
 		}
 
-		static const char* GLShaderStageToString(GLenum stage)
-		{
-			switch (stage)
-			{
-				case GL_VERTEX_SHADER:		return "GL_VERTEX_SHADER";
-				case GL_FRAGMENT_SHADER:	return "GL_FRAGMENT_SHADER";
-				case GL_GEOMETRY_SHADER:	return "GL_GEOMETRY_SHADER";
-				case GL_COMPUTE_SHADER:		return "GL_COMPUTE_SHADER";
-			}
-			VS_CORE_ASSERT(false);
-			return nullptr;
-		}
-
-		static const char* GetCacheDirectory()
-		{
-			return "Resources/Cache/Shader/Opengl";
-		}
-
 		static void CreateCacheDirectoryIfNeeded()
 		{
-			std::string cacheDirectory = GetCacheDirectory();
+			std::string cacheDirectory = ShaderCompiler::GetCacheDirectory();
 			if (!std::filesystem::exists(cacheDirectory))
 				std::filesystem::create_directories(cacheDirectory);
 		}
@@ -83,17 +62,18 @@ namespace Venus {
 			return "";
 		}
 
-		static const char* GLShaderStageCachedVulkanFileExtension(uint32_t stage)
+		// The OpenGL path goes through GLSL, where specialization constants are plain constants.
+		// Their defaults are overwritten before cross compiling, so the variant's values end up in the source
+		static void SetSpecializationConstants(spirv_cross::Compiler& compiler, const std::vector<ShaderSpecializationConstant>& specialization)
 		{
-			switch (stage)
+			for (const auto& constant : compiler.get_specialization_constants())
 			{
-				case GL_VERTEX_SHADER:		return ".cached_vulkan.vert";
-				case GL_FRAGMENT_SHADER:	return ".cached_vulkan.frag";
-				case GL_GEOMETRY_SHADER:	return ".cached_vulkan.geo";
-				case GL_COMPUTE_SHADER:		return ".cached_vulkan.comp";
+				for (const auto& value : specialization)
+				{
+					if (value.ID == constant.constant_id)
+						compiler.get_constant(constant.id).m.c[0].r[0].u32 = value.Value;
+				}
 			}
-			VS_CORE_ASSERT(false);
-			return "";
 		}
 
 		static const bool IsAmdGPU()
@@ -125,15 +105,26 @@ namespace Venus {
 		return true;
 	}
 
-	OpenGLShader::OpenGLShader(const std::string& filepath)
-		: m_FilePath(filepath)
+	OpenGLShader::OpenGLShader(const std::string& filepath, const std::vector<ShaderSpecializationConstant>& specialization)
+		: m_FilePath(filepath), m_Specialization(specialization)
 	{
 		VS_PROFILE_FUNCTION();
 
 		Utils::CreateCacheDirectoryIfNeeded();
 
-		std::string source = ReadFile(filepath);
-		auto shaderSources = PreProcess(source);
+		m_CacheName = std::filesystem::path(filepath).filename().string();
+		if (!m_Specialization.empty())
+		{
+			std::stringstream variant;
+			for (const auto& constant : m_Specialization)
+				variant << constant.ID << "=" << constant.Value << ";";
+
+			std::stringstream cacheName;
+			cacheName << m_CacheName << "." << std::hex << Hash::GenerateFNVHash(variant.str());
+			m_CacheName = cacheName.str();
+		}
+
+		auto shaderSources = ShaderCompiler::PreProcess(ShaderCompiler::ReadFile(filepath));
 
 		{
 			Timer timer;
@@ -149,6 +140,7 @@ namespace Venus {
 				CompileOrGetOpenGLBinaries();
 				CreateProgram();
 			}
+			ResolveUniformLocations();
 
 			CORE_LOG_WARN("Shader creation took {0} ms", timer.ElapsedMillis());
 		}
@@ -166,9 +158,9 @@ namespace Venus {
 	{
 		VS_PROFILE_FUNCTION();
 
-		std::unordered_map<GLenum, std::string> sources;
-		sources[GL_VERTEX_SHADER] = vertexSrc;
-		sources[GL_FRAGMENT_SHADER] = fragmentSrc;
+		std::unordered_map<ShaderStage, std::string> sources;
+		sources[ShaderStage::Vertex] = vertexSrc;
+		sources[ShaderStage::Fragment] = fragmentSrc;
 
 		{
 			Timer timer;
@@ -184,6 +176,7 @@ namespace Venus {
 				CompileOrGetOpenGLBinaries();
 				CreateProgram();
 			}
+			ResolveUniformLocations();
 
 			CORE_LOG_WARN("Shader creation took {0} ms", timer.ElapsedMillis());
 		}
@@ -196,117 +189,19 @@ namespace Venus {
 		glDeleteProgram(m_RendererID);
 	}
 
-	std::string OpenGLShader::ReadFile(const std::string& filepath)
-	{
-		VS_PROFILE_FUNCTION();
-
-		std::string result;
-		std::ifstream in(filepath, std::ios::in | std::ios::binary); // ifstream closes itself due to RAII
-		if (in)
-		{
-			in.seekg(0, std::ios::end);
-			size_t size = in.tellg();
-			if (size != -1)
-			{
-				result.resize(size);
-				in.seekg(0, std::ios::beg);
-				in.read(&result[0], size);
-			}
-			else
-			{
-				CORE_LOG_ERROR("Could not read from file '{0}'", filepath);
-			}
-		}
-		else
-		{
-			CORE_LOG_ERROR("Could not open file '{0}'", filepath);
-		}
-
-		return result;
-	}
-
-	std::unordered_map<GLenum, std::string> OpenGLShader::PreProcess(const std::string& source)
+	void OpenGLShader::CompileOrGetVulkanBinaries(const std::unordered_map<ShaderStage, std::string>& shaderSources)
 	{
-		VS_PROFILE_FUNCTION();
+		ShaderCompiler::Reflection reflection;
 
-		std::unordered_map<GLenum, std::string> shaderSources;
-
-		const char* typeToken = "#type";
-		size_t typeTokenLength = strlen(typeToken);
-		size_t pos = source.find(typeToken, 0); //Start of shader type declaration line
-		while (pos != std::string::npos)
+		m_VulkanSPIRV.clear();
+		for (auto&& [stage, data] : ShaderCompiler::CompileOrGetVulkanBinaries(shaderSources, m_FilePath))
 		{
-			size_t eol = source.find_first_of("\r\n", pos); //End of shader type declaration line
-			VS_CORE_ASSERT(eol != std::string::npos, "Syntax error");
-			size_t begin = pos + typeTokenLength + 1; //Start of shader type name (after "#type " keyword)
-			std::string type = source.substr(begin, eol - begin);
-			VS_CORE_ASSERT(Utils::ShaderTypeFromString(type), "Invalid shader type specified");
-
-			size_t nextLinePos = source.find_first_not_of("\r\n", eol); //Start of shader code after shader type declaration line
-			VS_CORE_ASSERT(nextLinePos != std::string::npos, "Syntax error");
-			pos = source.find(typeToken, nextLinePos); //Start of next shader type declaration line
-
-			shaderSources[Utils::ShaderTypeFromString(type)] = (pos == std::string::npos) ? source.substr(nextLinePos) : source.substr(nextLinePos, pos - nextLinePos);
-		}
-
-		return shaderSources;
-	}
-
-	void OpenGLShader::CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& shaderSources)
-	{
-		GLuint program = glCreateProgram();
-
-		shaderc::Compiler compiler;
-		shaderc::CompileOptions options;
-		options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
-		const bool optimize = false;
-		if (optimize)
-			options.SetOptimizationLevel(shaderc_optimization_level_performance);
-
-		std::filesystem::path cacheDirectory = Utils::GetCacheDirectory();
-
-		auto& shaderData = m_VulkanSPIRV;
-		shaderData.clear();
-		for (auto&& [stage, source] : shaderSources)
-		{
-			std::filesystem::path shaderFilePath = m_FilePath;
-			std::filesystem::path cachedPath = cacheDirectory / (shaderFilePath.filename().string() + Utils::GLShaderStageCachedVulkanFileExtension(stage));
-
-			std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
-			if (in.is_open())
-			{
-				in.seekg(0, std::ios::end);
-				auto size = in.tellg();
-				in.seekg(0, std::ios::beg);
-
-				auto& data = shaderData[stage];
-				data.resize(size / sizeof(uint32_t));
-				in.read((char*)data.data(), size);
-			}
-			else
-			{
-				shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(source, Utils::GLShaderStageToShaderC(stage), m_FilePath.c_str(), options);
-				if (module.GetCompilationStatus() != shaderc_compilation_status_success)
-				{
-					CORE_LOG_ERROR(module.GetErrorMessage());
-					VS_CORE_ASSERT(false);
-				}
-
-				shaderData[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
-
-				std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
-				if (out.is_open())
-				{
-					auto& data = shaderData[stage];
-					out.write((char*)data.data(), data.size() * sizeof(uint32_t));
-					out.flush();
-					out.close();
-				}
-			}
+			ShaderCompiler::Reflect(stage, data, m_FilePath, reflection);
+			m_VulkanSPIRV[Utils::ShaderStageToGL(stage)] = std::move(data);
 		}
 
-		for (auto&& [stage, data]: shaderData)
-			Reflect(stage, data);
+		m_ReflectedUniforms = std::move(reflection.Uniforms);
+		m_MaterialBuffer = std::move(reflection.MaterialBuffer);
 	}
 
 	void OpenGLShader::CompileOrGetOpenGLBinaries()
@@ -322,14 +217,13 @@ namespace Venus {
 		if (optimize)
 			options.SetOptimizationLevel(shaderc_optimization_level_performance);
 
-		std::filesystem::path cacheDirectory = Utils::GetCacheDirectory();
+		std::filesystem::path cacheDirectory = ShaderCompiler::GetCacheDirectory();
 
 		shaderData.clear();
 		m_OpenGLSourceCode.clear();
 		for (auto&& [stage, spirv] : m_VulkanSPIRV)
 		{
-			std::filesystem::path shaderFilePath = m_FilePath;
-			std::filesystem::path cachedPath = cacheDirectory / (shaderFilePath.filename().string() + Utils::GLShaderStageCachedOpenGLFileExtension(stage));
+			std::filesystem::path cachedPath = cacheDirectory / (m_CacheName + Utils::GLShaderStageCachedOpenGLFileExtension(stage));
 
 			std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
 			if (in.is_open())
@@ -345,7 +239,8 @@ namespace Venus {
 			else
 			{
 				spirv_cross::CompilerGLSL glslCompiler(spirv);
-				
+				Utils::SetSpecializationConstants(glslCompiler, m_Specialization);
+
 				m_OpenGLSourceCode[stage] = glslCompiler.compile();
 				auto& source = m_OpenGLSourceCode[stage];
 
@@ -421,6 +316,7 @@ namespace Venus {
 		for (auto&& [stage, spirv] : m_VulkanSPIRV)
 		{
 			spirv_cross::CompilerGLSL glslCompiler(spirv);
+			Utils::SetSpecializationConstants(glslCompiler, m_Specialization);
 			std::string source = glslCompiler.compile();
 
 			uint32_t shader;
@@ -457,9 +353,8 @@ namespace Venus {
 	{
 		GLuint program = glCreateProgram();
 
-		std::filesystem::path cacheDirectory = Utils::GetCacheDirectory();
-		std::filesystem::path shaderFilePath = m_FilePath;
-		std::filesystem::path cachedPath = cacheDirectory / (shaderFilePath.filename().string() + ".cached_opengl.pgr");
+		std::filesystem::path cacheDirectory = ShaderCompiler::GetCacheDirectory();
+		std::filesystem::path cachedPath = cacheDirectory / (m_CacheName + ".cached_opengl.pgr");
 		std::ifstream in(cachedPath, std::ios::ate | std::ios::binary);
 
 		if (in.is_open())
@@ -517,34 +412,23 @@ namespace Venus {
 		CORE_LOG_INFO("Creating Shader {0} at program: {1}", m_FilePath, m_RendererID);
 	}
 
-	void OpenGLShader::Reflect(GLenum stage, const std::vector<uint32_t>& shaderData)
+	void OpenGLShader::ResolveUniformLocations()
 	{
-		return;
+		m_UniformLocations.clear();
 
-		spirv_cross::Compiler compiler(shaderData);
-		spirv_cross::ShaderResources resources = compiler.get_shader_resources();
-		
-		CORE_LOG_TRACE("OpenGLShader::Reflect - {0} {1}", Utils::GLShaderStageToString(stage), m_FilePath);
-		CORE_LOG_TRACE("    {0} uniform buffers", resources.uniform_buffers.size());
-		CORE_LOG_TRACE("    {0} resources", resources.sampled_images.size());
-
-		CORE_LOG_TRACE("Uniform buffers:");
-		
-
-		for (const auto& resource : resources.uniform_buffers)
+		// Every stage reflects the uniforms it uses, the same name shows up more than once
+		std::unordered_map<ShaderUniformID, const std::string*> names;
+		for (const auto& name : m_ReflectedUniforms)
 		{
-			const auto& bufferType = compiler.get_type(resource.base_type_id);
-			uint32_t bufferSize = compiler.get_declared_struct_size(bufferType);
-			uint32_t binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
-			int memberCount = bufferType.member_types.size();
-
-			
-			CORE_LOG_TRACE("  {0}", resource.name);
-			CORE_LOG_TRACE("    Size = {0}", bufferSize);
-			CORE_LOG_TRACE("    Binding = {0}", binding);
-			CORE_LOG_TRACE("    Members = {0}", memberCount);
-			
+			ShaderUniformID id = GetUniformID(name);
+			auto [it, inserted] = names.emplace(id, &name);
+			VS_CORE_ASSERT(inserted || *it->second == name, "Two uniform names hash to the same ShaderUniformID!");
+
+			if (inserted)
+				m_UniformLocations[id] = glGetUniformLocation(m_RendererID, name.c_str());
 		}
+
+		m_ReflectedUniforms.clear();
 	}
 
 	void OpenGLShader::Bind() const
@@ -608,6 +492,41 @@ namespace Venus {
 		UploadUniformMat4(name, value);
 	}
 
+	void OpenGLShader::SetInt(const ShaderUniformName& uniform, int value)
+	{
+		glUniform1i(GetUniformLocation(uniform), value);
+	}
+
+	void OpenGLShader::SetIntArray(const ShaderUniformName& uniform, int* values, uint32_t count)
+	{
+		glUniform1iv(GetUniformLocation(uniform), count, values);
+	}
+
+	void OpenGLShader::SetFloat(const ShaderUniformName& uniform, float value)
+	{
+		glUniform1f(GetUniformLocation(uniform), value);
+	}
+
+	void OpenGLShader::SetFloat2(const ShaderUniformName& uniform, const glm::vec2& value)
+	{
+		glUniform2f(GetUniformLocation(uniform), value.x, value.y);
+	}
+
+	void OpenGLShader::SetFloat3(const ShaderUniformName& uniform, const glm::vec3& value)
+	{
+		glUniform3f(GetUniformLocation(uniform), value.x, value.y, value.z);
+	}
+
+	void OpenGLShader::SetFloat4(const ShaderUniformName& uniform, const glm::vec4& value)
+	{
+		glUniform4f(GetUniformLocation(uniform), value.x, value.y, value.z, value.w);
+	}
+
+	void OpenGLShader::SetMat4(const ShaderUniformName& uniform, const glm::mat4& value)
+	{
+		glUniformMatrix4fv(GetUniformLocation(uniform), 1, GL_FALSE, glm::value_ptr(value));
+	}
+
 	void OpenGLShader::SetTexture(const std::string& name, int binding, uint32_t texture)
 	{
 		glActiveTexture(GL_TEXTURE0 + binding);
@@ -676,7 +595,25 @@ namespace Venus {
 
 	int OpenGLShader::GetUniformLocation(const std::string& name)
 	{
+		ShaderUniformID id = GetUniformID(name);
+		auto it = m_UniformLocations.find(id);
+		if (it != m_UniformLocations.end())
+			return it->second;
+
+		// Not found by reflection (nested members, AMD path), query once and keep it
 		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		m_UniformLocations[id] = location;
+		return (int)location;
+	}
+
+	int OpenGLShader::GetUniformLocation(const ShaderUniformName& uniform)
+	{
+		auto it = m_UniformLocations.find(uniform.ID);
+		if (it != m_UniformLocations.end())
+			return it->second;
+
+		GLint location = glGetUniformLocation(m_RendererID, std::string(uniform.Name).c_str());
+		m_UniformLocations[uniform.ID] = location;
 		return (int)location;
 	}
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Renderer/Shader.h"
+#include "Renderer/ShaderCompiler.h"
 #include <glm/glm.hpp>
 
 typedef unsigned int GLenum;
@@ -10,7 +11,7 @@ namespace Venus {
 	class OpenGLShader : public Shader
 	{
 		public:
-			OpenGLShader(const std::string& filepath);
+			OpenGLShader(const std::string& filepath, const std::vector<ShaderSpecializationConstant>& specialization = {});
 			OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
 			virtual ~OpenGLShader();
 
@@ -18,6 +19,7 @@ namespace Venus {
 			virtual void Unbind() const override;
 
 			virtual const std::string& GetName() const override { return m_Name; }
+			virtual const ShaderBuffer* GetMaterialBuffer() const override { return m_MaterialBuffer.Size ? &m_MaterialBuffer : nullptr; }
 
 			virtual void SetInt(const std::string& name, int value) override;
 			virtual void SetIntArray(const std::string& name, int* values, uint32_t count) override;
@@ -27,6 +29,14 @@ namespace Venus {
 			virtual void SetFloat4(const std::string& name, const glm::vec4& value) override;
 			virtual void SetMat4(const std::string& name, const glm::mat4& value) override;
 
+			virtual void SetInt(const ShaderUniformName& uniform, int value) override;
+			virtual void SetIntArray(const ShaderUniformName& uniform, int* values, uint32_t count) override;
+			virtual void SetFloat(const ShaderUniformName& uniform, float value) override;
+			virtual void SetFloat2(const ShaderUniformName& uniform, const glm::vec2& value) override;
+			virtual void SetFloat3(const ShaderUniformName& uniform, const glm::vec3& value) override;
+			virtual void SetFloat4(const ShaderUniformName& uniform, const glm::vec4& value) override;
+			virtual void SetMat4(const ShaderUniformName& uniform, const glm::mat4& value) override;
+
 			virtual void SetTexture(const std::string& name, int binding, uint32_t texture) override;
 			virtual void SetCubeMap(const std::string& name, int binding, uint32_t texture) override;
 			virtual void SetTextureArray(const std::string& name, int binding, uint32_t texture) override;
@@ -43,12 +53,10 @@ namespace Venus {
 			void UploadUniformMat4(const std::string& name, const glm::mat4& matrix);
 
 			virtual int GetUniformLocation(const std::string& name) override;
+			virtual int GetUniformLocation(const ShaderUniformName& uniform) override;
 
 		private:
-			std::string ReadFile(const std::string& filepath);
-			std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);
-
-			void CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& shaderSources);
+			void CompileOrGetVulkanBinaries(const std::unordered_map<ShaderStage, std::string>& shaderSources);
 			void CompileOrGetOpenGLBinaries();
 			void CreateProgram();
 
@@ -56,16 +64,26 @@ namespace Venus {
 			void CompileOpenGLBinariesAMD(GLenum& program, std::array<uint32_t, 2>& glShadersIDs);
 			void CreateProgramAMD();
 
-			void Reflect(GLenum stage, const std::vector<uint32_t>& shaderData);
+			void ResolveUniformLocations();
 		private:
 			uint32_t m_RendererID;
 			std::string m_FilePath;
 			std::string m_Name;
 
+			// Baked into the OpenGL binaries, which are cached per variant under m_CacheName
+			std::vector<ShaderSpecializationConstant> m_Specialization;
+			std::string m_CacheName;
+
 			std::unordered_map<GLenum, std::vector<uint32_t>> m_VulkanSPIRV;
 			std::unordered_map<GLenum, std::vector<uint32_t>> m_OpenGLSPIRV;
 
 			std::unordered_map<GLenum, std::string> m_OpenGLSourceCode;
+
+			// Uniform names found by reflection, resolved into locations once the program is linked
+			std::vector<std::string> m_ReflectedUniforms;
+			std::unordered_map<ShaderUniformID, int> m_UniformLocations;
+
+			ShaderBuffer m_MaterialBuffer;
 	};
 
 }
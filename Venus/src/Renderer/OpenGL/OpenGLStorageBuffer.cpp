@@ -0,0 +1,38 @@
+#include "pch.h"
+#include "OpenGLStorageBuffer.h"
+
+#include <glad/glad.h>
+
+namespace Venus {
+
+	OpenGLStorageBuffer::OpenGLStorageBuffer(uint32_t size, uint32_t binding)
+		: m_Size(size), m_Binding(binding)
+	{
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_RendererID);
+	}
+
+	OpenGLStorageBuffer::~OpenGLStorageBuffer()
+	{
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLStorageBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		VS_CORE_ASSERT(offset + size <= m_Size, "Storage buffer overflow!");
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
+	void OpenGLStorageBuffer::Resize(uint32_t size)
+	{
+		if (size == m_Size)
+			return;
+
+		// Contents are discarded, callers upload the whole buffer after growing it
+		m_Size = size;
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, m_Binding, m_RendererID);
+	}
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Renderer/StorageBuffer.h"
+
+namespace Venus {
+
+	class OpenGLStorageBuffer : public StorageBuffer
+	{
+		public:
+			OpenGLStorageBuffer(uint32_t size, uint32_t binding);
+			virtual ~OpenGLStorageBuffer();
+
+			virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+			virtual void Resize(uint32_t size) override;
+
+			virtual uint32_t GetSize() const override { return m_Size; }
+
+		private:
+			uint32_t m_RendererID = 0;
+			uint32_t m_Size = 0;
+			uint32_t m_Binding = 0;
+	};
+}
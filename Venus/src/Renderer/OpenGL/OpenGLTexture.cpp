@@ -4,6 +4,9 @@
 #include <stb_image.h>
 #include "glm/glm.hpp"
 
+#include "Renderer/Image.h"
+#include "Renderer/RingBuffer.h"
+
 namespace Venus {
 
 	/////////////////////////////////////////////////////////////////////////////
@@ -16,138 +19,133 @@ namespace Venus {
 		Invalidate();
 	}
 
-	OpenGLTexture2D::OpenGLTexture2D(const std::string& path, TextureProperties props)
-		: m_Path(path), m_Properties(props)
+	OpenGLTexture2D::OpenGLTexture2D(const std::string& path, TextureProperties props, bool streamed)
+		: m_Path(path), m_Properties(props), m_Streamed(streamed)
 	{
 		Invalidate();
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
+		TextureStreamer::Cancel(m_StreamRequest);
 		glDeleteTextures(1, &m_RendererID);
+		glDeleteTextures(1, &m_PendingCompressed.RendererID);
 	}
 
 	void OpenGLTexture2D::Invalidate()
 	{
+		// Storage is immutable, a reload replaces the whole texture
+		TextureStreamer::Cancel(m_StreamRequest);
+		m_StreamRequest = nullptr;
+
+		if (m_RendererID)
+		{
+			glDeleteTextures(1, &m_RendererID);
+			m_RendererID = 0;
+		}
+		if (m_PendingCompressed.RendererID)
+		{
+			glDeleteTextures(1, &m_PendingCompressed.RendererID);
+			m_PendingCompressed.RendererID = 0;
+		}
+		m_Compressed = false;
+		m_DataFormat = GL_RGBA;
+
 		//-- Create Texture and load Data---------------------------------------------------------------
 		if (!m_Path.empty())
 		{
-			int width, height, channels;
+			bool streamed = m_Streamed && TextureStreamer::IsInitialized();
 
-			//-- HDR Image------------------------------------------------------------------------------
-			if (stbi_is_hdr(m_Path.c_str()))
+			// Streamed textures only need the header to size their storage
+			Scope<Image> image;
+			bool isHDR = false;
+			if (streamed)
 			{
-				stbi_set_flip_vertically_on_load(m_Properties.FlipVertically);
-				float* data = nullptr;
-				data = stbi_loadf(m_Path.c_str(), &width, &height, &channels, 4);
-
-				if (data)
+				if (!Image::GetInfo(m_Path, m_Width, m_Height, isHDR))
 				{
-					m_IsLoaded = true;
-
-					m_Width = width;
-					m_Height = height;
-
-					m_Properties.Format = TextureFormat::RGBA32F;
-
-					uint32_t mipmapCount = m_Properties.GenerateMipmaps ? GetMipLevelCount() : 1;
-
-					m_InternalFormat = OpenGLTextureFormat(m_Properties.Format);
-					m_DataFormat = GL_RGBA;
-
-					glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-					glTextureStorage2D(m_RendererID, mipmapCount, m_InternalFormat, m_Width, m_Height);
-
-					GLenum minFilter = OpenGLFilterMode(m_Properties.Filter);
-					if (m_Properties.UseMipmaps && minFilter == GL_LINEAR)
-						minFilter = GL_LINEAR_MIPMAP_LINEAR;
-					else if (m_Properties.UseMipmaps && minFilter == GL_NEAREST)
-						minFilter = GL_NEAREST_MIPMAP_NEAREST;
-
-					glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, minFilter);
-					glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, OpenGLFilterMode(m_Properties.Filter));
-					glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, OpenGLWrapMode(m_Properties.WrapMode));
-					glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, OpenGLWrapMode(m_Properties.WrapMode));
-
-					glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_FLOAT, data);
-
-					if (m_Properties.GenerateMipmaps)
-						GenerateMips();
-
-					stbi_image_free(data);
+					CORE_LOG_ERROR("Could not load texture: {0}", m_Path);
+					return;
 				}
-				else
-					CORE_LOG_ERROR("Could not load HDR texture: {0}", m_Path);
 			}
-			//-- Normal Image---------------------------------------------------------------------------
 			else
 			{
-				stbi_set_flip_vertically_on_load(m_Properties.FlipVertically);
-				stbi_uc* data = nullptr;
-				data = stbi_load(m_Path.c_str(), &width, &height, &channels, 4);
-
-				if (data)
+				image = Image::Load(m_Path, m_Properties.FlipVertically);
+				if (!image)
 				{
-					m_IsLoaded = true;
-
-					m_Width = width;
-					m_Height = height;
-
-					m_InternalFormat = OpenGLTextureFormat(m_Properties.Format);
-					m_DataFormat = GL_RGBA;
+					CORE_LOG_ERROR("Could not load texture: {0}", m_Path);
+					return;
+				}
 
-					uint32_t mipmapCount = m_Properties.GenerateMipmaps ? GetMipLevelCount() : 1;
+				m_Width = image->GetWidth();
+				m_Height = image->GetHeight();
+				isHDR = image->IsHDR();
+			}
 
-					glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-					glTextureStorage2D(m_RendererID, mipmapCount, m_InternalFormat, m_Width, m_Height);
+			m_IsLoaded = true;
 
-					GLenum minFilter = OpenGLFilterMode(m_Properties.Filter);
-					if (m_Properties.UseMipmaps && minFilter == GL_LINEAR)
-						minFilter = GL_LINEAR_MIPMAP_LINEAR;
-					else if (m_Properties.UseMipmaps && minFilter == GL_NEAREST)
-						minFilter = GL_NEAREST_MIPMAP_NEAREST;
+			//-- HDR Image------------------------------------------------------------------------------
+			if (isHDR)
+			{
+				m_Properties.Format = TextureFormat::RGBA32F;
+				m_DataType = GL_FLOAT;
+			}
+			//-- Normal Image---------------------------------------------------------------------------
+			else
+			{
+				m_DataType = GL_UNSIGNED_BYTE;
+			}
 
-					glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, minFilter);
-					glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, OpenGLFilterMode(m_Properties.Filter));
-					glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, OpenGLWrapMode(m_Properties.WrapMode));
-					glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, OpenGLWrapMode(m_Properties.WrapMode));
+			uint32_t mipmapCount = m_Properties.GenerateMipmaps ? GetMipLevelCount() : 1;
+			m_InternalFormat = OpenGLTextureFormat(m_Properties.Format);
+			m_RendererID = CreateStorage(m_InternalFormat, m_Width, m_Height, mipmapCount);
 
-					glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+			if (image)
+			{
+				glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, m_DataType, image->GetData());
 
-					if (m_Properties.GenerateMipmaps)
-						GenerateMips();
+				if (m_Properties.GenerateMipmaps)
+					GenerateMips();
+			}
+			else
+			{
+				// Opaque white until the streamer filled in the real data
+				uint32_t placeholder = 0xffffffff;
+				for (uint32_t mip = 0; mip < mipmapCount; mip++)
+					glClearTexImage(m_RendererID, mip, GL_RGBA, GL_UNSIGNED_BYTE, &placeholder);
 
-					stbi_image_free(data);
-				}
-				else
-					CORE_LOG_ERROR("Could not load texture: {0}", m_Path);
+				// Asset textures swap to their block compressed copy once it has been cooked
+				m_StreamRequest = TextureStreamer::Request(this, m_Path, m_Properties.FlipVertically, !isHDR, m_Properties.Usage);
 			}
 		}
 		//-- Create Texture Storage Only----------------------------------------------------------------
 		else
 		{
 			m_InternalFormat = OpenGLTextureFormat(m_Properties.Format);
-			m_DataFormat = GL_RGBA;
+			m_RendererID = CreateStorage(m_InternalFormat, m_Width, m_Height, m_Properties.GenerateMipmaps ? GetMipLevelCount() : 1);
 
-			uint32_t mipmapCount = m_Properties.GenerateMipmaps ? GetMipLevelCount() : 1;
+			if (m_Properties.GenerateMipmaps)
+				GenerateMips();
+		}
+	}
 
-			glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-			glTextureStorage2D(m_RendererID, mipmapCount, m_InternalFormat, m_Width, m_Height);
+	uint32_t OpenGLTexture2D::CreateStorage(GLenum internalFormat, uint32_t width, uint32_t height, uint32_t mipmapCount) const
+	{
+		uint32_t rendererID;
+		glCreateTextures(GL_TEXTURE_2D, 1, &rendererID);
+		glTextureStorage2D(rendererID, mipmapCount, internalFormat, width, height);
 
-			GLenum minFilter = OpenGLFilterMode(m_Properties.Filter);
-			if (m_Properties.UseMipmaps && minFilter == GL_LINEAR)
-				minFilter = GL_LINEAR_MIPMAP_LINEAR;
-			else if (m_Properties.UseMipmaps && minFilter == GL_NEAREST)
-				minFilter = GL_NEAREST_MIPMAP_NEAREST;
+		GLenum minFilter = OpenGLFilterMode(m_Properties.Filter);
+		if (m_Properties.UseMipmaps && minFilter == GL_LINEAR)
+			minFilter = GL_LINEAR_MIPMAP_LINEAR;
+		else if (m_Properties.UseMipmaps && minFilter == GL_NEAREST)
+			minFilter = GL_NEAREST_MIPMAP_NEAREST;
 
-			glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, minFilter);
-			glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, OpenGLFilterMode(m_Properties.Filter));
-			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, OpenGLWrapMode(m_Properties.WrapMode));
-			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, OpenGLWrapMode(m_Properties.WrapMode));
+		glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, minFilter);
+		glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, OpenGLFilterMode(m_Properties.Filter));
+		glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, OpenGLWrapMode(m_Properties.WrapMode));
+		glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, OpenGLWrapMode(m_Properties.WrapMode));
 
-			if (m_Properties.GenerateMipmaps)
-				GenerateMips();
-		}
+		return rendererID;
 	}
 
 	void OpenGLTexture2D::Reload()
@@ -171,12 +169,60 @@ namespace Venus {
 		else
 			desiredSize = m_Width * m_Height * 4;
 
+		VS_CORE_ASSERT(!m_Compressed, "Compressed textures can't be written!");
 		VS_CORE_ASSERT(size == desiredSize, "Data must be entire texture!");
 		glTextureSubImage2D(m_RendererID, mipLevel, 0, 0, width, height, m_DataFormat, GL_UNSIGNED_BYTE, data);
 	}
 
+	void OpenGLTexture2D::SetData(const Ref<RingBuffer>& buffer, uint32_t offset, uint32_t y, uint32_t rows)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->GetRendererID());
+		glTextureSubImage2D(m_RendererID, 0, 0, y, m_Width, rows, m_DataFormat, m_DataType, (const void*)(uintptr_t)offset);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	void OpenGLTexture2D::BeginCompressedData(TextureCompression compression, uint32_t width, uint32_t height, uint32_t levelCount)
+	{
+		// Mips come from the cook, GenerateMipmaps only decides whether they are used
+		m_PendingCompressed.Compression = compression;
+		m_PendingCompressed.InternalFormat = OpenGLCompressedFormat(compression, m_Properties.Format == TextureFormat::SRGB);
+		m_PendingCompressed.Width = width;
+		m_PendingCompressed.Height = height;
+		m_PendingCompressed.RendererID = CreateStorage(m_PendingCompressed.InternalFormat, width, height, levelCount);
+	}
+
+	void OpenGLTexture2D::SetCompressedData(const Ref<RingBuffer>& buffer, uint32_t offset, uint32_t level, uint32_t y, uint32_t rows)
+	{
+		VS_CORE_ASSERT(m_PendingCompressed.RendererID, "BeginCompressedData wasn't called!");
+
+		uint32_t width = std::max(m_PendingCompressed.Width >> level, 1u);
+		uint32_t size = (uint32_t)TextureCompressor::GetCompressedSize(m_PendingCompressed.Compression, width, rows);
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->GetRendererID());
+		glCompressedTextureSubImage2D(m_PendingCompressed.RendererID, level, 0, y, width, rows, m_PendingCompressed.InternalFormat, size, (const void*)(uintptr_t)offset);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	void OpenGLTexture2D::EndCompressedData()
+	{
+		glDeleteTextures(1, &m_RendererID);
+
+		m_RendererID = m_PendingCompressed.RendererID;
+		m_InternalFormat = m_PendingCompressed.InternalFormat;
+		m_Width = m_PendingCompressed.Width;
+		m_Height = m_PendingCompressed.Height;
+		m_DataType = GL_UNSIGNED_BYTE;
+		m_Compressed = true;
+
+		m_PendingCompressed.RendererID = 0;
+	}
+
 	void OpenGLTexture2D::GenerateMips()
 	{
+		// Cooked textures ship their mips
+		if (m_Compressed)
+			return;
+
 		glBindTexture(GL_TEXTURE_2D, m_RendererID);
 		glGenerateMipmap(GL_TEXTURE_2D);
 	}
@@ -221,7 +267,7 @@ namespace Venus {
 		: m_Width(width), m_Height(height), m_Properties(props)
 	{
 		m_InternalFormat = OpenGLTextureFormat(props.Format);
-		m_DataFormat = GL_RGBA;
+		m_DataFormat = OpenGLTextureDataFormat(props.Format);
 
 		glGenTextures(1, &m_RendererID);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
@@ -317,6 +363,27 @@ namespace Venus {
 		glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 	}
 
+	uint32_t OpenGLTextureCube::GetLevelSize(uint32_t mipLevel) const
+	{
+		auto [width, height] = GetMipSize(mipLevel);
+		return width * height * 6 * OpenGLTextureBytesPerTexel(m_Properties.Format);
+	}
+
+	void OpenGLTextureCube::GetLevelData(void* data, uint32_t size, uint32_t mipLevel) const
+	{
+		VS_CORE_ASSERT(size == GetLevelSize(mipLevel), "Data must be entire level!");
+		glGetTextureImage(m_RendererID, mipLevel, m_DataFormat, OpenGLTextureDataType(m_Properties.Format), size, data);
+	}
+
+	void OpenGLTextureCube::SetLevelData(const void* data, uint32_t size, uint32_t mipLevel)
+	{
+		VS_CORE_ASSERT(size == GetLevelSize(mipLevel), "Data must be entire level!");
+
+		// Faces are the layers of a cube map for the DSA calls
+		auto [width, height] = GetMipSize(mipLevel);
+		glTextureSubImage3D(m_RendererID, mipLevel, 0, 0, 0, width, height, 6, m_DataFormat, OpenGLTextureDataType(m_Properties.Format), data);
+	}
+
 	void OpenGLTextureCube::Bind(uint32_t slot) const
 	{
 		glBindTextureUnit(slot, m_RendererID);
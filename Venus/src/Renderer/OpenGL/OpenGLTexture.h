@@ -1,9 +1,19 @@
 #pragma once
 
 #include "Renderer/Texture.h"
+#include "Renderer/TextureCompressor.h"
+#include "Renderer/TextureStreamer.h"
 
 #include <glad/glad.h>
 
+// S3TC is an extension, glad only knows the core formats
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+
 namespace Venus {
 
 	static GLenum OpenGLWrapMode(TextureWrapMode mode)
@@ -34,14 +44,59 @@ namespace Venus {
 			case TextureFormat::RGBA8:		return GL_RGBA8;
 			case TextureFormat::RGBA16F:	return GL_RGBA16F;
 			case TextureFormat::RGBA32F:	return GL_RGBA32F;
+			case TextureFormat::R11G11B10F:	return GL_R11F_G11F_B10F;
+		}
+	}
+
+	static GLenum OpenGLTextureDataType(TextureFormat format)
+	{
+		switch (format)
+		{
+			case TextureFormat::SRGB:		return GL_UNSIGNED_BYTE;
+			case TextureFormat::RGBA8:		return GL_UNSIGNED_BYTE;
+			case TextureFormat::RGBA16F:	return GL_HALF_FLOAT;
+			case TextureFormat::RGBA32F:	return GL_FLOAT;
+			case TextureFormat::R11G11B10F:	return GL_UNSIGNED_INT_10F_11F_11F_REV;
 		}
 	}
 
+	static GLenum OpenGLTextureDataFormat(TextureFormat format)
+	{
+		// The packed type only pairs with three components
+		return format == TextureFormat::R11G11B10F ? GL_RGB : GL_RGBA;
+	}
+
+	static uint32_t OpenGLTextureBytesPerTexel(TextureFormat format)
+	{
+		switch (format)
+		{
+			case TextureFormat::SRGB:		return 4;
+			case TextureFormat::RGBA8:		return 4;
+			case TextureFormat::RGBA16F:	return 8;
+			case TextureFormat::RGBA32F:	return 16;
+			case TextureFormat::R11G11B10F:	return 4;
+		}
+	}
+
+	static GLenum OpenGLCompressedFormat(TextureCompression compression, bool sRGB)
+	{
+		switch (compression)
+		{
+			case TextureCompression::BC1:	return sRGB ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+			case TextureCompression::BC4:	return GL_COMPRESSED_RED_RGTC1;
+			case TextureCompression::BC5:	return GL_COMPRESSED_RG_RGTC2;
+			case TextureCompression::BC7:	return sRGB ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+		}
+
+		VS_CORE_ASSERT(false, "Unknown Compression");
+		return 0;
+	}
+
 	class OpenGLTexture2D : public Texture2D
 	{
 		public:
 			OpenGLTexture2D(uint32_t width, uint32_t height, TextureProperties props = TextureProperties());
-			OpenGLTexture2D(const std::string& path, TextureProperties props = TextureProperties());
+			OpenGLTexture2D(const std::string& path, TextureProperties props = TextureProperties(), bool streamed = false);
 			virtual ~OpenGLTexture2D();
 			
 			void Invalidate();
@@ -54,6 +109,10 @@ namespace Venus {
 		
 			virtual void Reload() override;
 			virtual void SetData(void* data, uint32_t size, uint32_t mipLevel = 0) override;
+			virtual void SetData(const Ref<RingBuffer>& buffer, uint32_t offset, uint32_t y, uint32_t rows) override;
+			virtual void BeginCompressedData(TextureCompression compression, uint32_t width, uint32_t height, uint32_t levelCount) override;
+			virtual void SetCompressedData(const Ref<RingBuffer>& buffer, uint32_t offset, uint32_t level, uint32_t y, uint32_t rows) override;
+			virtual void EndCompressedData() override;
 			virtual void GenerateMips() override;
 
 			virtual void Bind(uint32_t slot = 0) const override;
@@ -74,13 +133,31 @@ namespace Venus {
 			}
 
 		private:
-			uint32_t m_RendererID;
+			uint32_t CreateStorage(GLenum internalFormat, uint32_t width, uint32_t height, uint32_t mipmapCount) const;
+
+		private:
+			uint32_t m_RendererID = 0;
 			std::string m_Path;
 			bool m_IsLoaded = false;
 
 			TextureProperties m_Properties;
 			uint32_t m_Width, m_Height;
 			GLenum m_InternalFormat, m_DataFormat;
+			GLenum m_DataType = GL_UNSIGNED_BYTE;
+			bool m_Compressed = false;
+
+			// Filled by the streamer while the placeholder stays bound
+			struct PendingCompressedStorage
+			{
+				uint32_t RendererID = 0;
+				GLenum InternalFormat = 0;
+				TextureCompression Compression = TextureCompression::None;
+				uint32_t Width = 0, Height = 0;
+			};
+			PendingCompressedStorage m_PendingCompressed;
+
+			bool m_Streamed = false;
+			Ref<TextureStreamRequest> m_StreamRequest;
 	};
 
 	class OpenGLTextureCube : public TextureCube
@@ -100,6 +177,10 @@ namespace Venus {
 			virtual void SetData(void* data, uint32_t size, uint32_t mipLevel = 0) override;
 			virtual void GenerateMips() override;
 
+			virtual uint32_t GetLevelSize(uint32_t mipLevel) const override;
+			virtual void GetLevelData(void* data, uint32_t size, uint32_t mipLevel) const override;
+			virtual void SetLevelData(const void* data, uint32_t size, uint32_t mipLevel) override;
+
 			virtual void Bind(uint32_t slot = 0) const override;
 
 			virtual bool IsLoaded() const override { return m_IsLoaded; }
@@ -119,7 +200,7 @@ namespace Venus {
 			}
 
 		private:
-			uint32_t m_RendererID;
+			uint32_t m_RendererID = 0;
 			std::string m_Path;
 			bool m_IsLoaded = false;
 	
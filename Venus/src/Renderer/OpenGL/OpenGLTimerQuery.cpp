@@ -0,0 +1,53 @@
+#include "pch.h"
+#include "OpenGLTimerQuery.h"
+
+#include <glad/glad.h>
+
+namespace Venus {
+
+	OpenGLTimerQueryPool::OpenGLTimerQueryPool(uint32_t capacity)
+	{
+		m_Queries.resize(capacity);
+		glCreateQueries(GL_TIMESTAMP, capacity, m_Queries.data());
+	}
+
+	OpenGLTimerQueryPool::~OpenGLTimerQueryPool()
+	{
+		glDeleteQueries((GLsizei)m_Queries.size(), m_Queries.data());
+	}
+
+	void OpenGLTimerQueryPool::WriteTimestamp(uint32_t index)
+	{
+		VS_CORE_ASSERT(index < m_Queries.size(), "Timer query index out of range!");
+		glQueryCounter(m_Queries[index], GL_TIMESTAMP);
+	}
+
+	bool OpenGLTimerQueryPool::GetTimestamps(uint32_t first, uint32_t count, uint64_t* timestamps)
+	{
+		VS_CORE_ASSERT(first + count <= m_Queries.size(), "Timer query range out of range!");
+		if (count == 0)
+			return true;
+
+		// Queries finish in order, so the newest one is the first to be missing
+		for (int32_t i = (int32_t)count - 1; i >= 0; i--)
+		{
+			GLint available = GL_FALSE;
+			glGetQueryObjectiv(m_Queries[first + i], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return false;
+		}
+
+		for (uint32_t i = 0; i < count; i++)
+			glGetQueryObjectui64v(m_Queries[first + i], GL_QUERY_RESULT, &timestamps[i]);
+
+		return true;
+	}
+
+	uint64_t OpenGLTimerQueryPool::GetCurrentTimestamp()
+	{
+		GLint64 timestamp = 0;
+		glGetInteger64v(GL_TIMESTAMP, &timestamp);
+		return (uint64_t)timestamp;
+	}
+
+}
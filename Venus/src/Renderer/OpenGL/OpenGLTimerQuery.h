@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Renderer/TimerQuery.h"
+
+namespace Venus {
+
+	class OpenGLTimerQueryPool : public TimerQueryPool
+	{
+		public:
+			OpenGLTimerQueryPool(uint32_t capacity);
+			virtual ~OpenGLTimerQueryPool();
+
+			virtual void WriteTimestamp(uint32_t index) override;
+			virtual bool GetTimestamps(uint32_t first, uint32_t count, uint64_t* timestamps) override;
+			virtual uint64_t GetCurrentTimestamp() override;
+
+			virtual uint32_t GetCapacity() const override { return (uint32_t)m_Queries.size(); }
+
+		private:
+			std::vector<uint32_t> m_Queries;
+	};
+
+}
@@ -6,6 +6,7 @@
 namespace Venus {
 
 	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, uint32_t binding)
+		: m_Binding(binding)
 	{
 		glCreateBuffers(1, &m_RendererID);
 		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW); 
@@ -23,4 +24,14 @@ namespace Venus {
 		glNamedBufferSubData(m_RendererID, offset, size, data);
 	}
 
+	void OpenGLUniformBuffer::Bind()
+	{
+		glBindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_RendererID);
+	}
+
+	void OpenGLUniformBuffer::BindRange(uint32_t offset, uint32_t size)
+	{
+		glBindBufferRange(GL_UNIFORM_BUFFER, m_Binding, m_RendererID, offset, size);
+	}
+
 }
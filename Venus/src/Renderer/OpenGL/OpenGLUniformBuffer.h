@@ -11,7 +11,11 @@ namespace Venus {
 			virtual ~OpenGLUniformBuffer();
 
 			virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+			virtual void Bind() override;
+			virtual void BindRange(uint32_t offset, uint32_t size) override;
+
 		private:
 			uint32_t m_RendererID = 0;
+			uint32_t m_Binding = 0;
 	};
 }
@@ -3,6 +3,7 @@
 
 namespace Venus {
 
-	Scope<RendererAPI> RenderCommand::s_RendererAPI = RendererAPI::Create();
+	// Created by Init, the API can still be changed until then
+	Scope<RendererAPI> RenderCommand::s_RendererAPI;
 
 }
\ No newline at end of file
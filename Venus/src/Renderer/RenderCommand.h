@@ -9,6 +9,7 @@ namespace Venus {
 		public:
 			static void Init()
 			{
+				s_RendererAPI = RendererAPI::Create();
 				s_RendererAPI->Init();
 			}
 
@@ -57,6 +58,16 @@ namespace Venus {
 				s_RendererAPI->EnableDepthTest();
 			}
 
+			static void DisableDepthWrite()
+			{
+				s_RendererAPI->DisableDepthWrite();
+			}
+
+			static void EnableDepthWrite()
+			{
+				s_RendererAPI->EnableDepthWrite();
+			}
+
 			static void SetStencilTest(int function, int value, int mask)
 			{
 				s_RendererAPI->SetStencilTest(function, value, mask);
@@ -67,6 +78,16 @@ namespace Venus {
 				s_RendererAPI->SetLineWidth(width);
 			}
 
+			static void PushDebugGroup(const std::string& name)
+			{
+				s_RendererAPI->PushDebugGroup(name);
+			}
+
+			static void PopDebugGroup()
+			{
+				s_RendererAPI->PopDebugGroup();
+			}
+
 			static void BindTexture(int location, int textureID)
 			{
 				s_RendererAPI->BindTexture(location, textureID);
@@ -81,15 +102,25 @@ namespace Venus {
 			{
 				s_RendererAPI->BindTextureArray(location, textureID);
 			}
+
+			static void BindSampler(int location, int samplerID)
+			{
+				s_RendererAPI->BindSampler(location, samplerID);
+			}
 			
 			static void BindFramebuffer(int framebufferID)
 			{
 				s_RendererAPI->BindFramebuffer(framebufferID);
 			}
 
-			static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0)
+			static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0)
+			{
+				s_RendererAPI->DrawIndexed(vertexArray, indexCount, baseVertex);
+			}
+
+			static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount = 0)
 			{
-				s_RendererAPI->DrawIndexed(vertexArray, indexCount);
+				s_RendererAPI->DrawIndexedInstanced(vertexArray, instanceCount, indexCount);
 			}
 
 			static void DrawArrays(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
@@ -97,9 +128,9 @@ namespace Venus {
 				s_RendererAPI->DrawArrays(vertexArray, indexCount);
 			}
 
-			static void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
+			static void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t firstVertex = 0)
 			{
-				s_RendererAPI->DrawLines(vertexArray, vertexCount);
+				s_RendererAPI->DrawLines(vertexArray, vertexCount, firstVertex);
 			}
 
 		private:
@@ -0,0 +1,459 @@
+#include "pch.h"
+#include "RenderGraph.h"
+
+#include "Renderer/Renderer.h"
+#include "Renderer/GPUProfiler.h"
+
+namespace Venus {
+
+	namespace Utils {
+
+		static bool IsDepthFormat(FramebufferTextureFormat format)
+		{
+			switch (format)
+			{
+				case FramebufferTextureFormat::DEPTH24STENCIL8:		return true;
+				case FramebufferTextureFormat::DEPTH32FSTENCIL8:	return true;
+				case FramebufferTextureFormat::DEPTH24:				return true;
+				case FramebufferTextureFormat::DEPTH32F:			return true;
+				case FramebufferTextureFormat::STENCIL8:			return true;
+			}
+
+			return false;
+		}
+
+		static uint32_t GetBytesPerTexel(FramebufferTextureFormat format)
+		{
+			switch (format)
+			{
+				case FramebufferTextureFormat::RGBA8:				return 4;
+				case FramebufferTextureFormat::RGBA16F:				return 8;
+				case FramebufferTextureFormat::RGBA32F:				return 16;
+				case FramebufferTextureFormat::R11G11B10F:			return 4;
+				case FramebufferTextureFormat::RED_INTEGER:			return 4;
+				case FramebufferTextureFormat::DEPTH24STENCIL8:		return 4;
+				case FramebufferTextureFormat::DEPTH32FSTENCIL8:	return 8;
+				case FramebufferTextureFormat::DEPTH24:				return 4;
+				case FramebufferTextureFormat::DEPTH32F:			return 4;
+				case FramebufferTextureFormat::STENCIL8:			return 1;
+			}
+
+			return 0;
+		}
+
+		static uint32_t GetBytesPerTexel(TextureFormat format)
+		{
+			switch (format)
+			{
+				case TextureFormat::SRGB:		return 4;
+				case TextureFormat::RGBA8:		return 4;
+				case TextureFormat::RGBA16F:	return 8;
+				case TextureFormat::RGBA32F:	return 16;
+				case TextureFormat::R11G11B10F:	return 4;
+			}
+
+			return 0;
+		}
+
+		static bool IsCompatible(const FramebufferSpecification& a, const FramebufferSpecification& b)
+		{
+			if (a.Width != b.Width || a.Height != b.Height || a.Samples != b.Samples || a.Layers != b.Layers)
+				return false;
+
+			if (a.ColorTextureFilter != b.ColorTextureFilter || a.ColorWrapMode != b.ColorWrapMode
+				|| a.DepthTextureFilter != b.DepthTextureFilter || a.DepthWrapMode != b.DepthWrapMode)
+				return false;
+
+			// Pooled targets always own their attachments
+			if (!a.ExistingColorTextures.empty() || !b.ExistingColorTextures.empty() || a.ExistingDepthTexture || b.ExistingDepthTexture)
+				return false;
+
+			const auto& attachmentsA = a.Attachments.Attachments;
+			const auto& attachmentsB = b.Attachments.Attachments;
+			if (attachmentsA.size() != attachmentsB.size())
+				return false;
+
+			for (size_t i = 0; i < attachmentsA.size(); i++)
+			{
+				if (attachmentsA[i].TextureFormat != attachmentsB[i].TextureFormat)
+					return false;
+			}
+
+			return true;
+		}
+
+		static bool IsCompatible(const RenderGraphTextureSpecification& a, const RenderGraphTextureSpecification& b)
+		{
+			return a.Width == b.Width && a.Height == b.Height && a.Properties == b.Properties;
+		}
+
+		static void AddRequestedSize(std::vector<glm::uvec2>& sizes, uint32_t width, uint32_t height)
+		{
+			glm::uvec2 size = { width, height };
+			if (std::find(sizes.begin(), sizes.end(), size) == sizes.end())
+				sizes.push_back(size);
+		}
+
+		// Nothing requested means the graph didn't run, which says nothing about the sizes still in use
+		static bool IsStaleSize(const std::vector<glm::uvec2>& sizes, uint32_t width, uint32_t height)
+		{
+			return !sizes.empty() && std::find(sizes.begin(), sizes.end(), glm::uvec2(width, height)) == sizes.end();
+		}
+
+	}
+
+	static constexpr uint64_t s_MaxUnusedFrames = 8;
+
+	Ref<Framebuffer> RenderTargetPool::Acquire(const FramebufferSpecification& spec)
+	{
+		Utils::AddRequestedSize(m_RequestedSizes, spec.Width, spec.Height);
+
+		for (auto& entry : m_Entries)
+		{
+			if (!entry.InUse && Utils::IsCompatible(entry.Target->GetSpecification(), spec))
+			{
+				entry.InUse = true;
+				entry.LastUsedFrame = m_FrameIndex;
+				return entry.Target;
+			}
+		}
+
+		Entry& entry = m_Entries.emplace_back();
+		entry.Target = Framebuffer::Create(spec);
+		entry.InUse = true;
+		entry.LastUsedFrame = m_FrameIndex;
+
+		return entry.Target;
+	}
+
+	void RenderTargetPool::Release(const Ref<Framebuffer>& framebuffer)
+	{
+		for (auto& entry : m_Entries)
+		{
+			if (entry.Target == framebuffer)
+			{
+				entry.InUse = false;
+				return;
+			}
+		}
+
+		VS_CORE_ASSERT(false, "Framebuffer doesn't belong to this pool!");
+	}
+
+	void RenderTargetPool::NextFrame()
+	{
+		m_FrameIndex++;
+
+		m_Entries.erase(std::remove_if(m_Entries.begin(), m_Entries.end(), [this](const Entry& entry)
+		{
+			const FramebufferSpecification& spec = entry.Target->GetSpecification();
+			return !entry.InUse && (m_FrameIndex - entry.LastUsedFrame > s_MaxUnusedFrames || Utils::IsStaleSize(m_RequestedSizes, spec.Width, spec.Height));
+		}), m_Entries.end());
+
+		m_RequestedSizes.clear();
+	}
+
+	uint64_t RenderTargetPool::GetMemoryUsage() const
+	{
+		uint64_t size = 0;
+		for (const auto& entry : m_Entries)
+		{
+			const FramebufferSpecification& spec = entry.Target->GetSpecification();
+
+			uint64_t texels = (uint64_t)spec.Width * spec.Height * spec.Layers * spec.Samples;
+			for (const auto& attachment : spec.Attachments.Attachments)
+				size += texels * Utils::GetBytesPerTexel(attachment.TextureFormat);
+		}
+
+		return size;
+	}
+
+	Ref<Texture2D> TexturePool::Acquire(const RenderGraphTextureSpecification& spec)
+	{
+		Utils::AddRequestedSize(m_RequestedSizes, spec.Width, spec.Height);
+
+		for (auto& entry : m_Entries)
+		{
+			RenderGraphTextureSpecification entrySpec = { entry.Texture->GetWidth(), entry.Texture->GetHeight(), entry.Texture->GetProperties() };
+			if (!entry.InUse && Utils::IsCompatible(entrySpec, spec))
+			{
+				entry.InUse = true;
+				entry.LastUsedFrame = m_FrameIndex;
+				return entry.Texture;
+			}
+		}
+
+		Entry& entry = m_Entries.emplace_back();
+		entry.Texture = Texture2D::Create(spec.Width, spec.Height, spec.Properties);
+		entry.InUse = true;
+		entry.LastUsedFrame = m_FrameIndex;
+
+		return entry.Texture;
+	}
+
+	void TexturePool::Release(const Ref<Texture2D>& texture)
+	{
+		for (auto& entry : m_Entries)
+		{
+			if (entry.Texture == texture)
+			{
+				entry.InUse = false;
+				return;
+			}
+		}
+
+		VS_CORE_ASSERT(false, "Texture doesn't belong to this pool!");
+	}
+
+	void TexturePool::NextFrame()
+	{
+		m_FrameIndex++;
+
+		m_Entries.erase(std::remove_if(m_Entries.begin(), m_Entries.end(), [this](const Entry& entry)
+		{
+			return !entry.InUse && (m_FrameIndex - entry.LastUsedFrame > s_MaxUnusedFrames
+				|| Utils::IsStaleSize(m_RequestedSizes, entry.Texture->GetWidth(), entry.Texture->GetHeight()));
+		}), m_Entries.end());
+
+		m_RequestedSizes.clear();
+	}
+
+	uint64_t TexturePool::GetMemoryUsage() const
+	{
+		uint64_t size = 0;
+		for (const auto& entry : m_Entries)
+		{
+			uint32_t bytesPerTexel = Utils::GetBytesPerTexel(entry.Texture->GetProperties().Format);
+			for (uint32_t mip = 0; mip < entry.Texture->GetMipLevelCount(); mip++)
+			{
+				auto [width, height] = entry.Texture->GetMipSize(mip);
+				size += (uint64_t)width * height * bytesPerTexel;
+			}
+		}
+
+		return size;
+	}
+
+	void RenderGraph::Reset()
+	{
+		for (auto& resource : m_Resources)
+		{
+			if (resource.Transient && resource.Target)
+				m_Pool.Release(resource.Target);
+			if (resource.Transient && resource.Texture)
+				m_TexturePool.Release(resource.Texture);
+		}
+
+		m_Resources.clear();
+		m_Passes.clear();
+		m_Pool.NextFrame();
+		m_TexturePool.NextFrame();
+	}
+
+	RenderGraphResource RenderGraph::CreateTarget(const std::string& name, const FramebufferSpecification& spec)
+	{
+		Resource& resource = m_Resources.emplace_back();
+		resource.Name = name;
+		resource.Specification = spec;
+		resource.Transient = true;
+
+		return (RenderGraphResource)m_Resources.size() - 1;
+	}
+
+	RenderGraphResource RenderGraph::CreateTexture(const std::string& name, const RenderGraphTextureSpecification& spec)
+	{
+		Resource& resource = m_Resources.emplace_back();
+		resource.Name = name;
+		resource.TextureSpecification = spec;
+		resource.IsTexture = true;
+		resource.Transient = true;
+
+		return (RenderGraphResource)m_Resources.size() - 1;
+	}
+
+	RenderGraphResource RenderGraph::ImportTarget(const std::string& name, const Ref<Framebuffer>& framebuffer)
+	{
+		Resource& resource = m_Resources.emplace_back();
+		resource.Name = name;
+		resource.Target = framebuffer;
+
+		return (RenderGraphResource)m_Resources.size() - 1;
+	}
+
+	RenderGraphResource RenderGraph::ImportResource(const std::string& name)
+	{
+		Resource& resource = m_Resources.emplace_back();
+		resource.Name = name;
+
+		return (RenderGraphResource)m_Resources.size() - 1;
+	}
+
+	void RenderGraph::AddPass(const std::string& name, const std::vector<RenderGraphResource>& reads, const std::vector<RenderGraphWrite>& writes, const ExecuteFunction& execute)
+	{
+		Pass& pass = m_Passes.emplace_back();
+		pass.Name = name;
+		pass.Reads = reads;
+		pass.Writes = writes;
+		pass.Execute = execute;
+
+		for (RenderGraphResource read : pass.Reads)
+			VS_CORE_ASSERT(read < m_Resources.size(), "Unknown render graph resource!");
+		for (const RenderGraphWrite& write : pass.Writes)
+			VS_CORE_ASSERT(write.Resource < m_Resources.size(), "Unknown render graph resource!");
+	}
+
+	void RenderGraph::SetOutput(RenderGraphResource resource)
+	{
+		VS_CORE_ASSERT(resource < m_Resources.size(), "Unknown render graph resource!");
+		m_Resources[resource].Output = true;
+	}
+
+	void RenderGraph::Execute()
+	{
+		VS_PROFILE_FUNCTION();
+
+		Cull();
+		ComputeLifetimes();
+
+		m_Stats = Statistics();
+		for (uint32_t i = 0; i < (uint32_t)m_Passes.size(); i++)
+		{
+			Pass& pass = m_Passes[i];
+			if (pass.Culled)
+			{
+				m_Stats.CulledPassCount++;
+				continue;
+			}
+
+			for (auto& resource : m_Resources)
+			{
+				if (resource.Transient && resource.FirstPass == (int32_t)i)
+				{
+					if (resource.IsTexture)
+						resource.Texture = m_TexturePool.Acquire(resource.TextureSpecification);
+					else
+						resource.Target = m_Pool.Acquire(resource.Specification);
+
+					m_Stats.TransientTargetCount++;
+				}
+			}
+
+			{
+				GPUProfileScope gpuScope(pass.Name);
+				BeginPass(i);
+				pass.Execute();
+			}
+			m_Stats.PassCount++;
+
+			// Anything released here can be handed to a later pass as its own target
+			for (auto& resource : m_Resources)
+			{
+				if (resource.Transient && resource.LastPass == (int32_t)i && !resource.Output)
+				{
+					if (resource.IsTexture)
+						m_TexturePool.Release(resource.Texture);
+					else
+						m_Pool.Release(resource.Target);
+
+					resource.Target = nullptr;
+					resource.Texture = nullptr;
+				}
+			}
+		}
+
+		m_Stats.PooledTargetCount = m_Pool.GetTargetCount();
+		m_Stats.PooledTextureCount = m_TexturePool.GetTextureCount();
+		m_Stats.PooledMemory = m_Pool.GetMemoryUsage() + m_TexturePool.GetMemoryUsage();
+	}
+
+	Ref<Framebuffer> RenderGraph::GetFramebuffer(RenderGraphResource resource) const
+	{
+		VS_CORE_ASSERT(resource < m_Resources.size(), "Unknown render graph resource!");
+		return m_Resources[resource].Target;
+	}
+
+	Ref<Texture2D> RenderGraph::GetTexture(RenderGraphResource resource) const
+	{
+		VS_CORE_ASSERT(resource < m_Resources.size(), "Unknown render graph resource!");
+		return m_Resources[resource].Texture;
+	}
+
+	void RenderGraph::Cull()
+	{
+		// Walks back from the outputs, a pass is needed if something later reads what it writes
+		std::vector<bool> live(m_Resources.size(), false);
+		for (size_t i = 0; i < m_Resources.size(); i++)
+			live[i] = m_Resources[i].Output;
+
+		for (int32_t i = (int32_t)m_Passes.size() - 1; i >= 0; i--)
+		{
+			Pass& pass = m_Passes[i];
+
+			pass.Culled = true;
+			for (const RenderGraphWrite& write : pass.Writes)
+			{
+				if (live[write.Resource])
+					pass.Culled = false;
+			}
+
+			if (pass.Culled)
+				continue;
+
+			// Overwritten contents don't keep earlier writers alive, loaded ones do
+			for (const RenderGraphWrite& write : pass.Writes)
+				live[write.Resource] = write.LoadOp == AttachmentLoadOp::Load;
+
+			for (RenderGraphResource read : pass.Reads)
+				live[read] = true;
+		}
+	}
+
+	void RenderGraph::ComputeLifetimes()
+	{
+		auto use = [this](RenderGraphResource index, int32_t passIndex)
+		{
+			Resource& resource = m_Resources[index];
+			if (resource.FirstPass < 0)
+				resource.FirstPass = passIndex;
+			resource.LastPass = passIndex;
+		};
+
+		for (int32_t i = 0; i < (int32_t)m_Passes.size(); i++)
+		{
+			const Pass& pass = m_Passes[i];
+			if (pass.Culled)
+				continue;
+
+			for (RenderGraphResource read : pass.Reads)
+				use(read, i);
+			for (const RenderGraphWrite& write : pass.Writes)
+				use(write.Resource, i);
+		}
+	}
+
+	void RenderGraph::BeginPass(uint32_t passIndex)
+	{
+		for (const RenderGraphWrite& write : m_Passes[passIndex].Writes)
+		{
+			const Resource& resource = m_Resources[write.Resource];
+			if (!resource.Target || write.LoadOp != AttachmentLoadOp::Clear)
+				continue;
+
+			Renderer::Clear(resource.Target, write.ClearColor);
+
+			// Float clears leave integer attachments undefined
+			uint32_t colorIndex = 0;
+			for (const auto& attachment : resource.Target->GetSpecification().Attachments.Attachments)
+			{
+				if (Utils::IsDepthFormat(attachment.TextureFormat))
+					continue;
+
+				if (attachment.TextureFormat == FramebufferTextureFormat::RED_INTEGER)
+					resource.Target->ClearAttachment(colorIndex, write.ClearInteger);
+
+				colorIndex++;
+			}
+		}
+	}
+
+}
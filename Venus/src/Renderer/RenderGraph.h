@@ -0,0 +1,167 @@
+#pragma once
+
+#include "Renderer/Framebuffer.h"
+#include "Renderer/Texture.h"
+
+#include <glm/glm.hpp>
+
+#include <functional>
+
+namespace Venus {
+
+	using RenderGraphResource = uint32_t;
+
+	enum class AttachmentLoadOp
+	{
+		Load = 0,	// Keeps what the target holds, so the previous writer stays alive
+		Clear,		// Cleared right before the pass runs
+		DontCare	// The pass overwrites every texel
+	};
+
+	struct RenderGraphWrite
+	{
+		RenderGraphWrite(RenderGraphResource resource, AttachmentLoadOp loadOp = AttachmentLoadOp::Load, const glm::vec4& clearColor = { 0.0f, 0.0f, 0.0f, 1.0f }, int clearInteger = -1)
+			: Resource(resource), LoadOp(loadOp), ClearColor(clearColor), ClearInteger(clearInteger) {}
+
+		RenderGraphResource Resource;
+		AttachmentLoadOp LoadOp;
+		glm::vec4 ClearColor;
+		int ClearInteger; // RED_INTEGER attachments
+	};
+
+	struct RenderGraphTextureSpecification
+	{
+		uint32_t Width = 1;
+		uint32_t Height = 1;
+		TextureProperties Properties;
+	};
+
+	// Framebuffers kept between frames and handed out by specification
+	class RenderTargetPool
+	{
+		public:
+			Ref<Framebuffer> Acquire(const FramebufferSpecification& spec);
+			void Release(const Ref<Framebuffer>& framebuffer);
+
+			// Drops targets of a size nobody asked for last frame right away, so a viewport resize drag doesn't
+			// keep every intermediate size alive. Others go once they weren't acquired for a few frames
+			void NextFrame();
+
+			uint32_t GetTargetCount() const { return (uint32_t)m_Entries.size(); }
+			uint64_t GetMemoryUsage() const;
+
+		private:
+			struct Entry
+			{
+				Ref<Framebuffer> Target;
+				bool InUse = false;
+				uint64_t LastUsedFrame = 0;
+			};
+
+			std::vector<Entry> m_Entries;
+			std::vector<glm::uvec2> m_RequestedSizes;
+			uint64_t m_FrameIndex = 0;
+	};
+
+	// Same as the target pool for textures written by compute passes
+	class TexturePool
+	{
+		public:
+			Ref<Texture2D> Acquire(const RenderGraphTextureSpecification& spec);
+			void Release(const Ref<Texture2D>& texture);
+			void NextFrame();
+
+			uint32_t GetTextureCount() const { return (uint32_t)m_Entries.size(); }
+			uint64_t GetMemoryUsage() const;
+
+		private:
+			struct Entry
+			{
+				Ref<Texture2D> Texture;
+				bool InUse = false;
+				uint64_t LastUsedFrame = 0;
+			};
+
+			std::vector<Entry> m_Entries;
+			std::vector<glm::uvec2> m_RequestedSizes;
+			uint64_t m_FrameIndex = 0;
+	};
+
+	// Passes and resources are declared again every frame. Passes whose writes nobody reads are culled,
+	// transient targets only live from their first to their last pass and are aliased through the pool
+	class RenderGraph
+	{
+		public:
+			using ExecuteFunction = std::function<void()>;
+
+			struct Statistics
+			{
+				uint32_t PassCount = 0;
+				uint32_t CulledPassCount = 0;
+				uint32_t TransientTargetCount = 0;
+				uint32_t PooledTargetCount = 0;
+				uint32_t PooledTextureCount = 0;
+				uint64_t PooledMemory = 0;
+			};
+
+			// Releases last frame's targets, declared resources and passes
+			void Reset();
+
+			RenderGraphResource CreateTarget(const std::string& name, const FramebufferSpecification& spec);
+			// Pooled like targets, always loaded since compute passes overwrite what they need
+			RenderGraphResource CreateTexture(const std::string& name, const RenderGraphTextureSpecification& spec);
+			// Owned outside the graph, e.g. the shadow map keeping cached cascades between frames
+			RenderGraphResource ImportTarget(const std::string& name, const Ref<Framebuffer>& framebuffer);
+			// Buffers and textures tracked only to order and cull the passes using them
+			RenderGraphResource ImportResource(const std::string& name);
+
+			// Passes run in the order they were added
+			void AddPass(const std::string& name, const std::vector<RenderGraphResource>& reads, const std::vector<RenderGraphWrite>& writes, const ExecuteFunction& execute);
+
+			// Read after the frame, kept alive until the next Reset and never aliased
+			void SetOutput(RenderGraphResource resource);
+
+			void Execute();
+
+			// Only valid while the resource is alive, outputs until the next Reset
+			Ref<Framebuffer> GetFramebuffer(RenderGraphResource resource) const;
+			Ref<Texture2D> GetTexture(RenderGraphResource resource) const;
+			const Statistics& GetStats() const { return m_Stats; }
+
+		private:
+			void Cull();
+			void ComputeLifetimes();
+			void BeginPass(uint32_t passIndex);
+
+		private:
+			struct Resource
+			{
+				std::string Name;
+				FramebufferSpecification Specification;
+				Ref<Framebuffer> Target;
+				RenderGraphTextureSpecification TextureSpecification;
+				Ref<Texture2D> Texture;
+				bool IsTexture = false;
+				bool Transient = false;
+				bool Output = false;
+				int32_t FirstPass = -1;
+				int32_t LastPass = -1;
+			};
+
+			struct Pass
+			{
+				std::string Name;
+				std::vector<RenderGraphResource> Reads;
+				std::vector<RenderGraphWrite> Writes;
+				ExecuteFunction Execute;
+				bool Culled = false;
+			};
+
+			std::vector<Resource> m_Resources;
+			std::vector<Pass> m_Passes;
+			RenderTargetPool m_Pool;
+			TexturePool m_TexturePool;
+			Statistics m_Stats;
+	};
+
+}
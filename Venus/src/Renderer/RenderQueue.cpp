@@ -0,0 +1,118 @@
+#include "pch.h"
+#include "RenderQueue.h"
+
+namespace Venus {
+
+	static constexpr uint64_t s_PassShift = 60;
+	static constexpr uint64_t s_PipelineShift = 54;
+	static constexpr uint64_t s_ShaderShift = 48;
+	static constexpr uint64_t s_MaterialShift = 32;
+	static constexpr uint64_t s_MeshShift = 16;
+
+	void RenderQueue::Submit(RenderQueuePass pass, const RenderQueueCommand& command, float depth)
+	{
+		const Mesh* mesh = &command.Model->GetMeshs()[command.MeshIndex];
+
+		uint64_t pipelineID = GetID(m_PipelineIDs, command.Pipeline.get(), 0x3F);
+		uint64_t shaderID = GetID(m_ShaderIDs, command.Pipeline->GetShader().get(), 0x3F);
+		uint64_t materialID = command.Material ? GetID(m_MaterialIDs, command.Material.get(), 0xFFFF) : 0;
+		uint64_t meshID = GetID(m_MeshIDs, mesh, 0xFFFF);
+
+		// Positive floats keep their order when compared as integers, the top 16 bits are enough to sort front to back
+		uint32_t depthBits;
+		depth = glm::max(depth, 0.0f);
+		std::memcpy(&depthBits, &depth, sizeof(float));
+
+		uint64_t key = 0;
+		key |= (uint64_t)pass << s_PassShift;
+		key |= pipelineID << s_PipelineShift;
+		key |= shaderID << s_ShaderShift;
+		key |= materialID << s_MaterialShift;
+		key |= meshID << s_MeshShift;
+		key |= depthBits >> 16;
+
+		m_SortedEntries.push_back({ key, (uint32_t)m_Commands.size() });
+		m_Commands.push_back(command);
+	}
+
+	void RenderQueue::Sort()
+	{
+		VS_PROFILE_FUNCTION();
+
+		RadixSort(m_SortedEntries, m_ScratchEntries);
+
+		for (auto& range : m_PassRanges)
+			range = { 0, 0 };
+
+		uint32_t count = (uint32_t)m_SortedEntries.size();
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint32_t pass = (uint32_t)(m_SortedEntries[i].Key >> s_PassShift);
+			if (i == 0 || pass != (uint32_t)(m_SortedEntries[i - 1].Key >> s_PassShift))
+				m_PassRanges[pass].first = i;
+			m_PassRanges[pass].second = i + 1;
+		}
+	}
+
+	void RenderQueue::Clear()
+	{
+		m_Commands.clear();
+		m_SortedEntries.clear();
+
+		m_PipelineIDs.clear();
+		m_ShaderIDs.clear();
+		m_MaterialIDs.clear();
+		m_MeshIDs.clear();
+
+		for (auto& range : m_PassRanges)
+			range = { 0, 0 };
+	}
+
+	uint16_t RenderQueue::GetID(std::unordered_map<const void*, uint16_t>& ids, const void* object, uint16_t max)
+	{
+		auto [it, inserted] = ids.try_emplace(object, (uint16_t)ids.size());
+		VS_CORE_ASSERT(it->second <= max, "Render queue ran out of sort key bits!");
+		return it->second & max;
+	}
+
+	void RenderQueue::RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch)
+	{
+		// LSD radix sort, 8 bits per pass, stable so equal keys keep submission order
+		if (entries.size() < 2)
+			return;
+
+		scratch.resize(entries.size());
+
+		SortEntry* src = entries.data();
+		SortEntry* dst = scratch.data();
+		size_t count = entries.size();
+
+		for (uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			uint32_t histogram[256] = {};
+			for (size_t i = 0; i < count; i++)
+				histogram[(src[i].Key >> shift) & 0xFF]++;
+
+			// Every key shares this byte, nothing to reorder
+			if (histogram[(src[0].Key >> shift) & 0xFF] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				uint32_t bucketCount = histogram[i];
+				histogram[i] = offset;
+				offset += bucketCount;
+			}
+
+			for (size_t i = 0; i < count; i++)
+				dst[histogram[(src[i].Key >> shift) & 0xFF]++] = src[i];
+
+			std::swap(src, dst);
+		}
+
+		if (src != entries.data())
+			std::memcpy(entries.data(), src, count * sizeof(SortEntry));
+	}
+
+}
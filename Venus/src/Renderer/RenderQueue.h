@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Renderer/Pipeline.h"
+#include "Renderer/Mesh.h"
+#include "Renderer/MeshMaterial.h"
+
+namespace Venus {
+
+	enum class RenderQueuePass : uint8_t
+	{
+		Shadow = 0,
+		Geometry,
+		Count
+	};
+
+	struct RenderQueueCommand
+	{
+		Ref<Pipeline> Pipeline;
+		Ref<Model> Model;
+		uint32_t MeshIndex = 0;
+		Ref<MeshMaterial> Material; // Null for depth only pipelines
+		uint32_t InstanceOffset = 0;
+		uint32_t InstanceCount = 0;
+	};
+
+	// Key layout, most significant first:
+	// pass (4) | pipeline (6) | shader (6) | material (16) | mesh (16) | depth (16)
+	class RenderQueue
+	{
+		public:
+			void Submit(RenderQueuePass pass, const RenderQueueCommand& command, float depth = 0.0f);
+			void Sort();
+			void Clear();
+
+			// Sorted commands of a pass, only valid after Sort()
+			template<typename Fn>
+			void ForEach(RenderQueuePass pass, Fn&& fn) const
+			{
+				const auto& range = m_PassRanges[(uint32_t)pass];
+				for (uint32_t i = range.first; i < range.second; i++)
+					fn(m_Commands[m_SortedEntries[i].Index]);
+			}
+
+			uint32_t GetCommandCount() const { return (uint32_t)m_Commands.size(); }
+
+		private:
+			struct SortEntry
+			{
+				uint64_t Key;
+				uint32_t Index;
+			};
+
+			uint16_t GetID(std::unordered_map<const void*, uint16_t>& ids, const void* object, uint16_t max);
+			static void RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch);
+
+		private:
+			std::vector<RenderQueueCommand> m_Commands;
+			std::vector<SortEntry> m_SortedEntries;
+			std::vector<SortEntry> m_ScratchEntries;
+			std::pair<uint32_t, uint32_t> m_PassRanges[(uint32_t)RenderQueuePass::Count] = {};
+
+			// Compact per-frame IDs, assigned in submission order
+			std::unordered_map<const void*, uint16_t> m_PipelineIDs;
+			std::unordered_map<const void*, uint16_t> m_ShaderIDs;
+			std::unordered_map<const void*, uint16_t> m_MaterialIDs;
+			std::unordered_map<const void*, uint16_t> m_MeshIDs;
+	};
+
+}
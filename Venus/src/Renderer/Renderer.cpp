@@ -2,14 +2,37 @@
 #include "Renderer/Renderer.h"
 #include "Renderer/Renderer2D.h"
 #include "Renderer/UniformBuffer.h"
+#include "Renderer/StorageBuffer.h"
+#include "Renderer/RingBuffer.h"
 #include "Renderer/ComputePipeline.h"
+#include "Renderer/TextureStreamer.h"
+#include "Renderer/GPUProfiler.h"
 
-#include "glad/glad.h"
+#include <glm/gtc/packing.hpp>
 
 #include "imgui.h"
 
 namespace Venus {
 
+	namespace Utils {
+
+		// Irradiance cube rebuilt from SH, small enough to fill on the CPU
+		static void UploadIrradianceSH(const Ref<TextureCube>& irradianceMap, const SphericalHarmonics& irradianceSH)
+		{
+			uint32_t size = irradianceMap->GetWidth();
+			std::vector<float> texels((uint64_t)size * size * 6 * 4);
+			irradianceSH.EvaluateCubeMap(texels.data(), size);
+
+			std::vector<uint16_t> halfTexels(texels.size());
+			for (size_t i = 0; i < texels.size(); i++)
+				halfTexels[i] = glm::packHalf1x16(texels[i]);
+
+			irradianceMap->SetLevelData(halfTexels.data(), irradianceMap->GetLevelSize(0), 0);
+			irradianceMap->GenerateMips();
+		}
+
+	}
+
 	struct RendererData
 	{
 		//-- Shaders--------------------------------
@@ -35,9 +58,15 @@ namespace Venus {
 		{
 			glm::mat4 Transform;
 			int EntityID;
+			int InstanceOffset;
 		};
 		ModelData ModelBuffer;
-		Ref<UniformBuffer> ModelDataBuffer;
+		Ref<RingBuffer> ModelDataBuffer; // Every draw gets its own range, bound at binding 1
+		//------------------------------------------
+
+
+		//-- Instance Data--------------------------
+		Ref<StorageBuffer> InstanceDataBuffer;
 		//------------------------------------------
 
 
@@ -65,6 +94,11 @@ namespace Venus {
 		//------------------------------------------
 
 
+		//-- Samplers-------------------------------
+		std::unordered_map<uint32_t, Ref<Sampler>> Samplers; // By SamplerSpecification key
+		//------------------------------------------
+
+
 		//-- Environment----------------------------
 		Ref<SceneEnvironment> EnviromentMap;
 		Ref<Material> EnvironmentMaterial;
@@ -79,6 +113,12 @@ namespace Venus {
 
 	static RendererData s_Data;
 
+	static void UploadModelData()
+	{
+		uint32_t offset = s_Data.ModelDataBuffer->Push(&s_Data.ModelBuffer, sizeof(RendererData::ModelData));
+		s_Data.ModelDataBuffer->BindRange(1, offset, sizeof(RendererData::ModelData));
+	}
+
 	void Renderer::Init()
 	{
 		VS_PROFILE_FUNCTION();
@@ -91,10 +131,10 @@ namespace Venus {
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/Skybox.glsl");
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/ShadowMap.glsl");
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/ShadowMapDebug.glsl");
-		Renderer::GetShaderLibrary()->Load("Resources/Shaders/FXAA.glsl");
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/Bloom.glsl");
+		Renderer::GetShaderLibrary()->Load("Resources/Shaders/LightCulling.glsl");
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/BloomDebug.glsl");
-		Renderer::GetShaderLibrary()->Load("Resources/Shaders/Composite.glsl");
+		Renderer::GetShaderLibrary()->Load("Resources/Shaders/PostProcess.glsl");
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/EquirectangularToCubeMap.glsl");
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/EnvironmentMipFilter.glsl");
 		Renderer::GetShaderLibrary()->Load("Resources/Shaders/EnvironmentIrradiance.glsl");
@@ -219,16 +259,23 @@ namespace Venus {
 
 		//-- Uniforms----------------------------------------------------------------------------------
 		s_Data.CameraUniformBuffer = UniformBuffer::Create(sizeof(RendererData::CameraData), 0);
-		s_Data.ModelDataBuffer = UniformBuffer::Create(sizeof(RendererData::ModelData), 1);
+		s_Data.ModelDataBuffer = RingBuffer::Create(256 * 1024, RingBufferUsage::Uniform);
+		s_Data.InstanceDataBuffer = StorageBuffer::Create(sizeof(Renderer::InstanceData) * 1024, 0);
 		//---------------------------------------------------------------------------------------------
 
 		RenderCommand::Init();
+		GPUProfiler::Init();
 		Renderer2D::Init();
+		TextureStreamer::Init();
 	}
 
 	void Renderer::Shutdown()
 	{
+		TextureStreamer::Shutdown();
 		Renderer2D::Shutdown();
+		GPUProfiler::Shutdown();
+
+		s_Data.Samplers.clear();
 	}
 
 	void Renderer::Clear(Ref<Framebuffer> framebuffer, glm::vec4 color)
@@ -274,13 +321,16 @@ namespace Venus {
 	void Renderer::EndScene()
 	{
 		Renderer2D::EndScene();
+
+		s_Data.ModelDataBuffer->NextFrame();
 	}
 
 	void Renderer::Render(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform)
 	{
 		s_Data.ModelBuffer.Transform = transform;
 		s_Data.ModelBuffer.EntityID = -1;
-		s_Data.ModelDataBuffer->SetData(&s_Data.ModelBuffer, sizeof(RendererData::ModelData));
+		s_Data.ModelBuffer.InstanceOffset = 0;
+		UploadModelData();
 
 		shader->Bind();
 		RenderCommand::DrawIndexed(vertexArray);
@@ -293,7 +343,8 @@ namespace Venus {
 
 		s_Data.ModelBuffer.Transform = transform;
 		s_Data.ModelBuffer.EntityID = -1;
-		s_Data.ModelDataBuffer->SetData(&s_Data.ModelBuffer, sizeof(RendererData::ModelData));
+		s_Data.ModelBuffer.InstanceOffset = 0;
+		UploadModelData();
 
 		s_Data.Stats.VertexCount += 4;
 		s_Data.Stats.IndexCount += 6;
@@ -312,7 +363,8 @@ namespace Venus {
 
 		s_Data.ModelBuffer.Transform = transform;
 		s_Data.ModelBuffer.EntityID = -1;
-		s_Data.ModelDataBuffer->SetData(&s_Data.ModelBuffer, sizeof(RendererData::ModelData));
+		s_Data.ModelBuffer.InstanceOffset = 0;
+		UploadModelData();
 
 		s_Data.Stats.VertexCount += 4;
 		s_Data.Stats.IndexCount += 6;
@@ -340,7 +392,7 @@ namespace Venus {
 
 	void Renderer::RenderCube(const Ref<Pipeline>& pipeline, const Ref<Material>& material)
 	{
-		glDepthMask(GL_FALSE);
+		RenderCommand::DisableDepthWrite();
 		pipeline->GetFramebuffer()->Bind();
 		pipeline->GetShader()->Bind();
 		material->Bind();
@@ -348,63 +400,103 @@ namespace Venus {
 		RenderCommand::DrawIndexed(s_Data.CubeVertexArray);
 
 		pipeline->GetFramebuffer()->Unbind();
-		glDepthMask(GL_TRUE);
+		RenderCommand::EnableDepthWrite();
 	}
 
-	void Renderer::RenderModel(const Ref<Pipeline>& pipeline, const Ref<Model>& model, const glm::mat4& transform, int entityID)
+	void Renderer::SetInstanceData(const std::vector<InstanceData>& instances)
 	{
-		pipeline->GetFramebuffer()->Bind();
-		pipeline->GetShader()->Bind();
-
-		s_Data.ModelBuffer.Transform = transform;
-		s_Data.ModelBuffer.EntityID = entityID;
-		s_Data.ModelDataBuffer->SetData(&s_Data.ModelBuffer, sizeof(RendererData::ModelData));
+		uint32_t size = (uint32_t)(instances.size() * sizeof(InstanceData));
+		if (size == 0)
+			return;
 
-		for (auto& mesh : model->m_Meshes)
+		// Grow geometrically so a few extra entities don't reallocate every frame
+		uint32_t capacity = s_Data.InstanceDataBuffer->GetSize();
+		if (size > capacity)
 		{
-			s_Data.Stats.VertexCount += mesh.m_Vertices.size();
-			s_Data.Stats.IndexCount += mesh.m_Indices.size();
-			s_Data.Stats.Meshs++;
-			s_Data.Stats.DrawCalls++;
+			while (capacity < size)
+				capacity *= 2;
 
-			RenderCommand::DrawIndexed(mesh.m_VertexArray);
+			s_Data.InstanceDataBuffer->Resize(capacity);
 		}
-		s_Data.Stats.Models++;
 
-		pipeline->GetFramebuffer()->Unbind();
+		s_Data.InstanceDataBuffer->SetData(instances.data(), size);
 	}
 
-	void Renderer::RenderModelWithMaterial(const Ref<Pipeline>& pipeline, const Ref<Model>& model, const Ref<MaterialTable>& materialTable, const glm::mat4& transform, int entityID)
+	void Renderer::SubmitRenderQueue(const RenderQueue& queue, RenderQueuePass pass)
 	{
-		pipeline->GetFramebuffer()->Bind();
-		pipeline->GetShader()->Bind();
-
-		auto& defaultMaterialTable = model->GetMaterialTable();
-		auto& envMaterial = s_Data.EnvironmentMaterial;
-
-		s_Data.ModelBuffer.Transform = transform;
-		s_Data.ModelBuffer.EntityID = entityID;
-		s_Data.ModelDataBuffer->SetData(&s_Data.ModelBuffer, sizeof(RendererData::ModelData));
+		VS_PROFILE_FUNCTION();
 
-		envMaterial->Bind();
+		// Queue is sorted by state, only touch GL when something actually changes
+		Framebuffer* currentFramebuffer = nullptr;
+		Shader* currentShader = nullptr;
+		MeshMaterial* currentMaterial = nullptr;
+		bool environmentBound = false;
 
-		for (auto& mesh : model->m_Meshes)
+		queue.ForEach(pass, [&](const RenderQueueCommand& cmd)
 		{
-			s_Data.Stats.VertexCount += mesh.m_Vertices.size();
-			s_Data.Stats.IndexCount += mesh.m_Indices.size();
-			s_Data.Stats.Meshs++;
-			s_Data.Stats.DrawCalls++;
+			Ref<Framebuffer> framebuffer = cmd.Pipeline->GetFramebuffer();
+			if (framebuffer.get() != currentFramebuffer)
+			{
+				framebuffer->Bind();
+				currentFramebuffer = framebuffer.get();
+				s_Data.Stats.StateChanges++;
+			}
+			else
+			{
+				s_Data.Stats.StateChangesAvoided++;
+			}
 
-			if (materialTable->HasMaterial(mesh.m_MaterialIndex))
-				materialTable->GetMaterial(mesh.m_MaterialIndex)->Bind();
+			Ref<Shader> shader = cmd.Pipeline->GetShader();
+			if (shader.get() != currentShader)
+			{
+				shader->Bind();
+				currentShader = shader.get();
+				currentMaterial = nullptr;
+				environmentBound = false;
+				s_Data.Stats.StateChanges++;
+			}
 			else
-				defaultMaterialTable->GetMaterial(mesh.m_MaterialIndex)->Bind();
+			{
+				s_Data.Stats.StateChangesAvoided++;
+			}
 
-			RenderCommand::DrawIndexed(mesh.m_VertexArray);
-		}
-		s_Data.Stats.Models++;
+			if (cmd.Material)
+			{
+				if (!environmentBound)
+				{
+					s_Data.EnvironmentMaterial->Bind();
+					environmentBound = true;
+				}
+
+				if (cmd.Material.get() != currentMaterial)
+				{
+					cmd.Material->Bind();
+					currentMaterial = cmd.Material.get();
+					s_Data.Stats.StateChanges++;
+				}
+				else
+				{
+					s_Data.Stats.StateChangesAvoided++;
+				}
+			}
 
-		pipeline->GetFramebuffer()->Unbind();
+			s_Data.ModelBuffer.InstanceOffset = cmd.InstanceOffset;
+			UploadModelData();
+
+			auto& mesh = cmd.Model->m_Meshes[cmd.MeshIndex];
+			s_Data.Stats.VertexCount += mesh.m_VertexCount * cmd.InstanceCount;
+			s_Data.Stats.IndexCount += mesh.m_IndexCount * cmd.InstanceCount;
+			s_Data.Stats.Meshs += cmd.InstanceCount;
+			s_Data.Stats.Instances += cmd.InstanceCount;
+			s_Data.Stats.DrawCalls++;
+			if (cmd.MeshIndex == 0)
+				s_Data.Stats.Models += cmd.InstanceCount;
+
+			RenderCommand::DrawIndexedInstanced(mesh.m_VertexArray, cmd.InstanceCount);
+		});
+
+		if (currentFramebuffer)
+			currentFramebuffer->Unbind();
 	}
 
 	void Renderer::RenderSelectedModel(const Ref<Pipeline>& pipeline, const Ref<Model>& model, const glm::mat4& transform, int entityID)
@@ -420,12 +512,43 @@ namespace Venus {
 		return emptyEnv;
 	}
 
-	Ref<SceneEnvironment> Renderer::CreateEnvironmentMap(const std::string& path)
+	Ref<SceneEnvironment> Renderer::CreateEnvironmentMap(const std::string& path, const EnvironmentBakeSettings& settings)
 	{
 		CORE_LOG_INFO("Creating ENV MAP: {0}", path);
 
-		const uint32_t cubeMapSize = 1024;
-		const uint32_t irradianceMapSize = 32;
+		const uint32_t cubeMapSize = settings.RadianceSize;
+		const uint32_t irradianceMapSize = settings.IrradianceSize;
+
+		TextureProperties cubeProps;
+		cubeProps.Format = TextureFormat::RGBA16F;
+		cubeProps.WrapMode = TextureWrapMode::ClampToEdge;
+		cubeProps.UseMipmaps = true;
+
+		// Baked before, upload the stored levels
+		uint64_t sourceHash = EnvironmentCache::HashSource(path);
+		EnvironmentCache::Reader reader(EnvironmentCache::GetCachePath(path), sourceHash, settings);
+		if (reader.IsValid())
+		{
+			CORE_LOG_INFO("Loading Baked ENV MAP: {0}", path);
+			const CookedEnvironment& cooked = reader.GetEnvironment();
+
+			Ref<TextureCube> radianceMap = TextureCube::Create(cubeMapSize, cubeMapSize, cubeProps);
+			for (uint32_t level = 0; level < (uint32_t)cooked.RadianceLevels.size(); level++)
+				radianceMap->SetLevelData(cooked.RadianceLevels[level], radianceMap->GetLevelSize(level), level);
+
+			Ref<TextureCube> irradianceMap = TextureCube::Create(irradianceMapSize, irradianceMapSize, cubeProps);
+			if (cooked.Irradiance)
+			{
+				irradianceMap->SetLevelData(cooked.Irradiance, irradianceMap->GetLevelSize(0), 0);
+				irradianceMap->GenerateMips();
+			}
+			else
+			{
+				Utils::UploadIrradianceSH(irradianceMap, cooked.IrradianceSH);
+			}
+
+			return SceneEnvironment::Create(radianceMap, irradianceMap);
+		}
 
 		// Load HDR Env
 		TextureProperties props;
@@ -434,10 +557,6 @@ namespace Venus {
 		Ref<Texture2D> hdrTexture = Texture2D::Create(path, props);
 
 		// Convert Equirectangular to Cubemap
-		TextureProperties cubeProps;
-		cubeProps.Format = TextureFormat::RGBA32F;
-		cubeProps.WrapMode = TextureWrapMode::ClampToEdge;
-		cubeProps.UseMipmaps = true;
 		Ref<TextureCube> cubeMap = TextureCube::Create(cubeMapSize, cubeMapSize, cubeProps);
 		{
 			CORE_LOG_INFO("Converting Equirectangular to Cubemap");
@@ -449,6 +568,7 @@ namespace Venus {
 
 			cubeMap->GenerateMips();
 		}
+		hdrTexture = nullptr;
 
 		// Pre-filter mipmap levels
 		Ref<TextureCube> filteredCubeMap = TextureCube::Create(cubeMapSize, cubeMapSize, cubeProps);
@@ -475,6 +595,28 @@ namespace Venus {
 
 		// Irradiance Cube map
 		Ref<TextureCube> irradianceCubeMap = TextureCube::Create(irradianceMapSize, irradianceMapSize, cubeProps);
+		SphericalHarmonics irradianceSH;
+		if (settings.IrradianceSH)
+		{
+			CORE_LOG_INFO("Irradiance SH Projection");
+
+			// The unfiltered mip closest to the irradiance map size is plenty for nine coefficients
+			uint32_t level = (uint32_t)std::log2(std::max(cubeMapSize / irradianceMapSize, 1u));
+			uint32_t levelSize = cubeMap->GetMipSize(level).first;
+
+			std::vector<uint16_t> halfTexels(cubeMap->GetLevelSize(level) / sizeof(uint16_t));
+			cubeMap->GetLevelData(halfTexels.data(), cubeMap->GetLevelSize(level), level);
+
+			std::vector<float> texels(halfTexels.size());
+			for (size_t i = 0; i < texels.size(); i++)
+				texels[i] = glm::unpackHalf1x16(halfTexels[i]);
+
+			irradianceSH = SphericalHarmonics::ProjectCubeMap(texels.data(), levelSize);
+			irradianceSH.ConvolveLambert();
+
+			Utils::UploadIrradianceSH(irradianceCubeMap, irradianceSH);
+		}
+		else
 		{
 			Ref<ComputePipeline> computePipeline = ComputePipeline::Create(Renderer::GetShaderLibrary()->Get("EnvironmentIrradiance"));
 			
@@ -489,6 +631,38 @@ namespace Venus {
 			irradianceCubeMap->GenerateMips();
 		}
 
+		// Only the filtered levels are kept around
+		cubeMap = nullptr;
+
+		// Read the results back once so the next load skips the bake, the null backend has nothing to read
+		if (GetAPI() != RendererAPI::API::None)
+		{
+			CookedEnvironment cooked;
+			cooked.RadianceSize = cubeMapSize;
+			cooked.IrradianceSize = irradianceMapSize;
+			cooked.IrradianceSH = irradianceSH;
+
+			uint32_t mipCount = filteredCubeMap->GetMipLevelCount();
+			std::vector<std::vector<uint8_t>> radianceLevels(mipCount);
+			for (uint32_t level = 0; level < mipCount; level++)
+			{
+				radianceLevels[level].resize(filteredCubeMap->GetLevelSize(level));
+				filteredCubeMap->GetLevelData(radianceLevels[level].data(), (uint32_t)radianceLevels[level].size(), level);
+				cooked.RadianceLevels.push_back(radianceLevels[level].data());
+			}
+
+			std::vector<uint8_t> irradiance;
+			if (!settings.IrradianceSH)
+			{
+				irradiance.resize(irradianceCubeMap->GetLevelSize(0));
+				irradianceCubeMap->GetLevelData(irradiance.data(), (uint32_t)irradiance.size(), 0);
+				cooked.Irradiance = irradiance.data();
+			}
+
+			if (sourceHash)
+				EnvironmentCache::Write(EnvironmentCache::GetCachePath(path), sourceHash, settings, cooked);
+		}
+
 		return SceneEnvironment::Create(filteredCubeMap, irradianceCubeMap);
 	}
 
@@ -497,7 +671,7 @@ namespace Venus {
 		uint32_t cubeMapSize = 1024;
 
 		TextureProperties cubeProps;
-		cubeProps.Format = TextureFormat::RGBA32F;
+		cubeProps.Format = TextureFormat::RGBA16F;
 		cubeProps.WrapMode = TextureWrapMode::ClampToEdge;
 		cubeProps.UseMipmaps = true;
 		Ref<TextureCube> cubeMap = TextureCube::Create(cubeMapSize, cubeMapSize, cubeProps);
@@ -546,6 +720,15 @@ namespace Venus {
 		return s_Data.DefaultBlackTexture;
 	}
 
+	Ref<Sampler> Renderer::GetSampler(const SamplerSpecification& spec)
+	{
+		Ref<Sampler>& sampler = s_Data.Samplers[spec.GetKey()];
+		if (!sampler)
+			sampler = Sampler::Create(spec);
+
+		return sampler;
+	}
+
 	Ref<TextureCube> Renderer::GetDefaultTextureCube()
 	{
 		return s_Data.DefaultCube;
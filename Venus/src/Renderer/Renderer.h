@@ -10,6 +10,9 @@
 #include "Renderer/Mesh.h"
 #include "Renderer/Framebuffer.h"
 #include "Renderer/Material.h"
+#include "Renderer/Sampler.h"
+#include "Renderer/EnvironmentCache.h"
+#include "Renderer/RenderQueue.h"
 
 #include "Scene/Components.h"
 
@@ -33,23 +36,35 @@ namespace Venus {
 			static void RenderQuadWithMaterial(const Ref<Pipeline>& pipeline, const glm::mat4& transform, const Ref<Material>& material); 
 			static void RenderFullscreenQuad(const Ref<Pipeline>& pipeline, const Ref<Material>& material);
 			static void RenderCube(const Ref<Pipeline>& pipeline, const Ref<Material>& material);
-			static void RenderModel(const Ref<Pipeline>& pipeline, const Ref<Model>& model, const glm::mat4& transform = glm::mat4(1.0f), int entityID = -1);
-			static void RenderModelWithMaterial(const Ref<Pipeline>& pipeline, const Ref<Model>& model, const Ref<MaterialTable>& materialTable, const glm::mat4& transform = glm::mat4(1.0f), int entityID = -1);
+			static void SubmitRenderQueue(const RenderQueue& queue, RenderQueuePass pass);
 			static void RenderSelectedModel(const Ref<Pipeline>& pipeline, const Ref<Model>& model, const glm::mat4& transform = glm::mat4(1.0f), int entityID = -1);
 			
 			static void SetEnvironment(Ref<SceneEnvironment> envMap, uint32_t shadowMap);
 
 			static Ref<SceneEnvironment> CreateEmptyEnvironmentMap();
-			static Ref<SceneEnvironment> CreateEnvironmentMap(const std::string& path);
+			static Ref<SceneEnvironment> CreateEnvironmentMap(const std::string& path, const EnvironmentBakeSettings& settings = EnvironmentBakeSettings());
 			static Ref<TextureCube> CreatePreethamSky(glm::vec3 TurbidityAzimuthInclination = { 2.0f, 0.0f, 0.0f });
 
 			static Ref<Texture2D> GetDefaultTexture();
 			static Ref<Texture2D> GetDefaultBlackTexture();
 			static Ref<TextureCube> GetDefaultTextureCube();
+
+			// Samplers are created on first use and shared by every texture with the same filter and wrap
+			static Ref<Sampler> GetSampler(const SamplerSpecification& spec);
 			static Ref<ShaderLibrary> GetShaderLibrary();
 
 			static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
 
+			// Instancing, std430 layout
+			struct InstanceData
+			{
+				glm::mat4 Transform;
+				int EntityID;
+				int CascadeMask; // Shadow cascades the instance is rendered into
+				int Padding[2];
+			};
+			static void SetInstanceData(const std::vector<InstanceData>& instances);
+
 			static void SetDebugTexture(uint32_t textureID);
 			static float GetDebugParam();
 			static void OnImGuiRender();
@@ -60,6 +75,9 @@ namespace Venus {
 				uint32_t DrawCalls = 0;
 				uint32_t Models = 0;
 				uint32_t Meshs = 0;
+				uint32_t Instances = 0;
+				uint32_t StateChanges = 0;
+				uint32_t StateChangesAvoided = 0;
 				uint32_t VertexCount = 0;
 				uint32_t IndexCount = 0;
 			};
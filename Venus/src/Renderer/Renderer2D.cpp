@@ -63,6 +63,7 @@ namespace Venus {
 
 		// Quads 
 		Ref<VertexArray> QuadVertexArray;
+		Ref<RingBuffer> QuadVertexRing;
 		Ref<VertexBuffer> QuadVertexBuffer;
 		Ref<Shader> QuadShader;
 
@@ -72,6 +73,7 @@ namespace Venus {
 
 		// Circles
 		Ref<VertexArray> CircleVertexArray;
+		Ref<RingBuffer> CircleVertexRing;
 		Ref<VertexBuffer> CircleVertexBuffer;
 		Ref<Shader> CircleShader;
 
@@ -81,6 +83,7 @@ namespace Venus {
 
 		// Lines
 		Ref<VertexArray> LineVertexArray;
+		Ref<RingBuffer> LineVertexRing;
 		Ref<VertexBuffer> LineVertexBuffer;
 		Ref<Shader> LineShader;
 
@@ -92,6 +95,7 @@ namespace Venus {
 
 		// Textures
 		std::array<Ref<Texture2D>, MaxTextureSlots> TextureSlots;
+		std::array<Ref<Sampler>, MaxTextureSlots> SamplerSlots; // Same texture with another sampler takes another slot
 		uint32_t TextureSlotIndex = 1; // 0 = Default white texture
 
 		glm::vec4 QuadVertexPositions[4];
@@ -112,7 +116,9 @@ namespace Venus {
 		// Quads
 		s_2DData.QuadVertexArray = VertexArray::Create();
 
-		s_2DData.QuadVertexBuffer = VertexBuffer::Create(s_2DData.MaxVertices * sizeof(QuadVertex));
+		// One extra vertex per region leaves room to align batches to the vertex stride
+		s_2DData.QuadVertexRing = RingBuffer::Create((s_2DData.MaxVertices + 1) * sizeof(QuadVertex), RingBufferUsage::Vertex);
+		s_2DData.QuadVertexBuffer = VertexBuffer::Create(s_2DData.QuadVertexRing);
 		s_2DData.QuadVertexBuffer->SetLayout({
 			{ ShaderDataType::Float3, "a_Position"     },
 			{ ShaderDataType::Float4, "a_Color"        },
@@ -148,7 +154,8 @@ namespace Venus {
 		// Circles
 		s_2DData.CircleVertexArray = VertexArray::Create();
 		
-		s_2DData.CircleVertexBuffer = VertexBuffer::Create(s_2DData.MaxVertices * sizeof(CircleVertex));
+		s_2DData.CircleVertexRing = RingBuffer::Create((s_2DData.MaxVertices + 1) * sizeof(CircleVertex), RingBufferUsage::Vertex);
+		s_2DData.CircleVertexBuffer = VertexBuffer::Create(s_2DData.CircleVertexRing);
 		
 		s_2DData.CircleVertexBuffer->SetLayout({
 			{ ShaderDataType::Float3, "a_WorldPosition" },
@@ -166,7 +173,8 @@ namespace Venus {
 		// Lines
 		s_2DData.LineVertexArray = VertexArray::Create();
 
-		s_2DData.LineVertexBuffer = VertexBuffer::Create(s_2DData.MaxVertices * sizeof(LineVertex));
+		s_2DData.LineVertexRing = RingBuffer::Create((s_2DData.MaxVertices + 1) * sizeof(LineVertex), RingBufferUsage::Vertex);
+		s_2DData.LineVertexBuffer = VertexBuffer::Create(s_2DData.LineVertexRing);
 
 		s_2DData.LineVertexBuffer->SetLayout({
 			{ ShaderDataType::Float3, "a_Position"		},
@@ -212,6 +220,10 @@ namespace Venus {
 	void Renderer2D::EndScene()
 	{
 		Flush();
+
+		s_2DData.QuadVertexRing->NextFrame();
+		s_2DData.CircleVertexRing->NextFrame();
+		s_2DData.LineVertexRing->NextFrame();
 	}
 
 	void Renderer2D::StartBatch()
@@ -237,35 +249,45 @@ namespace Venus {
 		if (s_2DData.QuadIndexCount)
 		{
 			uint32_t dataSize = (uint32_t)((uint8_t*)s_2DData.QuadVertexBufferPtr - (uint8_t*)s_2DData.QuadVertexBufferBase);
-			s_2DData.QuadVertexBuffer->SetData(s_2DData.QuadVertexBufferBase, dataSize);
+			uint32_t offset = s_2DData.QuadVertexRing->Push(s_2DData.QuadVertexBufferBase, dataSize, sizeof(QuadVertex));
 
 			// Bind textures
 			for (uint32_t i = 0; i < s_2DData.TextureSlotIndex; i++)
+			{
 				s_2DData.TextureSlots[i]->Bind(i);
+				RenderCommand::BindSampler(i, s_2DData.SamplerSlots[i] ? s_2DData.SamplerSlots[i]->GetRendererID() : 0);
+			}
 
 			s_2DData.QuadShader->Bind();
-			RenderCommand::DrawIndexed(s_2DData.QuadVertexArray, s_2DData.QuadIndexCount);
+			RenderCommand::DrawIndexed(s_2DData.QuadVertexArray, s_2DData.QuadIndexCount, offset / sizeof(QuadVertex));
 			s_2DData.Stats.DrawCalls++;
+
+			// Later passes bind textures without samplers
+			for (uint32_t i = 0; i < s_2DData.TextureSlotIndex; i++)
+			{
+				if (s_2DData.SamplerSlots[i])
+					RenderCommand::BindSampler(i, 0);
+			}
 		}
 
 		if (s_2DData.CircleIndexCount)
 		{
 			uint32_t dataSize = (uint32_t)((uint8_t*)s_2DData.CircleVertexBufferPtr - (uint8_t*)s_2DData.CircleVertexBufferBase);
-			s_2DData.CircleVertexBuffer->SetData(s_2DData.CircleVertexBufferBase, dataSize);
+			uint32_t offset = s_2DData.CircleVertexRing->Push(s_2DData.CircleVertexBufferBase, dataSize, sizeof(CircleVertex));
 
 			s_2DData.CircleShader->Bind();
-			RenderCommand::DrawIndexed(s_2DData.CircleVertexArray, s_2DData.CircleIndexCount);
+			RenderCommand::DrawIndexed(s_2DData.CircleVertexArray, s_2DData.CircleIndexCount, offset / sizeof(CircleVertex));
 			s_2DData.Stats.DrawCalls++;
 		}
 
 		if (s_2DData.LineVertexCount)
 		{
 			uint32_t dataSize = (uint32_t)((uint8_t*)s_2DData.LineVertexBufferPtr - (uint8_t*)s_2DData.LineVertexBufferBase);
-			s_2DData.LineVertexBuffer->SetData(s_2DData.LineVertexBufferBase, dataSize);
+			uint32_t offset = s_2DData.LineVertexRing->Push(s_2DData.LineVertexBufferBase, dataSize, sizeof(LineVertex));
 
 			s_2DData.LineShader->Bind();
 			RenderCommand::SetLineWidth(s_2DData.LineWidth);
-			RenderCommand::DrawLines(s_2DData.LineVertexArray, s_2DData.LineVertexCount);
+			RenderCommand::DrawLines(s_2DData.LineVertexArray, s_2DData.LineVertexCount, offset / sizeof(LineVertex));
 			s_2DData.Stats.DrawCalls++;
 		}
 
@@ -336,6 +358,11 @@ namespace Venus {
 	}
 
 	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor, int entityID)
+	{
+		DrawQuad(transform, texture, nullptr, false, tilingFactor, tintColor, entityID);
+	}
+
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, const Ref<Sampler>& sampler, bool flipVertically, float tilingFactor, const glm::vec4& tintColor, int entityID)
 	{
 		constexpr size_t quadVertexCount = 4;
 		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
@@ -346,7 +373,7 @@ namespace Venus {
 		float textureIndex = 0.0f;
 		for (uint32_t i = 1; i < s_2DData.TextureSlotIndex; i++)
 		{
-			if (*s_2DData.TextureSlots[i] == *texture)
+			if (*s_2DData.TextureSlots[i] == *texture && s_2DData.SamplerSlots[i] == sampler)
 			{
 				textureIndex = (float)i;
 				break;
@@ -360,14 +387,19 @@ namespace Venus {
 
 			textureIndex = (float)s_2DData.TextureSlotIndex;
 			s_2DData.TextureSlots[s_2DData.TextureSlotIndex] = texture;
+			s_2DData.SamplerSlots[s_2DData.TextureSlotIndex] = sampler;
 			s_2DData.TextureSlotIndex++;
 		}
 
 		for (size_t i = 0; i < quadVertexCount; i++)
 		{
+			glm::vec2 texCoord = textureCoords[i];
+			if (flipVertically)
+				texCoord.y = 1.0f - texCoord.y;
+
 			s_2DData.QuadVertexBufferPtr->Position = transform * s_2DData.QuadVertexPositions[i];
 			s_2DData.QuadVertexBufferPtr->Color = tintColor;
-			s_2DData.QuadVertexBufferPtr->TexCoord = textureCoords[i];
+			s_2DData.QuadVertexBufferPtr->TexCoord = texCoord;
 			s_2DData.QuadVertexBufferPtr->TexIndex = textureIndex;
 			s_2DData.QuadVertexBufferPtr->TilingFactor = tilingFactor;
 			s_2DData.QuadVertexBufferPtr->EntityID = entityID;
@@ -390,7 +422,7 @@ namespace Venus {
 		float textureIndex = 0.0f;
 		for (uint32_t i = 1; i < s_2DData.TextureSlotIndex; i++)
 		{
-			if (*s_2DData.TextureSlots[i] == *texture)
+			if (*s_2DData.TextureSlots[i] == *texture && !s_2DData.SamplerSlots[i])
 			{
 				textureIndex = (float)i;
 				break;
@@ -404,6 +436,7 @@ namespace Venus {
 
 			textureIndex = (float)s_2DData.TextureSlotIndex;
 			s_2DData.TextureSlots[s_2DData.TextureSlotIndex] = texture;
+			s_2DData.SamplerSlots[s_2DData.TextureSlotIndex] = nullptr;
 			s_2DData.TextureSlotIndex++;
 		}
 
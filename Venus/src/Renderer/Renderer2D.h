@@ -3,6 +3,7 @@
 #include "Renderer/OrthographicCamera.h"
 
 #include "Renderer/Texture.h"
+#include "Renderer/Sampler.h"
 
 #include "Renderer/Camera.h"
 #include "Renderer/EditorCamera.h"
@@ -31,6 +32,8 @@ namespace Venus {
 
 			static void DrawQuad(const glm::mat4& transform, const glm::vec4& color, int entityID = -1);
 			static void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f), int entityID = -1);
+			// A null sampler keeps the texture's own filter and wrap
+			static void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, const Ref<Sampler>& sampler, bool flipVertically, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f), int entityID = -1);
 
 			static void DrawQuadBillboard(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 
@@ -2,6 +2,7 @@
 #include "Renderer/RendererAPI.h"
 
 #include <Renderer/OpenGL/OpenGLRendererAPI.h>
+#include <Renderer/Null/NullRendererAPI.h>
 
 namespace Venus {
 
@@ -11,16 +12,18 @@ namespace Venus {
 	{
 		switch (s_API)
 		{
-			case RendererAPI::API::None:    "";
+			case RendererAPI::API::None:    return "None";
 			case RendererAPI::API::OpenGL:  return "OpenGL";
 		}
+
+		return "";
 	}
 
 	Scope<RendererAPI> RendererAPI::Create()
 	{
 		switch (s_API)
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateScope<NullRendererAPI>();
 			case RendererAPI::API::OpenGL:  return CreateScope<OpenGLRendererAPI>();
 		}
 
@@ -28,20 +28,30 @@ namespace Venus {
 			virtual void EnableStencilWrite() = 0;
 			virtual void DisableDepthTest() = 0;
 			virtual void EnableDepthTest() = 0;
+			virtual void DisableDepthWrite() = 0;
+			virtual void EnableDepthWrite() = 0;
 			virtual void SetStencilTest(int function, int value, int mask) = 0;
 
 			virtual void SetLineWidth(float width) = 0;
+
+			// Named groups shown by RenderDoc, Nsight and other frame debuggers
+			virtual void PushDebugGroup(const std::string& name) = 0;
+			virtual void PopDebugGroup() = 0;
 			
 			virtual void BindTexture(int location, int textureID) = 0;
 			virtual void BindTextureCube(int location, int textureID) = 0;
 			virtual void BindTextureArray(int location, int textureID) = 0;
+			virtual void BindSampler(int location, int samplerID) = 0;
 			virtual void BindFramebuffer(int framebufferID) = 0;
 
-			virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
+			virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0) = 0;
+			virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount = 0) = 0;
 			virtual void DrawArrays(const Ref<VertexArray>& vertexArray, uint32_t indexCount) = 0;
-			virtual void DrawLines(const Ref<VertexArray>& vertexArrray, uint32_t vertexCount) = 0;
+			virtual void DrawLines(const Ref<VertexArray>& vertexArrray, uint32_t vertexCount, uint32_t firstVertex = 0) = 0;
 
 			static API GetAPI() { return s_API; }
+			// Before the window and renderer are created, None runs without a GPU
+			static void SetAPI(API api) { s_API = api; }
 			static std::string GetAPIName();
 
 
@@ -0,0 +1,22 @@
+#include "pch.h"
+#include "RingBuffer.h"
+
+#include "Renderer/Renderer.h"
+#include "Renderer/OpenGL/OpenGLRingBuffer.h"
+#include "Renderer/Null/NullRingBuffer.h"
+
+namespace Venus {
+
+	Ref<RingBuffer> RingBuffer::Create(uint32_t frameSize, RingBufferUsage usage)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    return CreateRef<NullRingBuffer>(frameSize, usage);
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLRingBuffer>(frameSize, usage);
+		}
+
+		VS_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Engine/Base.h"
+
+namespace Venus {
+
+	enum class RingBufferUsage
+	{
+		Uniform = 0, Storage, Vertex, PixelUnpack
+	};
+
+	// Persistently mapped buffer split in FramesInFlight regions, each one fenced before it is reused
+	class RingBuffer
+	{
+		public:
+			virtual ~RingBuffer() {}
+
+			// Copies data into the current region and returns its offset from the start of the buffer
+			virtual uint32_t Push(const void* data, uint32_t size, uint32_t alignment = 0) = 0;
+			virtual void BindRange(uint32_t binding, uint32_t offset, uint32_t size) const = 0;
+
+			// Fences the current region and moves to the next one, waiting for the GPU if it is still in use
+			virtual void NextFrame() = 0;
+
+			virtual uint32_t GetRendererID() const = 0;
+
+			static Ref<RingBuffer> Create(uint32_t frameSize, RingBufferUsage usage);
+
+			static constexpr uint32_t FramesInFlight = 3;
+	};
+
+}
@@ -0,0 +1,22 @@
+#include "pch.h"
+#include "Sampler.h"
+
+#include "Renderer/Renderer.h"
+#include "Renderer/OpenGL/OpenGLSampler.h"
+#include "Renderer/Null/NullSampler.h"
+
+namespace Venus {
+
+	Ref<Sampler> Sampler::Create(const SamplerSpecification& spec)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    return CreateRef<NullSampler>(spec);
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLSampler>(spec);
+		}
+
+		VS_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Engine/Base.h"
+#include "Renderer/Texture.h"
+
+namespace Venus {
+
+	// Filtering and addressing state, bound per texture unit independently of the texture storage
+	struct SamplerSpecification
+	{
+		TextureFilterMode Filter = TextureFilterMode::Bilinear;
+		TextureWrapMode WrapMode = TextureWrapMode::Repeat;
+		bool UseMipmaps = false;
+
+		SamplerSpecification() = default;
+		SamplerSpecification(const TextureProperties& props)
+			: Filter(props.Filter), WrapMode(props.WrapMode), UseMipmaps(props.UseMipmaps) {}
+
+		uint32_t GetKey() const { return (uint32_t)Filter | ((uint32_t)WrapMode << 1) | ((uint32_t)UseMipmaps << 3); }
+	};
+
+	class Sampler
+	{
+		public:
+			virtual ~Sampler() = default;
+
+			virtual void Bind(uint32_t slot) const = 0;
+
+			virtual uint32_t GetRendererID() const = 0;
+			virtual const SamplerSpecification& GetSpecification() const = 0;
+
+			// Prefer Renderer::GetSampler, samplers are shared by key
+			static Ref<Sampler> Create(const SamplerSpecification& spec);
+	};
+
+}
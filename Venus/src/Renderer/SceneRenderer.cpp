@@ -4,12 +4,59 @@
 #include "Renderer.h"
 #include "Renderer2D.h"
 #include "Engine/Application.h"
+#include "Engine/JobSystem.h"
 #include "Assets/AssetManager.h"
 
 #include "ImGui/UI.h"
 
 namespace Venus {
 
+	static constexpr ShaderUniformName s_LightCullingNearUniform("u_Uniforms.Near");
+	static constexpr ShaderUniformName s_LightCullingFarUniform("u_Uniforms.Far");
+
+	namespace Utils {
+
+		static FramebufferTextureFormat GetColorFramebufferFormat(ColorBufferFormat format)
+		{
+			switch (format)
+			{
+				case ColorBufferFormat::RGBA16F:	return FramebufferTextureFormat::RGBA16F;
+				case ColorBufferFormat::R11G11B10F:	return FramebufferTextureFormat::R11G11B10F;
+				case ColorBufferFormat::RGBA32F:	return FramebufferTextureFormat::RGBA32F;
+			}
+
+			VS_CORE_ASSERT(false, "Unknown Color Buffer Format");
+			return FramebufferTextureFormat::None;
+		}
+
+		static TextureFormat GetColorTextureFormat(ColorBufferFormat format)
+		{
+			switch (format)
+			{
+				case ColorBufferFormat::RGBA16F:	return TextureFormat::RGBA16F;
+				case ColorBufferFormat::R11G11B10F:	return TextureFormat::R11G11B10F;
+				case ColorBufferFormat::RGBA32F:	return TextureFormat::RGBA32F;
+			}
+
+			VS_CORE_ASSERT(false, "Unknown Color Buffer Format");
+			return TextureFormat::RGBA32F;
+		}
+
+		// Levels of the half resolution chain down to the minimum size, at least two so there is something to upsample
+		static uint32_t GetBloomMipCount(uint32_t width, uint32_t height, int minMipSize)
+		{
+			uint32_t size = std::min(width, height);
+			uint32_t minSize = (uint32_t)std::max(minMipSize, 1);
+
+			uint32_t mipCount = 1;
+			while ((size >> mipCount) >= minSize)
+				mipCount++;
+
+			return std::max(mipCount, 2u);
+		}
+
+	}
+
 	SceneRenderer::SceneRenderer(Ref<Scene> scene)
 		:m_Scene(scene)
 	{
@@ -37,47 +84,19 @@ namespace Venus {
 			m_ShadowPipeline = Pipeline::Create(pipelineSpec);
 		}
 
-		// Geometry 
+		// Geometry, the targets of this and the following pipelines come from the render graph
 		{
-			FramebufferSpecification fbSpec;
-			fbSpec.Attachments = { FramebufferTextureFormat::RGBA32F, FramebufferTextureFormat::RED_INTEGER, FramebufferTextureFormat::DEPTH24STENCIL8 };
-			fbSpec.Samples = 1;
-			fbSpec.SwapChainTarget = false;
-			fbSpec.Width = 1920;
-			fbSpec.Height = 1080;
-			Ref<Framebuffer> framebuffer = Framebuffer::Create(fbSpec);
-
 			PipelineSpecification pipelineSpec;
 			pipelineSpec.Shader = Renderer::GetShaderLibrary()->Get("PBR");
-			pipelineSpec.Framebuffer = framebuffer;
 			pipelineSpec.DebugName = "Geometry";
 
 			m_GeometryPipeline = Pipeline::Create(pipelineSpec);
 		}
 
-		// Selected Geometry
-		{
-			FramebufferSpecification fbSpec;
-			fbSpec.Attachments = { FramebufferTextureFormat::RGBA32F, FramebufferTextureFormat::DEPTH24STENCIL8 };
-			fbSpec.Samples = 1;
-			fbSpec.SwapChainTarget = false;
-			fbSpec.Width = 1920;
-			fbSpec.Height = 1080;
-			Ref<Framebuffer> framebuffer = Framebuffer::Create(fbSpec);
-
-			PipelineSpecification pipelineSpec;
-			pipelineSpec.Shader = Renderer::GetShaderLibrary()->Get("Outline");
-			pipelineSpec.Framebuffer = framebuffer;
-			pipelineSpec.DebugName = "Selected Geometry";
-
-			m_SelectedGeometryPipeline = Pipeline::Create(pipelineSpec);
-		}
-
 		// Grid
 		{
 			PipelineSpecification pipelineSpec;
 			pipelineSpec.Shader = Renderer::GetShaderLibrary()->Get("Grid");
-			pipelineSpec.Framebuffer = m_GeometryPipeline->GetFramebuffer();
 			pipelineSpec.DebugName = "Grid";
 
 			m_GridPipeline = Pipeline::Create(pipelineSpec);
@@ -91,7 +110,6 @@ namespace Venus {
 		{
 			PipelineSpecification pipelineSpec;
 			pipelineSpec.Shader = Renderer::GetShaderLibrary()->Get("Skybox");
-			pipelineSpec.Framebuffer = m_GeometryPipeline->GetFramebuffer();
 			pipelineSpec.DebugName = "Skybox";
 
 			m_SkyboxPipeline = Pipeline::Create(pipelineSpec);
@@ -99,67 +117,27 @@ namespace Venus {
 			m_SkyboxMaterial = Material::Create(pipelineSpec.Shader);
 		}
 
-		// FXAA 
-		{
-			FramebufferSpecification fbSpec;
-			fbSpec.SwapChainTarget = false;
-			fbSpec.Attachments = { FramebufferTextureFormat::RGBA32F };
-			fbSpec.Width = 1920;
-			fbSpec.Height = 1080;
-			Ref<Framebuffer> framebuffer = Framebuffer::Create(fbSpec);
-
-			PipelineSpecification pipelineSpec;
-			pipelineSpec.Shader = Renderer::GetShaderLibrary()->Get("FXAA");
-			pipelineSpec.Framebuffer = framebuffer;
-			pipelineSpec.DebugName = "FXAA";
-
-			m_FXAAPipeline = Pipeline::Create(pipelineSpec);
-
-			m_FXAAMaterial = Material::Create(pipelineSpec.Shader);
-		}
-
 		// Bloom
 		{
 			Ref<Shader> bloomShader = Renderer::GetShaderLibrary()->Get("Bloom");
 			m_BloomPipeline = ComputePipeline::Create(bloomShader);
 			m_BloomMaterial = Material::Create(bloomShader);
-
-			m_BloomTextures[0] = Texture2D::Create(1, 1);
-			m_BloomTextures[1] = Texture2D::Create(1, 1);
-			m_BloomTextures[2] = Texture2D::Create(1, 1);
 		}
 
-		// Scene Composite
+		// Light Culling
 		{
-			FramebufferSpecification fbSpec;
-			fbSpec.SwapChainTarget = false;
-			fbSpec.Attachments = { FramebufferTextureFormat::RGBA8 };
-			fbSpec.Width = 1920;
-			fbSpec.Height = 1080;
-			Ref<Framebuffer> framebuffer = Framebuffer::Create(fbSpec);
-
-			PipelineSpecification pipelineSpec;
-			pipelineSpec.Shader = Renderer::GetShaderLibrary()->Get("Composite");
-			pipelineSpec.Framebuffer = framebuffer;
-			pipelineSpec.DebugName = "Composite";
-
-			m_CompositePipeline = Pipeline::Create(pipelineSpec);
+			m_LightCullingPipeline = ComputePipeline::Create(Renderer::GetShaderLibrary()->Get("LightCulling"));
+		}
 
-			m_CompositeMaterial = Material::Create(pipelineSpec.Shader);
+		// Post Process, variants share the settings layout of the default one
+		{
+			m_PostProcessMaterial = Material::Create(Renderer::GetShaderLibrary()->Get("PostProcess"));
 		}
 
 		// Temp Pipeline 
 		{
-			FramebufferSpecification fbSpec;
-			fbSpec.SwapChainTarget = false;
-			fbSpec.Attachments = { FramebufferTextureFormat::RGBA8 };
-			fbSpec.Width = 1920;
-			fbSpec.Height = 1080;
-			Ref<Framebuffer> framebuffer = Framebuffer::Create(fbSpec);
-
 			PipelineSpecification pipelineSpec;
 			pipelineSpec.Shader = Renderer::GetShaderLibrary()->Get("ShadowMapDebug");
-			pipelineSpec.Framebuffer = framebuffer;
 			pipelineSpec.DebugName = "Temp";
 
 			m_TempPipeline = Pipeline::Create(pipelineSpec);
@@ -169,16 +147,8 @@ namespace Venus {
 
 		//  Bloom Debug
 		{
-			FramebufferSpecification fbSpec;
-			fbSpec.SwapChainTarget = false;
-			fbSpec.Attachments = { FramebufferTextureFormat::RGBA8 };
-			fbSpec.Width = 1920;
-			fbSpec.Height = 1080;
-			Ref<Framebuffer> framebuffer = Framebuffer::Create(fbSpec);
-
 			PipelineSpecification pipelineSpec;
 			pipelineSpec.Shader = Renderer::GetShaderLibrary()->Get("BloomDebug");
-			pipelineSpec.Framebuffer = framebuffer;
 			pipelineSpec.DebugName = "Bloom Debug";
 
 			m_BloomDebugPipeline = Pipeline::Create(pipelineSpec);
@@ -186,26 +156,16 @@ namespace Venus {
 			m_BloomDebugMaterial = Material::Create(pipelineSpec.Shader);
 		}
 
-		// 2D
-		{
-			FramebufferSpecification fbSpec;
-			fbSpec.SwapChainTarget = false;
-			fbSpec.Attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::DEPTH24STENCIL8 };
-			fbSpec.Width = 1920;
-			fbSpec.Height = 1080;
-			fbSpec.ExistingColorTextures.push_back(m_CompositePipeline->GetFramebuffer()->GetColorAttachmentRendererID());
-			fbSpec.ExistingDepthTexture = m_GeometryPipeline->GetFramebuffer()->GetDepthAttachmentRendererID();
-
-			m_2DFramebuffer = Framebuffer::Create(fbSpec);
-
-			Renderer2D::SetRenderTarget(m_2DFramebuffer);
-		}
-
 		// Uniform Buffers
 		m_ShadowDataBuffer = UniformBuffer::Create(sizeof(ShadowData), 2);
 		m_SceneDataBuffer = UniformBuffer::Create(sizeof(SceneData), 3);
-		m_PointLightDataBuffer = UniformBuffer::Create(sizeof(PointLightData), 4);
 		m_RendererDataBuffer = UniformBuffer::Create(sizeof(RendererData), 5);
+		m_BloomParamsBuffer = UniformBuffer::Create(sizeof(BloomParams) * MaxBloomDispatches, 4);
+
+		// Storage Buffers, binding 0 is the Renderer instance buffer
+		m_PointLightDataBuffer = StorageBuffer::Create(sizeof(PointLightData) + sizeof(PointLight) * 1024, 1);
+		m_ClusterLightCountBuffer = StorageBuffer::Create(sizeof(uint32_t) * ClusterCount, 2);
+		m_ClusterLightIndexBuffer = StorageBuffer::Create(sizeof(uint32_t) * ClusterCount * MaxLightsPerCluster, 3);
 	}
 
 	void SceneRenderer::SetScene(Ref<Scene> scene)
@@ -218,68 +178,21 @@ namespace Venus {
 
 	void SceneRenderer::SetViewportSize(uint32_t width, uint32_t height)
 	{
+		// A collapsed viewport keeps the last size instead of creating empty targets
+		if (width == 0 || height == 0)
+			return;
+
 		if (m_ViewportWidth != width || m_ViewportHeight != height)
 		{
 			m_ViewportWidth = width;
 			m_ViewportHeight = height;
-			m_NeedsResize = true;
-
 		}
 	}
 
 	void SceneRenderer::BeginScene(CameraComponent& cameraComponent, const glm::mat4& transform)
 	{
-		// Resizes if needed
-		if (m_NeedsResize)
-		{
-			m_GeometryPipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-			m_SelectedGeometryPipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-			m_FXAAPipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-			m_CompositePipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-			m_TempPipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-			m_BloomDebugPipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-
-			// Update Existing Textures Renderer2D framebuffer
-			{
-				uint32_t colorTexture = m_CompositePipeline->GetFramebuffer()->GetColorAttachmentRendererID();
-				uint32_t depthTexture = m_GeometryPipeline->GetFramebuffer()->GetDepthAttachmentRendererID();
-
-				m_2DFramebuffer->GetSpecification().ExistingColorTextures.clear();
-				m_2DFramebuffer->GetSpecification().ExistingColorTextures.push_back(colorTexture);
-				m_2DFramebuffer->GetSpecification().ExistingDepthTexture = depthTexture;
-
-				m_2DFramebuffer->Resize(m_ViewportWidth, m_ViewportHeight);
-			}
-
-			// Bloom Textures
-			{
-				TextureProperties props;
-				props.Format = TextureFormat::RGBA32F;
-				props.WrapMode = TextureWrapMode::ClampToEdge;
-				props.UseMipmaps = true;
-
-				uint32_t viewportWidth = m_ViewportWidth / 2;
-				uint32_t viewportHeight = m_ViewportHeight / 2;
-				viewportWidth += (4 - (viewportWidth % 4)); // Workgroup size = 4
-				viewportHeight += (4 - (viewportHeight % 4));
-
-				m_BloomTextures[0] = Texture2D::Create(viewportWidth, viewportHeight, props);
-				m_BloomTextures[1] = Texture2D::Create(viewportWidth, viewportHeight, props);
-				m_BloomTextures[2] = Texture2D::Create(viewportWidth, viewportHeight, props);
-			}
-
-			m_NeedsResize = false;
-		}
-
-		// Clear buffers
-		Renderer::Clear(m_ShadowPipeline->GetFramebuffer());
-		Renderer::Clear(m_GeometryPipeline->GetFramebuffer(), cameraComponent.BackgroundColor);
-		m_GeometryPipeline->GetFramebuffer()->ClearAttachment(1, -1);
-		Renderer::Clear(m_SelectedGeometryPipeline->GetFramebuffer());
-		Renderer::Clear(m_FXAAPipeline->GetFramebuffer());
-		Renderer::Clear(m_CompositePipeline->GetFramebuffer());
-		Renderer::Clear(m_TempPipeline->GetFramebuffer());
-		Renderer::Clear(m_BloomDebugPipeline->GetFramebuffer());
+		// Cleared by the passes writing them
+		m_ClearColor = cameraComponent.BackgroundColor;
 
 		Renderer::ResetStats();
 
@@ -300,10 +213,7 @@ namespace Venus {
 		m_SceneBuffer.EnvironmentMapIntensity = m_Scene->m_LightEnvironment.SkyLight.Intensity;
 		m_SceneDataBuffer->SetData(&m_SceneBuffer, sizeof(m_SceneBuffer)); // SCENE BUFFER
 
-		const std::vector<PointLight>& pointLightsVec = m_Scene->m_LightEnvironment.PointLights;
-		m_PointLightBuffer.Count = uint32_t(pointLightsVec.size());
-		std::memcpy(m_PointLightBuffer.PointLights, pointLightsVec.data(), sizeof PointLight * pointLightsVec.size());
-		m_PointLightDataBuffer->SetData(&m_PointLightBuffer, 16ull + sizeof(PointLight) * m_PointLightBuffer.Count); // POINT LIGHT BUFFER
+		UploadPointLights(); // POINT LIGHT BUFFER
 
 		CameraInfo cameraInfo;
 		cameraInfo.Camera = camera;
@@ -322,6 +232,10 @@ namespace Venus {
 		m_ShadowDataBuffer->SetData(&m_ShadowBuffer, sizeof(m_ShadowBuffer)); // SHADOW BUFFER
 
 		m_RendererBuffer.CascadeSplits = cascadeSplit;
+		if (camera.GetProjectionType() == SceneCamera::ProjectionType::Orthographic)
+			UpdateClusterData(camera.GetOrthographicNearClip(), camera.GetOrthographicFarClip());
+		else
+			UpdateClusterData(cameraInfo.Near, cameraInfo.Far);
 		m_RendererDataBuffer->SetData(&m_RendererBuffer, sizeof(m_RendererBuffer)); // RENDERER BUFFER
 
 		// Environment
@@ -334,58 +248,9 @@ namespace Venus {
 
 	void SceneRenderer::BeginScene(EditorCamera& camera)
 	{
-		// Resizes if needed
-		if (m_NeedsResize)
-		{
-			m_GeometryPipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-			m_SelectedGeometryPipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-			m_FXAAPipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-			m_CompositePipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-			m_TempPipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-			m_BloomDebugPipeline->GetFramebuffer()->Resize(m_ViewportWidth, m_ViewportHeight);
-
-			// Update Existing Textures Renderer2D framebuffer
-			{
-				uint32_t colorTexture = m_CompositePipeline->GetFramebuffer()->GetColorAttachmentRendererID();
-				uint32_t depthTexture = m_GeometryPipeline->GetFramebuffer()->GetDepthAttachmentRendererID();
+		// Cleared by the passes writing them
+		m_ClearColor = m_EditorBackgroundColor;
 
-				m_2DFramebuffer->GetSpecification().ExistingColorTextures.clear();
-				m_2DFramebuffer->GetSpecification().ExistingColorTextures.push_back(colorTexture);
-				m_2DFramebuffer->GetSpecification().ExistingDepthTexture = depthTexture;
-
-				m_2DFramebuffer->Resize(m_ViewportWidth, m_ViewportHeight);
-			}
-
-			// Bloom Textures
-			{
-				TextureProperties props;
-				props.Format = TextureFormat::RGBA32F;
-				props.WrapMode = TextureWrapMode::ClampToEdge;
-				props.UseMipmaps = true;
-
-				uint32_t viewportWidth = m_ViewportWidth / 2;
-				uint32_t viewportHeight = m_ViewportHeight / 2;
-				viewportWidth += (4 - (viewportWidth % 4)); // Workgroup size = 4
-				viewportHeight += (4 - (viewportHeight % 4));
-
-				m_BloomTextures[0] = Texture2D::Create(viewportWidth, viewportHeight, props);
-				m_BloomTextures[1] = Texture2D::Create(viewportWidth, viewportHeight, props);
-				m_BloomTextures[2] = Texture2D::Create(viewportWidth, viewportHeight, props);
-			}
-
-			m_NeedsResize = false;
-		}
-
-		// Clear buffers
-		Renderer::Clear(m_ShadowPipeline->GetFramebuffer());
-		Renderer::Clear(m_GeometryPipeline->GetFramebuffer(), m_EditorBackgroundColor);
-		m_GeometryPipeline->GetFramebuffer()->ClearAttachment(1, -1);
-		Renderer::Clear(m_SelectedGeometryPipeline->GetFramebuffer());
-		Renderer::Clear(m_FXAAPipeline->GetFramebuffer());
-		Renderer::Clear(m_CompositePipeline->GetFramebuffer());
-		Renderer::Clear(m_TempPipeline->GetFramebuffer());
-		Renderer::Clear(m_BloomDebugPipeline->GetFramebuffer());
-		
 		Renderer::ResetStats();
 
 		// Begin scene at Renderer
@@ -402,10 +267,7 @@ namespace Venus {
 		m_SceneBuffer.EnvironmentMapIntensity = m_Scene->m_LightEnvironment.SkyLight.Intensity;
 		m_SceneDataBuffer->SetData(&m_SceneBuffer, sizeof(m_SceneBuffer)); // SCENE BUFFER
 
-		const std::vector<PointLight>& pointLightsVec = m_Scene->m_LightEnvironment.PointLights;
-		m_PointLightBuffer.Count = uint32_t(pointLightsVec.size());
-		std::memcpy(m_PointLightBuffer.PointLights, pointLightsVec.data(), sizeof PointLight * pointLightsVec.size());
-		m_PointLightDataBuffer->SetData(&m_PointLightBuffer, 16ull + sizeof(PointLight) * m_PointLightBuffer.Count); // POINT LIGHT BUFFER
+		UploadPointLights(); // POINT LIGHT BUFFER
 
 		CameraInfo cameraInfo;
 		cameraInfo.Camera = camera;
@@ -424,6 +286,7 @@ namespace Venus {
 		m_ShadowDataBuffer->SetData(&m_ShadowBuffer, sizeof(m_ShadowBuffer)); // SHADOW BUFFER
 
 		m_RendererBuffer.CascadeSplits = cascadeSplit;
+		UpdateClusterData(cameraInfo.Near, cameraInfo.Far);
 		m_RendererDataBuffer->SetData(&m_RendererBuffer, sizeof(m_RendererBuffer)); // RENDERER BUFFER
 
 		// Environment
@@ -469,11 +332,24 @@ namespace Venus {
 		//m_SelectedDrawList.push_back(drawCmd);
 	}
 
-	void SceneRenderer::SubmitQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor, int entityID)
+	void SceneRenderer::SubmitShadowCaster(const Ref<Model>& model, const Ref<MaterialTable>& materialTable, const glm::mat4& transform, int entityID)
+	{
+		DrawCmd drawCmd;
+		drawCmd.Model = model;
+		drawCmd.MaterialTable = materialTable;
+		drawCmd.Transform = transform;
+		drawCmd.ID = entityID;
+
+		m_ShadowDrawList.push_back(drawCmd);
+	}
+
+	void SceneRenderer::SubmitQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor, int entityID, const Ref<Sampler>& sampler, bool flipVertically)
 	{
 		QuadDrawCmd drawCmd;
 		drawCmd.Transform = transform;
 		drawCmd.Texture = texture;
+		drawCmd.Sampler = sampler;
+		drawCmd.FlipVertically = flipVertically;
 		drawCmd.TilingFactor = tilingFactor;
 		drawCmd.TintColor = tintColor;
 		drawCmd.ID = entityID;
@@ -517,40 +393,185 @@ namespace Venus {
 
 	void SceneRenderer::Flush()
 	{
-		ShadowMapPass();
-		GeometryPass();
-		FXAAPass();
-		BloomPass();
-		CompositePass();
-		Render2DPass();
+		// Shadow and geometry instances share one buffer, uploaded once per frame
+		if (m_Scene->m_LightEnvironment.HasDirLight && m_Scene->m_LightEnvironment.CastsShadows)
+		{
+			CullShadowCasters();
+			BuildMeshBatches(m_ShadowDrawList, m_ShadowMeshBatches, false);
+		}
+		BuildMeshBatches(m_DrawList, m_MeshBatches, true);
+		Renderer::SetInstanceData(m_InstanceData);
+		BuildRenderQueue();
+
+		// Debug views stay empty when their passes are culled
+		m_ShadowMapDebugFramebuffer = nullptr;
+		m_BloomDebugFramebuffer = nullptr;
+		m_BloomTextures[0] = nullptr;
+		m_BloomTextures[1] = nullptr;
+
+		BuildRenderGraph();
+		m_RenderGraph.Execute();
 
 		m_DrawList.clear();
 		m_SelectedDrawList.clear();
 		m_ShadowDrawList.clear();
 
+		m_MeshBatches.clear();
+		m_ShadowMeshBatches.clear();
+		m_InstanceData.clear();
+		m_RenderQueue.Clear();
+
 		m_QuadDrawList.clear();
 		m_CircleDrawList.clear();
 		m_RectDrawList.clear();
 		m_BillboardDrawList.clear();
 	}
 
+	void SceneRenderer::BuildRenderGraph()
+	{
+		m_RenderGraph.Reset();
+
+		FramebufferTextureFormat colorFormat = Utils::GetColorFramebufferFormat(m_Options.ColorFormat);
+
+		FramebufferSpecification geometrySpec;
+		geometrySpec.Attachments = { colorFormat, FramebufferTextureFormat::RED_INTEGER, FramebufferTextureFormat::DEPTH24STENCIL8 };
+		geometrySpec.Width = m_ViewportWidth;
+		geometrySpec.Height = m_ViewportHeight;
+
+		FramebufferSpecification ldrSpec;
+		ldrSpec.Attachments = { FramebufferTextureFormat::RGBA8 };
+		ldrSpec.Width = m_ViewportWidth;
+		ldrSpec.Height = m_ViewportHeight;
+
+		// Bloom runs at half resolution, both chains share the same size and levels
+		RenderGraphTextureSpecification bloomSpec;
+		bloomSpec.Width = std::max(m_ViewportWidth / 2, 2u);
+		bloomSpec.Height = std::max(m_ViewportHeight / 2, 2u);
+		bloomSpec.Properties.Format = Utils::GetColorTextureFormat(m_Options.ColorFormat);
+		bloomSpec.Properties.WrapMode = TextureWrapMode::ClampToEdge;
+		bloomSpec.Properties.UseMipmaps = true;
+		m_BloomMipCount = Utils::GetBloomMipCount(bloomSpec.Width, bloomSpec.Height, m_Options.BloomMinMipSize);
+
+		RenderGraphResource shadowMap = m_RenderGraph.ImportTarget("Shadow Map", m_ShadowPipeline->GetFramebuffer());
+		RenderGraphResource lightClusters = m_RenderGraph.ImportResource("Light Clusters");
+		RenderGraphResource bloomDownsample = m_RenderGraph.CreateTexture("Bloom Downsample", bloomSpec);
+		RenderGraphResource bloomUpsample = m_RenderGraph.CreateTexture("Bloom Upsample", bloomSpec);
+		RenderGraphResource geometry = m_RenderGraph.CreateTarget("Geometry", geometrySpec);
+		RenderGraphResource finalImage = m_RenderGraph.CreateTarget("Final Image", ldrSpec);
+
+		m_RenderGraph.AddPass("Light Culling", {}, { lightClusters }, [this]()
+		{
+			LightCullingPass();
+		});
+
+		// Loads, cached cascades keep last frame's depth
+		m_RenderGraph.AddPass("Shadow Map", {}, { shadowMap }, [this]()
+		{
+			ShadowMapPass();
+		});
+
+		m_RenderGraph.AddPass("Geometry", { shadowMap, lightClusters }, { { geometry, AttachmentLoadOp::Clear, m_ClearColor, -1 } }, [this, geometry]()
+		{
+			m_GeometryFramebuffer = m_RenderGraph.GetFramebuffer(geometry);
+			m_GeometryPipeline->GetSpecification().Framebuffer = m_GeometryFramebuffer;
+			m_SkyboxPipeline->GetSpecification().Framebuffer = m_GeometryFramebuffer;
+			m_GridPipeline->GetSpecification().Framebuffer = m_GeometryFramebuffer;
+			GeometryPass();
+		});
+
+		m_RenderGraph.AddPass("Bloom", { geometry }, { bloomDownsample, bloomUpsample }, [this, bloomDownsample, bloomUpsample]()
+		{
+			m_BloomTextures[0] = m_RenderGraph.GetTexture(bloomDownsample);
+			m_BloomTextures[1] = m_RenderGraph.GetTexture(bloomUpsample);
+			BloomPass();
+		});
+
+		// Bloom is culled when the post process doesn't read it
+		std::vector<RenderGraphResource> postProcessInputs = { geometry };
+		if (IsBloomEnabled())
+			postProcessInputs.push_back(bloomUpsample);
+
+		m_RenderGraph.AddPass("Post Process", postProcessInputs, { { finalImage, AttachmentLoadOp::DontCare } }, [this, finalImage]()
+		{
+			m_FinalFramebuffer = m_RenderGraph.GetFramebuffer(finalImage);
+			PostProcessPass();
+		});
+
+		// Drawn over the composited image, depth tested against the geometry
+		m_RenderGraph.AddPass("2D", { geometry }, { finalImage }, [this]()
+		{
+			Render2DPass();
+		});
+
+		// Entity IDs in the geometry buffer are read back for picking
+		m_RenderGraph.SetOutput(geometry);
+		m_RenderGraph.SetOutput(finalImage);
+
+		// Runtime never declares the editor debug views, the editor only keeps them while the panel shows them
+		if (!m_IsRuntime)
+		{
+			RenderGraphResource shadowMapDebug = m_RenderGraph.CreateTarget("Shadow Map Debug", ldrSpec);
+			m_RenderGraph.AddPass("Shadow Map Debug", { shadowMap }, { { shadowMapDebug, AttachmentLoadOp::Clear } }, [this, shadowMapDebug]()
+			{
+				m_ShadowMapDebugFramebuffer = m_RenderGraph.GetFramebuffer(shadowMapDebug);
+				m_TempPipeline->GetSpecification().Framebuffer = m_ShadowMapDebugFramebuffer;
+				ShadowMapDebugPass();
+			});
+
+			RenderGraphResource bloomDebug = m_RenderGraph.CreateTarget("Bloom Debug", ldrSpec);
+			m_RenderGraph.AddPass("Bloom Debug", { bloomDownsample, bloomUpsample }, { { bloomDebug, AttachmentLoadOp::Clear } }, [this, bloomDebug]()
+			{
+				m_BloomDebugFramebuffer = m_RenderGraph.GetFramebuffer(bloomDebug);
+				m_BloomDebugPipeline->GetSpecification().Framebuffer = m_BloomDebugFramebuffer;
+				BloomDebugPass();
+			});
+
+			if (m_ShadowMapDebugView)
+				m_RenderGraph.SetOutput(shadowMapDebug);
+			if (m_BloomDebugView)
+				m_RenderGraph.SetOutput(bloomDebug);
+		}
+	}
+
+	bool SceneRenderer::IsBloomEnabled() const
+	{
+		if (m_IsRuntime && !m_RuntimeCamera->UseRendererSettings && !m_RuntimeCamera->Bloom)
+			return false;
+
+		return m_Options.Bloom;
+	}
+
+	void SceneRenderer::LightCullingPass()
+	{
+		// Always dispatched so cluster counts never go stale, the shader writes zeroes when there are no lights
+		m_LightCullingPipeline->Begin();
+		m_LightCullingPipeline->GetShader()->SetFloat(s_LightCullingNearUniform, m_ClusterNear);
+		m_LightCullingPipeline->GetShader()->SetFloat(s_LightCullingFarUniform, m_ClusterFar);
+		m_LightCullingPipeline->Execute(1, 1, ClusterCountZ / ClusterSlicesPerGroup, false);
+	}
+
 	void SceneRenderer::ShadowMapPass()
 	{
 		if (m_Scene->m_LightEnvironment.HasDirLight && m_Scene->m_LightEnvironment.CastsShadows)
 		{
-			for (auto& cmd : m_ShadowDrawList)
-			{
-				Renderer::RenderModel(m_ShadowPipeline, cmd.Model, cmd.Transform);
-			}
-			
-			// Shadow Map cascade viewer at settings
+			// Cached cascades keep last frame's depth
+			Ref<Framebuffer> framebuffer = m_ShadowPipeline->GetFramebuffer();
+			for (uint32_t i = 0; i < 4; i++)
 			{
-				uint32_t depthTextureID = m_ShadowPipeline->GetFramebuffer()->GetDepthAttachmentRendererID();
-				uint32_t layer = GetOptions().ShadowMapDebugCascade;
-				m_TempMaterial->SetTextureArray("u_Texture", 0, depthTextureID);
-				m_TempMaterial->SetInt("u_Settings.Layer", layer);
-				Renderer::RenderFullscreenQuad(m_TempPipeline, m_TempMaterial);
+				if (m_CascadeUpdateMask & (1 << i))
+					framebuffer->ClearDepthAttachment(i);
 			}
+
+			Renderer::SubmitRenderQueue(m_RenderQueue, RenderQueuePass::Shadow);
+		}
+		else
+		{
+			// Nothing was rendered, the map must be rebuilt when shadows come back
+			for (auto& cache : m_CascadeCache)
+				cache.Valid = false;
+
+			m_CascadeUpdateMask = 0;
+			m_ShadowCasterCount = 0;
 		}
 	}
 
@@ -573,10 +594,7 @@ namespace Venus {
 
 		// Models
 		{
-			for (auto& cmd : m_DrawList)
-			{
-				Renderer::RenderModelWithMaterial(m_GeometryPipeline, cmd.Model, cmd.MaterialTable, cmd.Transform, cmd.ID);
-			}
+			Renderer::SubmitRenderQueue(m_RenderQueue, RenderQueuePass::Geometry);
 		}
 
 		// Grid
@@ -589,154 +607,67 @@ namespace Venus {
 		}
 	}
 
-	void SceneRenderer::FXAAPass()
-	{
-		if (!GetOptions().FXAA)
-			return;
-
-		auto& geoFramebuffer = m_GeometryPipeline->GetFramebuffer();
-		uint32_t texture = geoFramebuffer->GetColorAttachmentRendererID();
-
-		m_FXAAMaterial->SetInt("u_Settings.ViewportWidth", m_ViewportWidth);
-		m_FXAAMaterial->SetInt("u_Settings.ViewportHeight", m_ViewportHeight);
-		m_FXAAMaterial->SetFloat("u_Settings.ThresholdMin", GetOptions().FXAAThresholdMin);
-		m_FXAAMaterial->SetFloat("u_Settings.ThresholdMax", GetOptions().FXAAThresholdMax);
-		m_FXAAMaterial->SetInt("u_Settings.Iterations", GetOptions().FXAAIterations);
-		m_FXAAMaterial->SetFloat("u_Settings.SubpixelQuality", GetOptions().FXAASubPixelQuality);
-		m_FXAAMaterial->SetTexture("u_Texture", 0, texture);
-
-		Renderer::RenderFullscreenQuad(m_FXAAPipeline, m_FXAAMaterial);
-	}
-
 	void SceneRenderer::BloomPass()
 	{
-		if (m_IsRuntime && !m_RuntimeCamera->UseRendererSettings && !m_RuntimeCamera->Bloom)
-			return;
-		else if (!GetOptions().Bloom)
-			return;
-
-		uint32_t workGroupSize = 4;
+		enum BloomMode { Prefilter = 0, Downsample = 1, Upsample = 2 };
+		static constexpr uint32_t workGroupSize = 8;
 
 		float threshold = GetOptions().BloomThreshold;
 		float knee = GetOptions().BloomKnee;
-		int mode = 0;  // 0 Prefilter, 1 Downsample, 2 UpSample(1), 3 Upsample
-		float LOD = 0.0f;
-
-		auto inputTexture = m_GeometryPipeline->GetFramebuffer()->GetColorAttachmentRendererID();
 		glm::vec4 params = { threshold, threshold - knee, knee * 2.0f, 0.25f / knee };
 
-		uint32_t workGroupsX = 1, workGroupsY = 1;
+		const Ref<Texture2D>& downsampleTexture = m_BloomTextures[0];
+		const Ref<Texture2D>& upsampleTexture = m_BloomTextures[1];
+		uint32_t mipCount = m_BloomMipCount;
 
-		// Prefilter
-		{
-			mode = 0;
-			LOD = 0.0f;
-
-			workGroupsX = m_BloomTextures[0]->GetWidth() / workGroupSize;
-			workGroupsY = m_BloomTextures[0]->GetHeight() / workGroupSize;
-
-			m_BloomPipeline->Begin();
-			m_BloomPipeline->GetShader()->SetFloat4("u_Uniforms.Params", params);
-			m_BloomPipeline->GetShader()->SetInt("u_Uniforms.Mode", mode);
-			m_BloomPipeline->GetShader()->SetFloat("u_Uniforms.LOD", LOD);
-			m_BloomPipeline->BindWriteOnlyImage(0, m_BloomTextures[0]);
-			m_BloomPipeline->GetShader()->SetTexture("u_Texture", 1, inputTexture);
-			m_BloomPipeline->GetShader()->SetTexture("u_BloomTexture", 2, inputTexture);
-			m_BloomPipeline->Execute(workGroupsX, workGroupsY, 1, false);
-		}
+		// Every dispatch reads its own block, all of them are uploaded at once in dispatch order
+		uint32_t dispatchCount = 1 + (mipCount - 1) * 2;
+		VS_CORE_ASSERT(dispatchCount <= MaxBloomDispatches, "Too many bloom dispatches!");
 
-		// Downsample
-		int mipCount = m_BloomTextures[0]->GetMipLevelCount() - 2;
-		{
-			mode = 1;
+		m_BloomParams.resize(dispatchCount);
+		m_BloomParams[0] = { params, 0.0f, Prefilter };
+		for (uint32_t mip = 1; mip < mipCount; mip++)
+			m_BloomParams[mip] = { params, mip - 1.0f, Downsample };
+		for (uint32_t i = 0; i < mipCount - 1; i++)
+			m_BloomParams[mipCount + i] = { params, (float)(mipCount - 2 - i), Upsample };
 
-			for (int i = 1; i < mipCount; i++)
-			{
-				LOD = i - 1.0f;
-
-				auto [mipWidth, mipHeight] = m_BloomTextures[0]->GetMipSize(i);
-				workGroupsX = (uint32_t)glm::ceil((float)mipWidth / (float)workGroupSize);
-				workGroupsY = (uint32_t)glm::ceil((float)mipHeight / (float)workGroupSize);
-
-				m_BloomPipeline->Begin();
-				m_BloomPipeline->GetShader()->SetFloat4("u_Uniforms.Params", params);
-				m_BloomPipeline->GetShader()->SetInt("u_Uniforms.Mode", mode);
-				m_BloomPipeline->GetShader()->SetFloat("u_Uniforms.LOD", LOD);
-				m_BloomPipeline->BindWriteOnlyImage(0, m_BloomTextures[1], i);
-				m_BloomTextures[0]->Bind(1);
-				m_BloomPipeline->GetShader()->SetTexture("u_BloomTexture", 2, inputTexture);
-				m_BloomPipeline->Execute(workGroupsX, workGroupsY, 1, false);
-
-				LOD = i;
-				m_BloomPipeline->Begin();
-				m_BloomPipeline->GetShader()->SetFloat4("u_Uniforms.Params", params);
-				m_BloomPipeline->GetShader()->SetInt("u_Uniforms.Mode", mode);
-				m_BloomPipeline->GetShader()->SetFloat("u_Uniforms.LOD", LOD);
-				m_BloomPipeline->BindWriteOnlyImage(0, m_BloomTextures[0], i);
-				m_BloomTextures[1]->Bind(1);
-				m_BloomPipeline->GetShader()->SetTexture("u_BloomTexture", 2, inputTexture);
-				m_BloomPipeline->Execute(workGroupsX, workGroupsY, 1, false);
-			}
-		}
+		m_BloomParamsBuffer->SetData(m_BloomParams.data(), dispatchCount * sizeof(BloomParams));
 
-		// Upsample (1)
+		auto dispatch = [this](uint32_t index, const Ref<Texture2D>& target, uint32_t mip)
 		{
-			if (mipCount < 0)
-				return;
-
-			mode = 2;
-			LOD--;
-			auto [mipWidth, mipHeight] = m_BloomTextures[2]->GetMipSize(mipCount - 2);
-			workGroupsX *= 2;
-			workGroupsY *= 2;
-			workGroupsX = (uint32_t)glm::ceil((float)mipWidth / (float)workGroupSize);
-			workGroupsY = (uint32_t)glm::ceil((float)mipHeight / (float)workGroupSize);
-
-			m_BloomPipeline->Begin();
-			m_BloomPipeline->GetShader()->SetFloat4("u_Uniforms.Params", params);
-			m_BloomPipeline->GetShader()->SetInt("u_Uniforms.Mode", mode);
-			m_BloomPipeline->GetShader()->SetFloat("u_Uniforms.LOD", LOD);
-			m_BloomPipeline->BindWriteOnlyImage(0, m_BloomTextures[2], mipCount - 2);
-			m_BloomTextures[0]->Bind(1);
-			m_BloomPipeline->GetShader()->SetTexture("u_BloomTexture", 2, inputTexture);
-			m_BloomPipeline->Execute(workGroupsX, workGroupsY, 1, false);
-		}
+			auto [mipWidth, mipHeight] = target->GetMipSize(mip);
+
+			m_BloomParamsBuffer->BindRange(index * sizeof(BloomParams), sizeof(BloomParams));
+			m_BloomPipeline->BindWriteOnlyImage(0, target, mip);
+			m_BloomPipeline->Execute((mipWidth + workGroupSize - 1) / workGroupSize, (mipHeight + workGroupSize - 1) / workGroupSize, 1, false);
+		};
+
+		m_BloomPipeline->Begin();
 
-		// Upsample
+		// Prefilter, geometry into the first level
+		uint32_t inputTexture = m_GeometryPipeline->GetFramebuffer()->GetColorAttachmentRendererID();
+		m_BloomPipeline->GetShader()->SetTexture("u_Texture", 1, inputTexture);
+		dispatch(0, downsampleTexture, 0);
+
+		// Downsample, each level reads the one above it in the same texture
+		downsampleTexture->Bind(1);
+		for (uint32_t mip = 1; mip < mipCount; mip++)
+			dispatch(mip, downsampleTexture, mip);
+
+		// Upsample, the last downsampled level seeds the upsample chain
+		downsampleTexture->Bind(2);
+		for (uint32_t i = 0; i < mipCount - 1; i++)
 		{
-			mode = 3;
-			for (int mip = mipCount - 3; mip >= 0; mip--)
-			{
-				LOD = mip;
-
-				auto [mipWidth, mipHeight] = m_BloomTextures[2]->GetMipSize(mip);
-				workGroupsX = (uint32_t)glm::ceil((float)mipWidth / (float)workGroupSize);
-				workGroupsY = (uint32_t)glm::ceil((float)mipHeight / (float)workGroupSize);
-
-				m_BloomPipeline->Begin();
-				m_BloomPipeline->GetShader()->SetFloat4("u_Uniforms.Params", params);
-				m_BloomPipeline->GetShader()->SetInt("u_Uniforms.Mode", mode);
-				m_BloomPipeline->GetShader()->SetFloat("u_Uniforms.LOD", LOD);
-				m_BloomPipeline->BindWriteOnlyImage(0, m_BloomTextures[2], mip);
-				m_BloomTextures[0]->Bind(1);
-				m_BloomTextures[2]->Bind(2);
-				m_BloomPipeline->Execute(workGroupsX, workGroupsY, 1, false);
-			}
-		}
+			dispatch(mipCount + i, upsampleTexture, mipCount - 2 - i);
 
-		// Debug
-		m_BloomDebugMaterial->SetFloat("u_Settings.Layer", (float)m_Options.BloomDebugMip);
-		m_BloomDebugMaterial->SetTexture("u_Texture", 0, m_BloomTextures[m_Options.BloomDebugTex]->GetRendererID());
-		Renderer::RenderFullscreenQuad(m_BloomDebugPipeline, m_BloomDebugMaterial);
+			if (i == 0)
+				upsampleTexture->Bind(2);
+		}
 	}
 
-	void SceneRenderer::CompositePass()
+	void SceneRenderer::PostProcessPass()
 	{
-		uint32_t texture;
-		if (GetOptions().FXAA)
-			texture = m_FXAAPipeline->GetFramebuffer()->GetColorAttachmentRendererID();
-		else
-			texture = m_GeometryPipeline->GetFramebuffer()->GetColorAttachmentRendererID();
+		static constexpr uint32_t tileSize = 16; // PostProcess.glsl TILE_SIZE
 
 		Ref<Texture2D> bloomDirtMask = Renderer::GetDefaultTexture();
 		bool isDirtMaskValid = AssetManager::IsAssetHandleValid(GetOptions().BloomDirtMask);
@@ -765,28 +696,72 @@ namespace Venus {
 			bloomDirtMask = isDirtMaskValid ? AssetManager::GetAsset<Texture2D>(m_RuntimeCamera->BloomDirtMask) : bloomDirtMask;
 		}
 
-		m_CompositeMaterial->SetTexture("u_Texture", 0, texture);
-
-		m_CompositeMaterial->SetFloat("u_Settings.Exposure", exposure);
-		m_CompositeMaterial->SetInt("u_Settings.Grayscale", grayscale);
-		m_CompositeMaterial->SetInt("u_Settings.ACESTone", useACESTone);
-		m_CompositeMaterial->SetInt("u_Settings.GammaCorrection", gamaCorrection);
-
-		m_CompositeMaterial->SetInt("u_Settings.Bloom", bloom);
-		m_CompositeMaterial->SetTexture("u_BloomTexture", 1, m_BloomTextures[2]->GetRendererID());
-		m_CompositeMaterial->SetTexture("u_BloomDirtMaskTexture", 2, bloomDirtMask->GetRendererID());
-		m_CompositeMaterial->SetFloat("u_Settings.BloomIntensity", bloomIntensity);
-		m_CompositeMaterial->SetFloat("u_Settings.BloomDirkMaskIntensity", bloomDirtMaskIntensity);
-
-		Renderer::RenderFullscreenQuad(m_CompositePipeline, m_CompositeMaterial);
+		// Toggles are baked into the variant so disabled features cost nothing, ids match the constant_ids
+		std::vector<ShaderSpecializationConstant> constants = {
+			{ 0, bloom && m_BloomTextures[1] }, { 1, useACESTone }, { 2, gamaCorrection }, { 3, grayscale }, { 4, GetOptions().FXAA }
+		};
+
+		uint32_t variant = 0;
+		for (const auto& constant : constants)
+			variant |= constant.Value << constant.ID;
+
+		Ref<ComputePipeline>& pipeline = m_PostProcessPipelines[variant];
+		if (!pipeline)
+			pipeline = ComputePipeline::Create(Shader::Create("Resources/Shaders/PostProcess.glsl", constants));
+
+		m_PostProcessMaterial->SetFloat("u_Settings.Exposure", exposure);
+		m_PostProcessMaterial->SetFloat("u_Settings.BloomIntensity", bloomIntensity);
+		m_PostProcessMaterial->SetFloat("u_Settings.BloomDirtMaskIntensity", bloomDirtMaskIntensity);
+		m_PostProcessMaterial->SetFloat("u_Settings.FXAAThresholdMin", GetOptions().FXAAThresholdMin);
+		m_PostProcessMaterial->SetFloat("u_Settings.FXAAThresholdMax", GetOptions().FXAAThresholdMax);
+		m_PostProcessMaterial->SetInt("u_Settings.FXAAIterations", GetOptions().FXAAIterations);
+		m_PostProcessMaterial->SetFloat("u_Settings.FXAASubpixelQuality", GetOptions().FXAASubPixelQuality);
+
+		Ref<Texture2D> bloomTexture = m_BloomTextures[1] ? m_BloomTextures[1] : Renderer::GetDefaultTexture();
+		m_PostProcessMaterial->SetTexture("u_Texture", 1, m_GeometryFramebuffer->GetColorAttachmentRendererID());
+		m_PostProcessMaterial->SetTexture("u_BloomTexture", 2, bloomTexture->GetRendererID());
+		m_PostProcessMaterial->SetTexture("u_BloomDirtMaskTexture", 3, bloomDirtMask->GetRendererID());
+		m_PostProcessMaterial->Bind();
+
+		pipeline->Begin();
+		pipeline->BindWriteOnlyImage(0, m_FinalFramebuffer);
+		pipeline->Execute((m_ViewportWidth + tileSize - 1) / tileSize, (m_ViewportHeight + tileSize - 1) / tileSize, 1, false);
 	}
 
 	void SceneRenderer::Render2DPass()
 	{
+		// Wraps the final color and the geometry depth, rebuilt when the graph hands out other targets
+		if (m_2DColorSource != m_FinalFramebuffer || m_2DDepthSource != m_GeometryFramebuffer)
+		{
+			m_2DColorSource = m_FinalFramebuffer;
+			m_2DDepthSource = m_GeometryFramebuffer;
+
+			FramebufferSpecification fbSpec;
+			fbSpec.SwapChainTarget = false;
+			fbSpec.Attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::DEPTH24STENCIL8 };
+			fbSpec.Width = m_ViewportWidth;
+			fbSpec.Height = m_ViewportHeight;
+			fbSpec.ExistingColorTextures.push_back(m_FinalFramebuffer->GetColorAttachmentRendererID());
+			fbSpec.ExistingDepthTexture = m_GeometryFramebuffer->GetDepthAttachmentRendererID();
+
+			if (m_2DFramebuffer)
+			{
+				m_2DFramebuffer->GetSpecification().ExistingColorTextures = fbSpec.ExistingColorTextures;
+				m_2DFramebuffer->GetSpecification().ExistingDepthTexture = fbSpec.ExistingDepthTexture;
+				m_2DFramebuffer->Resize(fbSpec.Width, fbSpec.Height);
+			}
+			else
+			{
+				m_2DFramebuffer = Framebuffer::Create(fbSpec);
+			}
+
+			Renderer2D::SetRenderTarget(m_2DFramebuffer);
+		}
+
 		for (auto& cmd : m_QuadDrawList)
 		{
 			if (cmd.Texture)
-				Renderer2D::DrawQuad(cmd.Transform, cmd.Texture, cmd.TilingFactor, cmd.TintColor, cmd.ID);
+				Renderer2D::DrawQuad(cmd.Transform, cmd.Texture, cmd.Sampler, cmd.FlipVertically, cmd.TilingFactor, cmd.TintColor, cmd.ID);
 			else
 				Renderer2D::DrawQuad(cmd.Transform, cmd.TintColor, cmd.ID);
 		}
@@ -807,8 +782,155 @@ namespace Venus {
 		}
 	}
 
+	void SceneRenderer::ShadowMapDebugPass()
+	{
+		if (!m_Scene->m_LightEnvironment.HasDirLight || !m_Scene->m_LightEnvironment.CastsShadows)
+			return;
+
+		uint32_t depthTextureID = m_ShadowPipeline->GetFramebuffer()->GetDepthAttachmentRendererID();
+		uint32_t layer = GetOptions().ShadowMapDebugCascade;
+		m_TempMaterial->SetTextureArray("u_Texture", 0, depthTextureID);
+		m_TempMaterial->SetInt("u_Settings.Layer", layer);
+		Renderer::RenderFullscreenQuad(m_TempPipeline, m_TempMaterial);
+	}
+
+	void SceneRenderer::BloomDebugPass()
+	{
+		m_BloomDebugMaterial->SetFloat("u_Settings.Layer", (float)m_Options.BloomDebugMip);
+		m_BloomDebugMaterial->SetTexture("u_Texture", 0, m_BloomTextures[std::clamp(m_Options.BloomDebugTex, 0, 1)]->GetRendererID());
+		Renderer::RenderFullscreenQuad(m_BloomDebugPipeline, m_BloomDebugMaterial);
+	}
+
+	void SceneRenderer::BuildMeshBatches(const std::vector<DrawCmd>& drawList, std::vector<MeshBatch>& batches, bool useMaterials)
+	{
+		struct BatchKey
+		{
+			Model* Model;
+			uint32_t MeshIndex;
+			MeshMaterial* Material;
+
+			bool operator==(const BatchKey& other) const
+			{
+				return Model == other.Model && MeshIndex == other.MeshIndex && Material == other.Material;
+			}
+		};
+
+		struct BatchKeyHash
+		{
+			size_t operator()(const BatchKey& key) const
+			{
+				size_t hash = std::hash<void*>()(key.Model);
+				hash ^= std::hash<uint32_t>()(key.MeshIndex) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+				hash ^= std::hash<void*>()(key.Material) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+				return hash;
+			}
+		};
+
+		std::unordered_map<BatchKey, uint32_t, BatchKeyHash> batchLookup;
+		m_BatchIndices.clear();
+
+		// Assign every mesh of every command to a batch, counting instances
+		for (auto& cmd : drawList)
+		{
+			const auto& meshes = cmd.Model->GetMeshs();
+			for (uint32_t i = 0; i < meshes.size(); i++)
+			{
+				Ref<MeshMaterial> material = nullptr;
+				if (useMaterials)
+				{
+					uint32_t materialIndex = meshes[i].GetMaterialIndex();
+					if (cmd.MaterialTable->HasMaterial(materialIndex))
+						material = cmd.MaterialTable->GetMaterial(materialIndex);
+					else
+						material = cmd.Model->GetMaterialTable()->GetMaterial(materialIndex);
+				}
+
+				BatchKey key = { cmd.Model.get(), i, material.get() };
+				auto [it, inserted] = batchLookup.try_emplace(key, (uint32_t)batches.size());
+				if (inserted)
+				{
+					MeshBatch& batch = batches.emplace_back();
+					batch.Model = cmd.Model;
+					batch.MeshIndex = i;
+					batch.Material = material;
+				}
+
+				batches[it->second].InstanceCount++;
+				m_BatchIndices.push_back(it->second);
+			}
+		}
+
+		// Reserve a contiguous range of instances for each batch
+		uint32_t instanceOffset = (uint32_t)m_InstanceData.size();
+		for (auto& batch : batches)
+		{
+			batch.InstanceOffset = instanceOffset;
+			instanceOffset += batch.InstanceCount;
+			batch.InstanceCount = 0;
+		}
+		m_InstanceData.resize(instanceOffset);
+
+		// Scatter transforms into their batch range
+		uint32_t index = 0;
+		for (auto& cmd : drawList)
+		{
+			uint32_t meshCount = (uint32_t)cmd.Model->GetMeshs().size();
+			for (uint32_t i = 0; i < meshCount; i++)
+			{
+				MeshBatch& batch = batches[m_BatchIndices[index++]];
+				Renderer::InstanceData& instance = m_InstanceData[batch.InstanceOffset + batch.InstanceCount++];
+				instance.Transform = cmd.Transform;
+				instance.EntityID = cmd.ID;
+				instance.CascadeMask = cmd.CascadeMask;
+			}
+		}
+	}
+
+	void SceneRenderer::BuildRenderQueue()
+	{
+		for (auto& batch : m_ShadowMeshBatches)
+		{
+			RenderQueueCommand cmd;
+			cmd.Pipeline = m_ShadowPipeline;
+			cmd.Model = batch.Model;
+			cmd.MeshIndex = batch.MeshIndex;
+			cmd.InstanceOffset = batch.InstanceOffset;
+			cmd.InstanceCount = batch.InstanceCount;
+
+			m_RenderQueue.Submit(RenderQueuePass::Shadow, cmd);
+		}
+
+		const glm::vec3& cameraPosition = m_SceneBuffer.u_CameraPosition;
+		for (auto& batch : m_MeshBatches)
+		{
+			RenderQueueCommand cmd;
+			cmd.Pipeline = m_GeometryPipeline;
+			cmd.Model = batch.Model;
+			cmd.MeshIndex = batch.MeshIndex;
+			cmd.Material = batch.Material;
+			cmd.InstanceOffset = batch.InstanceOffset;
+			cmd.InstanceCount = batch.InstanceCount;
+
+			// Nearest instance decides where the batch lands inside its state group
+			float depth = std::numeric_limits<float>::max();
+			for (uint32_t i = 0; i < batch.InstanceCount; i++)
+			{
+				const glm::mat4& transform = m_InstanceData[batch.InstanceOffset + i].Transform;
+				depth = glm::min(depth, glm::distance(cameraPosition, glm::vec3(transform[3])));
+			}
+
+			m_RenderQueue.Submit(RenderQueuePass::Geometry, cmd, depth);
+		}
+
+		m_RenderQueue.Sort();
+	}
+
 	void SceneRenderer::OnImGuiRender(bool& show)
 	{
+		// Requested again every frame the views are visible
+		m_ShadowMapDebugView = false;
+		m_BloomDebugView = false;
+
 		if (!show)
 			return;
 
@@ -828,6 +950,15 @@ namespace Venus {
 
 			UI::Checkbox("Show Grid", &options.ShowGrid, true);
 			UI::ColorEdit4("Editor Background Color", m_EditorBackgroundColor);
+
+			const char* colorFormats[] = { "RGBA16F", "R11G11B10F", "RGBA32F (Debug)" };
+			int currentColorFormat = (int)options.ColorFormat;
+			if (UI::DropDown("HDR Color Format", colorFormats, 3, &currentColorFormat, true))
+				options.ColorFormat = (ColorBufferFormat)currentColorFormat;
+
+			const RenderGraph::Statistics& graphStats = m_RenderGraph.GetStats();
+			ImGui::Text("Render Passes: %d (%d culled)", graphStats.PassCount, graphStats.CulledPassCount);
+			ImGui::Text("Render Targets: %d pooled, %d textures, %.1f MB", graphStats.PooledTargetCount, graphStats.PooledTextureCount, graphStats.PooledMemory / (1024.0f * 1024.0f));
 		}
 
 		if (ImGui::CollapsingHeader("Color and Lightning"))
@@ -838,6 +969,13 @@ namespace Venus {
 			UI::Checkbox("Gamma Correction", &options.GammaCorrection);
 		}
 
+		if (ImGui::CollapsingHeader("Lights"))
+		{
+			UI::Checkbox("Show Light Complexity", &m_RendererBuffer.ShowLightComplexity, true);
+			ImGui::Text("Point Lights: %d", m_PointLightBuffer.Count);
+			ImGui::Text("Clusters: %dx%dx%d", ClusterCountX, ClusterCountY, ClusterCountZ);
+		}
+
 		if (ImGui::CollapsingHeader("Shadows"))
 		{
 			UI::Checkbox("Soft Shadows", &m_RendererBuffer.SoftShadows, true);
@@ -852,6 +990,14 @@ namespace Venus {
 			UI::DragFloat("Dir. Light Size", &m_RendererBuffer.LightSize, 0.1f, 0.0f, 1000000.0f, true);
 
 			UI::Checkbox("Show Cascade in Viewport", &m_RendererBuffer.ShowCascades, true);
+			UI::Checkbox("Cache Static Cascades", &options.CacheShadowCascades, true);
+			UI::SliderInt("Cached Cascade Start", &options.CachedCascadeStart, 0, 3, true);
+
+			uint32_t renderedCascades = 0;
+			for (uint32_t i = 0; i < 4; i++)
+				renderedCascades += (m_CascadeUpdateMask >> i) & 1;
+			ImGui::Text("Cascades Rendered: %d/4", renderedCascades);
+			ImGui::Text("Shadow Casters: %d", m_ShadowCasterCount);
 
 			UI::SetPosX(ImGui::GetContentRegionMax().x - 70);
 			if (ImGui::Button("Reset", ImVec2{ 70, 30 }))
@@ -860,16 +1006,23 @@ namespace Venus {
 				options.CascadeNearPlaneOffset = -50.0f;
 				options.CascadeFarPlaneOffset = 50.0f;
 				options.CascadeSplitLambda = 0.92f;
+				options.CacheShadowCascades = true;
+				options.CachedCascadeStart = 2;
 			}
 
 			UI::ShiftPos(20.0f, 10.0f);
 			ImGuiTreeNodeFlags treeNodeFlags = ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_FramePadding;
 			if(ImGui::TreeNodeEx("Shadow Map", treeNodeFlags))
 			{
-				uint32_t shadowMapRendererID = m_TempPipeline->GetFramebuffer()->GetColorAttachmentRendererID();
+				m_ShadowMapDebugView = true;
+
 				UI::SliderInt("Cascade", &options.ShadowMapDebugCascade, 0, 3);
 				UI::ShiftPosY(5.0f);
-				ImGui::Image(reinterpret_cast<void*>(shadowMapRendererID), ImVec2{ 256, 256 }, ImVec2{ 0, 1 }, ImVec2{ 1, 0 });
+				if (m_ShadowMapDebugFramebuffer)
+				{
+					uint32_t shadowMapRendererID = m_ShadowMapDebugFramebuffer->GetColorAttachmentRendererID();
+					ImGui::Image(reinterpret_cast<void*>(shadowMapRendererID), ImVec2{ 256, 256 }, ImVec2{ 0, 1 }, ImVec2{ 1, 0 });
+				}
 
 				ImGui::TreePop();
 			}
@@ -915,6 +1068,7 @@ namespace Venus {
 			ImGui::Separator();
 
 			UI::DragFloat("Dirt Mask Intensity", &options.BloomDirtMaskIntensity, 0.1f, 0.0f, 1000.0f, true);
+			UI::SliderInt("Min Mip Size", &options.BloomMinMipSize, 1, 64);
 
 			UI::SetPosX(ImGui::GetContentRegionMax().x - 70);
 			if (ImGui::Button("Reset", ImVec2{ 70, 30 }))
@@ -924,19 +1078,24 @@ namespace Venus {
 				options.BloomKnee = 0.1f;
 				options.BloomDirtMask = 0;
 				options.BloomDirtMaskIntensity = 1.0f;
+				options.BloomMinMipSize = 8;
 			}
 
 			UI::ShiftPos(20.0f, 10.0f);
 			ImGuiTreeNodeFlags treeNodeFlags = ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_FramePadding;
 			if (ImGui::TreeNodeEx("Bloom Textures", treeNodeFlags))
 			{
-				UI::SliderInt("Bloom Texture", &options.BloomDebugTex, 0, 2);
-				uint32_t bloomDebugTex = m_BloomDebugPipeline->GetFramebuffer()->GetColorAttachmentRendererID();
-				uint32_t maxMipLevel = m_BloomTextures[options.BloomDebugTex]->GetMipLevelCount();
-				UI::SliderInt("Bloom Mipmap Level", &options.BloomDebugMip, 0, maxMipLevel - 1);
+				m_BloomDebugView = true;
+
+				UI::SliderInt("Bloom Texture", &options.BloomDebugTex, 0, 1);
+				UI::SliderInt("Bloom Mipmap Level", &options.BloomDebugMip, 0, m_BloomMipCount - 1);
 				UI::ShiftPosY(5.0f);
-				ImGui::Image(reinterpret_cast<void*>(bloomDebugTex), ImVec2{ 256, 256 }, ImVec2{ 0, 1 }, ImVec2{ 1, 0 });
-				Renderer::SetDebugTexture(bloomDebugTex);
+				if (m_BloomDebugFramebuffer)
+				{
+					uint32_t bloomDebugTex = m_BloomDebugFramebuffer->GetColorAttachmentRendererID();
+					ImGui::Image(reinterpret_cast<void*>(bloomDebugTex), ImVec2{ 256, 256 }, ImVec2{ 0, 1 }, ImVec2{ 1, 0 });
+					Renderer::SetDebugTexture(bloomDebugTex);
+				}
 				ImGui::TreePop();
 			}
 		}
@@ -1049,24 +1208,23 @@ namespace Venus {
 			}
 			radius = std::ceil(radius * 16.0f) / 16.0f;
 
-			glm::vec3 maxExtents = glm::vec3(radius);
-			glm::vec3 minExtents = -maxExtents;
+			// Snap the center in light space to whole texels (or a coarser grid for cached cascades), the matrix then
+			// only changes when the camera crosses a grid cell. The radius grows so the sphere stays covered after snapping
+			float ShadowMapResolution = (float)m_ShadowPipeline->GetFramebuffer()->GetSpecification().Width;
+			float snapTexels = options.CacheShadowCascades && (int)i >= options.CachedCascadeStart ? CachedCascadeSnapTexels : 1.0f;
+			radius /= 1.0f - 2.0f * snapTexels / ShadowMapResolution;
 
-			glm::vec3 lightDir = -lightDirection;
-			glm::mat4 lightViewMatrix = glm::lookAt(frustumCenter - lightDir * -minExtents.z, frustumCenter, glm::vec3(0.0f, 0.0f, 1.0f));
-			glm::mat4 lightOrthoMatrix = glm::ortho(minExtents.x, maxExtents.x, minExtents.y, maxExtents.y, 0.0f + options.CascadeNearPlaneOffset, maxExtents.z - minExtents.z + options.CascadeFarPlaneOffset);
+			float texelSize = 2.0f * radius / ShadowMapResolution;
+			float snapSize = texelSize * snapTexels;
 
-			// Offset to texel space to avoid shimmering (from https://stackoverflow.com/questions/33499053/cascaded-shadow-map-shimmering)
-			glm::mat4 shadowMatrix = lightOrthoMatrix * lightViewMatrix;
-			float ShadowMapResolution = m_ShadowPipeline->GetFramebuffer()->GetSpecification().Width;
-			glm::vec4 shadowOrigin = (shadowMatrix * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)) * ShadowMapResolution / 2.0f;
-			glm::vec4 roundedOrigin = glm::round(shadowOrigin);
-			glm::vec4 roundOffset = roundedOrigin - shadowOrigin;
-			roundOffset = roundOffset * 2.0f / ShadowMapResolution;
-			roundOffset.z = 0.0f;
-			roundOffset.w = 0.0f;
+			glm::mat4 lightViewMatrix = glm::lookAt(glm::vec3(0.0f), -lightDirection, glm::vec3(0.0f, 0.0f, 1.0f));
+			glm::vec3 lightSpaceCenter = glm::vec3(lightViewMatrix * glm::vec4(frustumCenter, 1.0f));
+			lightSpaceCenter = glm::round(lightSpaceCenter / snapSize) * snapSize;
 
-			lightOrthoMatrix[3] += roundOffset;
+			glm::mat4 lightOrthoMatrix = glm::ortho(
+				lightSpaceCenter.x - radius, lightSpaceCenter.x + radius,
+				lightSpaceCenter.y - radius, lightSpaceCenter.y + radius,
+				-lightSpaceCenter.z - radius + options.CascadeNearPlaneOffset, -lightSpaceCenter.z + radius + options.CascadeFarPlaneOffset);
 
 			// Store split distance and matrix in cascade
 			cascades[i].SplitDepth = (nearClip + splitDist * clipRange) * -1.0f;
@@ -1077,18 +1235,141 @@ namespace Venus {
 		}
 	}
 
+	static uint64_t HashShadowCaster(uint64_t hash, const DrawCmd& cmd)
+	{
+		// FNV-1a over what affects the depth written by a caster
+		auto hashBytes = [&hash](const void* data, size_t size)
+		{
+			const uint8_t* bytes = (const uint8_t*)data;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+		};
+
+		const Model* model = cmd.Model.get();
+		hashBytes(&model, sizeof(model));
+		hashBytes(&cmd.Transform, sizeof(cmd.Transform));
+		return hash;
+	}
+
+	void SceneRenderer::CullShadowCasters()
+	{
+		VS_PROFILE_FUNCTION();
+
+		const SceneRendererOptions& options = GetOptions();
+
+		Frustum cascadeFrustums[4];
+		uint64_t casterHashes[4];
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			cascadeFrustums[i] = Frustum(m_ShadowBuffer.ViewProjection[i]);
+			casterHashes[i] = 14695981039346656037ull;
+		}
+
+		// Casters are independent, masks are built in parallel
+		JobSystem::ParallelFor((uint32_t)m_ShadowDrawList.size(), 256, [&](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t index = begin; index < end; index++)
+			{
+				DrawCmd& cmd = m_ShadowDrawList[index];
+				cmd.CascadeMask = 0;
+
+				const AABB& bounds = cmd.Model->GetBoundingBox();
+				if (!bounds.IsValid())
+					continue;
+
+				AABB worldBounds = bounds.Transform(cmd.Transform);
+				for (uint32_t i = 0; i < 4; i++)
+				{
+					if (cascadeFrustums[i].Intersects(worldBounds))
+						cmd.CascadeMask |= 1 << i;
+				}
+			}
+		});
+
+		// Hashes depend on submission order, so they stay serial
+		for (const auto& cmd : m_ShadowDrawList)
+		{
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				if (cmd.CascadeMask & (1 << i))
+					casterHashes[i] = HashShadowCaster(casterHashes[i], cmd);
+			}
+		}
+
+		m_CascadeUpdateMask = 0;
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			CascadeCache& cache = m_CascadeCache[i];
+			bool cached = options.CacheShadowCascades && cache.Valid &&
+				cache.ViewProjection == m_ShadowBuffer.ViewProjection[i] && cache.CasterHash == casterHashes[i];
+
+			if (!cached)
+			{
+				m_CascadeUpdateMask |= 1 << i;
+				cache.ViewProjection = m_ShadowBuffer.ViewProjection[i];
+				cache.CasterHash = casterHashes[i];
+				cache.Valid = true;
+			}
+		}
+
+		// Only casters touching a cascade that is being rendered are kept
+		m_ShadowDrawList.erase(std::remove_if(m_ShadowDrawList.begin(), m_ShadowDrawList.end(), [this](DrawCmd& cmd)
+		{
+			cmd.CascadeMask &= m_CascadeUpdateMask;
+			return cmd.CascadeMask == 0;
+		}), m_ShadowDrawList.end());
+
+		m_ShadowCasterCount = (uint32_t)m_ShadowDrawList.size();
+	}
+
+	void SceneRenderer::UploadPointLights()
+	{
+		const std::vector<PointLight>& pointLightsVec = m_Scene->m_LightEnvironment.PointLights;
+		m_PointLightBuffer.Count = uint32_t(pointLightsVec.size());
+
+		uint32_t lightsSize = sizeof(PointLight) * m_PointLightBuffer.Count;
+		uint32_t requiredSize = sizeof(PointLightData) + lightsSize;
+		if (requiredSize > m_PointLightDataBuffer->GetSize())
+			m_PointLightDataBuffer->Resize(glm::max(requiredSize, m_PointLightDataBuffer->GetSize() * 2));
+
+		m_PointLightDataBuffer->SetData(&m_PointLightBuffer, sizeof(PointLightData));
+		if (lightsSize)
+			m_PointLightDataBuffer->SetData(pointLightsVec.data(), lightsSize, sizeof(PointLightData));
+	}
+
+	void SceneRenderer::UpdateClusterData(float nearClip, float farClip)
+	{
+		// Orthographic near planes can sit at or behind the camera, the log split needs a positive range.
+		// Anything in front of the clamped near falls into the first slice
+		m_ClusterNear = glm::max(nearClip, ClusterMinNear);
+		m_ClusterFar = glm::max(farClip, m_ClusterNear * 2.0f);
+
+		// Slice = log(z) * scale + bias, the inverse of the exponential split used by the culling shader
+		float logDepthRatio = glm::log(m_ClusterFar / m_ClusterNear);
+		m_RendererBuffer.ClusterDepthScale = ClusterCountZ / logDepthRatio;
+		m_RendererBuffer.ClusterDepthBias = -(ClusterCountZ * glm::log(m_ClusterNear)) / logDepthRatio;
+
+		m_RendererBuffer.TilesCountX = ClusterCountX;
+		m_RendererBuffer.TilesCountY = ClusterCountY;
+		m_RendererBuffer.TilesCountZ = ClusterCountZ;
+		m_RendererBuffer.ClusterTileSize = { (float)m_ViewportWidth / ClusterCountX, (float)m_ViewportHeight / ClusterCountY };
+	}
+
 	Ref<Framebuffer> SceneRenderer::GetGeometryBuffer()
 	{
-		return m_GeometryPipeline->GetFramebuffer();
+		return m_GeometryFramebuffer;
 	}
 
 	Ref<Framebuffer> SceneRenderer::GetFinalBuffer()
 	{
-		return m_CompositePipeline->GetFramebuffer();
+		return m_FinalFramebuffer;
 	}
 
 	uint32_t SceneRenderer::GetFinalImage()
 	{
-		return m_CompositePipeline->GetFramebuffer()->GetColorAttachmentRendererID();
+		return m_FinalFramebuffer ? m_FinalFramebuffer->GetColorAttachmentRendererID() : 0;
 	}
 }
\ No newline at end of file
@@ -1,12 +1,16 @@
 #pragma once
 
+#include "Renderer/Renderer.h"
 #include "Renderer/Framebuffer.h"
 #include "Renderer/Pipeline.h"
 #include "Renderer/Mesh.h"
 #include "Renderer/MeshMaterial.h"
 #include "Renderer/UniformBuffer.h"
+#include "Renderer/StorageBuffer.h"
 #include "Renderer/ComputePipeline.h"
+#include "Renderer/RenderGraph.h"
 #include "Scene/Scene.h"
+#include "Math/Frustum.h"
 
 namespace Venus {
 
@@ -16,12 +20,25 @@ namespace Venus {
 		Ref<Model> Model;
 		Ref<MaterialTable> MaterialTable;
 		int ID;
+		uint32_t CascadeMask = 0;
+	};
+
+	// Meshes sharing model, mesh and material, drawn with a single instanced call
+	struct MeshBatch
+	{
+		Ref<Model> Model;
+		uint32_t MeshIndex = 0;
+		Ref<MeshMaterial> Material;
+		uint32_t InstanceOffset = 0;
+		uint32_t InstanceCount = 0;
 	};
 
 	struct QuadDrawCmd
 	{
 		glm::mat4 Transform;
 		Ref<Texture2D> Texture;
+		Ref<Sampler> Sampler;
+		bool FlipVertically;
 		float TilingFactor;
 		glm::vec4 TintColor;
 		int ID;
@@ -61,16 +78,27 @@ namespace Venus {
 		float FOV;
 	};
 
+	// HDR color targets, the geometry buffer, FXAA and bloom
+	enum class ColorBufferFormat
+	{
+		RGBA16F = 0,
+		R11G11B10F = 1,	// Half the size again, no alpha and no negative values
+		RGBA32F = 2		// Full precision, for debugging
+	};
+
 	struct SceneRendererOptions
 	{
 		// Geral
 		bool ShowGrid = true;
+		ColorBufferFormat ColorFormat = ColorBufferFormat::RGBA16F;
 
 		// Shadows
 		int ShadowMapDebugCascade = 0;
 		float CascadeSplitLambda = 0.92f;
 		float CascadeNearPlaneOffset = -50.0f;
 		float CascadeFarPlaneOffset = 50.0f;
+		bool CacheShadowCascades = true;
+		int CachedCascadeStart = 2;
 
 		// Bloom
 		bool Bloom = true;
@@ -79,6 +107,7 @@ namespace Venus {
 		float BloomKnee = 0.1f;
 		AssetHandle BloomDirtMask = 0;
 		float BloomDirtMaskIntensity = 1.0f;
+		int BloomMinMipSize = 8; // Smallest side of the last level, lower spreads wider but costs more dispatches
 		int BloomDebugTex = 0;
 		int BloomDebugMip = 0;
 
@@ -111,7 +140,9 @@ namespace Venus {
 
 			void SubmitModel(const Ref<Model>& model, const Ref<MaterialTable>& materialTable, const glm::mat4& transform = glm::mat4(1.0f), int entityID = -1);
 			void SubmitSelectedModel(const Ref<Model>& model, const Ref<MaterialTable>& materialTable, const glm::mat4& transform = glm::mat4(1.0f), int entityID = -1);
-			void SubmitQuad(const glm::mat4& transform, const Ref<Texture2D>& texture = nullptr, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f), int entityID = -1);
+			// Outside the camera frustum but may still cast shadows into it
+			void SubmitShadowCaster(const Ref<Model>& model, const Ref<MaterialTable>& materialTable, const glm::mat4& transform = glm::mat4(1.0f), int entityID = -1);
+			void SubmitQuad(const glm::mat4& transform, const Ref<Texture2D>& texture = nullptr, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f), int entityID = -1, const Ref<Sampler>& sampler = nullptr, bool flipVertically = false);
 			void SubmitCircle(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f, float fade = 0.005f, int entityID = -1);
 			void SubmitRect(const glm::mat4& transform, const glm::vec4 color, int entityID = -1);
 			void SubmitBillboard(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
@@ -125,14 +156,21 @@ namespace Venus {
 
 		private:
 			void Flush();
+			void BuildRenderGraph();
+			bool IsBloomEnabled() const;
 
+			void LightCullingPass();
 			void ShadowMapPass();
 			void GeometryPass();
-			void FXAAPass();
 			void BloomPass();
-			void CompositePass();
+			void PostProcessPass();
 			void Render2DPass();
 
+			void ShadowMapDebugPass();
+			void BloomDebugPass();
+
+			void BuildMeshBatches(const std::vector<DrawCmd>& drawList, std::vector<MeshBatch>& batches, bool useMaterials);
+			void BuildRenderQueue();
 
 			//-- Shadows Cascade
 			struct CascadeData
@@ -142,6 +180,10 @@ namespace Venus {
 				float SplitDepth;
 			};
 			void CalculateCascades(CascadeData* cascades, const CameraInfo& camera, const glm::vec3& lightDirection);
+			void CullShadowCasters();
+
+			void UploadPointLights();
+			void UpdateClusterData(float nearClip, float farClip);
 
 		private:
 			Ref<Scene> m_Scene;
@@ -154,16 +196,26 @@ namespace Venus {
 			std::vector<DrawCmd> m_SelectedDrawList;
 			std::vector<DrawCmd> m_ShadowDrawList;
 
+			std::vector<MeshBatch> m_MeshBatches;
+			std::vector<MeshBatch> m_ShadowMeshBatches;
+			std::vector<uint32_t> m_BatchIndices;
+			std::vector<Renderer::InstanceData> m_InstanceData;
+			RenderQueue m_RenderQueue;
+
 			std::vector<QuadDrawCmd> m_QuadDrawList;
 			std::vector<CircleDrawCmd> m_CircleDrawList;
 			std::vector<RectDrawCmd> m_RectDrawList;
 			std::vector<BillboardDrawCmd> m_BillboardDrawList;
 
-			uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
+			uint32_t m_ViewportWidth = 1920, m_ViewportHeight = 1080;
 			glm::vec4 m_EditorBackgroundColor = { 0.1f, 0.1f, 0.1f, 1.0f };
+			glm::vec4 m_ClearColor = { 0.1f, 0.1f, 0.1f, 1.0f };
 			bool m_Rendering = false;
 			bool m_IsRuntime = false;
-			bool m_NeedsResize = false;
+
+			// Requested by the settings panel, only rendered while it shows them
+			bool m_ShadowMapDebugView = false;
+			bool m_BloomDebugView = false;
 
 
 			//-- Shadow Data----------------------------------------------
@@ -173,19 +225,50 @@ namespace Venus {
 			};
 			ShadowData m_ShadowBuffer;
 			Ref<UniformBuffer> m_ShadowDataBuffer;
+
+			// A cascade is only rendered again when its matrix or casters change,
+			// cached cascades snap to a coarser grid so small camera moves keep them valid
+			static constexpr float CachedCascadeSnapTexels = 32.0f;
+			struct CascadeCache
+			{
+				glm::mat4 ViewProjection = glm::mat4(0.0f);
+				uint64_t CasterHash = 0;
+				bool Valid = false;
+			};
+			CascadeCache m_CascadeCache[4];
+			uint32_t m_CascadeUpdateMask = 0;
+			uint32_t m_ShadowCasterCount = 0;
 			//------------------------------------------------------------
 
 
 
 			//-- Point Light Data-----------------------------------------
+			// Storage buffer header, the light array follows it
 			struct PointLightData
 			{
 				uint32_t Count{ 0 };
 				glm::vec3 Padding{};
-				PointLight PointLights[1024]{};
 			};
 			PointLightData m_PointLightBuffer;
-			Ref<UniformBuffer> m_PointLightDataBuffer;
+			Ref<StorageBuffer> m_PointLightDataBuffer;
+			//------------------------------------------------------------
+
+
+
+			//-- Light Culling--------------------------------------------
+			// Must match LightCulling.glsl and PBR.glsl
+			static constexpr uint32_t ClusterCountX = 16;
+			static constexpr uint32_t ClusterCountY = 9;
+			static constexpr uint32_t ClusterCountZ = 24;
+			static constexpr uint32_t ClusterSlicesPerGroup = 4;
+			static constexpr uint32_t ClusterCount = ClusterCountX * ClusterCountY * ClusterCountZ;
+			static constexpr uint32_t MaxLightsPerCluster = 256;
+			static constexpr float ClusterMinNear = 0.01f;
+
+			float m_ClusterNear = 0.1f;
+			float m_ClusterFar = 1000.0f;
+			Ref<StorageBuffer> m_ClusterLightCountBuffer;
+			Ref<StorageBuffer> m_ClusterLightIndexBuffer;
 			//------------------------------------------------------------
 
 
@@ -227,6 +310,12 @@ namespace Venus {
 				float CascadeTransitionFade = 1.0f;
 				bool ShowLightComplexity = false;
 				char Padding3[3] = { 0,0,0 };
+				uint32_t TilesCountY{ 0 };
+				float ClusterDepthScale = 0.0f;
+				float ClusterDepthBias = 0.0f;
+				glm::vec2 ClusterTileSize = { 1.0f, 1.0f };
+				uint32_t TilesCountZ{ 0 };
+				char Padding4[4] = { 0,0,0,0 };
 			};
 			RendererData m_RendererBuffer;
 			Ref<UniformBuffer> m_RendererDataBuffer;
@@ -237,26 +326,37 @@ namespace Venus {
 			//-- Pipelines------------------------------------------------
 			Ref<Pipeline> m_ShadowPipeline;
 			Ref<Pipeline> m_GeometryPipeline;
-			Ref<Pipeline> m_SelectedGeometryPipeline;
 			Ref<Pipeline> m_GridPipeline;
 			Ref<Pipeline> m_SkyboxPipeline;
 
-			Ref<Pipeline> m_FXAAPipeline;
 			Ref<ComputePipeline> m_BloomPipeline;
+			Ref<ComputePipeline> m_LightCullingPipeline;
 			Ref<Framebuffer> m_2DFramebuffer;
-			Ref<Pipeline> m_CompositePipeline;
+			// One variant per combination of post process toggles, compiled the first time it's used
+			std::unordered_map<uint32_t, Ref<ComputePipeline>> m_PostProcessPipelines;
 
 			Ref<Pipeline> m_TempPipeline;
 			Ref<Pipeline> m_BloomDebugPipeline;
 			//------------------------------------------------------------
 
 
+			//-- Render Graph---------------------------------------------
+			// Pipelines other than the shadow map get their framebuffer from the graph every frame
+			RenderGraph m_RenderGraph;
+			Ref<Framebuffer> m_GeometryFramebuffer;
+			Ref<Framebuffer> m_FinalFramebuffer;
+			Ref<Framebuffer> m_ShadowMapDebugFramebuffer;
+			Ref<Framebuffer> m_BloomDebugFramebuffer;
+			Ref<Framebuffer> m_2DColorSource;
+			Ref<Framebuffer> m_2DDepthSource;
+			//------------------------------------------------------------
+
+
 			//-- Materials------------------------------------------------
 			Ref<Material> m_GridMaterial;
 			Ref<Material> m_SkyboxMaterial;
-			Ref<Material> m_FXAAMaterial;
 			Ref<Material> m_BloomMaterial;
-			Ref<Material> m_CompositeMaterial;
+			Ref<Material> m_PostProcessMaterial;
 
 			Ref<Material> m_TempMaterial;
 			Ref<Material> m_BloomDebugMaterial;
@@ -264,8 +364,21 @@ namespace Venus {
 
 
 
-			//-- Textures-------------------------------------------------
-			Ref<Texture2D> m_BloomTextures[3];
+			//-- Bloom----------------------------------------------------
+			// Must match Bloom.glsl, one block per dispatch at the largest uniform buffer offset alignment
+			struct alignas(256) BloomParams
+			{
+				glm::vec4 Params;
+				float LOD;
+				int Mode;
+			};
+			static constexpr uint32_t MaxBloomDispatches = 32;
+
+			// Downsample and upsample chains, from the render graph texture pool
+			Ref<Texture2D> m_BloomTextures[2];
+			uint32_t m_BloomMipCount = 2;
+			std::vector<BloomParams> m_BloomParams;
+			Ref<UniformBuffer> m_BloomParamsBuffer;
 			//------------------------------------------------------------
 
 	};
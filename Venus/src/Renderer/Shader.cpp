@@ -3,6 +3,7 @@
 #include "Renderer/Shader.h"
 #include "Renderer/Renderer.h"
 #include "Renderer/OpenGL/OpenGLShader.h"
+#include "Renderer/Null/NullShader.h"
 
 namespace Venus {
 
@@ -10,7 +11,7 @@ namespace Venus {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateRef<NullShader>(filepath);
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(filepath);
 		}
 
@@ -18,11 +19,23 @@ namespace Venus {
 		return nullptr;
 	}
 
+	Ref<Shader> Shader::Create(const std::string& filepath, const std::vector<ShaderSpecializationConstant>& specialization)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    return CreateRef<NullShader>(filepath, specialization);
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(filepath, specialization);
+		}
+
+		VS_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
 	Ref<Shader> Shader::Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateRef<NullShader>(name, vertexSrc, fragmentSrc);
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(name, vertexSrc, fragmentSrc);
 		}
 
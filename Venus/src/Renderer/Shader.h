@@ -2,11 +2,48 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <glm/glm.hpp>
 
+#include "Utils/Hash.h"
+
 namespace Venus {
 
+	// Hashed uniform name, see Shader::GetUniformID
+	using ShaderUniformID = uint32_t;
+
+	// Hashed once where it's declared, the name is kept for uniforms reflection didn't find
+	struct ShaderUniformName
+	{
+		ShaderUniformID ID;
+		std::string_view Name;
+
+		explicit constexpr ShaderUniformName(std::string_view name)
+			: ID(Hash::GenerateFNVHash(name)), Name(name) {}
+	};
+
+	struct ShaderUniform
+	{
+		uint32_t Offset = 0;
+		uint32_t Size = 0;
+	};
+
+	// std140 block backing material parameters, members keyed by "instance.Member"
+	struct ShaderBuffer
+	{
+		std::string Name;
+		uint32_t Size = 0;
+		std::unordered_map<ShaderUniformID, ShaderUniform> Uniforms;
+	};
+
+	// Value of a layout(constant_id = ID) constant, fixed when the program is created
+	struct ShaderSpecializationConstant
+	{
+		uint32_t ID = 0;
+		uint32_t Value = 0;
+	};
+
 	class Shader
 	{
 		public:
@@ -23,15 +60,33 @@ namespace Venus {
 			virtual void SetFloat4(const std::string& name, const glm::vec4& value) = 0;
 			virtual void SetMat4(const std::string& name, const glm::mat4& value) = 0;
 
+			// Hot paths, no string hashing or compares
+			virtual void SetInt(const ShaderUniformName& uniform, int value) = 0;
+			virtual void SetIntArray(const ShaderUniformName& uniform, int* values, uint32_t count) = 0;
+			virtual void SetFloat(const ShaderUniformName& uniform, float value) = 0;
+			virtual void SetFloat2(const ShaderUniformName& uniform, const glm::vec2& value) = 0;
+			virtual void SetFloat3(const ShaderUniformName& uniform, const glm::vec3& value) = 0;
+			virtual void SetFloat4(const ShaderUniformName& uniform, const glm::vec4& value) = 0;
+			virtual void SetMat4(const ShaderUniformName& uniform, const glm::mat4& value) = 0;
+
 			virtual void SetTexture(const std::string& name, int binding, uint32_t texture) = 0;
 			virtual void SetCubeMap(const std::string& name, int binding, uint32_t texture) = 0;
 			virtual void SetTextureArray(const std::string& name, int binding, uint32_t texture) = 0;
 
 			virtual int GetUniformLocation(const std::string& name) = 0;
+			virtual int GetUniformLocation(const ShaderUniformName& uniform) = 0;
+
+			static constexpr ShaderUniformID GetUniformID(std::string_view name) { return Hash::GenerateFNVHash(name); }
 
 			virtual const std::string& GetName() const = 0;
 
+			// Null when the shader has no uniform block at MaterialBufferBinding
+			virtual const ShaderBuffer* GetMaterialBuffer() const = 0;
+			static constexpr uint32_t MaterialBufferBinding = 6;
+
 			static Ref<Shader> Create(const std::string& filepath);
+			// A variant of the file's shader, each set of values is compiled and cached on its own
+			static Ref<Shader> Create(const std::string& filepath, const std::vector<ShaderSpecializationConstant>& specialization);
 			static Ref<Shader> Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
 		};
 
@@ -0,0 +1,241 @@
+#include "pch.h"
+#include "ShaderCompiler.h"
+
+#include <shaderc/shaderc.hpp>
+#include <spirv_cross/spirv_cross.hpp>
+
+namespace Venus {
+
+	namespace Utils {
+
+		static bool ShaderStageFromString(const std::string& type, ShaderStage& stage)
+		{
+			if (type == "vertex")
+				stage = ShaderStage::Vertex;
+			else if (type == "fragment" || type == "pixel")
+				stage = ShaderStage::Fragment;
+			else if (type == "geometry")
+				stage = ShaderStage::Geometry;
+			else if (type == "compute")
+				stage = ShaderStage::Compute;
+			else
+				return false;
+
+			return true;
+		}
+
+		static shaderc_shader_kind ShaderStageToShaderC(ShaderStage stage)
+		{
+			switch (stage)
+			{
+				case ShaderStage::Vertex:	return shaderc_glsl_vertex_shader;
+				case ShaderStage::Fragment:	return shaderc_glsl_fragment_shader;
+				case ShaderStage::Geometry:	return shaderc_glsl_geometry_shader;
+				case ShaderStage::Compute:	return shaderc_glsl_compute_shader;
+			}
+			VS_CORE_ASSERT(false);
+			return (shaderc_shader_kind)0;
+		}
+
+		static const char* ShaderStageToString(ShaderStage stage)
+		{
+			switch (stage)
+			{
+				case ShaderStage::Vertex:	return "Vertex";
+				case ShaderStage::Fragment:	return "Fragment";
+				case ShaderStage::Geometry:	return "Geometry";
+				case ShaderStage::Compute:	return "Compute";
+			}
+			VS_CORE_ASSERT(false);
+			return nullptr;
+		}
+
+		static const char* ShaderStageCachedVulkanFileExtension(ShaderStage stage)
+		{
+			switch (stage)
+			{
+				case ShaderStage::Vertex:	return ".cached_vulkan.vert";
+				case ShaderStage::Fragment:	return ".cached_vulkan.frag";
+				case ShaderStage::Geometry:	return ".cached_vulkan.geo";
+				case ShaderStage::Compute:	return ".cached_vulkan.comp";
+			}
+			VS_CORE_ASSERT(false);
+			return "";
+		}
+
+	}
+
+	const char* ShaderCompiler::GetCacheDirectory()
+	{
+		return "Resources/Cache/Shader/Opengl";
+	}
+
+	std::string ShaderCompiler::ReadFile(const std::string& filepath)
+	{
+		VS_PROFILE_FUNCTION();
+
+		std::string result;
+		std::ifstream in(filepath, std::ios::in | std::ios::binary); // ifstream closes itself due to RAII
+		if (in)
+		{
+			in.seekg(0, std::ios::end);
+			size_t size = in.tellg();
+			if (size != -1)
+			{
+				result.resize(size);
+				in.seekg(0, std::ios::beg);
+				in.read(&result[0], size);
+			}
+			else
+			{
+				CORE_LOG_ERROR("Could not read from file '{0}'", filepath);
+			}
+		}
+		else
+		{
+			CORE_LOG_ERROR("Could not open file '{0}'", filepath);
+		}
+
+		return result;
+	}
+
+	std::unordered_map<ShaderStage, std::string> ShaderCompiler::PreProcess(const std::string& source)
+	{
+		VS_PROFILE_FUNCTION();
+
+		std::unordered_map<ShaderStage, std::string> shaderSources;
+
+		const char* typeToken = "#type";
+		size_t typeTokenLength = strlen(typeToken);
+		size_t pos = source.find(typeToken, 0); //Start of shader type declaration line
+		while (pos != std::string::npos)
+		{
+			size_t eol = source.find_first_of("\r\n", pos); //End of shader type declaration line
+			VS_CORE_ASSERT(eol != std::string::npos, "Syntax error");
+			size_t begin = pos + typeTokenLength + 1; //Start of shader type name (after "#type " keyword)
+			std::string type = source.substr(begin, eol - begin);
+
+			ShaderStage stage;
+			bool validType = Utils::ShaderStageFromString(type, stage);
+			VS_CORE_ASSERT(validType, "Invalid shader type specified");
+
+			size_t nextLinePos = source.find_first_not_of("\r\n", eol); //Start of shader code after shader type declaration line
+			VS_CORE_ASSERT(nextLinePos != std::string::npos, "Syntax error");
+			pos = source.find(typeToken, nextLinePos); //Start of next shader type declaration line
+
+			if (validType)
+				shaderSources[stage] = (pos == std::string::npos) ? source.substr(nextLinePos) : source.substr(nextLinePos, pos - nextLinePos);
+		}
+
+		return shaderSources;
+	}
+
+	std::unordered_map<ShaderStage, std::vector<uint32_t>> ShaderCompiler::CompileOrGetVulkanBinaries(const std::unordered_map<ShaderStage, std::string>& sources, const std::string& filepath)
+	{
+		VS_PROFILE_FUNCTION();
+
+		shaderc::Compiler compiler;
+		shaderc::CompileOptions options;
+		options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
+		const bool optimize = false;
+		if (optimize)
+			options.SetOptimizationLevel(shaderc_optimization_level_performance);
+
+		bool cached = !filepath.empty();
+		std::filesystem::path cacheDirectory = GetCacheDirectory();
+		if (cached && !std::filesystem::exists(cacheDirectory))
+			std::filesystem::create_directories(cacheDirectory);
+
+		std::unordered_map<ShaderStage, std::vector<uint32_t>> shaderData;
+		for (auto&& [stage, source] : sources)
+		{
+			std::filesystem::path cachedPath;
+			if (cached)
+			{
+				cachedPath = cacheDirectory / (std::filesystem::path(filepath).filename().string() + Utils::ShaderStageCachedVulkanFileExtension(stage));
+
+				std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
+				if (in.is_open())
+				{
+					in.seekg(0, std::ios::end);
+					auto size = in.tellg();
+					in.seekg(0, std::ios::beg);
+
+					auto& data = shaderData[stage];
+					data.resize(size / sizeof(uint32_t));
+					in.read((char*)data.data(), size);
+					continue;
+				}
+			}
+
+			shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(source, Utils::ShaderStageToShaderC(stage), filepath.c_str(), options);
+			if (module.GetCompilationStatus() != shaderc_compilation_status_success)
+			{
+				CORE_LOG_ERROR(module.GetErrorMessage());
+				VS_CORE_ASSERT(false);
+				continue;
+			}
+
+			auto& data = shaderData[stage];
+			data = std::vector<uint32_t>(module.cbegin(), module.cend());
+
+			if (cached)
+			{
+				std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
+				if (out.is_open())
+					out.write((char*)data.data(), data.size() * sizeof(uint32_t));
+			}
+		}
+
+		return shaderData;
+	}
+
+	void ShaderCompiler::Reflect(ShaderStage stage, const std::vector<uint32_t>& spirv, const std::string& filepath, Reflection& reflection)
+	{
+		spirv_cross::Compiler compiler(spirv);
+		spirv_cross::ShaderResources resources = compiler.get_shader_resources();
+
+		CORE_LOG_TRACE("ShaderCompiler::Reflect - {0} {1}", Utils::ShaderStageToString(stage), filepath);
+
+		// Push constant blocks end up as plain uniform structs once cross compiled to OpenGL
+		for (const auto& resource : resources.push_constant_buffers)
+		{
+			const auto& bufferType = compiler.get_type(resource.base_type_id);
+			const std::string& instanceName = compiler.get_name(resource.id);
+			uint32_t memberCount = (uint32_t)bufferType.member_types.size();
+
+			for (uint32_t i = 0; i < memberCount; i++)
+			{
+				const std::string& memberName = compiler.get_member_name(resource.base_type_id, i);
+				reflection.Uniforms.push_back(instanceName.empty() ? memberName : instanceName + "." + memberName);
+			}
+		}
+
+		for (const auto& resource : resources.sampled_images)
+			reflection.Uniforms.push_back(resource.name);
+
+		for (const auto& resource : resources.uniform_buffers)
+		{
+			if (compiler.get_decoration(resource.id, spv::DecorationBinding) != Shader::MaterialBufferBinding)
+				continue;
+
+			const auto& bufferType = compiler.get_type(resource.base_type_id);
+			const std::string& instanceName = compiler.get_name(resource.id);
+			uint32_t memberCount = (uint32_t)bufferType.member_types.size();
+
+			reflection.MaterialBuffer.Name = instanceName;
+			reflection.MaterialBuffer.Size = (uint32_t)compiler.get_declared_struct_size(bufferType);
+
+			for (uint32_t i = 0; i < memberCount; i++)
+			{
+				const std::string& memberName = compiler.get_member_name(resource.base_type_id, i);
+				std::string uniformName = instanceName.empty() ? memberName : instanceName + "." + memberName;
+
+				ShaderUniform& uniform = reflection.MaterialBuffer.Uniforms[Shader::GetUniformID(uniformName)];
+				uniform.Offset = compiler.type_struct_member_offset(bufferType, i);
+				uniform.Size = (uint32_t)compiler.get_declared_struct_member_size(bufferType, i);
+			}
+		}
+	}
+
+}
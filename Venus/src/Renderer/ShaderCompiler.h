@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Renderer/Shader.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Venus {
+
+	enum class ShaderStage
+	{
+		Vertex = 0,
+		Fragment,
+		Geometry,
+		Compute
+	};
+
+	// The backend independent half of shader creation: "#type" splitting, Vulkan SPIR-V compilation and reflection
+	class ShaderCompiler
+	{
+		public:
+			struct Reflection
+			{
+				// Push constant members and samplers, resolved into locations by backends that have them
+				std::vector<std::string> Uniforms;
+				ShaderBuffer MaterialBuffer;
+			};
+
+			static const char* GetCacheDirectory();
+
+			static std::string ReadFile(const std::string& filepath);
+			static std::unordered_map<ShaderStage, std::string> PreProcess(const std::string& source);
+
+			// Cached per stage next to the file's name, shaders created from strings pass an empty path and skip the cache
+			static std::unordered_map<ShaderStage, std::vector<uint32_t>> CompileOrGetVulkanBinaries(const std::unordered_map<ShaderStage, std::string>& sources, const std::string& filepath);
+
+			static void Reflect(ShaderStage stage, const std::vector<uint32_t>& spirv, const std::string& filepath, Reflection& reflection);
+	};
+
+}
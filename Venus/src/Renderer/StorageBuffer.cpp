@@ -0,0 +1,22 @@
+#include "pch.h"
+#include "StorageBuffer.h"
+
+#include "Renderer/Renderer.h"
+#include "Renderer/OpenGL/OpenGLStorageBuffer.h"
+#include "Renderer/Null/NullStorageBuffer.h"
+
+namespace Venus {
+
+	Ref<StorageBuffer> StorageBuffer::Create(uint32_t size, uint32_t binding)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    return CreateRef<NullStorageBuffer>(size);
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLStorageBuffer>(size, binding);
+		}
+
+		VS_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Engine/Base.h"
+
+namespace Venus {
+
+	class StorageBuffer
+	{
+		public:
+			virtual ~StorageBuffer() {}
+			virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+			virtual void Resize(uint32_t size) = 0;
+
+			virtual uint32_t GetSize() const = 0;
+
+			static Ref<StorageBuffer> Create(uint32_t size, uint32_t binding);
+	};
+
+}
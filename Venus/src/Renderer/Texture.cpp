@@ -3,6 +3,7 @@
 
 #include "Renderer/Renderer.h"
 #include "Renderer/OpenGL/OpenGLTexture.h"
+#include "Renderer/Null/NullTexture.h"
 
 namespace Venus {
 
@@ -10,7 +11,7 @@ namespace Venus {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateRef<NullTexture2D>(width, height, props);
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(width, height, props);
 		}
 
@@ -18,12 +19,12 @@ namespace Venus {
 		return nullptr;
 	}
 
-	Ref<Texture2D> Texture2D::Create(const std::string& path, TextureProperties props)
+	Ref<Texture2D> Texture2D::Create(const std::string& path, TextureProperties props, bool streamed)
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(path, props);
+			case RendererAPI::API::None:    return CreateRef<NullTexture2D>(path, props, streamed);
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(path, props, streamed);
 		}
 
 		VS_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -34,7 +35,7 @@ namespace Venus {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateRef<NullTextureCube>(width, height, props);
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTextureCube>(width, height, props);
 		}
 
@@ -46,7 +47,7 @@ namespace Venus {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    VS_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateRef<NullTextureCube>(paths, props);
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTextureCube>(paths, props);
 		}
 
@@ -7,6 +7,9 @@
 
 namespace Venus {
 
+	class RingBuffer;
+	enum class TextureCompression : uint32_t;
+
 	enum class TextureFilterMode 
 	{
 		Point = 0,
@@ -26,7 +29,16 @@ namespace Venus {
 		SRGB = 0,
 		RGBA8 = 1,
 		RGBA16F = 2,
-		RGBA32F = 3
+		RGBA32F = 3,
+		R11G11B10F = 4 // Packed float, no alpha
+	};
+
+	// Picks the block compression a cooked texture gets, channels the shader doesn't read are dropped
+	enum class TextureUsage
+	{
+		Color = 0,
+		Normal = 1, // Tangent space XY, the shader rebuilds Z
+		Mask = 2 // Single channel, read from R
 	};
 
 	enum class TextureType
@@ -44,17 +56,18 @@ namespace Venus {
 		bool FlipVertically = true;
 		bool GenerateMipmaps = true;
 		bool UseMipmaps = false;
+		TextureUsage Usage = TextureUsage::Color;
 
-		bool operator==(const TextureProperties& other)
+		bool operator==(const TextureProperties& other) const
 		{
 			bool isEqual = Filter == other.Filter && WrapMode == other.WrapMode && Format == other.Format
 							&& FlipVertically == other.FlipVertically && GenerateMipmaps == other.GenerateMipmaps 
-							&& UseMipmaps == other.UseMipmaps;
+							&& UseMipmaps == other.UseMipmaps && Usage == other.Usage;
 
 			return isEqual;
 		}
 
-		bool operator!=(const TextureProperties& other)
+		bool operator!=(const TextureProperties& other) const
 		{
 			return !operator==(other);
 		}
@@ -90,13 +103,30 @@ namespace Venus {
 	class Texture2D : public Texture
 	{
 		public:
+			using Texture::SetData;
+
+			// Rows [y, y + rows) read from a pixel unpack ring buffer at offset
+			virtual void SetData(const Ref<RingBuffer>& buffer, uint32_t offset, uint32_t y, uint32_t rows) = 0;
+
+			// Cooked copies fill separate block compressed storage, the current contents stay bound until EndCompressedData swaps it in
+			virtual void BeginCompressedData(TextureCompression compression, uint32_t width, uint32_t height, uint32_t levelCount) = 0;
+			// Rows [y, y + rows) of a level from the ring buffer, y and rows are multiples of 4 except at the level's bottom edge
+			virtual void SetCompressedData(const Ref<RingBuffer>& buffer, uint32_t offset, uint32_t level, uint32_t y, uint32_t rows) = 0;
+			virtual void EndCompressedData() = 0;
+
 			static Ref<Texture2D> Create(uint32_t width, uint32_t height, TextureProperties props = TextureProperties());
-			static Ref<Texture2D> Create(const std::string& path, TextureProperties props = TextureProperties());
+			// Streamed textures return with a placeholder until the streamer uploaded the file, or its cooked block compressed copy
+			static Ref<Texture2D> Create(const std::string& path, TextureProperties props = TextureProperties(), bool streamed = false);
 	};
 
 	class TextureCube : public Texture
 	{
 		public:
+			// One mip level with the six faces packed one after the other, in the texture's own format
+			virtual uint32_t GetLevelSize(uint32_t mipLevel) const = 0;
+			virtual void GetLevelData(void* data, uint32_t size, uint32_t mipLevel) const = 0;
+			virtual void SetLevelData(const void* data, uint32_t size, uint32_t mipLevel) = 0;
+
 			static Ref<TextureCube> Create(uint32_t width, uint32_t height, TextureProperties props = TextureProperties());
 			static Ref<TextureCube> Create(std::vector<std::string> paths, TextureProperties props = TextureProperties());
 	};
@@ -0,0 +1,269 @@
+#include "pch.h"
+#include "TextureCache.h"
+
+#include "Engine/JobSystem.h"
+#include "Renderer/Image.h"
+#include "Utils/Hash.h"
+
+#include <unordered_set>
+
+namespace Venus {
+
+	namespace Utils {
+
+		static const char* GetTextureCacheDirectory()
+		{
+			return "Resources/Cache/Texture";
+		}
+
+		static void CreateTextureCacheDirectoryIfNeeded()
+		{
+			std::string cacheDirectory = GetTextureCacheDirectory();
+			if (!std::filesystem::exists(cacheDirectory))
+				std::filesystem::create_directories(cacheDirectory);
+		}
+
+		// 2x2 box filter, normal maps are renormalized so filtered texels stay unit length
+		static std::vector<uint8_t> Downsample(const uint8_t* pixels, uint32_t width, uint32_t height, bool normalMap)
+		{
+			uint32_t mipWidth = std::max(width / 2, 1u);
+			uint32_t mipHeight = std::max(height / 2, 1u);
+
+			std::vector<uint8_t> result((uint64_t)mipWidth * mipHeight * 4);
+			for (uint32_t y = 0; y < mipHeight; y++)
+			{
+				uint32_t y0 = std::min(y * 2, height - 1);
+				uint32_t y1 = std::min(y * 2 + 1, height - 1);
+				for (uint32_t x = 0; x < mipWidth; x++)
+				{
+					uint32_t x0 = std::min(x * 2, width - 1);
+					uint32_t x1 = std::min(x * 2 + 1, width - 1);
+
+					float texel[4];
+					for (uint32_t c = 0; c < 4; c++)
+					{
+						uint32_t sum = pixels[((uint64_t)y0 * width + x0) * 4 + c] + pixels[((uint64_t)y0 * width + x1) * 4 + c]
+							+ pixels[((uint64_t)y1 * width + x0) * 4 + c] + pixels[((uint64_t)y1 * width + x1) * 4 + c];
+						texel[c] = sum / 4.0f;
+					}
+
+					if (normalMap)
+					{
+						glm::vec3 normal = glm::vec3(texel[0], texel[1], texel[2]) / 255.0f * 2.0f - 1.0f;
+						if (glm::length(normal) > 1e-4f)
+							normal = glm::normalize(normal);
+
+						normal = (normal * 0.5f + 0.5f) * 255.0f;
+						texel[0] = normal.x;
+						texel[1] = normal.y;
+						texel[2] = normal.z;
+					}
+
+					uint8_t* destination = &result[((uint64_t)y * mipWidth + x) * 4];
+					for (uint32_t c = 0; c < 4; c++)
+						destination[c] = (uint8_t)std::clamp(texel[c] + 0.5f, 0.0f, 255.0f);
+				}
+			}
+
+			return result;
+		}
+
+	}
+
+	struct TextureCacheHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t SourceHash;
+		uint32_t Flags;
+		uint32_t Compression;
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t LevelCount;
+		uint32_t Usage;
+	};
+
+	struct TextureCacheLevel
+	{
+		uint64_t Offset;
+		uint64_t Size;
+	};
+
+	struct TextureCacheData
+	{
+		std::mutex Mutex;
+		std::unordered_set<std::string> CookingPaths; // Cache paths
+	};
+
+	static TextureCacheData s_CacheData;
+
+	static constexpr char s_TextureCacheMagic[4] = { 'V', 'S', 'T', 'X' };
+	static constexpr uint64_t s_TextureCacheAlignment = 16;
+	static constexpr uint32_t s_FlipVerticallyFlag = 1 << 0;
+
+	uint64_t TextureCache::HashSource(const std::string& sourcePath)
+	{
+		VS_PROFILE_FUNCTION();
+
+		MappedFile source(sourcePath);
+		if (!source.IsValid())
+			return 0;
+
+		return Hash::GenerateFNVHash64(source.GetData(), source.GetSize());
+	}
+
+	std::filesystem::path TextureCache::GetCachePath(const std::string& sourcePath, TextureUsage usage)
+	{
+		std::filesystem::path path = sourcePath;
+		uint32_t pathHash = Hash::GenerateFNVHash(std::filesystem::absolute(path).generic_string() + ":" + std::to_string((uint32_t)usage));
+
+		std::stringstream name;
+		name << path.stem().string() << "_" << std::hex << pathHash << ".vstex";
+
+		return std::filesystem::path(Utils::GetTextureCacheDirectory()) / name.str();
+	}
+
+	bool TextureCache::Cook(const std::string& sourcePath, const Image& image, uint64_t sourceHash, bool flipVertically, TextureUsage usage)
+	{
+		VS_PROFILE_FUNCTION();
+
+		if (!sourceHash || image.IsHDR())
+			return false;
+
+		TextureCompression compression = TextureCompressor::GetCompression(usage, image.GetData(), image.GetWidth(), image.GetHeight());
+
+		// Same chain as a texture generating its mips at runtime
+		uint32_t width = image.GetWidth();
+		uint32_t height = image.GetHeight();
+		uint32_t levelCount = (uint32_t)std::floor(std::log2(std::min(width, height))) + 1;
+
+		std::vector<uint8_t> buffer(sizeof(TextureCacheHeader) + levelCount * sizeof(TextureCacheLevel));
+
+		TextureCacheHeader header = {};
+		memcpy(header.Magic, s_TextureCacheMagic, sizeof(header.Magic));
+		header.Version = Version;
+		header.SourceHash = sourceHash;
+		header.Flags = flipVertically ? s_FlipVerticallyFlag : 0;
+		header.Compression = (uint32_t)compression;
+		header.Width = width;
+		header.Height = height;
+		header.LevelCount = levelCount;
+		header.Usage = (uint32_t)usage;
+		memcpy(buffer.data(), &header, sizeof(TextureCacheHeader));
+
+		std::vector<uint8_t> mip;
+		const uint8_t* pixels = image.GetData();
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			if (level > 0)
+			{
+				mip = Utils::Downsample(pixels, width, height, usage == TextureUsage::Normal);
+				pixels = mip.data();
+				width = std::max(width / 2, 1u);
+				height = std::max(height / 2, 1u);
+			}
+
+			buffer.resize((buffer.size() + s_TextureCacheAlignment - 1) & ~(s_TextureCacheAlignment - 1), 0);
+
+			TextureCacheLevel entry;
+			entry.Offset = buffer.size();
+			entry.Size = TextureCompressor::GetCompressedSize(compression, width, height);
+			memcpy(buffer.data() + sizeof(TextureCacheHeader) + level * sizeof(TextureCacheLevel), &entry, sizeof(TextureCacheLevel));
+
+			buffer.resize(buffer.size() + entry.Size);
+			TextureCompressor::Compress(compression, pixels, width, height, buffer.data() + entry.Offset);
+		}
+
+		Utils::CreateTextureCacheDirectoryIfNeeded();
+
+		// Written next to the target first so a crash never leaves a torn cache behind
+		std::filesystem::path path = GetCachePath(sourcePath, usage);
+		std::filesystem::path tempPath = path;
+		tempPath += ".tmp";
+
+		std::ofstream out(tempPath, std::ios::out | std::ios::binary);
+		if (!out.is_open())
+		{
+			CORE_LOG_WARN("TextureCache: Could not write {0}", path.string());
+			return false;
+		}
+
+		out.write((const char*)buffer.data(), buffer.size());
+		out.close();
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, path, error);
+		if (error)
+		{
+			CORE_LOG_WARN("TextureCache: Could not write {0}: {1}", path.string(), error.message());
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+
+		CORE_LOG_TRACE("TextureCache: Cooked {0}", sourcePath);
+		return true;
+	}
+
+	void TextureCache::CookAsync(const std::string& sourcePath, const Ref<Image>& image, uint64_t sourceHash, bool flipVertically, TextureUsage usage)
+	{
+		std::string cachePath = GetCachePath(sourcePath, usage).string();
+		{
+			std::lock_guard lock(s_CacheData.Mutex);
+			if (!s_CacheData.CookingPaths.insert(cachePath).second)
+				return;
+		}
+
+		JobSystem::Execute([sourcePath, image, sourceHash, flipVertically, usage, cachePath]()
+		{
+			Cook(sourcePath, *image, sourceHash, flipVertically, usage);
+
+			std::lock_guard lock(s_CacheData.Mutex);
+			s_CacheData.CookingPaths.erase(cachePath);
+		});
+	}
+
+	TextureCache::Reader::Reader(const std::filesystem::path& path, uint64_t sourceHash, bool flipVertically, TextureUsage usage)
+		: m_File(path)
+	{
+		VS_PROFILE_FUNCTION();
+
+		if (!m_File.IsValid() || m_File.GetSize() < sizeof(TextureCacheHeader))
+			return;
+
+		const uint8_t* data = m_File.GetData();
+		const uint64_t size = m_File.GetSize();
+
+		TextureCacheHeader header;
+		memcpy(&header, data, sizeof(TextureCacheHeader));
+
+		uint32_t flags = flipVertically ? s_FlipVerticallyFlag : 0;
+		if (memcmp(header.Magic, s_TextureCacheMagic, sizeof(header.Magic)) != 0 || header.Version != Version
+			|| header.SourceHash != sourceHash || header.Flags != flags || header.Usage != (uint32_t)usage)
+			return;
+
+		m_Compression = (TextureCompression)header.Compression;
+		if (TextureCompressor::GetBlockSize(m_Compression) == 0 || header.Width == 0 || header.Height == 0)
+			return;
+
+		uint32_t levelCount = (uint32_t)std::floor(std::log2(std::min(header.Width, header.Height))) + 1;
+		if (header.LevelCount != levelCount || sizeof(TextureCacheHeader) + levelCount * sizeof(TextureCacheLevel) > size)
+			return;
+
+		m_Width = header.Width;
+		m_Height = header.Height;
+		m_Levels.resize(levelCount);
+		memcpy(m_Levels.data(), data + sizeof(TextureCacheHeader), levelCount * sizeof(TextureCacheLevel));
+
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			uint32_t width = std::max(m_Width >> level, 1u);
+			uint32_t height = std::max(m_Height >> level, 1u);
+			if (m_Levels[level].Size != TextureCompressor::GetCompressedSize(m_Compression, width, height)
+				|| m_Levels[level].Offset + m_Levels[level].Size > size)
+				return;
+		}
+
+		m_Valid = true;
+	}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Renderer/TextureCompressor.h"
+#include "Utils/PlatformUtils.h"
+
+#include <filesystem>
+
+namespace Venus {
+
+	class Image;
+
+	// Textures cooked to .vstex files: the whole mip chain block compressed, keyed by source content hash
+	class TextureCache
+	{
+		public:
+			static constexpr uint32_t Version = 2;
+
+			// Zero if the source can't be read
+			static uint64_t HashSource(const std::string& sourcePath);
+			// One file per usage, a source bound to two material slots cooks twice
+			static std::filesystem::path GetCachePath(const std::string& sourcePath, TextureUsage usage);
+
+			// Builds the mips of an already decoded source and encodes them on the calling thread. HDR sources aren't cooked
+			static bool Cook(const std::string& sourcePath, const Image& image, uint64_t sourceHash, bool flipVertically, TextureUsage usage);
+
+			// Runs Cook on a worker, a path already being cooked is skipped. The image is shared with whoever decoded it
+			static void CookAsync(const std::string& sourcePath, const Ref<Image>& image, uint64_t sourceHash, bool flipVertically, TextureUsage usage);
+
+			// Keeps the file mapped, level data points straight into it
+			class Reader
+			{
+				public:
+					Reader(const std::filesystem::path& path, uint64_t sourceHash, bool flipVertically, TextureUsage usage);
+
+					bool IsValid() const { return m_Valid; }
+
+					TextureCompression GetCompression() const { return m_Compression; }
+					uint32_t GetWidth() const { return m_Width; }
+					uint32_t GetHeight() const { return m_Height; }
+					uint32_t GetLevelCount() const { return (uint32_t)m_Levels.size(); }
+
+					const uint8_t* GetLevelData(uint32_t level) const { return m_File.GetData() + m_Levels[level].Offset; }
+					uint32_t GetLevelSize(uint32_t level) const { return (uint32_t)m_Levels[level].Size; }
+
+				private:
+					struct Level
+					{
+						uint64_t Offset;
+						uint64_t Size;
+					};
+
+					MappedFile m_File;
+					TextureCompression m_Compression = TextureCompression::None;
+					uint32_t m_Width = 0;
+					uint32_t m_Height = 0;
+					std::vector<Level> m_Levels;
+					bool m_Valid = false;
+			};
+	};
+
+}
@@ -0,0 +1,534 @@
+#include "pch.h"
+#include "TextureCompressor.h"
+
+#include "Engine/JobSystem.h"
+
+namespace Venus {
+
+	namespace Utils {
+
+		static void ReadBlock(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t block[16][4])
+		{
+			for (uint32_t y = 0; y < 4; y++)
+			{
+				uint32_t sourceY = std::min(blockY * 4 + y, height - 1);
+				for (uint32_t x = 0; x < 4; x++)
+				{
+					uint32_t sourceX = std::min(blockX * 4 + x, width - 1);
+					memcpy(block[y * 4 + x], pixels + ((uint64_t)sourceY * width + sourceX) * 4, 4);
+				}
+			}
+		}
+
+		static void ReadChannel(const uint8_t block[16][4], uint32_t channel, uint8_t values[16])
+		{
+			for (uint32_t i = 0; i < 16; i++)
+				values[i] = block[i][channel];
+		}
+
+		// Endpoints along the principal axis of the first N channels, start lies on the positive side
+		template<int N>
+		static void FindEndpoints(const uint8_t block[16][4], float start[N], float end[N])
+		{
+			float mean[N] = {};
+			for (int i = 0; i < 16; i++)
+				for (int c = 0; c < N; c++)
+					mean[c] += block[i][c];
+			for (int c = 0; c < N; c++)
+				mean[c] /= 16.0f;
+
+			float covariance[N][N] = {};
+			for (int i = 0; i < 16; i++)
+				for (int a = 0; a < N; a++)
+					for (int b = 0; b < N; b++)
+						covariance[a][b] += (block[i][a] - mean[a]) * (block[i][b] - mean[b]);
+
+			// Power iteration, seeded with the column of the channel that varies the most
+			int seed = 0;
+			for (int c = 1; c < N; c++)
+			{
+				if (covariance[c][c] > covariance[seed][seed])
+					seed = c;
+			}
+
+			float axis[N];
+			for (int c = 0; c < N; c++)
+				axis[c] = covariance[c][seed];
+
+			for (int iteration = 0; iteration < 8; iteration++)
+			{
+				float next[N] = {};
+				float largest = 0.0f;
+				for (int a = 0; a < N; a++)
+				{
+					for (int b = 0; b < N; b++)
+						next[a] += covariance[a][b] * axis[b];
+
+					largest = std::max(largest, std::abs(next[a]));
+				}
+
+				if (largest < 1e-6f)
+					break;
+
+				for (int c = 0; c < N; c++)
+					axis[c] = next[c] / largest;
+			}
+
+			float length = 0.0f;
+			for (int c = 0; c < N; c++)
+				length += axis[c] * axis[c];
+			length = std::sqrt(length);
+
+			float minT = 0.0f, maxT = 0.0f;
+			if (length > 1e-6f)
+			{
+				for (int c = 0; c < N; c++)
+					axis[c] /= length;
+
+				minT = std::numeric_limits<float>::max();
+				maxT = -std::numeric_limits<float>::max();
+				for (int i = 0; i < 16; i++)
+				{
+					float t = 0.0f;
+					for (int c = 0; c < N; c++)
+						t += (block[i][c] - mean[c]) * axis[c];
+
+					minT = std::min(minT, t);
+					maxT = std::max(maxT, t);
+				}
+
+				// Pulling the endpoints in a bit lowers the error of the interpolated entries
+				float inset = (maxT - minT) / 16.0f;
+				minT += inset;
+				maxT -= inset;
+			}
+			else
+			{
+				for (int c = 0; c < N; c++)
+					axis[c] = 0.0f;
+			}
+
+			for (int c = 0; c < N; c++)
+			{
+				start[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+				end[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+			}
+		}
+
+		// Least squares endpoints for fixed interpolation weights, weights[i] is the share of start in texel i
+		template<int N>
+		static bool FitEndpoints(const uint8_t block[16][4], const float weights[16], float start[N], float end[N])
+		{
+			float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+			float ax[N] = {}, bx[N] = {};
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				float a = weights[i];
+				float b = 1.0f - a;
+
+				aa += a * a;
+				bb += b * b;
+				ab += a * b;
+				for (int c = 0; c < N; c++)
+				{
+					ax[c] += a * block[i][c];
+					bx[c] += b * block[i][c];
+				}
+			}
+
+			float determinant = aa * bb - ab * ab;
+			if (std::abs(determinant) < 1e-6f)
+				return false;
+
+			for (int c = 0; c < N; c++)
+			{
+				start[c] = std::clamp((bb * ax[c] - ab * bx[c]) / determinant, 0.0f, 255.0f);
+				end[c] = std::clamp((aa * bx[c] - ab * ax[c]) / determinant, 0.0f, 255.0f);
+			}
+
+			return true;
+		}
+
+		//-- BC1-----------------------------------------------------------------------------------------
+		static uint16_t PackRGB565(const float color[3])
+		{
+			uint32_t r = (uint32_t)(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+			uint32_t g = (uint32_t)(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+			uint32_t b = (uint32_t)(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+
+			return (uint16_t)((r << 11) | (g << 5) | b);
+		}
+
+		static void UnpackRGB565(uint16_t value, int color[3])
+		{
+			int r = (value >> 11) & 31;
+			int g = (value >> 5) & 63;
+			int b = value & 31;
+
+			color[0] = (r << 3) | (r >> 2);
+			color[1] = (g << 2) | (g >> 4);
+			color[2] = (b << 3) | (b >> 2);
+		}
+
+		// Closest of the four palette entries per texel, returns the squared error of the block
+		static uint32_t FindBC1Indices(const uint8_t block[16][4], uint16_t color0, uint16_t color1, uint32_t& indices)
+		{
+			int palette[4][3];
+			UnpackRGB565(color0, palette[0]);
+			UnpackRGB565(color1, palette[1]);
+			for (int c = 0; c < 3; c++)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+
+			indices = 0;
+			uint32_t error = 0;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				uint32_t bestIndex = 0;
+				uint32_t bestError = std::numeric_limits<uint32_t>::max();
+				for (uint32_t j = 0; j < 4; j++)
+				{
+					uint32_t distance = 0;
+					for (int c = 0; c < 3; c++)
+					{
+						int delta = block[i][c] - palette[j][c];
+						distance += delta * delta;
+					}
+
+					if (distance < bestError)
+					{
+						bestError = distance;
+						bestIndex = j;
+					}
+				}
+
+				indices |= bestIndex << (2 * i);
+				error += bestError;
+			}
+
+			return error;
+		}
+
+		static void EncodeBC1(const uint8_t block[16][4], uint8_t* output)
+		{
+			float start[3], end[3];
+			FindEndpoints<3>(block, start, end);
+
+			uint16_t color0 = PackRGB565(start);
+			uint16_t color1 = PackRGB565(end);
+			uint32_t indices = 0;
+
+			// Equal endpoints leave every index at zero
+			if (color0 != color1)
+			{
+				// color0 > color1 selects the four color mode
+				if (color0 < color1)
+					std::swap(color0, color1);
+
+				uint32_t error = FindBC1Indices(block, color0, color1, indices);
+
+				// One least squares pass fitting the endpoints to the chosen indices
+				static const float paletteWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+				float weights[16];
+				for (uint32_t i = 0; i < 16; i++)
+					weights[i] = paletteWeights[(indices >> (2 * i)) & 3];
+
+				float refinedStart[3], refinedEnd[3];
+				if (FitEndpoints<3>(block, weights, refinedStart, refinedEnd))
+				{
+					uint16_t refined0 = PackRGB565(refinedStart);
+					uint16_t refined1 = PackRGB565(refinedEnd);
+					if (refined0 < refined1)
+						std::swap(refined0, refined1);
+
+					uint32_t refinedIndices = 0;
+					if (refined0 != refined1 && FindBC1Indices(block, refined0, refined1, refinedIndices) < error)
+					{
+						color0 = refined0;
+						color1 = refined1;
+						indices = refinedIndices;
+					}
+				}
+			}
+
+			output[0] = (uint8_t)color0;
+			output[1] = (uint8_t)(color0 >> 8);
+			output[2] = (uint8_t)color1;
+			output[3] = (uint8_t)(color1 >> 8);
+			for (int i = 0; i < 4; i++)
+				output[4 + i] = (uint8_t)(indices >> (8 * i));
+		}
+
+		//-- BC4-----------------------------------------------------------------------------------------
+		static void EncodeBC4(const uint8_t values[16], uint8_t* output)
+		{
+			uint8_t minValue = 255, maxValue = 0;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				minValue = std::min(minValue, values[i]);
+				maxValue = std::max(maxValue, values[i]);
+			}
+
+			output[0] = maxValue;
+			output[1] = minValue;
+
+			uint64_t indices = 0;
+			if (maxValue > minValue)
+			{
+				// red0 > red1 selects six interpolated values between the endpoints
+				int palette[8];
+				palette[0] = maxValue;
+				palette[1] = minValue;
+				for (int i = 1; i < 7; i++)
+					palette[i + 1] = ((7 - i) * maxValue + i * minValue + 3) / 7;
+
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					uint64_t bestIndex = 0;
+					int bestError = std::numeric_limits<int>::max();
+					for (uint32_t j = 0; j < 8; j++)
+					{
+						int error = std::abs(values[i] - palette[j]);
+						if (error < bestError)
+						{
+							bestError = error;
+							bestIndex = j;
+						}
+					}
+
+					indices |= bestIndex << (3 * i);
+				}
+			}
+
+			for (int i = 0; i < 6; i++)
+				output[2 + i] = (uint8_t)(indices >> (8 * i));
+		}
+
+		//-- BC7-----------------------------------------------------------------------------------------
+		struct BlockWriter
+		{
+			uint8_t* Data;
+			uint32_t Bit = 0;
+
+			void Write(uint32_t value, uint32_t count)
+			{
+				for (uint32_t i = 0; i < count; i++, Bit++)
+				{
+					if ((value >> i) & 1)
+						Data[Bit >> 3] |= 1 << (Bit & 7);
+				}
+			}
+		};
+
+		static const int s_BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		struct BC7Endpoints
+		{
+			int Quantized[2][4];
+			int PBits[2];
+			uint32_t Indices[16];
+		};
+
+		// 7 bits per channel plus a low bit shared by all channels of an endpoint, returns the squared error of the block
+		static uint32_t QuantizeBC7(const uint8_t block[16][4], const float start[4], const float end[4], BC7Endpoints& result)
+		{
+			const float* endpoints[2] = { start, end };
+			for (int e = 0; e < 2; e++)
+			{
+				float bestError = std::numeric_limits<float>::max();
+				for (int p = 0; p < 2; p++)
+				{
+					int candidate[4];
+					float error = 0.0f;
+					for (int c = 0; c < 4; c++)
+					{
+						candidate[c] = std::clamp((int)((endpoints[e][c] - p) / 2.0f + 0.5f), 0, 127);
+						float delta = (float)((candidate[c] << 1) | p) - endpoints[e][c];
+						error += delta * delta;
+					}
+
+					if (error < bestError)
+					{
+						bestError = error;
+						result.PBits[e] = p;
+						memcpy(result.Quantized[e], candidate, sizeof(candidate));
+					}
+				}
+			}
+
+			int palette[16][4];
+			for (int j = 0; j < 16; j++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					int e0 = (result.Quantized[0][c] << 1) | result.PBits[0];
+					int e1 = (result.Quantized[1][c] << 1) | result.PBits[1];
+					palette[j][c] = ((64 - s_BC7Weights[j]) * e0 + s_BC7Weights[j] * e1 + 32) >> 6;
+				}
+			}
+
+			uint32_t error = 0;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				uint32_t bestError = std::numeric_limits<uint32_t>::max();
+				for (uint32_t j = 0; j < 16; j++)
+				{
+					uint32_t distance = 0;
+					for (int c = 0; c < 4; c++)
+					{
+						int delta = block[i][c] - palette[j][c];
+						distance += delta * delta;
+					}
+
+					if (distance < bestError)
+					{
+						bestError = distance;
+						result.Indices[i] = j;
+					}
+				}
+
+				error += bestError;
+			}
+
+			return error;
+		}
+
+		// Mode 6 only: one subset, RGBA endpoints and 4 bit indices. Not the best mode for every block, but a good one for most
+		static void EncodeBC7(const uint8_t block[16][4], uint8_t* output)
+		{
+			float start[4], end[4];
+			FindEndpoints<4>(block, start, end);
+
+			BC7Endpoints endpoints;
+			uint32_t error = QuantizeBC7(block, start, end, endpoints);
+
+			float weights[16];
+			for (uint32_t i = 0; i < 16; i++)
+				weights[i] = (64 - s_BC7Weights[endpoints.Indices[i]]) / 64.0f;
+
+			BC7Endpoints refined;
+			if (FitEndpoints<4>(block, weights, start, end) && QuantizeBC7(block, start, end, refined) < error)
+				endpoints = refined;
+
+			// The first index is stored without its top bit, swapping the endpoints mirrors the palette
+			if (endpoints.Indices[0] & 8)
+			{
+				std::swap(endpoints.Quantized[0], endpoints.Quantized[1]);
+				std::swap(endpoints.PBits[0], endpoints.PBits[1]);
+				for (uint32_t i = 0; i < 16; i++)
+					endpoints.Indices[i] = 15 - endpoints.Indices[i];
+			}
+
+			memset(output, 0, 16);
+			BlockWriter writer = { output };
+			writer.Write(1 << 6, 7);
+			for (int c = 0; c < 4; c++)
+			{
+				writer.Write(endpoints.Quantized[0][c], 7);
+				writer.Write(endpoints.Quantized[1][c], 7);
+			}
+			writer.Write(endpoints.PBits[0], 1);
+			writer.Write(endpoints.PBits[1], 1);
+
+			writer.Write(endpoints.Indices[0], 3);
+			for (uint32_t i = 1; i < 16; i++)
+				writer.Write(endpoints.Indices[i], 4);
+		}
+
+	}
+
+	TextureCompression TextureCompressor::GetCompression(TextureUsage usage, const uint8_t* pixels, uint32_t width, uint32_t height)
+	{
+		switch (usage)
+		{
+			case TextureUsage::Normal:	return TextureCompression::BC5;
+			case TextureUsage::Mask:	return TextureCompression::BC4;
+			case TextureUsage::Color:
+			{
+				uint64_t texelCount = (uint64_t)width * height;
+				for (uint64_t i = 0; i < texelCount; i++)
+				{
+					if (pixels[i * 4 + 3] != 255)
+						return TextureCompression::BC7;
+				}
+
+				return TextureCompression::BC1;
+			}
+		}
+
+		VS_CORE_ASSERT(false, "Unknown Usage");
+		return TextureCompression::None;
+	}
+
+	uint32_t TextureCompressor::GetBlockSize(TextureCompression compression)
+	{
+		switch (compression)
+		{
+			case TextureCompression::None:	return 0;
+			case TextureCompression::BC1:	return 8;
+			case TextureCompression::BC4:	return 8;
+			case TextureCompression::BC5:	return 16;
+			case TextureCompression::BC7:	return 16;
+		}
+
+		VS_CORE_ASSERT(false, "Unknown Compression");
+		return 0;
+	}
+
+	uint64_t TextureCompressor::GetCompressedSize(TextureCompression compression, uint32_t width, uint32_t height)
+	{
+		uint64_t blockCount = (uint64_t)((width + 3) / 4) * ((height + 3) / 4);
+		return blockCount * GetBlockSize(compression);
+	}
+
+	void TextureCompressor::Compress(TextureCompression compression, const uint8_t* pixels, uint32_t width, uint32_t height, uint8_t* output)
+	{
+		VS_PROFILE_FUNCTION();
+		VS_CORE_ASSERT(compression != TextureCompression::None, "Nothing to compress!");
+
+		uint32_t blocksX = (width + 3) / 4;
+		uint32_t blocksY = (height + 3) / 4;
+		uint32_t blockSize = GetBlockSize(compression);
+
+		JobSystem::ParallelFor(blocksY, 4, [&](uint32_t begin, uint32_t end)
+		{
+			uint8_t block[16][4];
+			uint8_t channel[16];
+
+			for (uint32_t blockY = begin; blockY < end; blockY++)
+			{
+				for (uint32_t blockX = 0; blockX < blocksX; blockX++)
+				{
+					Utils::ReadBlock(pixels, width, height, blockX, blockY, block);
+					uint8_t* destination = output + ((uint64_t)blockY * blocksX + blockX) * blockSize;
+
+					switch (compression)
+					{
+						case TextureCompression::BC1:
+							Utils::EncodeBC1(block, destination);
+							break;
+						case TextureCompression::BC4:
+							Utils::ReadChannel(block, 0, channel);
+							Utils::EncodeBC4(channel, destination);
+							break;
+						case TextureCompression::BC5:
+							Utils::ReadChannel(block, 0, channel);
+							Utils::EncodeBC4(channel, destination);
+							Utils::ReadChannel(block, 1, channel);
+							Utils::EncodeBC4(channel, destination + 8);
+							break;
+						case TextureCompression::BC7:
+							Utils::EncodeBC7(block, destination);
+							break;
+						case TextureCompression::None:
+							break;
+					}
+				}
+			}
+		});
+	}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Engine/Base.h"
+#include "Renderer/Texture.h"
+
+#include <string>
+
+namespace Venus {
+
+	enum class TextureCompression : uint32_t
+	{
+		None = 0,
+		BC1 = 1, // Opaque color, 4 bits per texel
+		BC4 = 2, // Single channel masks, 4 bits per texel
+		BC5 = 3, // Two channel normal maps, 8 bits per texel
+		BC7 = 4  // Color with alpha, 8 bits per texel
+	};
+
+	// CPU block encoders, take RGBA8 pixels and write 4x4 texel blocks
+	class TextureCompressor
+	{
+		public:
+			// Opaque color goes to BC1, color with alpha to BC7
+			static TextureCompression GetCompression(TextureUsage usage, const uint8_t* pixels, uint32_t width, uint32_t height);
+
+			static uint32_t GetBlockSize(TextureCompression compression);
+			static uint64_t GetCompressedSize(TextureCompression compression, uint32_t width, uint32_t height);
+
+			// Writes GetCompressedSize bytes, blocks crossing the edge repeat the last row and column
+			static void Compress(TextureCompression compression, const uint8_t* pixels, uint32_t width, uint32_t height, uint8_t* output);
+	};
+
+}
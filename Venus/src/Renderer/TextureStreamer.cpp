@@ -0,0 +1,238 @@
+#include "pch.h"
+#include "TextureStreamer.h"
+
+#include "Engine/JobSystem.h"
+#include "Renderer/Image.h"
+#include "Renderer/RingBuffer.h"
+#include "Renderer/TextureCache.h"
+
+#include <deque>
+
+namespace Venus {
+
+	struct TextureStreamRequest
+	{
+		Texture2D* Texture = nullptr; // Only touched on the main thread, and only while not cancelled
+		std::string Path;
+		bool FlipVertically = true;
+		bool Cached = false;
+		TextureUsage Usage = TextureUsage::Color;
+
+		std::atomic<bool> Finished = false; // Cancelled or fully uploaded
+		Ref<Image> Decoded; // Shared with the cook
+		Scope<TextureCache::Reader> Cooked; // Set instead of Decoded when the cooked copy is current
+		uint32_t NextLevel = 0;
+		uint32_t NextRow = 0;
+	};
+
+	struct TextureStreamerData
+	{
+		Ref<RingBuffer> UploadBuffer;
+		uint32_t UploadBudget = 0;
+
+		// Decoded and waiting for upload, main thread only
+		std::deque<Ref<TextureStreamRequest>> Uploads;
+		std::atomic<uint32_t> PendingCount = 0;
+
+		bool Initialized = false;
+	};
+
+	static TextureStreamerData s_StreamerData;
+
+	// Every row uploaded starts at this alignment, enough for float texels
+	static constexpr uint32_t s_RowAlignment = 16;
+
+	static void FinishRequest(const Ref<TextureStreamRequest>& request)
+	{
+		if (request->Finished.exchange(true))
+			return;
+
+		s_StreamerData.PendingCount--;
+	}
+
+	void TextureStreamer::Init(uint32_t uploadBudget)
+	{
+		VS_PROFILE_FUNCTION();
+
+		s_StreamerData.UploadBudget = uploadBudget;
+
+		// Slack for the alignment of the chunks pushed in one frame
+		s_StreamerData.UploadBuffer = RingBuffer::Create(uploadBudget + 64 * s_RowAlignment, RingBufferUsage::PixelUnpack);
+		s_StreamerData.Initialized = true;
+	}
+
+	void TextureStreamer::Shutdown()
+	{
+		for (auto& request : s_StreamerData.Uploads)
+			FinishRequest(request);
+
+		s_StreamerData.Uploads.clear();
+		s_StreamerData.UploadBuffer = nullptr;
+		s_StreamerData.Initialized = false;
+	}
+
+	bool TextureStreamer::IsInitialized()
+	{
+		return s_StreamerData.Initialized;
+	}
+
+	Ref<TextureStreamRequest> TextureStreamer::Request(Texture2D* texture, const std::string& path, bool flipVertically, bool cached, TextureUsage usage)
+	{
+		VS_CORE_ASSERT(s_StreamerData.Initialized, "TextureStreamer not initialized!");
+
+		Ref<TextureStreamRequest> request = CreateRef<TextureStreamRequest>();
+		request->Texture = texture;
+		request->Path = path;
+		request->FlipVertically = flipVertically;
+		request->Cached = cached;
+		request->Usage = usage;
+
+		s_StreamerData.PendingCount++;
+
+		JobSystem::Execute([request]()
+		{
+			if (request->Finished)
+				return;
+
+			// Hashing the source and mapping the cooked copy stay off the main thread like the decode
+			uint64_t sourceHash = request->Cached ? TextureCache::HashSource(request->Path) : 0;
+			if (sourceHash)
+			{
+				Scope<TextureCache::Reader> cooked = CreateScope<TextureCache::Reader>(TextureCache::GetCachePath(request->Path, request->Usage), sourceHash, request->FlipVertically, request->Usage);
+				if (cooked->IsValid())
+					request->Cooked = std::move(cooked);
+			}
+
+			if (!request->Cooked)
+			{
+				request->Decoded = Image::Load(request->Path, request->FlipVertically);
+
+				// Cooked from the pixels decoded here, the source is only decoded once
+				if (sourceHash && request->Decoded && !request->Decoded->IsHDR())
+					TextureCache::CookAsync(request->Path, request->Decoded, sourceHash, request->FlipVertically, request->Usage);
+			}
+
+			JobSystem::Execute([request]()
+			{
+				if (s_StreamerData.Initialized)
+					s_StreamerData.Uploads.push_back(request);
+			}, nullptr, JobAffinity::MainThread);
+		});
+
+		return request;
+	}
+
+	void TextureStreamer::Cancel(const Ref<TextureStreamRequest>& request)
+	{
+		if (request)
+			FinishRequest(request);
+	}
+
+	void TextureStreamer::Update()
+	{
+		VS_PROFILE_FUNCTION();
+
+		if (!s_StreamerData.Initialized)
+			return;
+
+		uint32_t uploaded = 0;
+		while (!s_StreamerData.Uploads.empty() && uploaded < s_StreamerData.UploadBudget)
+		{
+			Ref<TextureStreamRequest> request = s_StreamerData.Uploads.front();
+			if (request->Finished)
+			{
+				s_StreamerData.Uploads.pop_front();
+				continue;
+			}
+
+			Texture2D* texture = request->Texture;
+
+			// Cooked levels go up in rows of blocks, into storage that replaces the placeholder once every level is in
+			if (const TextureCache::Reader* cooked = request->Cooked.get())
+			{
+				uint32_t levelCount = texture->GetProperties().GenerateMipmaps ? cooked->GetLevelCount() : 1;
+				if (request->NextLevel == 0 && request->NextRow == 0)
+					texture->BeginCompressedData(cooked->GetCompression(), cooked->GetWidth(), cooked->GetHeight(), levelCount);
+
+				uint32_t levelWidth = std::max(cooked->GetWidth() >> request->NextLevel, 1u);
+				uint32_t levelHeight = std::max(cooked->GetHeight() >> request->NextLevel, 1u);
+				uint32_t blockRowSize = (uint32_t)TextureCompressor::GetCompressedSize(cooked->GetCompression(), levelWidth, 4);
+				uint32_t budgetBlockRows = (s_StreamerData.UploadBudget - uploaded) / blockRowSize;
+				if (budgetBlockRows == 0 && uploaded > 0)
+					break;
+
+				uint32_t blockRow = request->NextRow / 4;
+				uint32_t remainingBlockRows = (levelHeight + 3) / 4 - blockRow;
+				uint32_t blockRows = std::min(remainingBlockRows, std::max(budgetBlockRows, 1u));
+				uint32_t rows = std::min(blockRows * 4, levelHeight - request->NextRow);
+
+				const uint8_t* data = cooked->GetLevelData(request->NextLevel) + (uint64_t)blockRow * blockRowSize;
+				uint32_t offset = s_StreamerData.UploadBuffer->Push(data, blockRows * blockRowSize, s_RowAlignment);
+				texture->SetCompressedData(s_StreamerData.UploadBuffer, offset, request->NextLevel, request->NextRow, rows);
+
+				request->NextRow += rows;
+				uploaded += blockRows * blockRowSize;
+
+				if (request->NextRow == levelHeight)
+				{
+					request->NextLevel++;
+					request->NextRow = 0;
+				}
+
+				if (request->NextLevel == levelCount)
+				{
+					texture->EndCompressedData();
+					FinishRequest(request);
+					s_StreamerData.Uploads.pop_front();
+				}
+				continue;
+			}
+
+			const Image* image = request->Decoded.get();
+
+			// Decode failed or the file changed since the storage was created, the placeholder stays
+			if (!image || image->GetWidth() != texture->GetWidth() || image->GetHeight() != texture->GetHeight())
+			{
+				CORE_LOG_ERROR("Could not stream texture: {0}", request->Path);
+				FinishRequest(request);
+				s_StreamerData.Uploads.pop_front();
+				continue;
+			}
+
+			// Large textures are split across frames, at least one row goes up every frame
+			uint32_t rowSize = image->GetRowSize();
+			uint32_t budgetRows = (s_StreamerData.UploadBudget - uploaded) / rowSize;
+			if (budgetRows == 0 && uploaded > 0)
+				break;
+
+			uint32_t remainingRows = image->GetHeight() - request->NextRow;
+			uint32_t rows = std::min(remainingRows, std::max(budgetRows, 1u));
+
+			const uint8_t* data = image->GetData() + (uint64_t)request->NextRow * rowSize;
+			uint32_t offset = s_StreamerData.UploadBuffer->Push(data, rows * rowSize, s_RowAlignment);
+			texture->SetData(s_StreamerData.UploadBuffer, offset, request->NextRow, rows);
+
+			request->NextRow += rows;
+			uploaded += rows * rowSize;
+
+			if (request->NextRow == image->GetHeight())
+			{
+				if (texture->GetProperties().GenerateMipmaps)
+					texture->GenerateMips();
+
+				FinishRequest(request);
+				s_StreamerData.Uploads.pop_front();
+			}
+		}
+
+		// Fences this frame's copies before the region is written again
+		if (uploaded > 0)
+			s_StreamerData.UploadBuffer->NextFrame();
+	}
+
+	uint32_t TextureStreamer::GetPendingCount()
+	{
+		return s_StreamerData.PendingCount;
+	}
+
+}
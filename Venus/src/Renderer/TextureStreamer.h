@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Renderer/Texture.h"
+
+namespace Venus {
+
+	struct TextureStreamRequest;
+
+	// Decodes textures on job system workers and uploads them through a pixel buffer ring, a few rows at a time.
+	// Cached requests use the cooked block compressed copy when it is current, and cook one from the decoded pixels when not
+	class TextureStreamer
+	{
+		public:
+			static void Init(uint32_t uploadBudget = 8 * 1024 * 1024);
+			static void Shutdown();
+			static bool IsInitialized();
+
+			// Once a frame on the main thread, copies at most the upload budget into pending textures
+			static void Update();
+
+			// The texture must already own storage matching the file, it keeps it until the upload finished
+			static Ref<TextureStreamRequest> Request(Texture2D* texture, const std::string& path, bool flipVertically, bool cached = false, TextureUsage usage = TextureUsage::Color);
+
+			// Called before the texture is destroyed or reloaded
+			static void Cancel(const Ref<TextureStreamRequest>& request);
+
+			static uint32_t GetPendingCount();
+	};
+
+}
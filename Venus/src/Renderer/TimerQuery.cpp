@@ -0,0 +1,22 @@
+#include "pch.h"
+#include "TimerQuery.h"
+
+#include "Renderer/Renderer.h"
+#include "Renderer/OpenGL/OpenGLTimerQuery.h"
+#include "Renderer/Null/NullTimerQuery.h"
+
+namespace Venus {
+
+	Ref<TimerQueryPool> TimerQueryPool::Create(uint32_t capacity)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    return CreateRef<NullTimerQueryPool>(capacity);
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTimerQueryPool>(capacity);
+		}
+
+		VS_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Engine/Base.h"
+
+namespace Venus {
+
+	// GPU timestamps written in command order, in nanoseconds of the GPU clock
+	class TimerQueryPool
+	{
+		public:
+			virtual ~TimerQueryPool() {}
+
+			virtual void WriteTimestamp(uint32_t index) = 0;
+			// Never waits, false while any of the queries is still in flight
+			virtual bool GetTimestamps(uint32_t first, uint32_t count, uint64_t* timestamps) = 0;
+			// Time the GPU reached the commands issued so far
+			virtual uint64_t GetCurrentTimestamp() = 0;
+
+			virtual uint32_t GetCapacity() const = 0;
+
+			static Ref<TimerQueryPool> Create(uint32_t capacity);
+	};
+
+}
@@ -9,6 +9,9 @@ namespace Venus {
 		public:
 			virtual ~UniformBuffer() {}
 			virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+			virtual void Bind() = 0;
+			// Binds part of the buffer, offsets must follow the uniform buffer offset alignment
+			virtual void BindRange(uint32_t offset, uint32_t size) = 0;
 		
 			static Ref<UniformBuffer> Create(uint32_t size, uint32_t binding);
 	};
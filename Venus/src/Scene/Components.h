@@ -101,6 +101,34 @@ namespace Venus {
 
 			return glm::translate(glm::mat4(1.0f), Position) * rotation * glm::scale(glm::mat4(1.0f), Scale);
 		}
+
+		bool operator==(const TransformComponent& other) const
+		{
+			return Position == other.Position && Rotation == other.Rotation && Scale == other.Scale;
+		}
+
+		bool operator!=(const TransformComponent& other) const
+		{
+			return !(*this == other);
+		}
+	};
+
+	// Runtime Only, filled by Scene::UpdateWorldTransforms
+	struct WorldTransformComponent
+	{
+		glm::mat4 Local = glm::mat4(1.0f);
+		glm::mat4 World = glm::mat4(1.0f);
+
+		// Inputs used to build the cached matrices, compared every frame to detect changes
+		TransformComponent CachedTransform;
+		UUID CachedParent = 0;
+
+		bool Dirty = true;
+		// Already waiting in the scene's mesh bounds queue
+		bool BoundsQueued = false;
+
+		WorldTransformComponent() = default;
+		WorldTransformComponent(const WorldTransformComponent&) = default;
 	};
 
 	struct SpriteRendererComponent
@@ -68,7 +68,11 @@ namespace Venus {
 
 
 			//-- Relationship Functions----------------------------------------------------------------------------------
-			void SetParentUUID(UUID parent) { GetComponent<RelationshipComponent>().Parent = parent; }
+			void SetParentUUID(UUID parent)
+			{
+				GetComponent<RelationshipComponent>().Parent = parent;
+				m_Scene->MarkTransformHierarchyDirty();
+			}
 			UUID GetParentUUID() const { return GetComponent<RelationshipComponent>().Parent; }
 			std::vector<UUID>& GetChildren() { return GetComponent<RelationshipComponent>().Children; }
 
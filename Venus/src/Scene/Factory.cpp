@@ -84,6 +84,7 @@ namespace Venus {
 		Ref<Model> cube = CreateRef<Model>();
 		cube->GetMaterialTable()->SetMaterial(0, material);
 		cube->m_Meshes.push_back(mesh);
+		cube->CalculateBoundingBox();
 		
 		return cube;
 	}
@@ -137,6 +138,7 @@ namespace Venus {
 		Ref<Model> sphere = CreateRef<Model>();
 		sphere->GetMaterialTable()->SetMaterial(0, material);
 		sphere->m_Meshes.push_back(mesh);
+		sphere->CalculateBoundingBox();
 
 		return sphere;
 	}
@@ -35,10 +35,14 @@ namespace Venus {
 
 	Scene::Scene()
 	{
+		m_Registry.on_construct<MeshRendererComponent>().connect<&Scene::OnMeshRendererConstructed>(*this);
+		m_Registry.on_destroy<MeshRendererComponent>().connect<&Scene::OnMeshRendererDestroyed>(*this);
 	}
 
 	Scene::~Scene()
 	{
+		m_Registry.on_construct<MeshRendererComponent>().disconnect(*this);
+		m_Registry.on_destroy<MeshRendererComponent>().disconnect(*this);
 	}
 
 	template<typename Component>
@@ -288,6 +292,9 @@ namespace Venus {
 
 		entity.AddComponent<TransformComponent>();
 		entity.AddComponent<RelationshipComponent>();
+		entity.AddComponent<WorldTransformComponent>();
+
+		m_TransformHierarchyDirty = true;
 
 		VS_CORE_ASSERT(m_EntityMap.find(idComponent.ID) == m_EntityMap.end(), "Duplicated Entity ID in map!");
 		m_EntityMap[idComponent.ID] = entity;
@@ -429,6 +436,7 @@ namespace Venus {
 		}
 
 		m_Registry.destroy(entity);
+		m_TransformHierarchyDirty = true;
 	}
 
 	void Scene::SubmitToDestroyEntity(Entity entity)
@@ -438,6 +446,8 @@ namespace Venus {
 
 	void Scene::OnUpdateEditor(Ref<SceneRenderer> renderer, Timestep ts, EditorCamera& camera)
 	{
+		UpdateWorldTransforms();
+
 		/////////////////////////////////////////////////////////////////////////////
 		// LIGHTS ///////////////////////////////////////////////////////////////////
 		/////////////////////////////////////////////////////////////////////////////
@@ -466,17 +476,16 @@ namespace Venus {
 			
 			// Point Lights
 			{
-				auto pointLights = m_Registry.view<TransformComponent, PointLightComponent>();
+				auto pointLights = m_Registry.view<WorldTransformComponent, PointLightComponent>();
 				m_LightEnvironment.PointLights.resize(pointLights.size());
 				uint32_t index = 0;
 
 				for (auto entity : pointLights)
 				{
-					auto [transformComponent, lightComponent] = pointLights.get<TransformComponent, PointLightComponent>(entity);
-					auto transform = GetWorldSpaceTransform(Entity(entity, this));
+					auto [worldTransform, lightComponent] = pointLights.get<WorldTransformComponent, PointLightComponent>(entity);
 					m_LightEnvironment.PointLights[index++] =
 					{
-						transform.Position,
+						glm::vec3(worldTransform.World[3]),
 						lightComponent.Intensity,
 						lightComponent.Color,
 						lightComponent.MinRadius,
@@ -518,31 +527,7 @@ namespace Venus {
 		/////////////////////////////////////////////////////////////////////////////
 	
 		// Models
-		{
-			auto view = m_Registry.view<TransformComponent, MeshRendererComponent>();
-			for (auto entity : view)
-			{
-				auto& meshComponent = view.get<MeshRendererComponent>(entity);
-				auto& materialTable = meshComponent.MaterialTable;
-
-				glm::mat4 worldSpaceTransform = GetWorldSpaceTransformMatrix({ entity, this });
-
-				if (AssetManager::IsAssetHandleValid(meshComponent.Model))
-				{
-					auto model = AssetManager::GetAsset<Model>(meshComponent.Model);
-					if (!model->IsFlagSet(AssetFlag::Missing))
-					{
-						if (materialTable->GetMaterialCount() != model->GetMaterialTable()->GetMaterialCount())
-							materialTable->SetMaterialCount(model->GetMaterialTable()->GetMaterialCount());
-
-						if (m_EditorSelectedEntity == (uint32_t)entity)
-							renderer->SubmitSelectedModel(model, materialTable, worldSpaceTransform, (int)entity);
-						else
-							renderer->SubmitModel(model, materialTable, worldSpaceTransform, (int)entity);
-					}
-				}
-			}
-		}
+		SubmitMeshes(renderer, camera.GetViewProjection(), true);
 		
 		/////////////////////////////////////////////////////////////////////////////
 		// 2D ///////////////////////////////////////////////////////////////////////
@@ -550,35 +535,40 @@ namespace Venus {
 
 		// Quads
 		{
-			auto view = m_Registry.view<TransformComponent, SpriteRendererComponent>();
+			auto view = m_Registry.view<WorldTransformComponent, SpriteRendererComponent>();
 			for (auto entity : view)
 			{
-				auto sprite = view.get<SpriteRendererComponent>(entity);
-				auto transform = GetWorldSpaceTransformMatrix({ entity, this });
+				auto& sprite = view.get<SpriteRendererComponent>(entity);
+				const glm::mat4& transform = view.get<WorldTransformComponent>(entity).World;
 
 				Ref<Texture2D> texture = nullptr;
-				AssetMetadata texMetadata = AssetManager::GetMetadata(sprite.Texture);
-				if (texMetadata.IsValid())
+				Ref<Sampler> sampler = nullptr;
+				bool flipVertically = false;
+				if (AssetManager::IsAssetHandleRegistered(sprite.Texture))
 				{
 					texture = AssetManager::GetAsset<Texture2D>(sprite.Texture);
 
+					// Sprite settings never touch the shared texture, filter and wrap come from a sampler
 					if (texture->IsFlagSet(AssetFlag::Invalid))
 						texture = nullptr;
-					else if (sprite.TextureProperties != texture->GetProperties())
-						texture->SetProperties(sprite.TextureProperties, true);
+					else
+					{
+						sampler = Renderer::GetSampler(sprite.TextureProperties);
+						flipVertically = sprite.TextureProperties.FlipVertically != texture->GetProperties().FlipVertically;
+					}
 				}
 
-				renderer->SubmitQuad(transform, texture, sprite.TilingFactor, sprite.Color, (int)entity);
+				renderer->SubmitQuad(transform, texture, sprite.TilingFactor, sprite.Color, (int)entity, sampler, flipVertically);
 			}
 		}
 
 		// Circles
 		{
-			auto view = m_Registry.view<TransformComponent, CircleRendererComponent>();
+			auto view = m_Registry.view<WorldTransformComponent, CircleRendererComponent>();
 			for (auto entity : view)
 			{
 				auto circle = view.get<CircleRendererComponent>(entity);
-				auto transform = GetWorldSpaceTransformMatrix({ entity, this });
+				const glm::mat4& transform = view.get<WorldTransformComponent>(entity).World;
 
 				renderer->SubmitCircle(transform, circle.Color, circle.Thickness, circle.Fade, (int)entity);
 			}
@@ -638,6 +628,7 @@ namespace Venus {
 			m_PostUpdateQueue.clear();
 		}
 
+		UpdateWorldTransforms();
 	
 		/////////////////////////////////////////////////////////////////////////////
 		// LIGHTS ///////////////////////////////////////////////////////////////////
@@ -667,17 +658,16 @@ namespace Venus {
 
 			// Point Lights
 			{
-				auto pointLights = m_Registry.view<TransformComponent, PointLightComponent>();
+				auto pointLights = m_Registry.view<WorldTransformComponent, PointLightComponent>();
 				m_LightEnvironment.PointLights.resize(pointLights.size());
 				uint32_t index = 0;
 
 				for (auto entity : pointLights)
 				{
-					auto [transformComponent, lightComponent] = pointLights.get<TransformComponent, PointLightComponent>(entity);
-					auto transform = GetWorldSpaceTransform(Entity(entity, this));
+					auto [worldTransform, lightComponent] = pointLights.get<WorldTransformComponent, PointLightComponent>(entity);
 					m_LightEnvironment.PointLights[index++] =
 					{
-						transform.Position,
+						glm::vec3(worldTransform.World[3]),
 						lightComponent.Intensity,
 						lightComponent.Color,
 						lightComponent.MinRadius,
@@ -738,28 +728,7 @@ namespace Venus {
 			/////////////////////////////////////////////////////////////////////////////
 
 			// Models
-			{
-				auto view = m_Registry.view<TransformComponent, MeshRendererComponent>();
-				for (auto entity : view)
-				{
-					auto& meshComponent = view.get<MeshRendererComponent>(entity);
-					auto& materialTable = meshComponent.MaterialTable;
-
-					glm::mat4 worldSpaceTransform = GetWorldSpaceTransformMatrix({ entity, this });
-
-					if (AssetManager::IsAssetHandleValid(meshComponent.Model))
-					{
-						auto model = AssetManager::GetAsset<Model>(meshComponent.Model);
-						if (!model->IsFlagSet(AssetFlag::Missing))
-						{
-							if (materialTable->GetMaterialCount() != model->GetMaterialTable()->GetMaterialCount())
-								materialTable->SetMaterialCount(model->GetMaterialTable()->GetMaterialCount());
-
-							renderer->SubmitModel(model, materialTable, worldSpaceTransform, (int)entity);
-						}
-					}
-				}
-			}
+			SubmitMeshes(renderer, mainCamera->Camera.GetProjectionMatrix() * glm::inverse(cameraTransform), false);
 			
 			/////////////////////////////////////////////////////////////////////////////
 			// 2D ///////////////////////////////////////////////////////////////////////
@@ -767,35 +736,40 @@ namespace Venus {
 
 			// Quads
 			{
-				auto view = m_Registry.view<TransformComponent, SpriteRendererComponent>();
+				auto view = m_Registry.view<WorldTransformComponent, SpriteRendererComponent>();
 				for (auto entity : view)
 				{
-					auto sprite = view.get<SpriteRendererComponent>(entity);
-					auto transform = GetWorldSpaceTransformMatrix({ entity, this });
+					auto& sprite = view.get<SpriteRendererComponent>(entity);
+					const glm::mat4& transform = view.get<WorldTransformComponent>(entity).World;
 
 					Ref<Texture2D> texture = nullptr;
-					AssetMetadata texMetadata = AssetManager::GetMetadata(sprite.Texture);
-					if (texMetadata.IsValid())
+					Ref<Sampler> sampler = nullptr;
+					bool flipVertically = false;
+					if (AssetManager::IsAssetHandleRegistered(sprite.Texture))
 					{
 						texture = AssetManager::GetAsset<Texture2D>(sprite.Texture);
 
+						// Sprite settings never touch the shared texture, filter and wrap come from a sampler
 						if (texture->IsFlagSet(AssetFlag::Invalid))
 							texture = nullptr;
-						else if (sprite.TextureProperties != texture->GetProperties())
-							texture->SetProperties(sprite.TextureProperties, true);
+						else
+						{
+							sampler = Renderer::GetSampler(sprite.TextureProperties);
+							flipVertically = sprite.TextureProperties.FlipVertically != texture->GetProperties().FlipVertically;
+						}
 					}
 
-					renderer->SubmitQuad(transform, texture, sprite.TilingFactor, sprite.Color, (int)entity);
+					renderer->SubmitQuad(transform, texture, sprite.TilingFactor, sprite.Color, (int)entity, sampler, flipVertically);
 				}
 			}
 
 			// Circles
 			{
-				auto view = m_Registry.view<TransformComponent, CircleRendererComponent>();
+				auto view = m_Registry.view<WorldTransformComponent, CircleRendererComponent>();
 				for (auto entity : view)
 				{
 					auto circle = view.get<CircleRendererComponent>(entity);
-					auto transform = GetWorldSpaceTransformMatrix({ entity, this });
+					const glm::mat4& transform = view.get<WorldTransformComponent>(entity).World;
 
 					renderer->SubmitCircle(transform, circle.Color, circle.Thickness, circle.Fade, (int)entity);
 				}
@@ -893,6 +867,254 @@ namespace Venus {
 		return transform * entity.GetComponent<TransformComponent>().GetTransform();
 	}
 
+	const glm::mat4& Scene::GetCachedWorldTransformMatrix(Entity entity)
+	{
+		return entity.GetComponent<WorldTransformComponent>().World;
+	}
+
+	void Scene::RebuildTransformHierarchy()
+	{
+		VS_PROFILE_FUNCTION();
+
+		m_TransformHierarchy.clear();
+
+		// Roots first
+		auto view = m_Registry.view<RelationshipComponent, WorldTransformComponent>();
+		for (auto e : view)
+		{
+			auto [relationship, worldTransform] = view.get<RelationshipComponent, WorldTransformComponent>(e);
+
+			Entity parent = TryGetEntityWithUUID(relationship.Parent);
+			if (!parent || !m_Registry.valid(parent))
+			{
+				m_TransformHierarchy.push_back({ e, entt::null });
+			}
+			else
+			{
+				// Parent links are authoritative, children lists missing them (older or hand edited scenes) are repaired
+				auto& siblings = m_Registry.get<RelationshipComponent>(parent).Children;
+				UUID id = m_Registry.get<IDComponent>(e).ID;
+				if (std::find(siblings.begin(), siblings.end(), id) == siblings.end())
+				{
+					CORE_LOG_WARN("Entity {0} was missing from its parent's children, repaired", (uint64_t)id);
+					siblings.push_back(id);
+				}
+			}
+
+			worldTransform.CachedParent = relationship.Parent;
+			worldTransform.Dirty = true;
+		}
+
+		// Then each level of children, so a parent is always resolved before them
+		for (size_t i = 0; i < m_TransformHierarchy.size(); i++)
+		{
+			entt::entity parent = m_TransformHierarchy[i].Entity;
+			UUID parentID = m_Registry.get<IDComponent>(parent).ID;
+			auto& children = m_Registry.get<RelationshipComponent>(parent).Children;
+
+			// Children that were deleted or reparented elsewhere are dropped
+			auto stale = std::remove_if(children.begin(), children.end(), [&](UUID childID)
+			{
+				Entity child = TryGetEntityWithUUID(childID);
+				return !child || !m_Registry.valid(child) || m_Registry.get<RelationshipComponent>(child).Parent != parentID;
+			});
+			children.erase(stale, children.end());
+
+			for (UUID childID : children)
+				m_TransformHierarchy.push_back({ TryGetEntityWithUUID(childID), parent });
+		}
+
+		m_TransformHierarchyDirty = false;
+	}
+
+	void Scene::UpdateWorldTransforms()
+	{
+		VS_PROFILE_FUNCTION();
+
+		if (m_TransformHierarchyDirty)
+			RebuildTransformHierarchy();
+
+		for (const auto& node : m_TransformHierarchy)
+		{
+			auto& transform = m_Registry.get<TransformComponent>(node.Entity);
+			auto& relationship = m_Registry.get<RelationshipComponent>(node.Entity);
+			auto& worldTransform = m_Registry.get<WorldTransformComponent>(node.Entity);
+
+			// Relationship changed without going through the scene, order is no longer valid
+			if (relationship.Parent != worldTransform.CachedParent)
+			{
+				RebuildTransformHierarchy();
+				UpdateWorldTransforms();
+				return;
+			}
+
+			if (worldTransform.Dirty || transform != worldTransform.CachedTransform)
+			{
+				worldTransform.Local = transform.GetTransform();
+				worldTransform.CachedTransform = transform;
+				worldTransform.Dirty = true;
+			}
+
+			// Subtree of a changed parent needs its world matrix rebuilt too
+			const WorldTransformComponent* parentTransform = nullptr;
+			if (node.Parent != entt::null)
+			{
+				parentTransform = &m_Registry.get<WorldTransformComponent>(node.Parent);
+				if (parentTransform->Dirty)
+					worldTransform.Dirty = true;
+			}
+
+			if (worldTransform.Dirty)
+			{
+				worldTransform.World = parentTransform ? parentTransform->World * worldTransform.Local : worldTransform.Local;
+				QueueMeshBounds(node.Entity);
+			}
+		}
+
+		// Dirty flags are only cleared once every child has seen them
+		auto view = m_Registry.view<WorldTransformComponent>();
+		for (auto e : view)
+			view.get<WorldTransformComponent>(e).Dirty = false;
+
+		// Drained here rather than on submit, scenes without a camera never submit
+		UpdateMeshBounds();
+	}
+
+	void Scene::MarkMeshBoundsDirty(Entity entity)
+	{
+		QueueMeshBounds(entity);
+	}
+
+	void Scene::QueueMeshBounds(entt::entity entity)
+	{
+		if (!m_Registry.valid(entity) || !m_Registry.has<WorldTransformComponent>(entity))
+			return;
+
+		auto& worldTransform = m_Registry.get<WorldTransformComponent>(entity);
+		if (worldTransform.BoundsQueued)
+			return;
+
+		worldTransform.BoundsQueued = true;
+		m_MeshBoundsDirty.push_back(entity);
+	}
+
+	void Scene::UpdateMeshBounds()
+	{
+		VS_PROFILE_FUNCTION();
+
+		// Meshes without usable bounds lose their proxy and stay out until their model is flagged again
+		for (entt::entity entity : m_MeshBoundsDirty)
+		{
+			if (!m_Registry.valid(entity))
+				continue;
+
+			m_Registry.get<WorldTransformComponent>(entity).BoundsQueued = false;
+			if (m_Registry.has<MeshRendererComponent>(entity))
+				UpdateMeshProxy(entity);
+		}
+
+		m_MeshBoundsDirty.clear();
+	}
+
+	bool Scene::UpdateMeshProxy(entt::entity entity)
+	{
+		const auto& meshComponent = m_Registry.get<MeshRendererComponent>(entity);
+
+		Ref<Model> model = AssetManager::IsAssetHandleValid(meshComponent.Model) ? AssetManager::GetAsset<Model>(meshComponent.Model) : nullptr;
+		if (!model || model->IsFlagSet(AssetFlag::Missing) || !model->GetBoundingBox().IsValid())
+		{
+			DestroyMeshProxy(entity);
+			return false;
+		}
+
+		const glm::mat4& worldSpaceTransform = m_Registry.get<WorldTransformComponent>(entity).World;
+
+		MeshProxy& proxy = m_MeshProxies[entity];
+		if (proxy.ProxyID == DynamicAABBTree::NullNode)
+			proxy.ProxyID = m_MeshTree.CreateProxy(model->GetBoundingBox().Transform(worldSpaceTransform), (uint32_t)entity);
+		else if (proxy.Model != meshComponent.Model || proxy.Transform != worldSpaceTransform)
+			m_MeshTree.MoveProxy(proxy.ProxyID, model->GetBoundingBox().Transform(worldSpaceTransform));
+
+		proxy.Model = meshComponent.Model;
+		proxy.Transform = worldSpaceTransform;
+		return true;
+	}
+
+	void Scene::DestroyMeshProxy(entt::entity entity)
+	{
+		auto it = m_MeshProxies.find(entity);
+		if (it == m_MeshProxies.end())
+			return;
+
+		m_MeshTree.DestroyProxy(it->second.ProxyID);
+		m_MeshProxies.erase(it);
+	}
+
+	void Scene::OnMeshRendererConstructed(entt::registry& registry, entt::entity entity)
+	{
+		QueueMeshBounds(entity);
+	}
+
+	void Scene::OnMeshRendererDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		DestroyMeshProxy(entity);
+	}
+
+	void Scene::SubmitMeshes(Ref<SceneRenderer> renderer, const glm::mat4& viewProjection, bool highlightSelected)
+	{
+		VS_PROFILE_FUNCTION();
+
+		m_CullingFrame++;
+		m_VisibleMeshes.clear();
+
+		Frustum frustum(viewProjection);
+		m_MeshTree.Query(frustum, [this](uint32_t userData)
+		{
+			entt::entity entity = (entt::entity)userData;
+			m_MeshProxies.at(entity).VisibleFrame = m_CullingFrame;
+			m_VisibleMeshes.push_back(entity);
+		});
+
+		auto submit = [&](entt::entity entity, bool visible)
+		{
+			// Model swapped without MarkMeshBoundsDirty, skipped until its proxy is refit on the next update
+			auto& meshComponent = m_Registry.get<MeshRendererComponent>(entity);
+			if (meshComponent.Model != m_MeshProxies.at(entity).Model)
+			{
+				QueueMeshBounds(entity);
+				return;
+			}
+
+			auto& materialTable = meshComponent.MaterialTable;
+			auto model = AssetManager::GetAsset<Model>(meshComponent.Model);
+
+			if (materialTable->GetMaterialCount() != model->GetMaterialTable()->GetMaterialCount())
+				materialTable->SetMaterialCount(model->GetMaterialTable()->GetMaterialCount());
+
+			const glm::mat4& worldSpaceTransform = m_Registry.get<WorldTransformComponent>(entity).World;
+
+			if (!visible)
+				renderer->SubmitShadowCaster(model, materialTable, worldSpaceTransform, (int)entity);
+			else if (highlightSelected && m_EditorSelectedEntity == (uint32_t)entity)
+				renderer->SubmitSelectedModel(model, materialTable, worldSpaceTransform, (int)entity);
+			else
+				renderer->SubmitModel(model, materialTable, worldSpaceTransform, (int)entity);
+		};
+
+		for (entt::entity entity : m_VisibleMeshes)
+			submit(entity, true);
+
+		// Culled meshes still go to the shadow pass, they may cast into the view
+		if (m_LightEnvironment.HasDirLight && m_LightEnvironment.CastsShadows)
+		{
+			for (const auto& [entity, proxy] : m_MeshProxies)
+			{
+				if (proxy.VisibleFrame != m_CullingFrame)
+					submit(entity, false);
+			}
+		}
+	}
+
 	void Scene::ConvertToLocalSpace(Entity entity)
 	{
 		Entity parent = TryGetEntityWithUUID(entity.GetParentUUID());
@@ -945,6 +1167,11 @@ namespace Venus {
 	{
 	}
 
+	template<>
+	void Scene::OnComponentAdded<WorldTransformComponent>(Entity entity, WorldTransformComponent& component)
+	{
+	}
+
 	template<>
 	void Scene::OnComponentAdded<SpriteRendererComponent>(Entity entity, SpriteRendererComponent& component)
 	{
@@ -6,6 +6,7 @@
 #include "Engine/UUID.h"
 #include "Engine/Timestep.h"
 #include "Renderer/EditorCamera.h"
+#include "Math/DynamicAABBTree.h"
 #include "SceneCamera.h"
 
 #include "entt.hpp"
@@ -103,6 +104,11 @@ namespace Venus {
 			glm::vec3 GetWorldSpacePosition(Entity entity);
 			TransformComponent GetWorldSpaceTransform(Entity entity);
 			glm::mat4 GetWorldSpaceTransformMatrix(Entity entity);
+			const glm::mat4& GetCachedWorldTransformMatrix(Entity entity);
+			void UpdateWorldTransforms();
+			void MarkTransformHierarchyDirty() { m_TransformHierarchyDirty = true; }
+			// Culling bounds follow transform changes on their own, a new model has to be flagged
+			void MarkMeshBoundsDirty(Entity entity);
 			void ConvertToLocalSpace(Entity entity);
 			void ConvertToWorldSpace(Entity entity);
 
@@ -122,6 +128,16 @@ namespace Venus {
 				m_PostUpdateQueue.emplace_back(fn);
 			}
 
+			void RebuildTransformHierarchy();
+
+			void QueueMeshBounds(entt::entity entity);
+			void UpdateMeshBounds();
+			bool UpdateMeshProxy(entt::entity entity);
+			void DestroyMeshProxy(entt::entity entity);
+			void OnMeshRendererConstructed(entt::registry& registry, entt::entity entity);
+			void OnMeshRendererDestroyed(entt::registry& registry, entt::entity entity);
+			void SubmitMeshes(Ref<SceneRenderer> renderer, const glm::mat4& viewProjection, bool highlightSelected);
+
 		private:
 			std::string m_SceneName = "Untitled Scene";
 			uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
@@ -132,6 +148,31 @@ namespace Venus {
 			uint32_t m_EditorSelectedEntity = -1;
 			std::unordered_map<UUID, Entity> m_EntityMap;
 
+			// World Transforms, parents always come before their children
+			struct TransformHierarchyNode
+			{
+				entt::entity Entity = entt::null;
+				entt::entity Parent = entt::null;
+			};
+			std::vector<TransformHierarchyNode> m_TransformHierarchy;
+			bool m_TransformHierarchyDirty = true;
+
+			// Mesh culling, one tree proxy per MeshRenderer with a loaded model
+			struct MeshProxy
+			{
+				int32_t ProxyID = DynamicAABBTree::NullNode;
+				AssetHandle Model = 0;
+				glm::mat4 Transform = glm::mat4(1.0f);
+				uint64_t VisibleFrame = 0;
+			};
+			std::unordered_map<entt::entity, MeshProxy> m_MeshProxies;
+			DynamicAABBTree m_MeshTree;
+			uint64_t m_CullingFrame = 0;
+
+			// Changed world transforms, new mesh renderers and swapped models, refit at the end of UpdateWorldTransforms. Each entity once
+			std::vector<entt::entity> m_MeshBoundsDirty;
+			std::vector<entt::entity> m_VisibleMeshes;
+
 			LightEnvironment m_LightEnvironment;
 
 			// Scripting
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string_view>
+
+namespace Venus {
+
+	class Hash
+	{
+		public:
+			// 32 bit FNV-1a, constexpr so ids can be computed at compile time
+			static constexpr uint32_t GenerateFNVHash(std::string_view str)
+			{
+				constexpr uint32_t FNV_PRIME = 16777619u;
+				constexpr uint32_t OFFSET_BASIS = 2166136261u;
+
+				uint32_t hash = OFFSET_BASIS;
+				for (char c : str)
+				{
+					hash ^= (uint8_t)c;
+					hash *= FNV_PRIME;
+				}
+
+				return hash;
+			}
+
+			// 64 bit FNV-1a over raw bytes, used for file content keys
+			static uint64_t GenerateFNVHash64(const void* data, uint64_t size)
+			{
+				constexpr uint64_t FNV_PRIME = 1099511628211ull;
+				constexpr uint64_t OFFSET_BASIS = 14695981039346656037ull;
+
+				const uint8_t* bytes = (const uint8_t*)data;
+				uint64_t hash = OFFSET_BASIS;
+				for (uint64_t i = 0; i < size; i++)
+				{
+					hash ^= bytes[i];
+					hash *= FNV_PRIME;
+				}
+
+				return hash;
+			}
+	};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <filesystem>
 
 namespace Venus {
 
@@ -12,4 +13,26 @@ namespace Venus {
 			static void Open(const char* path);
 	};
 
+	// Read only mapping of a whole file, unmapped when destroyed
+	class MappedFile
+	{
+		public:
+			MappedFile(const std::filesystem::path& path);
+			~MappedFile();
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			bool IsValid() const { return m_Data != nullptr; }
+			const uint8_t* GetData() const { return m_Data; }
+			uint64_t GetSize() const { return m_Size; }
+
+		private:
+			const uint8_t* m_Data = nullptr;
+			uint64_t m_Size = 0;
+
+			void* m_FileHandle = nullptr;
+			void* m_MappingHandle = nullptr;
+	};
+
 }
\ No newline at end of file
@@ -10,8 +10,12 @@
 #include "Engine/KeyCodes.h"
 #include "Engine/MouseCodes.h"
 #include "Engine/Input.h"
+#include "Engine/JobSystem.h"
 #include "ImGui/ImGuiLayer.h"
 
+// Debug
+#include "Debug/FrameProfiler.h"
+
 // Asset
 #include "Assets/Asset.h"
 #include "Assets/AssetExtensions.h"
@@ -36,6 +40,7 @@
 #include "Renderer/Renderer.h"
 #include "Renderer/Renderer2D.h"
 #include "Renderer/SceneRenderer.h"
+#include "Renderer/GPUProfiler.h"
 #include "Renderer/RenderCommand.h"
 #include "Renderer/Buffer.h"
 #include "Renderer/Shader.h"
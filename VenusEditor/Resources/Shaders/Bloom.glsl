@@ -1,24 +1,25 @@
 #type compute
 #version 450 core
 
-layout(binding = 0, rgba32f) restrict writeonly uniform image2D o_Image;
+// No format qualifier, stores follow the bound texture format (RGBA16F, R11G11B10F or RGBA32F)
+layout(binding = 0) restrict writeonly uniform image2D o_Image;
 
 const float Epsilon = 1.0e-4;
 
 layout(binding = 1) uniform sampler2D u_Texture;
 layout(binding = 2) uniform sampler2D u_BloomTexture;
 
-layout(push_constant) uniform Uniforms
+// One block per dispatch, bound as a range of a buffer uploaded once per frame
+layout(std140, binding = 4) uniform Uniforms
 {
     vec4 Params; // (x) threshold, (y) threshold - knee, (z) knee * 2, (w) 0.25 / knee
-    float LOD;
+    float LOD; // Level read from u_Texture, the written level is LOD + 1 while downsampling
     int Mode; // See defines below
 } u_Uniforms;
 
 #define MODE_PREFILTER      0
 #define MODE_DOWNSAMPLE     1
-#define MODE_UPSAMPLE_FIRST 2
-#define MODE_UPSAMPLE       3
+#define MODE_UPSAMPLE       2
 
 vec3 DownsampleBox13(sampler2D tex, float lod, vec2 uv, vec2 texelSize)
 {
@@ -104,34 +105,33 @@ vec3 UpsampleTent9(sampler2D tex, float lod, vec2 uv, vec2 texelSize, float radi
     return result * (1.0f / 16.0f);
 }
 
-layout(local_size_x = 4, local_size_y = 4) in;
+layout(local_size_x = 8, local_size_y = 8) in;
 void main()
 {
-    vec2 imgSize = vec2(imageSize(o_Image));
-
     ivec2 invocID = ivec2(gl_GlobalInvocationID);
-    vec2 texCoords = vec2(float(invocID.x) / imgSize.x, float(invocID.y) / imgSize.y);
-    texCoords += (1.0f / imgSize) * 0.5f;
+    ivec2 imgSize = imageSize(o_Image);
+    if (invocID.x >= imgSize.x || invocID.y >= imgSize.y)
+        return;
+
+    vec2 texCoords = (vec2(invocID) + 0.5f) / vec2(imgSize);
 
-    vec2 texSize = vec2(textureSize(u_Texture, int(u_Uniforms.LOD)));
     vec4 color = vec4(1, 0, 1, 1);
     if (u_Uniforms.Mode == MODE_PREFILTER)
     {
+        vec2 texSize = vec2(textureSize(u_Texture, 0));
         color.rgb = DownsampleBox13(u_Texture, 0, texCoords, 1.0f / texSize);
         color = Prefilter(color, texCoords);
         color.a = 1.0f;
     }
-    else if (u_Uniforms.Mode == MODE_UPSAMPLE_FIRST)
+    else if (u_Uniforms.Mode == MODE_DOWNSAMPLE)
     {
-        vec2 bloomTexSize = vec2(textureSize(u_Texture, int(u_Uniforms.LOD + 1.0f)));
-        float sampleScale = 1.0f;
-        vec3 upsampledTexture = UpsampleTent9(u_Texture, u_Uniforms.LOD + 1.0f, texCoords, 1.0f / bloomTexSize, sampleScale);
-
-        vec3 existing = textureLod(u_Texture, texCoords, u_Uniforms.LOD).rgb;
-        color.rgb = existing + upsampledTexture;
+        // Reads the level above the one being written in the same chain
+        vec2 texSize = vec2(textureSize(u_Texture, int(u_Uniforms.LOD)));
+        color.rgb = DownsampleBox13(u_Texture, u_Uniforms.LOD, texCoords, 1.0f / texSize);
     }
     else if (u_Uniforms.Mode == MODE_UPSAMPLE)
     {
+        // Downsampled level plus the level below from u_BloomTexture, the upsample chain or the end of the downsample chain
         vec2 bloomTexSize = vec2(textureSize(u_BloomTexture, int(u_Uniforms.LOD + 1.0f)));
         float sampleScale = 1.0f;
         vec3 upsampledTexture = UpsampleTent9(u_BloomTexture, u_Uniforms.LOD + 1.0f, texCoords, 1.0f / bloomTexSize, sampleScale);
@@ -139,11 +139,6 @@ void main()
         vec3 existing = textureLod(u_Texture, texCoords, u_Uniforms.LOD).rgb;
         color.rgb = existing + upsampledTexture;
     }
-    else if (u_Uniforms.Mode == MODE_DOWNSAMPLE)
-    {
-        // Downsample
-        color.rgb = DownsampleBox13(u_Texture, u_Uniforms.LOD, texCoords, 1.0f / texSize);
-    }
-    
-    imageStore(o_Image, ivec2(gl_GlobalInvocationID), color);
+
+    imageStore(o_Image, invocID, color);
 }
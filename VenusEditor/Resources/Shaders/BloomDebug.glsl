@@ -25,7 +25,7 @@ layout(location = 0) out vec4 o_Color;
 
 // Uniforms
 layout(binding = 0) uniform sampler2D u_Texture;
-layout (push_constant) uniform Settings
+layout(std140, binding = 6) uniform Settings
 {
 	float Layer;
 } u_Settings;
@@ -4,7 +4,7 @@
 // Computes diffuse irradiance cubemap convolution for image-based lighting.
 // Uses quasi Monte Carlo sampling with Hammersley sequence.
 
-layout(binding = 0, rgba32f) restrict writeonly uniform imageCube o_IrradianceMap;
+layout(binding = 0, rgba16f) restrict writeonly uniform imageCube o_IrradianceMap;
 layout(binding = 1) uniform samplerCube u_RadianceMap;
 
 const float PI = 3.141592;
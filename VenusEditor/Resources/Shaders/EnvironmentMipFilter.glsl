@@ -12,7 +12,7 @@ const uint NumSamples = 1024;
 const float InvNumSamples = 1.0 / float(NumSamples);
 
 const int NumMipLevels = 1;
-layout(binding = 0, rgba32f) restrict writeonly uniform imageCube outputTexture[NumMipLevels];
+layout(binding = 0, rgba16f) restrict writeonly uniform imageCube outputTexture[NumMipLevels];
 layout(binding = 1) uniform samplerCube inputTexture;
 
 layout (push_constant) uniform Uniforms
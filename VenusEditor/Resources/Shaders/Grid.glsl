@@ -39,9 +39,9 @@ void main()
 layout (location = 0) in vec2 v_TexCoord;
 
 // Uniforms
-layout (push_constant) uniform Settings
+layout(std140, binding = 6) uniform Settings
 {
-	layout (offset = 64) float Scale;
+	float Scale;
 	float Size;
 } u_Settings;
 
@@ -0,0 +1,131 @@
+// Clustered Light Culling, bins point lights into a view space 3D grid
+// Grid size must match SceneRenderer::ClusterCount* and PBR.glsl
+
+#type compute
+#version 450 core
+
+#define CLUSTER_COUNT_X 16
+#define CLUSTER_COUNT_Y 9
+#define CLUSTER_COUNT_Z 24
+#define MAX_LIGHTS_PER_CLUSTER 256
+#define SLICES_PER_GROUP 4
+#define GROUP_SIZE (CLUSTER_COUNT_X * CLUSTER_COUNT_Y * SLICES_PER_GROUP)
+
+// One invocation per cluster
+layout(local_size_x = CLUSTER_COUNT_X, local_size_y = CLUSTER_COUNT_Y, local_size_z = SLICES_PER_GROUP) in;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewMatrix;
+	mat4 u_ProjectionMatrix;
+	mat4 u_ViewProjectionMatrix;
+	mat4 u_InverseViewProjectionMatrix;
+};
+
+struct PointLight
+{
+	vec3 Position;
+	float Intensity;
+	vec3 Color;
+	float MinRadius;
+	float Radius;
+	float Falloff;
+	float LightSize;
+	bool CastsShadows;
+};
+
+layout(std430, binding = 1) readonly buffer PointLightData
+{
+	uint u_PointLightsCount;
+	PointLight u_PointLights[];
+};
+
+layout(std430, binding = 2) writeonly buffer ClusterLightCounts
+{
+	uint u_ClusterLightCounts[];
+};
+
+layout(std430, binding = 3) writeonly buffer ClusterLightIndices
+{
+	uint u_ClusterLightIndices[];
+};
+
+layout(push_constant) uniform Uniforms
+{
+	float Near;
+	float Far;
+} u_Uniforms;
+
+// View space bounding spheres of the light batch being tested
+shared vec4 s_Lights[GROUP_SIZE];
+
+vec3 NDCToView(vec2 ndc, float depth, mat4 inverseProjection)
+{
+	vec4 position = inverseProjection * vec4(ndc, depth, 1.0);
+	return position.xyz / position.w;
+}
+
+vec3 IntersectZPlane(vec3 a, vec3 b, float z)
+{
+	float t = (z - a.z) / (b.z - a.z);
+	return a + t * (b - a);
+}
+
+void main()
+{
+	uvec3 cluster = gl_GlobalInvocationID;
+	uint clusterIndex = cluster.x + cluster.y * CLUSTER_COUNT_X + cluster.z * CLUSTER_COUNT_X * CLUSTER_COUNT_Y;
+
+	// Exponential depth slices
+	float depthRatio = u_Uniforms.Far / u_Uniforms.Near;
+	float sliceNear = -u_Uniforms.Near * pow(depthRatio, float(cluster.z) / CLUSTER_COUNT_Z);
+	float sliceFar = -u_Uniforms.Near * pow(depthRatio, float(cluster.z + 1) / CLUSTER_COUNT_Z);
+
+	// Cluster AABB from the tile corner rays clipped to the slice
+	mat4 inverseProjection = inverse(u_ProjectionMatrix);
+	vec2 tileMin = vec2(cluster.xy) / vec2(CLUSTER_COUNT_X, CLUSTER_COUNT_Y) * 2.0 - 1.0;
+	vec2 tileMax = vec2(cluster.xy + 1) / vec2(CLUSTER_COUNT_X, CLUSTER_COUNT_Y) * 2.0 - 1.0;
+	vec2 corners[4] = vec2[](tileMin, vec2(tileMax.x, tileMin.y), vec2(tileMin.x, tileMax.y), tileMax);
+
+	vec3 aabbMin = vec3(1.0e30);
+	vec3 aabbMax = vec3(-1.0e30);
+	for (int i = 0; i < 4; i++)
+	{
+		vec3 nearPoint = NDCToView(corners[i], -1.0, inverseProjection);
+		vec3 farPoint = NDCToView(corners[i], 1.0, inverseProjection);
+
+		vec3 p0 = IntersectZPlane(nearPoint, farPoint, sliceNear);
+		vec3 p1 = IntersectZPlane(nearPoint, farPoint, sliceFar);
+		aabbMin = min(aabbMin, min(p0, p1));
+		aabbMax = max(aabbMax, max(p0, p1));
+	}
+
+	uint lightCount = 0;
+	uint firstIndex = clusterIndex * MAX_LIGHTS_PER_CLUSTER;
+	for (uint batchStart = 0; batchStart < u_PointLightsCount; batchStart += GROUP_SIZE)
+	{
+		// Each invocation loads one light of the batch
+		uint lightIndex = batchStart + gl_LocalInvocationIndex;
+		if (lightIndex < u_PointLightsCount)
+		{
+			PointLight light = u_PointLights[lightIndex];
+			s_Lights[gl_LocalInvocationIndex] = vec4((u_ViewMatrix * vec4(light.Position, 1.0)).xyz, light.Radius);
+		}
+		barrier();
+
+		uint batchCount = min(uint(GROUP_SIZE), u_PointLightsCount - batchStart);
+		for (uint i = 0; i < batchCount; i++)
+		{
+			vec4 sphere = s_Lights[i];
+			vec3 delta = clamp(sphere.xyz, aabbMin, aabbMax) - sphere.xyz;
+			if (dot(delta, delta) <= sphere.w * sphere.w && lightCount < MAX_LIGHTS_PER_CLUSTER)
+			{
+				u_ClusterLightIndices[firstIndex + lightCount] = batchStart + i;
+				lightCount++;
+			}
+		}
+		barrier();
+	}
+
+	u_ClusterLightCounts[clusterIndex] = lightCount;
+}
@@ -23,6 +23,18 @@ layout(std140, binding = 1) uniform Model
 {
 	mat4 u_Transform;
 	int u_EntityID;
+	int u_InstanceOffset;
+};
+
+struct InstanceData
+{
+	mat4 Transform;
+	int EntityID;
+};
+
+layout(std430, binding = 0) readonly buffer Instances
+{
+	InstanceData u_Instances[];
 };
 
 layout(std140, binding = 2) uniform ShadowData
@@ -47,10 +59,12 @@ layout (location = 11) out flat int v_EntityID;
 
 void main()
 {
-    Output.WorldPosition = vec3(u_Transform * vec4(a_Position, 1.0f));
-    Output.Normal = mat3(u_Transform) * a_Normal;
+	InstanceData instance = u_Instances[u_InstanceOffset + gl_InstanceIndex];
+
+    Output.WorldPosition = vec3(instance.Transform * vec4(a_Position, 1.0f));
+    Output.Normal = mat3(instance.Transform) * a_Normal;
 	Output.TexCoord = vec2(a_TexCoord.x, 1.0 - a_TexCoord.y);
-	Output.WorldNormals = mat3(u_Transform) * mat3(a_Tangent, a_Binormal, a_Normal);
+	Output.WorldNormals = mat3(instance.Transform) * mat3(a_Tangent, a_Binormal, a_Normal);
 
 	Output.ShadowMapCoords[0] = u_LightMatrix[0] * vec4(Output.WorldPosition, 1.0);
 	Output.ShadowMapCoords[1] = u_LightMatrix[1] * vec4(Output.WorldPosition, 1.0);
@@ -58,8 +72,8 @@ void main()
 	Output.ShadowMapCoords[3] = u_LightMatrix[3] * vec4(Output.WorldPosition, 1.0);
 	Output.ViewPosition = vec3(u_ViewMatrix * vec4(Output.WorldPosition, 1.0));
 
-	v_EntityID = u_EntityID;
-	gl_Position = u_ViewProjectionMatrix * u_Transform * vec4(a_Position, 1.0);
+	v_EntityID = instance.EntityID;
+	gl_Position = u_ViewProjectionMatrix * instance.Transform * vec4(a_Position, 1.0);
 }
 
 #type fragment
@@ -116,10 +130,23 @@ layout(std140, binding = 3) uniform SceneData
 	float u_EnvironmentMapIntensity;
 };
 
-layout(std140, binding = 4) uniform PointLightData
+// Point lights and the per cluster lists written by LightCulling.glsl
+#define MAX_LIGHTS_PER_CLUSTER 256
+
+layout(std430, binding = 1) readonly buffer PointLightData
 {
 	uint u_PointLightsCount;
-	PointLight u_pointLights[1024];
+	PointLight u_PointLights[];
+};
+
+layout(std430, binding = 2) readonly buffer ClusterLightCounts
+{
+	uint u_ClusterLightCounts[];
+};
+
+layout(std430, binding = 3) readonly buffer ClusterLightIndices
+{
+	uint u_ClusterLightIndices[];
 };
 
 layout(std140, binding = 5) uniform RendererData
@@ -134,6 +161,11 @@ layout(std140, binding = 5) uniform RendererData
 	uniform bool u_CascadeFading;
 	uniform float u_CascadeTransitionFade;
 	uniform bool u_ShowLightComplexity;
+	uniform int u_TilesCountY;
+	uniform float u_ClusterDepthScale;
+	uniform float u_ClusterDepthBias;
+	uniform vec2 u_ClusterTileSize;
+	uniform int u_TilesCountZ;
 };
 
 // PBR Textures
@@ -151,7 +183,7 @@ layout(binding = 6) uniform sampler2D u_BRDFLUTTexture;
 layout(binding = 7) uniform sampler2DArray u_ShadowMapTexture;
 
 // PBR Material Params
-layout(push_constant) uniform Material
+layout(std140, binding = 6) uniform Material
 {
 	vec3 AlbedoColor;
 	float Emission;
@@ -424,12 +456,31 @@ vec3 CalculateDirLight(vec3 F0)
 	return result;
 }
 
-vec3 CalculatePointLights(in vec3 F0)
+uint GetClusterIndex()
+{
+	uvec2 tile = min(uvec2(gl_FragCoord.xy / u_ClusterTileSize), uvec2(u_TilesCountX - 1, u_TilesCountY - 1));
+	// Orthographic views can see fragments at or behind the camera plane, they land in the first slice
+	float slice = log(max(-Input.ViewPosition.z, 1.0e-4)) * u_ClusterDepthScale + u_ClusterDepthBias;
+	uint zSlice = uint(clamp(slice, 0.0, float(u_TilesCountZ - 1)));
+
+	return tile.x + tile.y * u_TilesCountX + zSlice * u_TilesCountX * u_TilesCountY;
+}
+
+vec3 GetLightComplexityColor(uint lightCount)
+{
+	// Blue (few lights) to red (many)
+	float t = clamp(float(lightCount) / 32.0, 0.0, 1.0);
+	return clamp(vec3(t * 2.0 - 1.0, 1.0 - abs(t * 2.0 - 1.0), 1.0 - t * 2.0), 0.0, 1.0);
+}
+
+vec3 CalculatePointLights(in vec3 F0, uint clusterIndex)
 {
 	vec3 result = vec3(0.0);
-	for (int i = 0; i < u_PointLightsCount; i++)
+	uint lightCount = u_ClusterLightCounts[clusterIndex];
+	uint firstIndex = clusterIndex * MAX_LIGHTS_PER_CLUSTER;
+	for (uint i = 0; i < lightCount; i++)
 	{
-		PointLight light = u_pointLights[i];
+		PointLight light = u_PointLights[u_ClusterLightIndices[firstIndex + i]];
 		vec3 Li = normalize(light.Position - Input.WorldPosition);
 		float lightDistance = length(light.Position - Input.WorldPosition);
 		vec3 Lh = normalize(Li + m_Params.View);
@@ -529,7 +580,9 @@ void main()
 	m_Params.Normal = normalize(Input.Normal);
 	if (u_MaterialUniforms.UseNormalMap == 1)
 	{
-		m_Params.Normal = normalize(texture(u_NormalTexture, Input.TexCoord).rgb * 2.0f - 1.0f);
+		// Z is rebuilt from XY, cooked normal maps are BC5 and only store two channels
+		vec2 normalXY = texture(u_NormalTexture, Input.TexCoord).rg * 2.0f - 1.0f;
+		m_Params.Normal = vec3(normalXY, sqrt(max(1.0f - dot(normalXY, normalXY), 0.0f)));
 		m_Params.Normal = normalize(Input.WorldNormals * m_Params.Normal);
 	}
 	m_Params.View = normalize(u_CameraPosition - Input.WorldPosition);
@@ -610,7 +663,8 @@ void main()
 	}
 	
 	vec3 lightContribution = CalculateDirLight(F0) * shadowAmount;
-	lightContribution += CalculatePointLights(F0);
+	uint clusterIndex = GetClusterIndex();
+	lightContribution += CalculatePointLights(F0, clusterIndex);
 	lightContribution += m_Params.Albedo * u_MaterialUniforms.Emission;
 	
 	vec3 iblContribution = IBL(F0, Lr) * u_EnvironmentMapIntensity;
@@ -620,5 +674,8 @@ void main()
 	if(u_ShowCascades)
 		o_Color *= GetCascadeColor();
 
+	if(u_ShowLightComplexity)
+		o_Color.rgb = mix(o_Color.rgb, GetLightComplexityColor(u_ClusterLightCounts[clusterIndex]), 0.75);
+
 	o_EntityID = v_EntityID;
 }
\ No newline at end of file
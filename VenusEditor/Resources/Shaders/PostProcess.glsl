@@ -0,0 +1,331 @@
+// Post Processing, bloom composite, exposure, tone mapping, gamma and grayscale into LDR followed by FXAA on the LDR result
+// Feature toggles are specialization constants, every combination is its own program
+
+#type compute
+#version 450 core
+
+#define TILE_SIZE 16
+// Edge searches never leave the cached border, wider catches longer edges at the cost of more LDR pixels per group
+#define TILE_BORDER 4
+#define TILE_CACHE_SIZE (TILE_SIZE + TILE_BORDER * 2)
+
+#define QUALITY(q) ((q) < 5 ? 1.0 : ((q) > 5 ? ((q) < 10 ? 2.0 : ((q) < 11 ? 4.0 : 8.0)) : 1.5))
+
+layout(local_size_x = TILE_SIZE, local_size_y = TILE_SIZE) in;
+
+layout(constant_id = 0) const bool c_Bloom = true;
+layout(constant_id = 1) const bool c_ACESTone = true;
+layout(constant_id = 2) const bool c_GammaCorrection = true;
+layout(constant_id = 3) const bool c_Grayscale = false;
+layout(constant_id = 4) const bool c_FXAA = true;
+
+layout(binding = 0) restrict writeonly uniform image2D o_Image;
+
+layout(binding = 1) uniform sampler2D u_Texture;
+layout(binding = 2) uniform sampler2D u_BloomTexture;
+layout(binding = 3) uniform sampler2D u_BloomDirtMaskTexture;
+layout(std140, binding = 6) uniform Settings
+{
+	float Exposure;
+	float BloomIntensity;
+	float BloomDirtMaskIntensity;
+	float FXAAThresholdMin;
+	float FXAAThresholdMax;
+	int FXAAIterations;
+	float FXAASubpixelQuality;
+} u_Settings;
+
+// LDR colors of the group's pixels plus the border, luma in w
+shared vec4 s_Tile[TILE_CACHE_SIZE][TILE_CACHE_SIZE];
+
+vec3 UpsampleTent9(sampler2D tex, float lod, vec2 uv, vec2 texelSize, float radius)
+{
+	vec4 offset = texelSize.xyxy * vec4(1.0f, 1.0f, -1.0f, 0.0f) * radius;
+
+	// Center
+	vec3 result = textureLod(tex, uv, lod).rgb * 4.0f;
+
+	result += textureLod(tex, uv - offset.xy, lod).rgb;
+	result += textureLod(tex, uv - offset.wy, lod).rgb * 2.0;
+	result += textureLod(tex, uv - offset.zy, lod).rgb;
+
+	result += textureLod(tex, uv + offset.zw, lod).rgb * 2.0;
+	result += textureLod(tex, uv + offset.xw, lod).rgb * 2.0;
+
+	result += textureLod(tex, uv + offset.zy, lod).rgb;
+	result += textureLod(tex, uv + offset.wy, lod).rgb * 2.0;
+	result += textureLod(tex, uv + offset.xy, lod).rgb;
+
+	return result * (1.0f / 16.0f);
+}
+
+vec3 ACESTonemap(vec3 color)
+{
+	mat3 m1 = mat3(
+		0.59719, 0.07600, 0.02840,
+		0.35458, 0.90834, 0.13383,
+		0.04823, 0.01566, 0.83777
+	);
+	mat3 m2 = mat3(
+		1.60475, -0.10208, -0.00327,
+		-0.53108, 1.10813, -0.07276,
+		-0.07367, -0.00605, 1.07602
+	);
+	vec3 v = m1 * color;
+	vec3 a = v * (v + 0.0245786) - 0.000090537;
+	vec3 b = v * (0.983729 * v + 0.4329510) + 0.238081;
+	return clamp(m2 * (a / b), 0.0, 1.0);
+}
+
+vec3 GammaCorrect(vec3 col, float gamma)
+{
+	return pow(col.rgb, vec3(1.0/gamma));
+}
+
+float rgb2luma(vec3 rgb)
+{
+	return sqrt(dot(rgb, vec3(0.299, 0.587, 0.114)));
+}
+
+// Final color of a pixel before anti aliasing, clamped to the edges like the samplers
+vec3 ComputeLDR(ivec2 pixel)
+{
+	ivec2 size = textureSize(u_Texture, 0);
+	pixel = clamp(pixel, ivec2(0), size - 1);
+	vec2 uv = (vec2(pixel) + 0.5f) / vec2(size);
+
+	vec3 col = texelFetch(u_Texture, pixel, 0).rgb;
+
+	if (c_Bloom)
+	{
+		const float sampleScale = 0.5;
+		vec2 bloomTexSize = vec2(textureSize(u_BloomTexture, 0));
+		vec3 bloom = UpsampleTent9(u_BloomTexture, 0, uv, 1.0f / bloomTexSize, sampleScale) * u_Settings.BloomIntensity;
+		vec3 bloomMask = textureLod(u_BloomDirtMaskTexture, uv, 0).rgb * u_Settings.BloomDirtMaskIntensity;
+
+		col += bloom;
+		col += bloom * bloomMask;
+	}
+
+	col *= u_Settings.Exposure;
+
+	if (c_ACESTone)
+		col = ACESTonemap(col);
+
+	if (c_GammaCorrection)
+		col = GammaCorrect(col, 2.2);
+
+	if (c_Grayscale)
+		col = vec3(0.2126 * col.r + 0.7152 * col.g + 0.0722 * col.b);
+
+	return col;
+}
+
+vec3 LoadColor(ivec2 pixel)
+{
+	ivec2 local = clamp(pixel - ivec2(gl_WorkGroupID.xy) * TILE_SIZE + TILE_BORDER, ivec2(0), ivec2(TILE_CACHE_SIZE - 1));
+	return s_Tile[local.y][local.x].rgb;
+}
+
+float LoadLuma(ivec2 pixel)
+{
+	ivec2 local = pixel - ivec2(gl_WorkGroupID.xy) * TILE_SIZE + TILE_BORDER;
+	return s_Tile[local.y][local.x].w;
+}
+
+// Bilinear fetch at a position in pixels, texel centers at .5
+vec3 SampleColor(vec2 position)
+{
+	vec2 texel = position - 0.5f;
+	ivec2 base = ivec2(floor(texel));
+	vec2 f = fract(texel);
+
+	vec3 a = mix(LoadColor(base), LoadColor(base + ivec2(1, 0)), f.x);
+	vec3 b = mix(LoadColor(base + ivec2(0, 1)), LoadColor(base + ivec2(1, 1)), f.x);
+	return mix(a, b, f.y);
+}
+
+// Whether a bilinear fetch at the position only touches cached pixels
+bool InsideTile(vec2 position)
+{
+	vec2 local = position - vec2(ivec2(gl_WorkGroupID.xy) * TILE_SIZE - TILE_BORDER);
+	return all(greaterThanEqual(local, vec2(0.5))) && all(lessThanEqual(local, vec2(TILE_CACHE_SIZE - 0.5)));
+}
+
+vec3 FXAA(ivec2 pixel)
+{
+	float thresholdMin = 1.0f / u_Settings.FXAAThresholdMin;
+	float thresholdMax = 1.0f / u_Settings.FXAAThresholdMax;
+
+	vec3 colorCenter = LoadColor(pixel);
+
+	// Luma at the current pixel and its four direct neighbours
+	float lumaCenter = LoadLuma(pixel);
+	float lumaDown = LoadLuma(pixel + ivec2(0, -1));
+	float lumaUp = LoadLuma(pixel + ivec2(0, 1));
+	float lumaLeft = LoadLuma(pixel + ivec2(-1, 0));
+	float lumaRight = LoadLuma(pixel + ivec2(1, 0));
+
+	float lumaMin = min(lumaCenter, min(min(lumaDown, lumaUp), min(lumaLeft, lumaRight)));
+	float lumaMax = max(lumaCenter, max(max(lumaDown, lumaUp), max(lumaLeft, lumaRight)));
+	float lumaRange = lumaMax - lumaMin;
+
+	// Not on an edge, or in a really dark area
+	if (lumaRange < max(thresholdMin, lumaMax * thresholdMax))
+		return colorCenter;
+
+	float lumaDownLeft = LoadLuma(pixel + ivec2(-1, -1));
+	float lumaUpRight = LoadLuma(pixel + ivec2(1, 1));
+	float lumaUpLeft = LoadLuma(pixel + ivec2(-1, 1));
+	float lumaDownRight = LoadLuma(pixel + ivec2(1, -1));
+
+	float lumaDownUp = lumaDown + lumaUp;
+	float lumaLeftRight = lumaLeft + lumaRight;
+
+	float lumaLeftCorners = lumaDownLeft + lumaUpLeft;
+	float lumaDownCorners = lumaDownLeft + lumaDownRight;
+	float lumaRightCorners = lumaDownRight + lumaUpRight;
+	float lumaUpCorners = lumaUpRight + lumaUpLeft;
+
+	// Gradient along the horizontal and vertical axis
+	float edgeHorizontal = abs(-2.0 * lumaLeft + lumaLeftCorners) + abs(-2.0 * lumaCenter + lumaDownUp) * 2.0 + abs(-2.0 * lumaRight + lumaRightCorners);
+	float edgeVertical = abs(-2.0 * lumaUp + lumaUpCorners) + abs(-2.0 * lumaCenter + lumaLeftRight) * 2.0 + abs(-2.0 * lumaDown + lumaDownCorners);
+	bool isHorizontal = (edgeHorizontal >= edgeVertical);
+
+	// Neighbours in the opposite direction to the edge and their gradients
+	float luma1 = isHorizontal ? lumaDown : lumaLeft;
+	float luma2 = isHorizontal ? lumaUp : lumaRight;
+	float gradient1 = luma1 - lumaCenter;
+	float gradient2 = luma2 - lumaCenter;
+
+	bool is1Steepest = abs(gradient1) >= abs(gradient2);
+	float gradientScaled = 0.25 * max(abs(gradient1), abs(gradient2));
+
+	// One pixel across the edge, towards the steepest side
+	float stepLength = 1.0;
+	float lumaLocalAverage = 0.0;
+	if (is1Steepest)
+	{
+		stepLength = -stepLength;
+		lumaLocalAverage = 0.5 * (luma1 + lumaCenter);
+	}
+	else
+	{
+		lumaLocalAverage = 0.5 * (luma2 + lumaCenter);
+	}
+
+	// Half a pixel across the edge, then explore along it on both sides
+	vec2 center = vec2(pixel) + 0.5f;
+	vec2 currentPosition = center;
+	if (isHorizontal)
+		currentPosition.y += stepLength * 0.5;
+	else
+		currentPosition.x += stepLength * 0.5;
+
+	vec2 offset = isHorizontal ? vec2(1.0, 0.0) : vec2(0.0, 1.0);
+	vec2 position1 = currentPosition - offset;
+	vec2 position2 = currentPosition + offset;
+
+	float lumaEnd1 = rgb2luma(SampleColor(position1)) - lumaLocalAverage;
+	float lumaEnd2 = rgb2luma(SampleColor(position2)) - lumaLocalAverage;
+
+	bool reached1 = abs(lumaEnd1) >= gradientScaled;
+	bool reached2 = abs(lumaEnd2) >= gradientScaled;
+	bool reachedBoth = reached1 && reached2;
+
+	if (!reached1)
+		position1 -= offset;
+	if (!reached2)
+		position2 += offset;
+
+	// An edge running past the cached border is treated as ending there
+	reached1 = reached1 || !InsideTile(position1);
+	reached2 = reached2 || !InsideTile(position2);
+	reachedBoth = reached1 && reached2;
+
+	if (!reachedBoth)
+	{
+		for (int i = 2; i < u_Settings.FXAAIterations; i++)
+		{
+			if (!reached1)
+				lumaEnd1 = rgb2luma(SampleColor(position1)) - lumaLocalAverage;
+			if (!reached2)
+				lumaEnd2 = rgb2luma(SampleColor(position2)) - lumaLocalAverage;
+
+			reached1 = reached1 || abs(lumaEnd1) >= gradientScaled;
+			reached2 = reached2 || abs(lumaEnd2) >= gradientScaled;
+
+			if (!reached1)
+				position1 -= offset * QUALITY(i);
+			if (!reached2)
+				position2 += offset * QUALITY(i);
+
+			reached1 = reached1 || !InsideTile(position1);
+			reached2 = reached2 || !InsideTile(position2);
+			reachedBoth = reached1 && reached2;
+
+			if (reachedBoth)
+				break;
+		}
+	}
+
+	// Distances to each end of the edge
+	float distance1 = isHorizontal ? (center.x - position1.x) : (center.y - position1.y);
+	float distance2 = isHorizontal ? (position2.x - center.x) : (position2.y - center.y);
+
+	bool isDirection1 = distance1 < distance2;
+	float distanceFinal = min(distance1, distance2);
+	float edgeThickness = (distance1 + distance2);
+
+	// Read in the direction of the closest end of the edge
+	float pixelOffset = -distanceFinal / edgeThickness + 0.5;
+
+	// The luma delta at the closest end must vary like the center does
+	bool isLumaCenterSmaller = lumaCenter < lumaLocalAverage;
+	bool correctVariation = ((isDirection1 ? lumaEnd1 : lumaEnd2) < 0.0) != isLumaCenterSmaller;
+	float finalOffset = correctVariation ? pixelOffset : 0.0;
+
+	// Sub pixel offset from the 3x3 neighbourhood
+	float lumaAverage = (1.0 / 12.0) * (2.0 * (lumaDownUp + lumaLeftRight) + lumaLeftCorners + lumaRightCorners);
+	float subPixelOffset1 = clamp(abs(lumaAverage - lumaCenter) / lumaRange, 0.0, 1.0);
+	float subPixelOffset2 = (-2.0 * subPixelOffset1 + 3.0) * subPixelOffset1 * subPixelOffset1;
+	float subPixelOffsetFinal = subPixelOffset2 * subPixelOffset2 * u_Settings.FXAASubpixelQuality;
+
+	finalOffset = max(finalOffset, subPixelOffsetFinal);
+
+	// At most one pixel across the edge, always inside the tile
+	vec2 finalPosition = center;
+	if (isHorizontal)
+		finalPosition.y += finalOffset * stepLength;
+	else
+		finalPosition.x += finalOffset * stepLength;
+
+	return SampleColor(finalPosition);
+}
+
+void main()
+{
+	ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+	ivec2 size = imageSize(o_Image);
+
+	if (!c_FXAA)
+	{
+		if (all(lessThan(pixel, size)))
+			imageStore(o_Image, pixel, vec4(ComputeLDR(pixel), 1.0));
+		return;
+	}
+
+	// Every LDR color of the tile and its border is computed once and shared by the group
+	ivec2 tileOrigin = ivec2(gl_WorkGroupID.xy) * TILE_SIZE - TILE_BORDER;
+	for (uint i = gl_LocalInvocationIndex; i < TILE_CACHE_SIZE * TILE_CACHE_SIZE; i += TILE_SIZE * TILE_SIZE)
+	{
+		ivec2 local = ivec2(i % TILE_CACHE_SIZE, i / TILE_CACHE_SIZE);
+		vec3 color = ComputeLDR(tileOrigin + local);
+		s_Tile[local.y][local.x] = vec4(color, rgb2luma(color));
+	}
+
+	barrier();
+
+	if (all(lessThan(pixel, size)))
+		imageStore(o_Image, pixel, vec4(FXAA(pixel), 1.0));
+}
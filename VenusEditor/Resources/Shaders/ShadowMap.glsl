@@ -10,15 +10,33 @@ layout(location = 2) in vec3 a_Tangent;
 layout(location = 3) in vec3 a_Binormal;
 layout(location = 4) in vec2 a_TexCoord;
 
+// Out
+layout(location = 0) out flat int v_CascadeMask;
+
 layout(std140, binding = 1) uniform Model
 {
 	mat4 u_Transform;
 	int u_EntityID;
+	int u_InstanceOffset;
+};
+
+struct InstanceData
+{
+	mat4 Transform;
+	int EntityID;
+	int CascadeMask;
+};
+
+layout(std430, binding = 0) readonly buffer Instances
+{
+	InstanceData u_Instances[];
 };
 
 void main()
 {
-	gl_Position = u_Transform * vec4(a_Position, 1.0);
+	InstanceData instance = u_Instances[u_InstanceOffset + gl_InstanceIndex];
+	v_CascadeMask = instance.CascadeMask;
+	gl_Position = instance.Transform * vec4(a_Position, 1.0);
 }
 
 
@@ -42,6 +60,8 @@ void main()
 layout(triangles, invocations = 4) in;
 layout(triangle_strip, max_vertices = 3) out;
 
+layout(location = 0) in flat int v_CascadeMask[];
+
 layout (std140, binding = 2) uniform ShadowData
 {
 	mat4 u_ViewProjectionMatrix[4];
@@ -49,6 +69,10 @@ layout (std140, binding = 2) uniform ShadowData
 
 void main()
 {
+	// Casters culled from this cascade, or the cascade is cached
+	if ((v_CascadeMask[0] & (1 << gl_InvocationID)) == 0)
+		return;
+
 	for (int i = 0; i < gl_in.length(); ++i)
 	{
 		gl_Layer = gl_InvocationID;
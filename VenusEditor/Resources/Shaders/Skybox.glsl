@@ -38,7 +38,7 @@ layout(location = 1) out int o_EntityID;
 // Uniforms
 layout (binding = 0) uniform samplerCube u_Texture;
 
-layout (push_constant) uniform Uniforms
+layout(std140, binding = 6) uniform Uniforms
 {
 	float TextureLod;
 	float Intensity;
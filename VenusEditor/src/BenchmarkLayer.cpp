@@ -0,0 +1,305 @@
+#include "BenchmarkLayer.h"
+
+#include "Assets/AssetManager.h"
+
+#include <glm/gtc/constants.hpp>
+
+namespace Venus {
+
+	BenchmarkLayer::BenchmarkLayer(const BenchmarkSpecification& spec)
+		: Layer("BenchmarkLayer"), m_Specification(spec)
+	{
+	}
+
+	void BenchmarkLayer::OnAttach()
+	{
+		AssetManager::Init();
+
+		m_Scene = CreateRef<Scene>();
+		if (m_Specification.ScenePath.empty())
+		{
+			m_Name = "Benchmark";
+			PopulateScene(m_Scene);
+		}
+		else
+		{
+			m_Name = m_Specification.ScenePath.stem().string();
+
+			SceneSerializer serializer(m_Scene);
+			if (!serializer.Deserialize(m_Specification.ScenePath.string()))
+				CORE_LOG_ERROR("Benchmark: could not load scene {0}", m_Specification.ScenePath.string());
+		}
+
+		m_Scene->OnViewportResize(m_Specification.Width, m_Specification.Height);
+		m_Scene->OnRuntimeStart();
+
+		m_SceneRenderer = CreateRef<SceneRenderer>(m_Scene);
+		m_SceneRenderer->SetViewportSize(m_Specification.Width, m_Specification.Height);
+
+		m_Frames.reserve(m_Specification.FrameCount);
+
+		CORE_LOG_INFO("Benchmark: {0}, {1} frames after {2} warmup frames at {3}x{4}, {5}s timestep", m_Name, m_Specification.FrameCount,
+			m_Specification.WarmupFrames, m_Specification.Width, m_Specification.Height, m_Specification.Timestep);
+	}
+
+	void BenchmarkLayer::OnDetach()
+	{
+		m_Scene->OnRuntimeStop();
+		AssetManager::Shutdown();
+	}
+
+	void BenchmarkLayer::OnUpdate(Timestep ts)
+	{
+		VS_PROFILE_FUNCTION();
+
+		// Lags a frame or more behind the one recorded below
+		ReadGPUTimes();
+
+		uint32_t frameCount = m_Specification.WarmupFrames + m_Specification.FrameCount;
+		if (m_FrameIndex > m_Specification.WarmupFrames && m_FrameIndex <= frameCount)
+			m_Frames.back().Frame = m_FrameTimer.ElapsedMillis();
+		m_FrameTimer.Reset();
+
+		if (m_FrameIndex < frameCount)
+		{
+			// The real frame time is ignored so every run simulates the same
+			Timer updateTimer;
+			m_Scene->OnUpdateRuntime(m_SceneRenderer, m_Specification.Timestep);
+			float update = updateTimer.ElapsedMillis();
+
+			if (m_FrameIndex >= m_Specification.WarmupFrames)
+			{
+				FrameTiming& frame = m_Frames.emplace_back();
+				frame.GPUFrame = GPUProfiler::GetCurrentFrame();
+				frame.Update = update;
+				frame.Stats = Renderer::GetStats();
+			}
+		}
+		else
+		{
+			// Nothing is rendered anymore, only waits for the last frame's GPU times
+			bool resolved = m_Frames.empty() || m_Frames.back().GPU >= 0.0f;
+			if (resolved || m_FrameIndex >= frameCount + GPUProfiler::FramesInFlight)
+			{
+				WriteResults();
+				Application::Get().Close();
+			}
+		}
+
+		m_FrameIndex++;
+	}
+
+	void BenchmarkLayer::ReadGPUTimes()
+	{
+		if (m_Frames.empty())
+			return;
+
+		// Recorded frames are consecutive, the profiler's frame index maps straight to them
+		uint64_t resultFrame = GPUProfiler::GetResultFrame();
+		uint64_t firstFrame = m_Frames.front().GPUFrame;
+		if (resultFrame < firstFrame || resultFrame - firstFrame >= m_Frames.size())
+			return;
+
+		FrameTiming& frame = m_Frames[resultFrame - firstFrame];
+		if (frame.GPU >= 0.0f)
+			return;
+
+		frame.GPU = GPUProfiler::GetFrameTime();
+		frame.Passes.assign(m_PassNames.size(), 0.0f);
+		for (const auto& scope : GPUProfiler::GetScopeTimes())
+		{
+			if (scope.Depth != 0)
+				continue;
+
+			uint32_t pass = (uint32_t)(std::find(m_PassNames.begin(), m_PassNames.end(), scope.Name) - m_PassNames.begin());
+			if (pass == m_PassNames.size())
+			{
+				m_PassNames.push_back(scope.Name);
+				frame.Passes.push_back(0.0f);
+			}
+
+			frame.Passes[pass] += scope.Time;
+		}
+	}
+
+	void BenchmarkLayer::WriteResults()
+	{
+		std::filesystem::create_directories(m_Specification.OutputDirectory);
+
+		std::filesystem::path timingsPath = m_Specification.OutputDirectory / (m_Name + ".csv");
+		std::ofstream out(timingsPath);
+		if (out)
+		{
+			out << "Frame,Frame (ms),Update (ms),GPU (ms),Draw Calls,Instances,Vertices";
+			for (const char* name : m_PassNames)
+				out << ",\"GPU " << name << " (ms)\"";
+			out << "\n";
+
+			// Empty cells where the GPU time never came back
+			for (uint32_t i = 0; i < (uint32_t)m_Frames.size(); i++)
+			{
+				const FrameTiming& frame = m_Frames[i];
+				out << i << "," << frame.Frame << "," << frame.Update << ",";
+				if (frame.GPU >= 0.0f)
+					out << frame.GPU;
+				out << "," << frame.Stats.DrawCalls << "," << frame.Stats.Instances << "," << frame.Stats.VertexCount;
+
+				for (uint32_t pass = 0; pass < (uint32_t)m_PassNames.size(); pass++)
+				{
+					out << ",";
+					if (pass < frame.Passes.size())
+						out << frame.Passes[pass];
+				}
+				out << "\n";
+			}
+
+			CORE_LOG_INFO("Benchmark: timings written to {0}", timingsPath.string());
+		}
+		else
+			CORE_LOG_ERROR("Benchmark: could not write {0}", timingsPath.string());
+
+		auto summarize = [this](const char* label, float FrameTiming::* member)
+		{
+			std::vector<float> times;
+			for (const auto& frame : m_Frames)
+			{
+				if (frame.*member >= 0.0f)
+					times.push_back(frame.*member);
+			}
+
+			if (times.empty())
+				return;
+
+			std::sort(times.begin(), times.end());
+			float sum = 0.0f;
+			for (float time : times)
+				sum += time;
+
+			float p99 = times[std::min((size_t)(times.size() * 0.99f), times.size() - 1)];
+			CORE_LOG_INFO("  {0}: avg {1}ms, min {2}ms, p99 {3}ms", label, sum / times.size(), times.front(), p99);
+		};
+
+		summarize("Frame", &FrameTiming::Frame);
+		summarize("Update", &FrameTiming::Update);
+		summarize("GPU", &FrameTiming::GPU);
+
+		if (m_Specification.CaptureFinalImage)
+			WriteFinalImage(m_Specification.OutputDirectory / (m_Name + ".tga"));
+	}
+
+	void BenchmarkLayer::WriteFinalImage(const std::filesystem::path& path)
+	{
+		Ref<Framebuffer> framebuffer = m_SceneRenderer->GetFinalBuffer();
+		if (!framebuffer)
+		{
+			CORE_LOG_WARN("Benchmark: nothing was rendered, no image to capture");
+			return;
+		}
+
+		uint32_t width = framebuffer->GetSpecification().Width;
+		uint32_t height = framebuffer->GetSpecification().Height;
+		std::vector<uint8_t> pixels(width * height * 4);
+		framebuffer->ReadColorAttachment(0, pixels.data(), (uint32_t)pixels.size());
+
+		// TGA stores BGRA, the final image is opaque
+		for (size_t i = 0; i < pixels.size(); i += 4)
+		{
+			std::swap(pixels[i], pixels[i + 2]);
+			pixels[i + 3] = 255;
+		}
+
+		// Uncompressed true color, the default bottom left origin matches the framebuffer's rows
+		uint8_t header[18] = {};
+		header[2] = 2;
+		header[12] = width & 0xFF;
+		header[13] = (width >> 8) & 0xFF;
+		header[14] = height & 0xFF;
+		header[15] = (height >> 8) & 0xFF;
+		header[16] = 32;
+		header[17] = 8;
+
+		std::ofstream out(path, std::ios::binary);
+		if (!out)
+		{
+			CORE_LOG_ERROR("Benchmark: could not write {0}", path.string());
+			return;
+		}
+
+		out.write((const char*)header, sizeof(header));
+		out.write((const char*)pixels.data(), pixels.size());
+		CORE_LOG_INFO("Benchmark: final image written to {0}", path.string());
+	}
+
+	void BenchmarkLayer::PopulateScene(const Ref<Scene>& scene)
+	{
+		// Shadowed geometry over the whole view, and enough bright lights to push bloom over its threshold
+		AssetHandle planeModel = AssetManager::GetHandle("Models/Default/Plane.fbx");
+		AssetHandle sphereModel = AssetManager::GetHandle("Models/Default/Sphere.fbx");
+		AssetHandle cubeModel = AssetManager::GetHandle("Models/Default/Cube.fbx");
+
+		{
+			auto entity = scene->CreateEntity("Sky Light");
+			entity.GetComponent<TagComponent>().Icon = TagIcon::Light;
+			entity.AddComponent<SkyLightComponent>().DinamicSky = true;
+		}
+
+		{
+			auto entity = scene->CreateEntity("Directional Light");
+			entity.GetComponent<TagComponent>().Icon = TagIcon::Light;
+			entity.GetComponent<TransformComponent>().Rotation = glm::radians(glm::vec3({ 80.0f, 10.0f, 0.0f }));
+			entity.AddComponent<DirectionalLightComponent>();
+		}
+
+		{
+			auto entity = scene->CreateEntity("Camera");
+			entity.GetComponent<TagComponent>().Icon = TagIcon::Camera;
+			auto& transform = entity.GetComponent<TransformComponent>();
+			transform.Position = { 0.0f, 12.0f, 30.0f };
+			transform.Rotation = glm::radians(glm::vec3({ -20.0f, 0.0f, 0.0f }));
+			entity.AddComponent<CameraComponent>();
+		}
+
+		{
+			auto entity = scene->CreateEntity("Ground");
+			entity.GetComponent<TagComponent>().Icon = TagIcon::Model;
+			entity.GetComponent<TransformComponent>().Scale = { 40.0f, 1.0f, 40.0f };
+			entity.AddComponent<MeshRendererComponent>().Model = planeModel;
+		}
+
+		const int gridSize = 16;
+		const float spacing = 2.5f;
+		const float offset = (gridSize - 1) * spacing * 0.5f;
+		for (int z = 0; z < gridSize; z++)
+		{
+			for (int x = 0; x < gridSize; x++)
+			{
+				bool sphere = (x + z) % 2 == 0;
+				auto entity = scene->CreateEntity(sphere ? "Sphere" : "Cube");
+				entity.GetComponent<TagComponent>().Icon = TagIcon::Model;
+				entity.GetComponent<TransformComponent>().Position = { x * spacing - offset, 1.0f, z * spacing - offset };
+				entity.AddComponent<MeshRendererComponent>().Model = sphere ? sphereModel : cubeModel;
+			}
+		}
+
+		const int lightGridSize = 8;
+		const float lightSpacing = 5.0f;
+		const float lightOffset = (lightGridSize - 1) * lightSpacing * 0.5f;
+		for (int z = 0; z < lightGridSize; z++)
+		{
+			for (int x = 0; x < lightGridSize; x++)
+			{
+				float hue = (float)(z * lightGridSize + x) / (lightGridSize * lightGridSize) * glm::two_pi<float>();
+
+				auto entity = scene->CreateEntity("Point Light");
+				entity.GetComponent<TagComponent>().Icon = TagIcon::Light;
+				entity.GetComponent<TransformComponent>().Position = { x * lightSpacing - lightOffset, 2.5f, z * lightSpacing - lightOffset };
+
+				auto& light = entity.AddComponent<PointLightComponent>();
+				light.Color = 0.5f + 0.5f * glm::cos(glm::vec3(hue, hue - 2.0944f, hue + 2.0944f));
+				light.Intensity = 20.0f;
+				light.Radius = 6.0f;
+			}
+		}
+	}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Venus.h>
+
+namespace Venus {
+
+	struct BenchmarkSpecification
+	{
+		// Empty runs the built in benchmark scene
+		std::filesystem::path ScenePath;
+
+		uint32_t FrameCount = 300;
+		// Run before recording, so shader compiles, environment bakes and texture streaming stay out of the numbers
+		uint32_t WarmupFrames = 30;
+		uint32_t Width = 1920, Height = 1080;
+		float Timestep = 1.0f / 60.0f; // seconds
+
+		// Timings go to <scene>.csv, the last frame to <scene>.tga
+		std::filesystem::path OutputDirectory = "Benchmark";
+		bool CaptureFinalImage = false;
+	};
+
+	// Plays a scene for a fixed number of frames at a fixed timestep, then writes the timings and closes the application
+	class BenchmarkLayer : public Layer
+	{
+		public:
+			BenchmarkLayer(const BenchmarkSpecification& spec);
+			virtual ~BenchmarkLayer() = default;
+
+			virtual void OnAttach() override;
+			virtual void OnDetach() override;
+			virtual void OnUpdate(Timestep ts) override;
+
+			// Fixed content so renderer timings compare between runs, formats and options
+			static void PopulateScene(const Ref<Scene>& scene);
+
+		private:
+			void ReadGPUTimes();
+			void WriteResults();
+			void WriteFinalImage(const std::filesystem::path& path);
+
+		private:
+			struct FrameTiming
+			{
+				uint64_t GPUFrame = 0;
+				float Frame = 0.0f; // Wall time until the next frame, ms
+				float Update = 0.0f; // Scene update and render submission, ms
+				float GPU = -1.0f; // ms, negative until read back
+				std::vector<float> Passes; // By m_PassNames, ms
+				Renderer::Statistics Stats;
+			};
+
+			BenchmarkSpecification m_Specification;
+			std::string m_Name;
+
+			Ref<Scene> m_Scene;
+			Ref<SceneRenderer> m_SceneRenderer;
+
+			uint32_t m_FrameIndex = 0;
+			std::vector<FrameTiming> m_Frames;
+			// Outermost GPU scopes, in order of first appearance
+			std::vector<const char*> m_PassNames;
+			Timer m_FrameTimer;
+	};
+
+}
@@ -2,9 +2,54 @@
 #include <Engine/EntryPoint.h>
 
 #include "EditorLayer.h"
+#include "BenchmarkLayer.h"
 
 namespace Venus {
 
+	namespace Utils {
+
+		// --benchmark [scene.venus] [--frames N] [--warmup N] [--size WxH] [--timestep seconds] [--output dir] [--capture] [--null]
+		static bool ParseBenchmarkArgs(const ApplicationCommandLineArgs& args, BenchmarkSpecification& benchmark, bool& nullRenderer)
+		{
+			// Anything else on the command line belongs to the editor, such as a project path
+			bool enabled = false;
+			for (int i = 1; i < args.Count; i++)
+				enabled |= std::string(args[i]) == "--benchmark";
+
+			if (!enabled)
+				return false;
+
+			for (int i = 1; i < args.Count; i++)
+			{
+				std::string arg = args[i];
+				bool hasValue = i + 1 < args.Count;
+
+				if (arg == "--benchmark")
+				{
+					if (hasValue && args[i + 1][0] != '-')
+						benchmark.ScenePath = args[++i];
+				}
+				else if (arg == "--frames" && hasValue)
+					benchmark.FrameCount = (uint32_t)std::strtoul(args[++i], nullptr, 10);
+				else if (arg == "--warmup" && hasValue)
+					benchmark.WarmupFrames = (uint32_t)std::strtoul(args[++i], nullptr, 10);
+				else if (arg == "--size" && hasValue)
+					sscanf(args[++i], "%ux%u", &benchmark.Width, &benchmark.Height);
+				else if (arg == "--timestep" && hasValue)
+					benchmark.Timestep = std::strtof(args[++i], nullptr);
+				else if (arg == "--output" && hasValue)
+					benchmark.OutputDirectory = args[++i];
+				else if (arg == "--capture")
+					benchmark.CaptureFinalImage = true;
+				else if (arg == "--null")
+					nullRenderer = true;
+			}
+
+			return true;
+		}
+
+	}
+
 	class EditorApp : public Application
 	{
 		public:
@@ -14,6 +59,12 @@ namespace Venus {
 				PushLayer(new EditorLayer());
 			}
 
+			EditorApp(ApplicationSpecification spec, ApplicationCommandLineArgs args, const BenchmarkSpecification& benchmark)
+				:Application(spec, args)
+			{
+				PushLayer(new BenchmarkLayer(benchmark));
+			}
+
 			~EditorApp()
 			{
 			}
@@ -29,7 +80,20 @@ namespace Venus {
 		spec.Vsync = false;
 		spec.WindowDecorated = false;
 
+		BenchmarkSpecification benchmark;
+		bool nullRenderer = false;
+		if (Utils::ParseBenchmarkArgs(args, benchmark, nullRenderer))
+		{
+			spec.Name = "Venus Benchmark";
+			spec.Width = benchmark.Width;
+			spec.Height = benchmark.Height;
+			spec.Headless = true;
+			spec.API = nullRenderer ? RendererAPI::API::None : RendererAPI::API::OpenGL;
+
+			return new EditorApp(spec, args, benchmark);
+		}
+
 		return new EditorApp(spec, args);
 	}
 
-}
\ No newline at end of file
+}
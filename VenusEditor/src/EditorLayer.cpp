@@ -1,4 +1,5 @@
 #include "EditorLayer.h"
+#include "BenchmarkLayer.h"
 
 #include "Assets/AssetManager.h"
 #include "Scripting/ScriptingEngine.h"
@@ -173,6 +174,7 @@ namespace Venus {
 		m_ConsolePanel.OnImGuiRender(m_ShowConsolePanel);
 		m_AssetBrowserPanel.OnImGuiRender(m_ShowAssetBrowserPanel);
 		m_RendererStatsPanel.OnImGuiRender(m_ShowStatsPanel);
+		m_ProfilerPanel.OnImGuiRender(m_ShowProfilerPanel);
 		m_MaterialEditorPanel.OnImGuiRender(m_ShowMaterialEditor);
 		m_SceneRenderer->OnImGuiRender(m_ShowSceneSettingsPanel);
 		AssetManager::OnImGuiRender(m_ShowAssetsInspector);
@@ -393,6 +395,9 @@ namespace Venus {
 				if (ImGui::MenuItem(ICON_FA_FILE_O "  New", "Ctrl+N"))
 					NewScene();
 
+				if (ImGui::MenuItem(ICON_FA_FILE_O "  New Benchmark Scene"))
+					NewBenchmarkScene();
+
 				if (ImGui::MenuItem(ICON_FA_FILE  "  Open...", "Ctrl+O"))
 					OpenScene();;
 
@@ -451,6 +456,8 @@ namespace Venus {
 				if (ImGui::MenuItem(ICON_FA_SIGNAL " Statistics", nullptr, m_ShowStatsPanel))
 					m_ShowStatsPanel = !m_ShowStatsPanel;
 
+				if (ImGui::MenuItem(ICON_FA_CLOCK_O " Profiler", nullptr, m_ShowProfilerPanel))
+					m_ShowProfilerPanel = !m_ShowProfilerPanel;
 
 
 				ImGui::EndMenu();
@@ -1144,6 +1151,16 @@ namespace Venus {
 		m_SceneRenderer->SetScene(m_ActiveScene);
 	}
 
+	void EditorLayer::NewBenchmarkScene()
+	{
+		NewScene();
+
+		m_EditorScene->m_SceneName = "Benchmark";
+		UpdateWindowTitle(m_EditorScene->m_SceneName);
+
+		BenchmarkLayer::PopulateScene(m_EditorScene);
+	}
+
 	void EditorLayer::OpenScene()
 	{
 		std::string filePath = FileDialogs::OpenFile("Venus Scene (*.venus)\0*.venus\0");
@@ -5,6 +5,7 @@
 #include "Panels/ObjectsPanel.h"
 #include "Panels/AssetBrowserPanel.h"
 #include "Panels/RendererStatsPanel.h"
+#include "Panels/ProfilerPanel.h"
 #include "Panels/MaterialEditorPanel.h"
 
 namespace Venus {
@@ -23,6 +24,7 @@ namespace Venus {
 
 		private:
 			void NewScene();
+			void NewBenchmarkScene();
 			void OpenScene();
 			void OpenScene(const std::filesystem::path& path);
 			void SaveSceneAs();
@@ -65,6 +67,7 @@ namespace Venus {
 			ObjectsPanel m_ObjectsPanel;
 			AssetBrowserPanel m_AssetBrowserPanel;
 			RendererStatsPanel m_RendererStatsPanel;
+			ProfilerPanel m_ProfilerPanel;
 			ConsolePanel m_ConsolePanel;
 			MaterialEditorPanel m_MaterialEditorPanel;
 			
@@ -104,6 +107,7 @@ namespace Venus {
 			bool m_ShowAssetBrowserPanel = true;
 			bool m_ShowAssetsInspector = false;
 			bool m_ShowStatsPanel = false;
+			bool m_ShowProfilerPanel = false;
 			bool m_ShowConsolePanel = true;
 			bool m_ShowSceneSettingsPanel = false;
 			bool m_ShowWelcomeMessage = false;
@@ -557,7 +557,7 @@ namespace Venus {
 		// Mesh Renderer Component
 		if (entity.HasComponent<MeshRendererComponent>() && componentsFilter.PassFilter("Mesh Renderer"))
 		{
-			RenderComponent<MeshRendererComponent>(ICON_FA_CUBES  "  Mesh Renderer", entity, true, [](auto& component)
+			RenderComponent<MeshRendererComponent>(ICON_FA_CUBES  "  Mesh Renderer", entity, true, [this, entity](auto& component)
 			{
 				ImGui::Columns(2);
 				ImGui::Text("Model");
@@ -580,6 +580,7 @@ namespace Venus {
 						const wchar_t* path = (const wchar_t*)payload->Data;
 						AssetHandle handle = AssetManager::GetHandle(path);
 						component.Model = handle;
+						m_Context->MarkMeshBoundsDirty(entity);
 					}
 				}
 
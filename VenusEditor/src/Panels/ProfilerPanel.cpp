@@ -0,0 +1,341 @@
+#include "ProfilerPanel.h"
+
+#include "imgui/imgui.h"
+
+namespace Venus {
+
+	static ImU32 GetScopeColor(const char* name)
+	{
+		// Stable per scope so the same function keeps its color between frames
+		float hue = (std::hash<std::string_view>()(name) % 360) / 360.0f;
+		return ImColor::HSV(hue, 0.45f, 0.65f);
+	}
+
+	static uint32_t DrawScopeTree(const ProfileFrame& frame, const std::vector<ProfileScope>& scopes, uint32_t index)
+	{
+		const ProfileScope& scope = scopes[index];
+		uint32_t next = index + 1;
+		bool hasChildren = next < scopes.size() && scopes[next].Depth > scope.Depth;
+
+		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanFullWidth;
+		if (!hasChildren)
+			flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+
+		float time = frame.ToMilliseconds(scope.End - scope.Start);
+
+		ImGui::TableNextRow();
+		ImGui::TableSetColumnIndex(0);
+		bool open = ImGui::TreeNodeEx((void*)(intptr_t)index, flags, "%s", scope.Name);
+		ImGui::TableSetColumnIndex(1);
+		ImGui::Text("%.3f", time);
+		ImGui::TableSetColumnIndex(2);
+		ImGui::Text("%.1f%%", frame.Duration > 0.0f ? time / frame.Duration * 100.0f : 0.0f);
+
+		if (!hasChildren)
+			return next;
+
+		if (open)
+		{
+			while (next < scopes.size() && scopes[next].Depth > scope.Depth)
+				next = DrawScopeTree(frame, scopes, next);
+			ImGui::TreePop();
+		}
+		else
+		{
+			while (next < scopes.size() && scopes[next].Depth > scope.Depth)
+				next++;
+		}
+
+		return next;
+	}
+
+	void ProfilerPanel::OnImGuiRender(bool& open)
+	{
+		// Scopes are only collected while someone looks at them
+		if (Instrumentor::Get().IsLiveCaptureEnabled() != open)
+			Instrumentor::Get().SetLiveCapture(open);
+
+		if (!open)
+		{
+			m_Frames.clear();
+			m_SelectedFrame = nullptr;
+			return;
+		}
+
+		ImGui::Begin(ICON_FA_CLOCK_O " Profiler", &open);
+
+	#if !VS_PROFILE
+		ImGui::TextWrapped("Profiling is compiled out, set VS_PROFILE to 1 in Debug/Instrumentor.h to record scopes.");
+	#endif
+
+		FrameProfiler& profiler = Instrumentor::Get().GetFrameProfiler();
+		m_Frames = profiler.GetFrames();
+
+		// Latest frame while running, the spike once frozen on one, otherwise whatever was clicked
+		int64_t spikeFrame = profiler.GetSpikeFrame();
+		if (!profiler.IsFrozen() || !m_SelectedFrame || spikeFrame >= 0)
+		{
+			m_SelectedFrame = m_Frames.empty() ? nullptr : m_Frames.back();
+			for (const auto& frame : m_Frames)
+			{
+				if ((int64_t)frame->Index == spikeFrame)
+					m_SelectedFrame = frame;
+			}
+		}
+
+		DrawToolbar();
+		DrawFrameHistory();
+
+		if (ImGui::BeginTabBar("ProfilerTabs"))
+		{
+			if (ImGui::BeginTabItem("Timeline"))
+			{
+				if (m_SelectedFrame)
+					DrawTimeline(*m_SelectedFrame);
+				ImGui::EndTabItem();
+			}
+
+			if (ImGui::BeginTabItem("Hierarchy"))
+			{
+				if (m_SelectedFrame)
+					DrawHierarchy(*m_SelectedFrame);
+				ImGui::EndTabItem();
+			}
+
+			if (ImGui::BeginTabItem("Scopes"))
+			{
+				DrawScopeStats();
+				ImGui::EndTabItem();
+			}
+
+			ImGui::EndTabBar();
+		}
+
+		ImGui::End();
+	}
+
+	void ProfilerPanel::DrawToolbar()
+	{
+		FrameProfiler& profiler = Instrumentor::Get().GetFrameProfiler();
+
+		bool frozen = profiler.IsFrozen();
+		if (ImGui::Button(frozen ? ICON_FA_PLAY " Resume" : ICON_FA_PAUSE " Freeze"))
+			profiler.SetFrozen(!frozen);
+
+		ImGui::SameLine();
+		bool autoFreeze = profiler.IsAutoFreezeEnabled();
+		if (ImGui::Checkbox("Freeze on Spike", &autoFreeze))
+			profiler.SetAutoFreeze(autoFreeze);
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(100.0f);
+		float budget = profiler.GetBudget();
+		if (ImGui::DragFloat("Budget (ms)", &budget, 0.1f, 1.0f, 1000.0f, "%.1f"))
+			profiler.SetBudget(budget);
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(100.0f);
+		int historySize = (int)profiler.GetHistorySize();
+		if (ImGui::SliderInt("History", &historySize, 60, 1000))
+			profiler.SetHistorySize((uint32_t)historySize);
+
+		ImGui::SameLine();
+		if (Instrumentor::Get().IsSessionOpen())
+			ImGui::TextUnformatted(ICON_FA_FLOPPY_O " Capturing...");
+		else if (ImGui::Button(ICON_FA_FLOPPY_O " Capture 300 Frames"))
+			VS_PROFILE_CAPTURE_FRAMES(300, "VenusProfile-Runtime.vsprof");
+
+		if (frozen && profiler.GetSpikeFrame() >= 0 && m_SelectedFrame)
+			ImGui::TextColored({ 0.9f, 0.35f, 0.3f, 1.0f }, "Frozen on frame %llu, %.2f ms over a %.1f ms budget", m_SelectedFrame->Index, m_SelectedFrame->Duration, budget);
+		else if (m_SelectedFrame)
+			ImGui::Text("Frame %llu, %.2f ms", m_SelectedFrame->Index, m_SelectedFrame->Duration);
+	}
+
+	void ProfilerPanel::DrawFrameHistory()
+	{
+		FrameProfiler& profiler = Instrumentor::Get().GetFrameProfiler();
+
+		const float height = 80.0f;
+		ImVec2 size = { ImGui::GetContentRegionAvail().x, height };
+		ImVec2 origin = ImGui::GetCursorScreenPos();
+		ImGui::InvisibleButton("FrameHistory", size);
+		bool hovered = ImGui::IsItemHovered();
+		bool clicked = ImGui::IsItemClicked();
+
+		auto* drawList = ImGui::GetWindowDrawList();
+		drawList->AddRectFilled(origin, { origin.x + size.x, origin.y + size.y }, IM_COL32(25, 25, 25, 255));
+
+		// Scaled so the budget sits in the middle, spikes are clamped to the top
+		float budget = profiler.GetBudget();
+		float scale = height / (budget * 2.0f);
+		float barWidth = size.x / profiler.GetHistorySize();
+
+		for (uint32_t i = 0; i < (uint32_t)m_Frames.size(); i++)
+		{
+			const ProfileFrame& frame = *m_Frames[i];
+			float barHeight = std::min(frame.Duration * scale, height);
+			float x = origin.x + size.x - (m_Frames.size() - i) * barWidth;
+
+			ImVec2 min = { x, origin.y + height - barHeight };
+			ImVec2 max = { x + std::max(barWidth - 1.0f, 1.0f), origin.y + height };
+
+			ImU32 color = frame.Duration > budget ? IM_COL32(200, 70, 60, 255) : IM_COL32(90, 160, 90, 255);
+			if (m_Frames[i] == m_SelectedFrame)
+				color = IM_COL32(230, 200, 80, 255);
+
+			drawList->AddRectFilled(min, max, color);
+
+			if (hovered && ImGui::GetIO().MousePos.x >= x && ImGui::GetIO().MousePos.x < x + barWidth)
+			{
+				ImGui::SetTooltip("Frame %llu: %.2f ms", frame.Index, frame.Duration);
+
+				// Picking a frame freezes the history so it stays around
+				if (clicked)
+				{
+					profiler.SetFrozen(true);
+					m_SelectedFrame = m_Frames[i];
+				}
+			}
+		}
+
+		float budgetY = origin.y + height - budget * scale;
+		drawList->AddLine({ origin.x, budgetY }, { origin.x + size.x, budgetY }, IM_COL32(200, 200, 200, 120));
+	}
+
+	void ProfilerPanel::DrawTimeline(const ProfileFrame& frame)
+	{
+		const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+		const float threadSpacing = ImGui::GetTextLineHeightWithSpacing();
+
+		ImGui::SetNextItemWidth(150.0f);
+		ImGui::SliderFloat("Zoom", &m_TimelineZoom, 1.0f, 64.0f, "%.1fx", ImGuiSliderFlags_Logarithmic);
+
+		ImGui::BeginChild("Timeline", { 0.0f, 0.0f }, false, ImGuiWindowFlags_HorizontalScrollbar);
+
+		float width = ImGui::GetContentRegionAvail().x * m_TimelineZoom;
+		float height = 0.0f;
+		for (const auto& thread : frame.Threads)
+			height += threadSpacing + (thread.MaxDepth + 1) * rowHeight;
+
+		ImVec2 origin = ImGui::GetCursorScreenPos();
+		ImGui::Dummy({ width, height });
+
+		auto* drawList = ImGui::GetWindowDrawList();
+		float frameTicks = (float)std::max<uint64_t>(frame.End - frame.Start, 1);
+		ImVec2 mouse = ImGui::GetIO().MousePos;
+		bool hovered = ImGui::IsWindowHovered();
+
+		float y = origin.y;
+		for (const auto& thread : frame.Threads)
+		{
+			std::string threadName = Instrumentor::Get().GetThreadName(thread.ThreadIndex);
+			drawList->AddText({ ImGui::GetWindowPos().x + 4.0f, y }, IM_COL32(180, 180, 180, 255), threadName.c_str());
+			y += threadSpacing;
+
+			for (const auto& scope : thread.Scopes)
+			{
+				float x0 = origin.x + (int64_t)(scope.Start - frame.Start) / frameTicks * width;
+				float x1 = origin.x + (int64_t)(scope.End - frame.Start) / frameTicks * width;
+				x1 = std::max(x1, x0 + 1.0f);
+
+				ImVec2 min = { x0, y + scope.Depth * rowHeight };
+				ImVec2 max = { x1, min.y + rowHeight - 1.0f };
+				drawList->AddRectFilled(min, max, GetScopeColor(scope.Name));
+
+				if (x1 - x0 > 20.0f)
+				{
+					drawList->PushClipRect(min, max, true);
+					drawList->AddText({ min.x + 2.0f, min.y + 2.0f }, IM_COL32(255, 255, 255, 255), scope.Name);
+					drawList->PopClipRect();
+				}
+
+				if (hovered && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+					ImGui::SetTooltip("%s\n%.3f ms", scope.Name, frame.ToMilliseconds(scope.End - scope.Start));
+			}
+
+			y += (thread.MaxDepth + 1) * rowHeight;
+		}
+
+		// Ctrl + wheel zooms around the cursor
+		if (hovered && ImGui::GetIO().KeyCtrl && ImGui::GetIO().MouseWheel != 0.0f)
+		{
+			float cursor = (mouse.x - origin.x) / width;
+			m_TimelineZoom = std::clamp(m_TimelineZoom * (ImGui::GetIO().MouseWheel > 0.0f ? 1.25f : 0.8f), 1.0f, 64.0f);
+
+			float newWidth = ImGui::GetContentRegionAvail().x * m_TimelineZoom;
+			ImGui::SetScrollX(cursor * newWidth - (mouse.x - ImGui::GetWindowPos().x));
+		}
+
+		ImGui::EndChild();
+	}
+
+	void ProfilerPanel::DrawHierarchy(const ProfileFrame& frame)
+	{
+		ImGuiTableFlags tableFlags = ImGuiTableFlags_BordersV | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+		if (!ImGui::BeginTable("ProfilerHierarchy", 3, tableFlags))
+			return;
+
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("Time (ms)", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+		ImGui::TableSetupColumn("Frame", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+		ImGui::TableHeadersRow();
+
+		for (const auto& thread : frame.Threads)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0);
+
+			std::string threadName = Instrumentor::Get().GetThreadName(thread.ThreadIndex);
+			ImGui::SetNextItemOpen(&thread == &frame.Threads.front(), ImGuiCond_Once);
+			if (ImGui::TreeNodeEx((void*)(intptr_t)(thread.ThreadIndex + 1), ImGuiTreeNodeFlags_SpanFullWidth, "%s", threadName.c_str()))
+			{
+				ImGui::PushID(thread.ThreadIndex);
+				uint32_t index = 0;
+				while (index < thread.Scopes.size())
+					index = DrawScopeTree(frame, thread.Scopes, index);
+				ImGui::PopID();
+
+				ImGui::TreePop();
+			}
+		}
+
+		ImGui::EndTable();
+	}
+
+	void ProfilerPanel::DrawScopeStats()
+	{
+		ImGuiTableFlags tableFlags = ImGuiTableFlags_BordersV | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+		if (!ImGui::BeginTable("ProfilerScopes", 6, tableFlags))
+			return;
+
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("Min", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+		ImGui::TableSetupColumn("Avg", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+		ImGui::TableSetupColumn("P99", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+		ImGui::TableSetupColumn("Last", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+		ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+		ImGui::TableHeadersRow();
+
+		for (const auto& stats : Instrumentor::Get().GetFrameProfiler().GetScopeStats())
+		{
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0);
+			ImGui::TextUnformatted(stats.Name);
+			ImGui::TableSetColumnIndex(1);
+			ImGui::Text("%.3f", stats.Min);
+			ImGui::TableSetColumnIndex(2);
+			ImGui::Text("%.3f", stats.Average);
+			ImGui::TableSetColumnIndex(3);
+			ImGui::Text("%.3f", stats.P99);
+			ImGui::TableSetColumnIndex(4);
+			ImGui::Text("%.3f", stats.Last);
+			ImGui::TableSetColumnIndex(5);
+			ImGui::Text("%u", stats.Calls);
+		}
+
+		ImGui::EndTable();
+	}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Venus.h>
+
+namespace Venus {
+
+	// Live CPU frame profiler, fed by the profile scopes while the panel is open
+	class ProfilerPanel
+	{
+		public:
+			ProfilerPanel() = default;
+
+			void OnImGuiRender(bool& open);
+
+		private:
+			void DrawToolbar();
+			void DrawFrameHistory();
+			void DrawTimeline(const ProfileFrame& frame);
+			void DrawHierarchy(const ProfileFrame& frame);
+			void DrawScopeStats();
+
+		private:
+			std::vector<Ref<ProfileFrame>> m_Frames;
+			Ref<ProfileFrame> m_SelectedFrame;
+			float m_TimelineZoom = 1.0f;
+	};
+
+}
@@ -42,9 +42,22 @@ namespace Venus {
 		ImGui::Text("Draw Calls: %d", stats.DrawCalls);
 		ImGui::Text("Models: %d", stats.Models);
 		ImGui::Text("Meshs: %d", stats.Meshs);
+		ImGui::Text("Instances: %d", stats.Instances);
+		ImGui::Text("State Changes: %d", stats.StateChanges);
+		ImGui::Text("State Changes Avoided: %d", stats.StateChangesAvoided);
 		ImGui::Text("Vertices: %d", stats.VertexCount);
 		ImGui::Text("Indices: %d", stats.IndexCount);
 
+		// GPU, read back a few frames late
+		ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 15.0f);
+		ImGui::PushFont(boldFont);
+		ImGui::Text("GPU Time:");
+		ImGui::PopFont();
+		ImGui::Separator();
+		ImGui::Text("Frame: %.3fms", GPUProfiler::GetFrameTime());
+		for (const auto& scope : GPUProfiler::GetScopeTimes())
+			ImGui::Text("%*s%s: %.3fms", scope.Depth * 2, "", scope.Name, scope.Time);
+
 		// Renderer 2D
 		ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 15.0f);
 		ImGui::PushFont(boldFont);
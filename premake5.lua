@@ -11,6 +11,12 @@ workspace "Venus"
 
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 
+newoption
+{
+	trigger = "egl",
+	description = "Create headless OpenGL contexts with EGL instead of a hidden GLFW window"
+}
+
 VULKAN_SDK = os.getenv("VULKAN_SDK")
 
 -- INCLUDES
@@ -146,6 +152,10 @@ project "Venus"
 	filter "files:Venus/vendor/ImGuizmo/ImGuizmo.cpp"
 	flags { "NoPCH" }
 
+	filter "options:egl"
+		defines "VS_EGL"
+		links "EGL"
+
 	filter "system:windows"
 		systemversion "latest"
 